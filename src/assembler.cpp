@@ -1,9 +1,9 @@
 /* Generated by re2c 2.0.3 on Fri Jun 11 01:26:32 2021 */
-// A Bison parser, made by GNU Bison 3.4.1.
+// A Bison parser, made by GNU Bison 3.8.2.
 
 // Skeleton implementation for Bison LALR(1) parsers in C++
 
-// Copyright (C) 2002-2015, 2018-2019 Free Software Foundation, Inc.
+// Copyright (C) 2002-2015, 2018-2021 Free Software Foundation, Inc.
 
 // This program is free software: you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
@@ -16,7 +16,7 @@
 // GNU General Public License for more details.
 
 // You should have received a copy of the GNU General Public License
-// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 // As a special exception, you may create a larger work that contains
 // part or all of the Bison parser skeleton and distribute that work
@@ -31,14 +31,15 @@
 // This special exception was added by the Free Software Foundation in
 // version 2.2 of Bison.
 
-// Undocumented macros, especially those whose name start with YY_,
-// are private implementation details.  Do not rely on them.
+// DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+// especially those whose name start with YY_ or yy_.  They are
+// private implementation details that can be changed or removed.
 
 
 
 
 
-// //                    "%code requires" blocks.
+// "%code requires" blocks.
 
 #include "assembler.hpp"
 
@@ -48,12 +49,15 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <stack>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
-#include "compoundInputFileStream.hpp"
+#include "inputStack.hpp"
 
 
 
@@ -102,44 +106,48 @@
 #endif
 
 #include <typeinfo>
-#ifndef YYASSERT
+#ifndef YY_ASSERT
 # include <cassert>
-# define YYASSERT assert
+# define YY_ASSERT assert
 #endif
 
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
 # else
-#  define YY_ATTRIBUTE(Spec) /* empty */
+#  define YY_ATTRIBUTE_PURE
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
-#endif
-
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -152,6 +160,27 @@
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
 #  if defined __cplusplus
 #   if 201103L <= __cplusplus
@@ -176,10 +205,15 @@ namespace yy {
   class position
   {
   public:
+    /// Type for file name.
+    typedef const std::string filename_type;
+    /// Type for line and column numbers.
+    typedef int counter_type;
+
     /// Construct a position.
-    explicit position (std::string* f = YY_NULLPTR,
-                       unsigned l = 1u,
-                       unsigned c = 1u)
+    explicit position (filename_type* f = YY_NULLPTR,
+                       counter_type l = 1,
+                       counter_type c = 1)
       : filename (f)
       , line (l)
       , column (c)
@@ -187,9 +221,9 @@ namespace yy {
 
 
     /// Initialization.
-    void initialize (std::string* fn = YY_NULLPTR,
-                     unsigned l = 1u,
-                     unsigned c = 1u)
+    void initialize (filename_type* fn = YY_NULLPTR,
+                     counter_type l = 1,
+                     counter_type c = 1)
     {
       filename = fn;
       line = l;
@@ -199,41 +233,40 @@ namespace yy {
     /** \name Line and Column related manipulators
      ** \{ */
     /// (line related) Advance to the COUNT next lines.
-    void lines (int count = 1)
+    void lines (counter_type count = 1)
     {
       if (count)
         {
-          column = 1u;
+          column = 1;
           line = add_ (line, count, 1);
         }
     }
 
     /// (column related) Advance to the COUNT next columns.
-    void columns (int count = 1)
+    void columns (counter_type count = 1)
     {
       column = add_ (column, count, 1);
     }
     /** \} */
 
     /// File name to which this position refers.
-    std::string* filename;
+    filename_type* filename;
     /// Current line number.
-    unsigned line;
+    counter_type line;
     /// Current column number.
-    unsigned column;
+    counter_type column;
 
   private:
     /// Compute max (min, lhs+rhs).
-    static unsigned add_ (unsigned lhs, int rhs, int min)
+    static counter_type add_ (counter_type lhs, counter_type rhs, counter_type min)
     {
-      return static_cast<unsigned> (std::max (min,
-                                              static_cast<int> (lhs) + rhs));
+      return lhs + rhs < min ? min : lhs + rhs;
     }
   };
 
   /// Add \a width columns, in place.
   inline position&
-  operator+= (position& res, int width)
+  operator+= (position& res, position::counter_type width)
   {
     res.columns (width);
     return res;
@@ -241,43 +274,25 @@ namespace yy {
 
   /// Add \a width columns.
   inline position
-  operator+ (position res, int width)
+  operator+ (position res, position::counter_type width)
   {
     return res += width;
   }
 
   /// Subtract \a width columns, in place.
   inline position&
-  operator-= (position& res, int width)
+  operator-= (position& res, position::counter_type width)
   {
     return res += -width;
   }
 
   /// Subtract \a width columns.
   inline position
-  operator- (position res, int width)
+  operator- (position res, position::counter_type width)
   {
     return res -= width;
   }
 
-  /// Compare two position objects.
-  inline bool
-  operator== (const position& pos1, const position& pos2)
-  {
-    return (pos1.line == pos2.line
-            && pos1.column == pos2.column
-            && (pos1.filename == pos2.filename
-                || (pos1.filename && pos2.filename
-                    && *pos1.filename == *pos2.filename)));
-  }
-
-  /// Compare two position objects.
-  inline bool
-  operator!= (const position& pos1, const position& pos2)
-  {
-    return !(pos1 == pos2);
-  }
-
   /** \brief Intercept output stream redirection.
    ** \param ostr the destination output stream
    ** \param pos a reference to the position to redirect
@@ -295,6 +310,10 @@ namespace yy {
   class location
   {
   public:
+    /// Type for file name.
+    typedef position::filename_type filename_type;
+    /// Type for line and column numbers.
+    typedef position::counter_type counter_type;
 
     /// Construct a location from \a b to \a e.
     location (const position& b, const position& e)
@@ -309,18 +328,18 @@ namespace yy {
     {}
 
     /// Construct a 0-width location in \a f, \a l, \a c.
-    explicit location (std::string* f,
-                       unsigned l = 1u,
-                       unsigned c = 1u)
+    explicit location (filename_type* f,
+                       counter_type l = 1,
+                       counter_type c = 1)
       : begin (f, l, c)
       , end (f, l, c)
     {}
 
 
     /// Initialization.
-    void initialize (std::string* f = YY_NULLPTR,
-                     unsigned l = 1u,
-                     unsigned c = 1u)
+    void initialize (filename_type* f = YY_NULLPTR,
+                     counter_type l = 1,
+                     counter_type c = 1)
     {
       begin.initialize (f, l, c);
       end = begin;
@@ -336,13 +355,13 @@ namespace yy {
     }
 
     /// Extend the current location to the COUNT next columns.
-    void columns (int count = 1)
+    void columns (counter_type count = 1)
     {
       end += count;
     }
 
     /// Extend the current location to the COUNT next lines.
-    void lines (int count = 1)
+    void lines (counter_type count = 1)
     {
       end.lines (count);
     }
@@ -357,57 +376,49 @@ namespace yy {
   };
 
   /// Join two locations, in place.
-  inline location& operator+= (location& res, const location& end)
+  inline location&
+  operator+= (location& res, const location& end)
   {
     res.end = end.end;
     return res;
   }
 
   /// Join two locations.
-  inline location operator+ (location res, const location& end)
+  inline location
+  operator+ (location res, const location& end)
   {
     return res += end;
   }
 
   /// Add \a width columns to the end position, in place.
-  inline location& operator+= (location& res, int width)
+  inline location&
+  operator+= (location& res, location::counter_type width)
   {
     res.columns (width);
     return res;
   }
 
   /// Add \a width columns to the end position.
-  inline location operator+ (location res, int width)
+  inline location
+  operator+ (location res, location::counter_type width)
   {
     return res += width;
   }
 
   /// Subtract \a width columns to the end position, in place.
-  inline location& operator-= (location& res, int width)
+  inline location&
+  operator-= (location& res, location::counter_type width)
   {
     return res += -width;
   }
 
   /// Subtract \a width columns to the end position.
-  inline location operator- (location res, int width)
+  inline location
+  operator- (location res, location::counter_type width)
   {
     return res -= width;
   }
 
-  /// Compare two location objects.
-  inline bool
-  operator== (const location& loc1, const location& loc2)
-  {
-    return loc1.begin == loc2.begin && loc1.end == loc2.end;
-  }
-
-  /// Compare two location objects.
-  inline bool
-  operator!= (const location& loc1, const location& loc2)
-  {
-    return !(loc1 == loc2);
-  }
-
   /** \brief Intercept output stream redirection.
    ** \param ostr the destination output stream
    ** \param loc a reference to the location to redirect
@@ -418,7 +429,8 @@ namespace yy {
   std::basic_ostream<YYChar>&
   operator<< (std::basic_ostream<YYChar>& ostr, const location& loc)
   {
-    unsigned end_col = 0 < loc.end.column ? loc.end.column - 1 : 0;
+    location::counter_type end_col
+      = 0 < loc.end.column ? loc.end.column - 1 : 0;
     ostr << loc.begin;
     if (loc.end.filename
         && (!loc.begin.filename
@@ -436,37 +448,49 @@ namespace yy {
   class parser
   {
   public:
-#ifndef YYSTYPE
+#ifdef YYSTYPE
+# ifdef __GNUC__
+#  pragma GCC message "bison: do not #define YYSTYPE in C++, use %define api.value.type"
+# endif
+    typedef YYSTYPE value_type;
+#else
   /// A buffer to store and retrieve objects.
   ///
   /// Sort of a variant, but does not keep track of the nature
   /// of the stored data, since that knowledge is available
   /// via the current parser state.
-  class semantic_type
+  class value_type
   {
   public:
     /// Type of *this.
-    typedef semantic_type self_type;
+    typedef value_type self_type;
 
     /// Empty construction.
-    semantic_type () YY_NOEXCEPT
-      : yybuffer_ ()
+    value_type () YY_NOEXCEPT
+      : yyraw_ ()
       , yytypeid_ (YY_NULLPTR)
     {}
 
     /// Construct and fill.
     template <typename T>
-    semantic_type (YY_RVREF (T) t)
+    value_type (YY_RVREF (T) t)
       : yytypeid_ (&typeid (T))
     {
-      YYASSERT (sizeof (T) <= size);
+      YY_ASSERT (sizeof (T) <= size);
       new (yyas_<T> ()) T (YY_MOVE (t));
     }
 
+#if 201103L <= YY_CPLUSPLUS
+    /// Non copyable.
+    value_type (const self_type&) = delete;
+    /// Non copyable.
+    self_type& operator= (const self_type&) = delete;
+#endif
+
     /// Destruction, allowed only if empty.
-    ~semantic_type () YY_NOEXCEPT
+    ~value_type () YY_NOEXCEPT
     {
-      YYASSERT (!yytypeid_);
+      YY_ASSERT (!yytypeid_);
     }
 
 # if 201103L <= YY_CPLUSPLUS
@@ -475,8 +499,8 @@ namespace yy {
     T&
     emplace (U&&... u)
     {
-      YYASSERT (!yytypeid_);
-      YYASSERT (sizeof (T) <= size);
+      YY_ASSERT (!yytypeid_);
+      YY_ASSERT (sizeof (T) <= size);
       yytypeid_ = & typeid (T);
       return *new (yyas_<T> ()) T (std::forward <U>(u)...);
     }
@@ -486,8 +510,8 @@ namespace yy {
     T&
     emplace ()
     {
-      YYASSERT (!yytypeid_);
-      YYASSERT (sizeof (T) <= size);
+      YY_ASSERT (!yytypeid_);
+      YY_ASSERT (sizeof (T) <= size);
       yytypeid_ = & typeid (T);
       return *new (yyas_<T> ()) T ();
     }
@@ -497,8 +521,8 @@ namespace yy {
     T&
     emplace (const T& t)
     {
-      YYASSERT (!yytypeid_);
-      YYASSERT (sizeof (T) <= size);
+      YY_ASSERT (!yytypeid_);
+      YY_ASSERT (sizeof (T) <= size);
       yytypeid_ = & typeid (T);
       return *new (yyas_<T> ()) T (t);
     }
@@ -527,9 +551,9 @@ namespace yy {
     T&
     as () YY_NOEXCEPT
     {
-      YYASSERT (yytypeid_);
-      YYASSERT (*yytypeid_ == typeid (T));
-      YYASSERT (sizeof (T) <= size);
+      YY_ASSERT (yytypeid_);
+      YY_ASSERT (*yytypeid_ == typeid (T));
+      YY_ASSERT (sizeof (T) <= size);
       return *yyas_<T> ();
     }
 
@@ -538,9 +562,9 @@ namespace yy {
     const T&
     as () const YY_NOEXCEPT
     {
-      YYASSERT (yytypeid_);
-      YYASSERT (*yytypeid_ == typeid (T));
-      YYASSERT (sizeof (T) <= size);
+      YY_ASSERT (yytypeid_);
+      YY_ASSERT (*yytypeid_ == typeid (T));
+      YY_ASSERT (sizeof (T) <= size);
       return *yyas_<T> ();
     }
 
@@ -556,8 +580,8 @@ namespace yy {
     void
     swap (self_type& that) YY_NOEXCEPT
     {
-      YYASSERT (yytypeid_);
-      YYASSERT (*yytypeid_ == *that.yytypeid_);
+      YY_ASSERT (yytypeid_);
+      YY_ASSERT (*yytypeid_ == *that.yytypeid_);
       std::swap (as<T> (), that.as<T> ());
     }
 
@@ -606,16 +630,19 @@ namespace yy {
     }
 
   private:
-    /// Prohibit blind copies.
+#if YY_CPLUSPLUS < 201103L
+    /// Non copyable.
+    value_type (const self_type&);
+    /// Non copyable.
     self_type& operator= (const self_type&);
-    semantic_type (const self_type&);
+#endif
 
     /// Accessor to raw memory as \a T.
     template <typename T>
     T*
     yyas_ () YY_NOEXCEPT
     {
-      void *yyp = yybuffer_.yyraw;
+      void *yyp = yyraw_;
       return static_cast<T*> (yyp);
      }
 
@@ -624,7 +651,7 @@ namespace yy {
     const T*
     yyas_ () const YY_NOEXCEPT
     {
-      const void *yyp = yybuffer_.yyraw;
+      const void *yyp = yyraw_;
       return static_cast<const T*> (yyp);
      }
 
@@ -661,18 +688,19 @@ namespace yy {
     union
     {
       /// Strongest alignment constraints.
-      long double yyalign_me;
+      long double yyalign_me_;
       /// A buffer large enough to store any of the semantic values.
-      char yyraw[size];
-    } yybuffer_;
+      char yyraw_[size];
+    };
 
     /// Whether the content is built: if defined, the name of the stored type.
     const std::type_info *yytypeid_;
   };
 
-#else
-    typedef YYSTYPE semantic_type;
 #endif
+    /// Backward compatibility (Bison 3.8).
+    typedef value_type semantic_type;
+
     /// Symbol locations.
     typedef location location_type;
 
@@ -694,122 +722,267 @@ namespace yy {
       location_type location;
     };
 
-    /// Tokens.
+    /// Token kinds.
     struct token
     {
-      enum yytokentype
-      {
-        END_OF_FILE = 0,
-        END_OF_LINE = 258,
-        IDENTIFIER = 259,
-        LITERAL = 260,
-        STRING = 261,
-        REGISTER = 262,
-        ARGUMENT_LIST = 263,
-        TEXT = 264,
-        DATA = 265,
-        WORD = 266,
-        BYTE = 267,
-        ASCII = 268,
-        ASCIIZ = 269,
-        ALIGN = 270,
-        SPACE = 271,
-        INCLUDE = 272,
-        ERROR = 273,
-        MESSAGE = 274,
-        MACRO = 275,
-        DBG = 276,
-        DEFINE = 277,
-        DBGBP = 278,
-        ADD = 279,
-        ADDI = 280,
-        ADDIU = 281,
-        ADDU = 282,
-        AND = 283,
-        ANDI = 284,
-        BEQ = 285,
-        BGEZ = 286,
-        BGEZAL = 287,
-        BGTZ = 288,
-        BLEZ = 289,
-        BLTZ = 290,
-        BLTZAL = 291,
-        BNE = 292,
-        DIV = 293,
-        DIVU = 294,
-        J = 295,
-        JAL = 296,
-        JR = 297,
-        LB = 298,
-        LUI = 299,
-        LW = 300,
-        MFHI = 301,
-        MFLO = 302,
-        MULT = 303,
-        MULTU = 304,
-        OR = 305,
-        ORI = 306,
-        SB = 307,
-        SLL = 308,
-        SLLV = 309,
-        NOR = 310,
-        SLT = 311,
-        SLTI = 312,
-        SLTIU = 313,
-        SLTU = 314,
-        SNE = 315,
-        SEQ = 316,
-        SRA = 317,
-        SRL = 318,
-        SRLV = 319,
-        SUB = 320,
-        SUBU = 321,
-        SW = 322,
-        SYS = 323,
-        XOR = 324,
-        XORI = 325,
-        JALR = 326,
-        COPY = 327,
-        CLR = 328,
-        B = 329,
-        BAL = 330,
-        BGT = 331,
-        BLT = 332,
-        BGE = 333,
-        BLE = 334,
-        BGTU = 335,
-        BEQZ = 336,
-        REM = 337,
-        LI = 338,
-        LA = 339,
-        NOP = 340,
-        NOT = 341,
-        PUSHW = 342,
-        POPW = 343,
-        PUSHB = 344,
-        POPB = 345,
-        RET = 346,
-        CALL = 347,
-        ENTER = 348
+      enum token_kind_type
+      {
+        YYEMPTY = -2,
+    END_OF_FILE = 0,               // END_OF_FILE
+    YYerror = 256,                 // error
+    YYUNDEF = 257,                 // "invalid token"
+    END_OF_LINE = 258,             // END_OF_LINE
+    IDENTIFIER = 259,              // IDENTIFIER
+    LITERAL = 260,                 // LITERAL
+    STRING = 261,                  // STRING
+    REGISTER = 262,                // REGISTER
+    ARGUMENT_LIST = 263,           // ARGUMENT_LIST
+    TEXT = 264,                    // TEXT
+    DATA = 265,                    // DATA
+    WORD = 266,                    // WORD
+    BYTE = 267,                    // BYTE
+    ASCII = 268,                   // ASCII
+    ASCIIZ = 269,                  // ASCIIZ
+    ALIGN = 270,                   // ALIGN
+    SPACE = 271,                   // SPACE
+    INCLUDE = 272,                 // INCLUDE
+    ERROR = 273,                   // ERROR
+    MESSAGE = 274,                 // MESSAGE
+    MACRO = 275,                   // MACRO
+    DBG = 276,                     // DBG
+    DEFINE = 277,                  // DEFINE
+    DBGBP = 278,                   // DBGBP
+    ADD = 279,                     // ADD
+    ADDI = 280,                    // ADDI
+    ADDIU = 281,                   // ADDIU
+    ADDU = 282,                    // ADDU
+    AND = 283,                     // AND
+    ANDI = 284,                    // ANDI
+    BEQ = 285,                     // BEQ
+    BGEZ = 286,                    // BGEZ
+    BGEZAL = 287,                  // BGEZAL
+    BGTZ = 288,                    // BGTZ
+    BLEZ = 289,                    // BLEZ
+    BLTZ = 290,                    // BLTZ
+    BLTZAL = 291,                  // BLTZAL
+    BNE = 292,                     // BNE
+    DIV = 293,                     // DIV
+    DIVU = 294,                    // DIVU
+    J = 295,                       // J
+    JAL = 296,                     // JAL
+    JR = 297,                      // JR
+    LB = 298,                      // LB
+    LUI = 299,                     // LUI
+    LW = 300,                      // LW
+    MFHI = 301,                    // MFHI
+    MFLO = 302,                    // MFLO
+    MULT = 303,                    // MULT
+    MULTU = 304,                   // MULTU
+    OR = 305,                      // OR
+    ORI = 306,                     // ORI
+    SB = 307,                      // SB
+    SLL = 308,                     // SLL
+    SLLV = 309,                    // SLLV
+    NOR = 310,                     // NOR
+    SLT = 311,                     // SLT
+    SLTI = 312,                    // SLTI
+    SLTIU = 313,                   // SLTIU
+    SLTU = 314,                    // SLTU
+    SNE = 315,                     // SNE
+    SEQ = 316,                     // SEQ
+    SRA = 317,                     // SRA
+    SRL = 318,                     // SRL
+    SRLV = 319,                    // SRLV
+    SUB = 320,                     // SUB
+    SUBU = 321,                    // SUBU
+    SW = 322,                      // SW
+    SYS = 323,                     // SYS
+    XOR = 324,                     // XOR
+    XORI = 325,                    // XORI
+    JALR = 326,                    // JALR
+    CAS = 327,                     // CAS
+    AMOADD = 328,                  // AMOADD
+    AMOSWAP = 329,                 // AMOSWAP
+    SYNC = 330,                    // SYNC
+    COPY = 331,                    // COPY
+    CLR = 332,                     // CLR
+    B = 333,                       // B
+    BAL = 334,                     // BAL
+    BGT = 335,                     // BGT
+    BLT = 336,                     // BLT
+    BGE = 337,                     // BGE
+    BLE = 338,                     // BLE
+    BGTU = 339,                    // BGTU
+    BEQZ = 340,                    // BEQZ
+    REM = 341,                     // REM
+    LI = 342,                      // LI
+    LA = 343,                      // LA
+    NOP = 344,                     // NOP
+    NOT = 345,                     // NOT
+    PUSHW = 346,                   // PUSHW
+    POPW = 347,                    // POPW
+    PUSHB = 348,                   // PUSHB
+    POPB = 349,                    // POPB
+    RET = 350,                     // RET
+    CALL = 351,                    // CALL
+    ENTER = 352                    // ENTER
       };
+      /// Backward compatibility alias (Bison 3.6).
+      typedef token_kind_type yytokentype;
     };
 
-    /// (External) token type, as returned by yylex.
-    typedef token::yytokentype token_type;
+    /// Token kind, as returned by yylex.
+    typedef token::token_kind_type token_kind_type;
 
-    /// Symbol type: an internal symbol number.
-    typedef int symbol_number_type;
+    /// Backward compatibility alias (Bison 3.6).
+    typedef token_kind_type token_type;
+
+    /// Symbol kinds.
+    struct symbol_kind
+    {
+      enum symbol_kind_type
+      {
+        YYNTOKENS = 103, ///< Number of tokens.
+        S_YYEMPTY = -2,
+        S_YYEOF = 0,                             // END_OF_FILE
+        S_YYerror = 1,                           // error
+        S_YYUNDEF = 2,                           // "invalid token"
+        S_END_OF_LINE = 3,                       // END_OF_LINE
+        S_IDENTIFIER = 4,                        // IDENTIFIER
+        S_LITERAL = 5,                           // LITERAL
+        S_STRING = 6,                            // STRING
+        S_REGISTER = 7,                          // REGISTER
+        S_ARGUMENT_LIST = 8,                     // ARGUMENT_LIST
+        S_TEXT = 9,                              // TEXT
+        S_DATA = 10,                             // DATA
+        S_WORD = 11,                             // WORD
+        S_BYTE = 12,                             // BYTE
+        S_ASCII = 13,                            // ASCII
+        S_ASCIIZ = 14,                           // ASCIIZ
+        S_ALIGN = 15,                            // ALIGN
+        S_SPACE = 16,                            // SPACE
+        S_INCLUDE = 17,                          // INCLUDE
+        S_ERROR = 18,                            // ERROR
+        S_MESSAGE = 19,                          // MESSAGE
+        S_MACRO = 20,                            // MACRO
+        S_DBG = 21,                              // DBG
+        S_DEFINE = 22,                           // DEFINE
+        S_DBGBP = 23,                            // DBGBP
+        S_ADD = 24,                              // ADD
+        S_ADDI = 25,                             // ADDI
+        S_ADDIU = 26,                            // ADDIU
+        S_ADDU = 27,                             // ADDU
+        S_AND = 28,                              // AND
+        S_ANDI = 29,                             // ANDI
+        S_BEQ = 30,                              // BEQ
+        S_BGEZ = 31,                             // BGEZ
+        S_BGEZAL = 32,                           // BGEZAL
+        S_BGTZ = 33,                             // BGTZ
+        S_BLEZ = 34,                             // BLEZ
+        S_BLTZ = 35,                             // BLTZ
+        S_BLTZAL = 36,                           // BLTZAL
+        S_BNE = 37,                              // BNE
+        S_DIV = 38,                              // DIV
+        S_DIVU = 39,                             // DIVU
+        S_J = 40,                                // J
+        S_JAL = 41,                              // JAL
+        S_JR = 42,                               // JR
+        S_LB = 43,                               // LB
+        S_LUI = 44,                              // LUI
+        S_LW = 45,                               // LW
+        S_MFHI = 46,                             // MFHI
+        S_MFLO = 47,                             // MFLO
+        S_MULT = 48,                             // MULT
+        S_MULTU = 49,                            // MULTU
+        S_OR = 50,                               // OR
+        S_ORI = 51,                              // ORI
+        S_SB = 52,                               // SB
+        S_SLL = 53,                              // SLL
+        S_SLLV = 54,                             // SLLV
+        S_NOR = 55,                              // NOR
+        S_SLT = 56,                              // SLT
+        S_SLTI = 57,                             // SLTI
+        S_SLTIU = 58,                            // SLTIU
+        S_SLTU = 59,                             // SLTU
+        S_SNE = 60,                              // SNE
+        S_SEQ = 61,                              // SEQ
+        S_SRA = 62,                              // SRA
+        S_SRL = 63,                              // SRL
+        S_SRLV = 64,                             // SRLV
+        S_SUB = 65,                              // SUB
+        S_SUBU = 66,                             // SUBU
+        S_SW = 67,                               // SW
+        S_SYS = 68,                              // SYS
+        S_XOR = 69,                              // XOR
+        S_XORI = 70,                             // XORI
+        S_JALR = 71,                             // JALR
+        S_CAS = 72,                              // CAS
+        S_AMOADD = 73,                           // AMOADD
+        S_AMOSWAP = 74,                          // AMOSWAP
+        S_SYNC = 75,                             // SYNC
+        S_COPY = 76,                             // COPY
+        S_CLR = 77,                              // CLR
+        S_B = 78,                                // B
+        S_BAL = 79,                              // BAL
+        S_BGT = 80,                              // BGT
+        S_BLT = 81,                              // BLT
+        S_BGE = 82,                              // BGE
+        S_BLE = 83,                              // BLE
+        S_BGTU = 84,                             // BGTU
+        S_BEQZ = 85,                             // BEQZ
+        S_REM = 86,                              // REM
+        S_LI = 87,                               // LI
+        S_LA = 88,                               // LA
+        S_NOP = 89,                              // NOP
+        S_NOT = 90,                              // NOT
+        S_PUSHW = 91,                            // PUSHW
+        S_POPW = 92,                             // POPW
+        S_PUSHB = 93,                            // PUSHB
+        S_POPB = 94,                             // POPB
+        S_RET = 95,                              // RET
+        S_CALL = 96,                             // CALL
+        S_ENTER = 97,                            // ENTER
+        S_98_ = 98,                              // ':'
+        S_99_ = 99,                              // '('
+        S_100_ = 100,                            // ')'
+        S_101_ = 101,                            // ','
+        S_102_ = 102,                            // '+'
+        S_YYACCEPT = 103,                        // $accept
+        S_statement_list = 104,                  // statement_list
+        S_statement = 105,                       // statement
+        S_106_1 = 106,                           // $@1
+        S_107_2 = 107,                           // $@2
+        S_108_3 = 108,                           // $@3
+        S_109_4 = 109,                           // $@4
+        S_110_5 = 110,                           // $@5
+        S_111_6 = 111,                           // $@6
+        S_112_7 = 112,                           // $@7
+        S_113_8 = 113,                           // $@8
+        S_114_9 = 114,                           // $@9
+        S_115_10 = 115,                          // $@10
+        S_116_11 = 116,                          // $@11
+        S_117_12 = 117,                          // $@12
+        S_118_13 = 118,                          // $@13
+        S_literal_argument = 119,                // literal_argument
+        S_literal_list = 120,                    // literal_list
+        S_identifier_list = 121,                 // identifier_list
+        S_identifier_list_not_empty = 122,       // identifier_list_not_empty
+        S_direct_address = 123,                  // direct_address
+        S_address = 124,                         // address
+        S_end_of_statement = 125                 // end_of_statement
+      };
+    };
 
-    /// The symbol type number to denote an empty symbol.
-    enum { empty_symbol = -2 };
+    /// (Internal) symbol kind.
+    typedef symbol_kind::symbol_kind_type symbol_kind_type;
 
-    /// Internal symbol number for tokens (subsumed by symbol_number_type).
-    typedef unsigned char token_number_type;
+    /// The number of tokens.
+    static const symbol_kind_type YYNTOKENS = symbol_kind::YYNTOKENS;
 
     /// A complete symbol.
     ///
-    /// Expects its Base type to provide access to the symbol type
-    /// via type_get ().
+    /// Expects its Base type to provide access to the symbol kind
+    /// via kind ().
     ///
     /// Provide access to semantic value and location.
     template <typename Base>
@@ -819,20 +992,58 @@ namespace yy {
       typedef Base super_type;
 
       /// Default constructor.
-      basic_symbol ()
+      basic_symbol () YY_NOEXCEPT
         : value ()
         , location ()
       {}
 
 #if 201103L <= YY_CPLUSPLUS
       /// Move constructor.
-      basic_symbol (basic_symbol&& that);
+      basic_symbol (basic_symbol&& that)
+        : Base (std::move (that))
+        , value ()
+        , location (std::move (that.location))
+      {
+        switch (this->kind ())
+    {
+      case symbol_kind::S_direct_address: // direct_address
+      case symbol_kind::S_address: // address
+        value.move< kasm::AddressData > (std::move (that.value));
+        break;
+
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+      case symbol_kind::S_STRING: // STRING
+        value.move< std::string > (std::move (that.value));
+        break;
+
+      case symbol_kind::S_LITERAL: // LITERAL
+      case symbol_kind::S_REGISTER: // REGISTER
+      case symbol_kind::S_statement: // statement
+        value.move< std::uint32_t > (std::move (that.value));
+        break;
+
+      case symbol_kind::S_ARGUMENT_LIST: // ARGUMENT_LIST
+      case symbol_kind::S_identifier_list: // identifier_list
+      case symbol_kind::S_identifier_list_not_empty: // identifier_list_not_empty
+        value.move< std::vector<std::string> > (std::move (that.value));
+        break;
+
+      case symbol_kind::S_literal_argument: // literal_argument
+      case symbol_kind::S_literal_list: // literal_list
+        value.move< std::vector<std::variant<std::uint32_t, kasm::AddressData>> > (std::move (that.value));
+        break;
+
+      default:
+        break;
+    }
+
+      }
 #endif
 
       /// Copy constructor.
       basic_symbol (const basic_symbol& that);
 
-      /// Constructor for valueless symbols, and symbols from each type.
+      /// Constructors for typed symbols.
 #if 201103L <= YY_CPLUSPLUS
       basic_symbol (typename Base::kind_type t, location_type&& l)
         : Base (t)
@@ -844,6 +1055,7 @@ namespace yy {
         , location (l)
       {}
 #endif
+
 #if 201103L <= YY_CPLUSPLUS
       basic_symbol (typename Base::kind_type t, kasm::AddressData&& v, location_type&& l)
         : Base (t)
@@ -857,6 +1069,7 @@ namespace yy {
         , location (l)
       {}
 #endif
+
 #if 201103L <= YY_CPLUSPLUS
       basic_symbol (typename Base::kind_type t, std::string&& v, location_type&& l)
         : Base (t)
@@ -870,6 +1083,7 @@ namespace yy {
         , location (l)
       {}
 #endif
+
 #if 201103L <= YY_CPLUSPLUS
       basic_symbol (typename Base::kind_type t, std::uint32_t&& v, location_type&& l)
         : Base (t)
@@ -883,6 +1097,7 @@ namespace yy {
         , location (l)
       {}
 #endif
+
 #if 201103L <= YY_CPLUSPLUS
       basic_symbol (typename Base::kind_type t, std::vector<std::string>&& v, location_type&& l)
         : Base (t)
@@ -896,6 +1111,7 @@ namespace yy {
         , location (l)
       {}
 #endif
+
 #if 201103L <= YY_CPLUSPLUS
       basic_symbol (typename Base::kind_type t, std::vector<std::variant<std::uint32_t, kasm::AddressData>>&& v, location_type&& l)
         : Base (t)
@@ -916,46 +1132,48 @@ namespace yy {
         clear ();
       }
 
+
+
       /// Destroy contents, and record that is empty.
-      void clear ()
+      void clear () YY_NOEXCEPT
       {
         // User destructor.
-        symbol_number_type yytype = this->type_get ();
+        symbol_kind_type yykind = this->kind ();
         basic_symbol<Base>& yysym = *this;
         (void) yysym;
-        switch (yytype)
+        switch (yykind)
         {
        default:
           break;
         }
 
-        // Type destructor.
-switch (yytype)
+        // Value type destructor.
+switch (yykind)
     {
-      case 119: // direct_address
-      case 120: // address
+      case symbol_kind::S_direct_address: // direct_address
+      case symbol_kind::S_address: // address
         value.template destroy< kasm::AddressData > ();
         break;
 
-      case 4: // IDENTIFIER
-      case 6: // STRING
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+      case symbol_kind::S_STRING: // STRING
         value.template destroy< std::string > ();
         break;
 
-      case 5: // LITERAL
-      case 7: // REGISTER
-      case 101: // statement
+      case symbol_kind::S_LITERAL: // LITERAL
+      case symbol_kind::S_REGISTER: // REGISTER
+      case symbol_kind::S_statement: // statement
         value.template destroy< std::uint32_t > ();
         break;
 
-      case 8: // ARGUMENT_LIST
-      case 117: // identifier_list
-      case 118: // identifier_list_not_empty
+      case symbol_kind::S_ARGUMENT_LIST: // ARGUMENT_LIST
+      case symbol_kind::S_identifier_list: // identifier_list
+      case symbol_kind::S_identifier_list_not_empty: // identifier_list_not_empty
         value.template destroy< std::vector<std::string> > ();
         break;
 
-      case 115: // literal_argument
-      case 116: // literal_list
+      case symbol_kind::S_literal_argument: // literal_argument
+      case symbol_kind::S_literal_list: // literal_list
         value.template destroy< std::vector<std::variant<std::uint32_t, kasm::AddressData>> > ();
         break;
 
@@ -966,6 +1184,15 @@ switch (yytype)
         Base::clear ();
       }
 
+      /// The user-facing name of this symbol.
+      std::string name () const YY_NOEXCEPT
+      {
+        return parser::symbol_name (this->kind ());
+      }
+
+      /// Backward compatibility (Bison 3.6).
+      symbol_kind_type type_get () const YY_NOEXCEPT;
+
       /// Whether empty.
       bool empty () const YY_NOEXCEPT;
 
@@ -973,7 +1200,7 @@ switch (yytype)
       void move (basic_symbol& s);
 
       /// The semantic value.
-      semantic_type value;
+      value_type value;
 
       /// The location.
       location_type location;
@@ -986,112 +1213,127 @@ switch (yytype)
     };
 
     /// Type access provider for token (enum) based symbols.
-    struct by_type
+    struct by_kind
     {
+      /// The symbol kind as needed by the constructor.
+      typedef token_kind_type kind_type;
+
       /// Default constructor.
-      by_type ();
+      by_kind () YY_NOEXCEPT;
 
 #if 201103L <= YY_CPLUSPLUS
       /// Move constructor.
-      by_type (by_type&& that);
+      by_kind (by_kind&& that) YY_NOEXCEPT;
 #endif
 
       /// Copy constructor.
-      by_type (const by_type& that);
-
-      /// The symbol type as needed by the constructor.
-      typedef token_type kind_type;
+      by_kind (const by_kind& that) YY_NOEXCEPT;
 
       /// Constructor from (external) token numbers.
-      by_type (kind_type t);
+      by_kind (kind_type t) YY_NOEXCEPT;
+
+
 
       /// Record that this symbol is empty.
-      void clear ();
+      void clear () YY_NOEXCEPT;
 
-      /// Steal the symbol type from \a that.
-      void move (by_type& that);
+      /// Steal the symbol kind from \a that.
+      void move (by_kind& that);
 
       /// The (internal) type number (corresponding to \a type).
       /// \a empty when empty.
-      symbol_number_type type_get () const YY_NOEXCEPT;
+      symbol_kind_type kind () const YY_NOEXCEPT;
 
-      /// The token.
-      token_type token () const YY_NOEXCEPT;
+      /// Backward compatibility (Bison 3.6).
+      symbol_kind_type type_get () const YY_NOEXCEPT;
 
-      /// The symbol type.
-      /// \a empty_symbol when empty.
-      /// An int, not token_number_type, to be able to store empty_symbol.
-      int type;
+      /// The symbol kind.
+      /// \a S_YYEMPTY when empty.
+      symbol_kind_type kind_;
     };
 
+    /// Backward compatibility for a private implementation detail (Bison 3.6).
+    typedef by_kind by_type;
+
     /// "External" symbols: returned by the scanner.
-    struct symbol_type : basic_symbol<by_type>
+    struct symbol_type : basic_symbol<by_kind>
     {
       /// Superclass.
-      typedef basic_symbol<by_type> super_type;
+      typedef basic_symbol<by_kind> super_type;
 
       /// Empty symbol.
-      symbol_type () {}
+      symbol_type () YY_NOEXCEPT {}
 
       /// Constructor for valueless symbols, and symbols from each type.
 #if 201103L <= YY_CPLUSPLUS
       symbol_type (int tok, location_type l)
-        : super_type(token_type (tok), std::move (l))
-      {
-        YYASSERT (tok == token::END_OF_FILE || tok == token::END_OF_LINE || tok == token::TEXT || tok == token::DATA || tok == token::WORD || tok == token::BYTE || tok == token::ASCII || tok == token::ASCIIZ || tok == token::ALIGN || tok == token::SPACE || tok == token::INCLUDE || tok == token::ERROR || tok == token::MESSAGE || tok == token::MACRO || tok == token::DBG || tok == token::DEFINE || tok == token::DBGBP || tok == token::ADD || tok == token::ADDI || tok == token::ADDIU || tok == token::ADDU || tok == token::AND || tok == token::ANDI || tok == token::BEQ || tok == token::BGEZ || tok == token::BGEZAL || tok == token::BGTZ || tok == token::BLEZ || tok == token::BLTZ || tok == token::BLTZAL || tok == token::BNE || tok == token::DIV || tok == token::DIVU || tok == token::J || tok == token::JAL || tok == token::JR || tok == token::LB || tok == token::LUI || tok == token::LW || tok == token::MFHI || tok == token::MFLO || tok == token::MULT || tok == token::MULTU || tok == token::OR || tok == token::ORI || tok == token::SB || tok == token::SLL || tok == token::SLLV || tok == token::NOR || tok == token::SLT || tok == token::SLTI || tok == token::SLTIU || tok == token::SLTU || tok == token::SNE || tok == token::SEQ || tok == token::SRA || tok == token::SRL || tok == token::SRLV || tok == token::SUB || tok == token::SUBU || tok == token::SW || tok == token::SYS || tok == token::XOR || tok == token::XORI || tok == token::JALR || tok == token::COPY || tok == token::CLR || tok == token::B || tok == token::BAL || tok == token::BGT || tok == token::BLT || tok == token::BGE || tok == token::BLE || tok == token::BGTU || tok == token::BEQZ || tok == token::REM || tok == token::LI || tok == token::LA || tok == token::NOP || tok == token::NOT || tok == token::PUSHW || tok == token::POPW || tok == token::PUSHB || tok == token::POPB || tok == token::RET || tok == token::CALL || tok == token::ENTER || tok == 58 || tok == 40 || tok == 41 || tok == 44 || tok == 43);
-      }
+        : super_type (token_kind_type (tok), std::move (l))
 #else
       symbol_type (int tok, const location_type& l)
-        : super_type(token_type (tok), l)
+        : super_type (token_kind_type (tok), l)
+#endif
       {
-        YYASSERT (tok == token::END_OF_FILE || tok == token::END_OF_LINE || tok == token::TEXT || tok == token::DATA || tok == token::WORD || tok == token::BYTE || tok == token::ASCII || tok == token::ASCIIZ || tok == token::ALIGN || tok == token::SPACE || tok == token::INCLUDE || tok == token::ERROR || tok == token::MESSAGE || tok == token::MACRO || tok == token::DBG || tok == token::DEFINE || tok == token::DBGBP || tok == token::ADD || tok == token::ADDI || tok == token::ADDIU || tok == token::ADDU || tok == token::AND || tok == token::ANDI || tok == token::BEQ || tok == token::BGEZ || tok == token::BGEZAL || tok == token::BGTZ || tok == token::BLEZ || tok == token::BLTZ || tok == token::BLTZAL || tok == token::BNE || tok == token::DIV || tok == token::DIVU || tok == token::J || tok == token::JAL || tok == token::JR || tok == token::LB || tok == token::LUI || tok == token::LW || tok == token::MFHI || tok == token::MFLO || tok == token::MULT || tok == token::MULTU || tok == token::OR || tok == token::ORI || tok == token::SB || tok == token::SLL || tok == token::SLLV || tok == token::NOR || tok == token::SLT || tok == token::SLTI || tok == token::SLTIU || tok == token::SLTU || tok == token::SNE || tok == token::SEQ || tok == token::SRA || tok == token::SRL || tok == token::SRLV || tok == token::SUB || tok == token::SUBU || tok == token::SW || tok == token::SYS || tok == token::XOR || tok == token::XORI || tok == token::JALR || tok == token::COPY || tok == token::CLR || tok == token::B || tok == token::BAL || tok == token::BGT || tok == token::BLT || tok == token::BGE || tok == token::BLE || tok == token::BGTU || tok == token::BEQZ || tok == token::REM || tok == token::LI || tok == token::LA || tok == token::NOP || tok == token::NOT || tok == token::PUSHW || tok == token::POPW || tok == token::PUSHB || tok == token::POPB || tok == token::RET || tok == token::CALL || tok == token::ENTER || tok == 58 || tok == 40 || tok == 41 || tok == 44 || tok == 43);
-      }
+#if !defined _MSC_VER || defined __clang__
+        YY_ASSERT (tok == token::END_OF_FILE
+                   || (token::YYerror <= tok && tok <= token::END_OF_LINE)
+                   || (token::TEXT <= tok && tok <= token::ENTER)
+                   || tok == 58
+                   || (40 <= tok && tok <= 41)
+                   || tok == 44
+                   || tok == 43);
 #endif
+      }
 #if 201103L <= YY_CPLUSPLUS
       symbol_type (int tok, std::string v, location_type l)
-        : super_type(token_type (tok), std::move (v), std::move (l))
-      {
-        YYASSERT (tok == token::IDENTIFIER || tok == token::STRING);
-      }
+        : super_type (token_kind_type (tok), std::move (v), std::move (l))
 #else
       symbol_type (int tok, const std::string& v, const location_type& l)
-        : super_type(token_type (tok), v, l)
+        : super_type (token_kind_type (tok), v, l)
+#endif
       {
-        YYASSERT (tok == token::IDENTIFIER || tok == token::STRING);
-      }
+#if !defined _MSC_VER || defined __clang__
+        YY_ASSERT (tok == token::IDENTIFIER
+                   || tok == token::STRING);
 #endif
+      }
 #if 201103L <= YY_CPLUSPLUS
       symbol_type (int tok, std::uint32_t v, location_type l)
-        : super_type(token_type (tok), std::move (v), std::move (l))
-      {
-        YYASSERT (tok == token::LITERAL || tok == token::REGISTER);
-      }
+        : super_type (token_kind_type (tok), std::move (v), std::move (l))
 #else
       symbol_type (int tok, const std::uint32_t& v, const location_type& l)
-        : super_type(token_type (tok), v, l)
+        : super_type (token_kind_type (tok), v, l)
+#endif
       {
-        YYASSERT (tok == token::LITERAL || tok == token::REGISTER);
-      }
+#if !defined _MSC_VER || defined __clang__
+        YY_ASSERT (tok == token::LITERAL
+                   || tok == token::REGISTER);
 #endif
+      }
 #if 201103L <= YY_CPLUSPLUS
       symbol_type (int tok, std::vector<std::string> v, location_type l)
-        : super_type(token_type (tok), std::move (v), std::move (l))
-      {
-        YYASSERT (tok == token::ARGUMENT_LIST);
-      }
+        : super_type (token_kind_type (tok), std::move (v), std::move (l))
 #else
       symbol_type (int tok, const std::vector<std::string>& v, const location_type& l)
-        : super_type(token_type (tok), v, l)
+        : super_type (token_kind_type (tok), v, l)
+#endif
       {
-        YYASSERT (tok == token::ARGUMENT_LIST);
-      }
+#if !defined _MSC_VER || defined __clang__
+        YY_ASSERT (tok == token::ARGUMENT_LIST);
 #endif
+      }
     };
 
     /// Build a parser object.
     parser ();
     virtual ~parser ();
 
+#if 201103L <= YY_CPLUSPLUS
+    /// Non copyable.
+    parser (const parser&) = delete;
+    /// Non copyable.
+    parser& operator= (const parser&) = delete;
+#endif
+
     /// Parse.  An alias for parse ().
     /// \returns  0 iff parsing succeeded.
     int operator() ();
@@ -1122,7 +1364,11 @@ switch (yytype)
     /// Report a syntax error.
     void error (const syntax_error& err);
 
-    // Implementation of make_symbol for each symbol type.
+    /// The user-facing name of the symbol whose (internal) number is
+    /// YYSYMBOL.  No bounds checking.
+    static std::string symbol_name (symbol_kind_type yysymbol);
+
+    // Implementation of make_symbol for each token kind.
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -1138,6 +1384,36 @@ switch (yytype)
         return symbol_type (token::END_OF_FILE, l);
       }
 #endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_YYerror (location_type l)
+      {
+        return symbol_type (token::YYerror, std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_YYerror (const location_type& l)
+      {
+        return symbol_type (token::YYerror, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_YYUNDEF (location_type l)
+      {
+        return symbol_type (token::YYUNDEF, std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_YYUNDEF (const location_type& l)
+      {
+        return symbol_type (token::YYUNDEF, l);
+      }
+#endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -2173,6 +2449,66 @@ switch (yytype)
         return symbol_type (token::JALR, l);
       }
 #endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CAS (location_type l)
+      {
+        return symbol_type (token::CAS, std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CAS (const location_type& l)
+      {
+        return symbol_type (token::CAS, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_AMOADD (location_type l)
+      {
+        return symbol_type (token::AMOADD, std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_AMOADD (const location_type& l)
+      {
+        return symbol_type (token::AMOADD, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_AMOSWAP (location_type l)
+      {
+        return symbol_type (token::AMOSWAP, std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_AMOSWAP (const location_type& l)
+      {
+        return symbol_type (token::AMOSWAP, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_SYNC (location_type l)
+      {
+        return symbol_type (token::SYNC, std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_SYNC (const location_type& l)
+      {
+        return symbol_type (token::SYNC, l);
+      }
+#endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -2505,93 +2841,119 @@ switch (yytype)
 #endif
 
 
+    class context
+    {
+    public:
+      context (const parser& yyparser, const symbol_type& yyla);
+      const symbol_type& lookahead () const YY_NOEXCEPT { return yyla_; }
+      symbol_kind_type token () const YY_NOEXCEPT { return yyla_.kind (); }
+      const location_type& location () const YY_NOEXCEPT { return yyla_.location; }
+
+      /// Put in YYARG at most YYARGN of the expected tokens, and return the
+      /// number of tokens stored in YYARG.  If YYARG is null, return the
+      /// number of expected tokens (guaranteed to be less than YYNTOKENS).
+      int expected_tokens (symbol_kind_type yyarg[], int yyargn) const;
+
+    private:
+      const parser& yyparser_;
+      const symbol_type& yyla_;
+    };
+
   private:
-    /// This class is not copyable.
+#if YY_CPLUSPLUS < 201103L
+    /// Non copyable.
     parser (const parser&);
+    /// Non copyable.
     parser& operator= (const parser&);
+#endif
 
-    /// State numbers.
-    typedef int state_type;
 
-    /// Generate an error message.
-    /// \param yystate   the state where the error occurred.
-    /// \param yyla      the lookahead token.
-    virtual std::string yysyntax_error_ (state_type yystate,
-                                         const symbol_type& yyla) const;
+    /// Stored state numbers (used for stacks).
+    typedef short state_type;
 
+    /// The arguments of the error message.
+    int yy_syntax_error_arguments_ (const context& yyctx,
+                                    symbol_kind_type yyarg[], int yyargn) const;
+
+    /// Generate an error message.
+    /// \param yyctx     the context in which the error occurred.
+    virtual std::string yysyntax_error_ (const context& yyctx) const;
     /// Compute post-reduction state.
     /// \param yystate   the current state
     /// \param yysym     the nonterminal to push on the stack
-    state_type yy_lr_goto_state_ (state_type yystate, int yysym);
+    static state_type yy_lr_goto_state_ (state_type yystate, int yysym);
 
     /// Whether the given \c yypact_ value indicates a defaulted state.
     /// \param yyvalue   the value to check
-    static bool yy_pact_value_is_default_ (int yyvalue);
+    static bool yy_pact_value_is_default_ (int yyvalue) YY_NOEXCEPT;
 
     /// Whether the given \c yytable_ value indicates a syntax error.
     /// \param yyvalue   the value to check
-    static bool yy_table_value_is_error_ (int yyvalue);
+    static bool yy_table_value_is_error_ (int yyvalue) YY_NOEXCEPT;
 
     static const signed char yypact_ninf_;
     static const signed char yytable_ninf_;
 
-    /// Convert a scanner token number \a t to a symbol number.
-    static token_number_type yytranslate_ (token_type t);
+    /// Convert a scanner token kind \a t to a symbol kind.
+    /// In theory \a t should be a token_kind_type, but character literals
+    /// are valid, yet not members of the token_kind_type enum.
+    static symbol_kind_type yytranslate_ (int t) YY_NOEXCEPT;
 
-    // Tables.
-  // YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-  // STATE-NUM.
-  static const short yypact_[];
+    /// Convert the symbol name \a n to a form suitable for a diagnostic.
+    static std::string yytnamerr_ (const char *yystr);
 
-  // YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-  // Performed when YYTABLE does not specify something else to do.  Zero
-  // means the default is an error.
-  static const unsigned char yydefact_[];
+    /// For a symbol, its name in clear.
+    static const char* const yytname_[];
 
-  // YYPGOTO[NTERM-NUM].
-  static const short yypgoto_[];
 
-  // YYDEFGOTO[NTERM-NUM].
-  static const short yydefgoto_[];
+    // Tables.
+    // YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+    // STATE-NUM.
+    static const short yypact_[];
 
-  // YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-  // positive, shift that token.  If negative, reduce the rule whose
-  // number is the opposite.  If YYTABLE_NINF, syntax error.
-  static const unsigned short yytable_[];
+    // YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+    // Performed when YYTABLE does not specify something else to do.  Zero
+    // means the default is an error.
+    static const unsigned char yydefact_[];
 
-  static const short yycheck_[];
+    // YYPGOTO[NTERM-NUM].
+    static const short yypgoto_[];
 
-  // YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-  // symbol of state STATE-NUM.
-  static const unsigned char yystos_[];
+    // YYDEFGOTO[NTERM-NUM].
+    static const short yydefgoto_[];
 
-  // YYR1[YYN] -- Symbol number of symbol that rule YYN derives.
-  static const unsigned char yyr1_[];
+    // YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+    // positive, shift that token.  If negative, reduce the rule whose
+    // number is the opposite.  If YYTABLE_NINF, syntax error.
+    static const short yytable_[];
 
-  // YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.
-  static const unsigned char yyr2_[];
+    static const short yycheck_[];
 
+    // YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+    // state STATE-NUM.
+    static const signed char yystos_[];
 
-    /// Convert the symbol name \a n to a form suitable for a diagnostic.
-    static std::string yytnamerr_ (const char *n);
+    // YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.
+    static const signed char yyr1_[];
+
+    // YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.
+    static const signed char yyr2_[];
 
 
-    /// For a symbol, its name in clear.
-    static const char* const yytname_[];
 #if YYDEBUG
-  // YYRLINE[YYN] -- Source line where rule number YYN was defined.
-  static const unsigned short yyrline_[];
+    // YYRLINE[YYN] -- Source line where rule number YYN was defined.
+    static const short yyrline_[];
     /// Report on the debug stream that the rule \a r is going to be reduced.
-    virtual void yy_reduce_print_ (int r);
+    virtual void yy_reduce_print_ (int r) const;
     /// Print the state stack on the debug stream.
-    virtual void yystack_print_ ();
+    virtual void yy_stack_print_ () const;
 
     /// Debugging level.
     int yydebug_;
     /// Debug stream.
     std::ostream* yycdebug_;
 
-    /// \brief Display a symbol type, value and location.
+    /// \brief Display a symbol kind, value and location.
     /// \param yyo    The output stream.
     /// \param yysym  The symbol.
     template <typename Base>
@@ -2612,7 +2974,7 @@ switch (yytype)
       /// Default constructor.
       by_state () YY_NOEXCEPT;
 
-      /// The symbol type as needed by the constructor.
+      /// The symbol kind as needed by the constructor.
       typedef state_type kind_type;
 
       /// Constructor.
@@ -2624,15 +2986,16 @@ switch (yytype)
       /// Record that this symbol is empty.
       void clear () YY_NOEXCEPT;
 
-      /// Steal the symbol type from \a that.
+      /// Steal the symbol kind from \a that.
       void move (by_state& that);
 
-      /// The (internal) type number (corresponding to \a state).
-      /// \a empty_symbol when empty.
-      symbol_number_type type_get () const YY_NOEXCEPT;
+      /// The symbol kind (corresponding to \a state).
+      /// \a symbol_kind::S_YYEMPTY when empty.
+      symbol_kind_type kind () const YY_NOEXCEPT;
 
       /// The state number used to denote an empty symbol.
-      enum { empty_state = -1 };
+      /// We use the initial state, as it does not have a value.
+      enum { empty_state = 0 };
 
       /// The state.
       /// \a empty when empty.
@@ -2654,6 +3017,10 @@ switch (yytype)
       /// Assignment, needed by push_back by some old implementations.
       /// Moves the contents of that.
       stack_symbol_type& operator= (stack_symbol_type& that);
+
+      /// Assignment, needed by push_back by other implementations.
+      /// Needed by some other old implementations.
+      stack_symbol_type& operator= (const stack_symbol_type& that);
 #endif
     };
 
@@ -2663,48 +3030,38 @@ switch (yytype)
     {
     public:
       // Hide our reversed order.
-      typedef typename S::reverse_iterator iterator;
-      typedef typename S::const_reverse_iterator const_iterator;
+      typedef typename S::iterator iterator;
+      typedef typename S::const_iterator const_iterator;
       typedef typename S::size_type size_type;
+      typedef typename std::ptrdiff_t index_type;
 
-      stack (size_type n = 200)
+      stack (size_type n = 200) YY_NOEXCEPT
         : seq_ (n)
       {}
 
-      /// Random access.
-      ///
-      /// Index 0 returns the topmost element.
-      T&
-      operator[] (size_type i)
-      {
-        return seq_[size () - 1 - i];
-      }
-
-      /// Random access.
-      ///
-      /// Index 0 returns the topmost element.
-      T&
-      operator[] (int i)
-      {
-        return operator[] (size_type (i));
-      }
+#if 201103L <= YY_CPLUSPLUS
+      /// Non copyable.
+      stack (const stack&) = delete;
+      /// Non copyable.
+      stack& operator= (const stack&) = delete;
+#endif
 
       /// Random access.
       ///
       /// Index 0 returns the topmost element.
       const T&
-      operator[] (size_type i) const
+      operator[] (index_type i) const
       {
-        return seq_[size () - 1 - i];
+        return seq_[size_type (size () - 1 - i)];
       }
 
       /// Random access.
       ///
       /// Index 0 returns the topmost element.
-      const T&
-      operator[] (int i) const
+      T&
+      operator[] (index_type i)
       {
-        return operator[] (size_type (i));
+        return seq_[size_type (size () - 1 - i)];
       }
 
       /// Steal the contents of \a t.
@@ -2719,7 +3076,7 @@ switch (yytype)
 
       /// Pop elements from the stack.
       void
-      pop (int n = 1) YY_NOEXCEPT
+      pop (std::ptrdiff_t n = 1) YY_NOEXCEPT
       {
         for (; 0 < n; --n)
           seq_.pop_back ();
@@ -2733,49 +3090,53 @@ switch (yytype)
       }
 
       /// Number of elements on the stack.
-      size_type
+      index_type
       size () const YY_NOEXCEPT
       {
-        return seq_.size ();
+        return index_type (seq_.size ());
       }
 
       /// Iterator on top of the stack (going downwards).
       const_iterator
       begin () const YY_NOEXCEPT
       {
-        return seq_.rbegin ();
+        return seq_.begin ();
       }
 
       /// Bottom of the stack.
       const_iterator
       end () const YY_NOEXCEPT
       {
-        return seq_.rend ();
+        return seq_.end ();
       }
 
       /// Present a slice of the top of a stack.
       class slice
       {
       public:
-        slice (const stack& stack, int range)
+        slice (const stack& stack, index_type range) YY_NOEXCEPT
           : stack_ (stack)
           , range_ (range)
         {}
 
         const T&
-        operator[] (int i) const
+        operator[] (index_type i) const
         {
           return stack_[range_ - i];
         }
 
       private:
         const stack& stack_;
-        int range_;
+        index_type range_;
       };
 
     private:
+#if YY_CPLUSPLUS < 201103L
+      /// Non copyable.
       stack (const stack&);
+      /// Non copyable.
       stack& operator= (const stack&);
+#endif
       /// The wrapped container.
       S seq_;
     };
@@ -2803,38 +3164,35 @@ switch (yytype)
     void yypush_ (const char* m, state_type s, YY_MOVE_REF (symbol_type) sym);
 
     /// Pop \a n symbols from the stack.
-    void yypop_ (int n = 1);
+    void yypop_ (int n = 1) YY_NOEXCEPT;
 
     /// Constants.
     enum
     {
-      yyeof_ = 0,
-      yylast_ = 708,     ///< Last index in yytable_.
+      yylast_ = 733,     ///< Last index in yytable_.
       yynnts_ = 23,  ///< Number of nonterminal symbols.
-      yyfinal_ = 2, ///< Termination state number.
-      yyterror_ = 1,
-      yyerrcode_ = 256,
-      yyntokens_ = 99  ///< Number of tokens.
+      yyfinal_ = 2 ///< Termination state number.
     };
 
 
+
   };
 
-  parser::token_number_type
-  parser::yytranslate_ (token_type t)
+  parser::symbol_kind_type
+  parser::yytranslate_ (int t) YY_NOEXCEPT
   {
     // YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to
     // TOKEN-NUM as returned by yylex.
     static
-    const token_number_type
+    const signed char
     translate_table[] =
     {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-      95,    96,     2,    98,    97,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,    94,     2,
+      99,   100,     2,   102,   101,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,    98,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -2863,95 +3221,53 @@ switch (yytype)
       55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
       65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
       75,    76,    77,    78,    79,    80,    81,    82,    83,    84,
-      85,    86,    87,    88,    89,    90,    91,    92,    93
+      85,    86,    87,    88,    89,    90,    91,    92,    93,    94,
+      95,    96,    97
     };
-    const unsigned user_token_number_max_ = 348;
-    const token_number_type undef_token_ = 2;
+    // Last valid token kind.
+    const int code_max = 352;
 
-    if (static_cast<int> (t) <= yyeof_)
-      return yyeof_;
-    else if (static_cast<unsigned> (t) <= user_token_number_max_)
-      return translate_table[t];
+    if (t <= 0)
+      return symbol_kind::S_YYEOF;
+    else if (t <= code_max)
+      return static_cast <symbol_kind_type> (translate_table[t]);
     else
-      return undef_token_;
+      return symbol_kind::S_YYUNDEF;
   }
 
   // basic_symbol.
-#if 201103L <= YY_CPLUSPLUS
-  template <typename Base>
-  parser::basic_symbol<Base>::basic_symbol (basic_symbol&& that)
-    : Base (std::move (that))
-    , value ()
-    , location (std::move (that.location))
-  {
-    switch (this->type_get ())
-    {
-      case 119: // direct_address
-      case 120: // address
-        value.move< kasm::AddressData > (std::move (that.value));
-        break;
-
-      case 4: // IDENTIFIER
-      case 6: // STRING
-        value.move< std::string > (std::move (that.value));
-        break;
-
-      case 5: // LITERAL
-      case 7: // REGISTER
-      case 101: // statement
-        value.move< std::uint32_t > (std::move (that.value));
-        break;
-
-      case 8: // ARGUMENT_LIST
-      case 117: // identifier_list
-      case 118: // identifier_list_not_empty
-        value.move< std::vector<std::string> > (std::move (that.value));
-        break;
-
-      case 115: // literal_argument
-      case 116: // literal_list
-        value.move< std::vector<std::variant<std::uint32_t, kasm::AddressData>> > (std::move (that.value));
-        break;
-
-      default:
-        break;
-    }
-
-  }
-#endif
-
   template <typename Base>
   parser::basic_symbol<Base>::basic_symbol (const basic_symbol& that)
     : Base (that)
     , value ()
     , location (that.location)
   {
-    switch (this->type_get ())
+    switch (this->kind ())
     {
-      case 119: // direct_address
-      case 120: // address
+      case symbol_kind::S_direct_address: // direct_address
+      case symbol_kind::S_address: // address
         value.copy< kasm::AddressData > (YY_MOVE (that.value));
         break;
 
-      case 4: // IDENTIFIER
-      case 6: // STRING
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+      case symbol_kind::S_STRING: // STRING
         value.copy< std::string > (YY_MOVE (that.value));
         break;
 
-      case 5: // LITERAL
-      case 7: // REGISTER
-      case 101: // statement
+      case symbol_kind::S_LITERAL: // LITERAL
+      case symbol_kind::S_REGISTER: // REGISTER
+      case symbol_kind::S_statement: // statement
         value.copy< std::uint32_t > (YY_MOVE (that.value));
         break;
 
-      case 8: // ARGUMENT_LIST
-      case 117: // identifier_list
-      case 118: // identifier_list_not_empty
+      case symbol_kind::S_ARGUMENT_LIST: // ARGUMENT_LIST
+      case symbol_kind::S_identifier_list: // identifier_list
+      case symbol_kind::S_identifier_list_not_empty: // identifier_list_not_empty
         value.copy< std::vector<std::string> > (YY_MOVE (that.value));
         break;
 
-      case 115: // literal_argument
-      case 116: // literal_list
+      case symbol_kind::S_literal_argument: // literal_argument
+      case symbol_kind::S_literal_list: // literal_list
         value.copy< std::vector<std::variant<std::uint32_t, kasm::AddressData>> > (YY_MOVE (that.value));
         break;
 
@@ -2963,11 +3279,20 @@ switch (yytype)
 
 
 
+
+  template <typename Base>
+  parser::symbol_kind_type
+  parser::basic_symbol<Base>::type_get () const YY_NOEXCEPT
+  {
+    return this->kind ();
+  }
+
+
   template <typename Base>
   bool
   parser::basic_symbol<Base>::empty () const YY_NOEXCEPT
   {
-    return Base::type_get () == empty_symbol;
+    return this->kind () == symbol_kind::S_YYEMPTY;
   }
 
   template <typename Base>
@@ -2975,32 +3300,32 @@ switch (yytype)
   parser::basic_symbol<Base>::move (basic_symbol& s)
   {
     super_type::move (s);
-    switch (this->type_get ())
+    switch (this->kind ())
     {
-      case 119: // direct_address
-      case 120: // address
+      case symbol_kind::S_direct_address: // direct_address
+      case symbol_kind::S_address: // address
         value.move< kasm::AddressData > (YY_MOVE (s.value));
         break;
 
-      case 4: // IDENTIFIER
-      case 6: // STRING
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+      case symbol_kind::S_STRING: // STRING
         value.move< std::string > (YY_MOVE (s.value));
         break;
 
-      case 5: // LITERAL
-      case 7: // REGISTER
-      case 101: // statement
+      case symbol_kind::S_LITERAL: // LITERAL
+      case symbol_kind::S_REGISTER: // REGISTER
+      case symbol_kind::S_statement: // statement
         value.move< std::uint32_t > (YY_MOVE (s.value));
         break;
 
-      case 8: // ARGUMENT_LIST
-      case 117: // identifier_list
-      case 118: // identifier_list_not_empty
+      case symbol_kind::S_ARGUMENT_LIST: // ARGUMENT_LIST
+      case symbol_kind::S_identifier_list: // identifier_list
+      case symbol_kind::S_identifier_list_not_empty: // identifier_list_not_empty
         value.move< std::vector<std::string> > (YY_MOVE (s.value));
         break;
 
-      case 115: // literal_argument
-      case 116: // literal_list
+      case symbol_kind::S_literal_argument: // literal_argument
+      case symbol_kind::S_literal_list: // literal_list
         value.move< std::vector<std::variant<std::uint32_t, kasm::AddressData>> > (YY_MOVE (s.value));
         break;
 
@@ -3011,69 +3336,56 @@ switch (yytype)
     location = YY_MOVE (s.location);
   }
 
-  // by_type.
-  parser::by_type::by_type ()
-    : type (empty_symbol)
+  // by_kind.
+  parser::by_kind::by_kind () YY_NOEXCEPT
+    : kind_ (symbol_kind::S_YYEMPTY)
   {}
 
 #if 201103L <= YY_CPLUSPLUS
-  parser::by_type::by_type (by_type&& that)
-    : type (that.type)
+  parser::by_kind::by_kind (by_kind&& that) YY_NOEXCEPT
+    : kind_ (that.kind_)
   {
     that.clear ();
   }
 #endif
 
-  parser::by_type::by_type (const by_type& that)
-    : type (that.type)
+  parser::by_kind::by_kind (const by_kind& that) YY_NOEXCEPT
+    : kind_ (that.kind_)
   {}
 
-  parser::by_type::by_type (token_type t)
-    : type (yytranslate_ (t))
+  parser::by_kind::by_kind (token_kind_type t) YY_NOEXCEPT
+    : kind_ (yytranslate_ (t))
   {}
 
+
+
   void
-  parser::by_type::clear ()
+  parser::by_kind::clear () YY_NOEXCEPT
   {
-    type = empty_symbol;
+    kind_ = symbol_kind::S_YYEMPTY;
   }
 
   void
-  parser::by_type::move (by_type& that)
+  parser::by_kind::move (by_kind& that)
   {
-    type = that.type;
+    kind_ = that.kind_;
     that.clear ();
   }
 
-  int
-  parser::by_type::type_get () const YY_NOEXCEPT
+  parser::symbol_kind_type
+  parser::by_kind::kind () const YY_NOEXCEPT
   {
-    return type;
+    return kind_;
   }
 
-  parser::token_type
-  parser::by_type::token () const YY_NOEXCEPT
+
+  parser::symbol_kind_type
+  parser::by_kind::type_get () const YY_NOEXCEPT
   {
-    // YYTOKNUM[NUM] -- (External) token number corresponding to the
-    // (internal) symbol number NUM (which must be that of a token).  */
-    static
-    const unsigned short
-    yytoken_number_[] =
-    {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,   311,   312,   313,   314,
-     315,   316,   317,   318,   319,   320,   321,   322,   323,   324,
-     325,   326,   327,   328,   329,   330,   331,   332,   333,   334,
-     335,   336,   337,   338,   339,   340,   341,   342,   343,   344,
-     345,   346,   347,   348,    58,    40,    41,    44,    43
-    };
-    return token_type (yytoken_number_[type]);
+    return this->kind ();
   }
 
+
 } // yy
 
 
@@ -3081,7 +3393,6 @@ switch (yytype)
 
 
 
-
 // Unqualified %code blocks.
 
 enum class CTXFlag
@@ -3099,13 +3410,42 @@ struct MacroCall
 	std::vector<std::string> arguments;
 };
 
-static kasm::CompoundInputFileStream in;
+static kasm::InputStack in;
 static yy::location loc;
 static kasm::Assembler* assembler;
 static CTXFlag flag;
 static std::vector<MacroCall> macroCallStack;
 static std::stack<bool> labelInMacro;
 
+// A macro body lexed once, when the macro is defined. Calls replay its tokens instead of lexing the text again, but
+// the text is still pushed for the argument lists and lines the parser reads as text.
+struct MacroToken
+{
+	yy::parser::symbol_type symbol;
+	std::size_t begin; // offsets into the body
+	std::size_t end;
+	unsigned columns; // of whitespace before the token
+	int slot; // the parameter an identifier names, -1 for none
+};
+
+struct MacroBody
+{
+	std::shared_ptr<const std::string> text;
+	std::vector<MacroToken> tokens;
+};
+
+struct Replay
+{
+	std::shared_ptr<const MacroBody> body;
+	std::size_t depth; // of the view of the body in the input
+	std::size_t index;
+};
+
+static std::unordered_map<std::string, std::shared_ptr<const MacroBody>> macroBodies;
+static std::vector<Replay> replays;
+static bool tokenizing;
+static const char* tokenStart;
+
 void eofCallback(unsigned uid)
 {
 	KASM_ASSERT(!macroCallStack.empty(), "Trying to pop empty macro stack");
@@ -3115,6 +3455,67 @@ void eofCallback(unsigned uid)
 
 namespace yy { parser::symbol_type yylex(); }
 
+// Identifiers naming a parameter keep its index. A body that fails to lex is left to be lexed as text on every call,
+// where the error shows up.
+static void tokenizeMacro(const std::string& name)
+{
+	const kasm::Assembler::MacroFunction& macroFunction = assembler->macroFunctions[name];
+	auto body = std::make_shared<MacroBody>();
+	body->text = std::make_shared<const std::string>(macroFunction.body);
+
+	kasm::InputStack input;
+	input.pushString(body->text);
+	std::swap(in, input);
+	yy::location savedLoc = loc;
+	tokenizing = true;
+	try
+	{
+		for (;;)
+		{
+			loc.initialize();
+			yy::parser::symbol_type symbol = yy::yylex();
+			if (symbol.kind() == yy::parser::symbol_kind::S_YYEOF)
+			{
+				break;
+			}
+
+			int slot = -1;
+			if (symbol.kind() == yy::parser::symbol_kind::S_IDENTIFIER)
+			{
+				auto it = std::find(macroFunction.paramaters.begin(), macroFunction.paramaters.end(), symbol.value.as<std::string>());
+				if (it != macroFunction.paramaters.end())
+				{
+					slot = static_cast<int>(std::distance(macroFunction.paramaters.begin(), it));
+				}
+			}
+
+			const char* text = body->text->data();
+			body->tokens.push_back({ std::move(symbol), static_cast<std::size_t>(tokenStart - text), static_cast<std::size_t>(in.cursor - text), static_cast<unsigned>(loc.end.column - 1), slot });
+		}
+		macroBodies[name] = body;
+	}
+	catch (const std::exception&)
+	{
+	}
+	tokenizing = false;
+	loc = savedLoc;
+	std::swap(in, input);
+}
+
+static void callMacro(const std::string& name, const std::vector<std::string>& arguments)
+{
+	const kasm::Assembler::MacroFunction& macroFunction = assembler->macroFunctions[name];
+	auto it = macroBodies.find(name);
+	if (it == macroBodies.end())
+	{
+		macroCallStack.push_back({ in.pushString(macroFunction.body, true), macroFunction.paramaters, arguments });
+		return;
+	}
+
+	macroCallStack.push_back({ in.pushString(it->second->text, true), macroFunction.paramaters, arguments });
+	replays.push_back({ it->second, in.getDepth(), 0 });
+}
+
 #define INSTRUCTION_RRR(op, r0, r1, r2) {                           \
 	kasm::InstructionData instructionData;                          \
 	instructionData.opcode = kasm::Opcode::op;                    \
@@ -3227,6 +3628,7 @@ kasm::AddressData returnAddress(kasm::Register::RA);
 # endif
 #endif
 
+
 // Whether we are compiled with exception support.
 #ifndef YY_EXCEPTIONS
 # if defined __GNUC__ && !defined __EXCEPTIONS
@@ -3257,9 +3659,6 @@ kasm::AddressData returnAddress(kasm::Register::RA);
 # endif
 
 
-// Suppress unused-variable warnings by "using" E.
-#define YYUSE(E) ((void) (E))
-
 // Enable debugging if requested.
 #if YYDEBUG
 
@@ -3285,13 +3684,13 @@ kasm::AddressData returnAddress(kasm::Register::RA);
 # define YY_STACK_PRINT()               \
   do {                                  \
     if (yydebug_)                       \
-      yystack_print_ ();                \
+      yy_stack_print_ ();                \
   } while (false)
 
 #else // !YYDEBUG
 
 # define YYCDEBUG if (false) std::cerr
-# define YY_SYMBOL_PRINT(Title, Symbol)  YYUSE (Symbol)
+# define YY_SYMBOL_PRINT(Title, Symbol)  YY_USE (Symbol)
 # define YY_REDUCE_PRINT(Rule)           static_cast<void> (0)
 # define YY_STACK_PRINT()                static_cast<void> (0)
 
@@ -3307,53 +3706,13 @@ kasm::AddressData returnAddress(kasm::Register::RA);
 
 namespace yy {
 
-
-  /* Return YYSTR after stripping away unnecessary quotes and
-     backslashes, so that it's suitable for yyerror.  The heuristic is
-     that double-quoting is unnecessary unless the string contains an
-     apostrophe, a comma, or backslash (other than backslash-backslash).
-     YYSTR is taken from yytname.  */
-  std::string
-  parser::yytnamerr_ (const char *yystr)
-  {
-    if (*yystr == '"')
-      {
-        std::string yyr;
-        char const *yyp = yystr;
-
-        for (;;)
-          switch (*++yyp)
-            {
-            case '\'':
-            case ',':
-              goto do_not_strip_quotes;
-
-            case '\\':
-              if (*++yyp != '\\')
-                goto do_not_strip_quotes;
-              else
-                goto append;
-
-            append:
-            default:
-              yyr += *yyp;
-              break;
-
-            case '"':
-              return yyr;
-            }
-      do_not_strip_quotes: ;
-      }
-
-    return yystr;
-  }
-
-
   /// Build a parser object.
   parser::parser ()
 #if YYDEBUG
-     :yydebug_ (false),
+    : yydebug_ (false),
       yycdebug_ (&std::cerr)
+#else
+
 #endif
   {}
 
@@ -3363,9 +3722,9 @@ namespace yy {
   parser::syntax_error::~syntax_error () YY_NOEXCEPT YY_NOTHROW
   {}
 
-  /*---------------.
-  | Symbol types.  |
-  `---------------*/
+  /*---------.
+  | symbol.  |
+  `---------*/
 
 
 
@@ -3395,13 +3754,13 @@ namespace yy {
     : state (s)
   {}
 
-  parser::symbol_number_type
-  parser::by_state::type_get () const YY_NOEXCEPT
+  parser::symbol_kind_type
+  parser::by_state::kind () const YY_NOEXCEPT
   {
     if (state == empty_state)
-      return empty_symbol;
+      return symbol_kind::S_YYEMPTY;
     else
-      return yystos_[state];
+      return YY_CAST (symbol_kind_type, yystos_[+state]);
   }
 
   parser::stack_symbol_type::stack_symbol_type ()
@@ -3410,32 +3769,32 @@ namespace yy {
   parser::stack_symbol_type::stack_symbol_type (YY_RVREF (stack_symbol_type) that)
     : super_type (YY_MOVE (that.state), YY_MOVE (that.location))
   {
-    switch (that.type_get ())
+    switch (that.kind ())
     {
-      case 119: // direct_address
-      case 120: // address
+      case symbol_kind::S_direct_address: // direct_address
+      case symbol_kind::S_address: // address
         value.YY_MOVE_OR_COPY< kasm::AddressData > (YY_MOVE (that.value));
         break;
 
-      case 4: // IDENTIFIER
-      case 6: // STRING
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+      case symbol_kind::S_STRING: // STRING
         value.YY_MOVE_OR_COPY< std::string > (YY_MOVE (that.value));
         break;
 
-      case 5: // LITERAL
-      case 7: // REGISTER
-      case 101: // statement
+      case symbol_kind::S_LITERAL: // LITERAL
+      case symbol_kind::S_REGISTER: // REGISTER
+      case symbol_kind::S_statement: // statement
         value.YY_MOVE_OR_COPY< std::uint32_t > (YY_MOVE (that.value));
         break;
 
-      case 8: // ARGUMENT_LIST
-      case 117: // identifier_list
-      case 118: // identifier_list_not_empty
+      case symbol_kind::S_ARGUMENT_LIST: // ARGUMENT_LIST
+      case symbol_kind::S_identifier_list: // identifier_list
+      case symbol_kind::S_identifier_list_not_empty: // identifier_list_not_empty
         value.YY_MOVE_OR_COPY< std::vector<std::string> > (YY_MOVE (that.value));
         break;
 
-      case 115: // literal_argument
-      case 116: // literal_list
+      case symbol_kind::S_literal_argument: // literal_argument
+      case symbol_kind::S_literal_list: // literal_list
         value.YY_MOVE_OR_COPY< std::vector<std::variant<std::uint32_t, kasm::AddressData>> > (YY_MOVE (that.value));
         break;
 
@@ -3452,32 +3811,32 @@ namespace yy {
   parser::stack_symbol_type::stack_symbol_type (state_type s, YY_MOVE_REF (symbol_type) that)
     : super_type (s, YY_MOVE (that.location))
   {
-    switch (that.type_get ())
+    switch (that.kind ())
     {
-      case 119: // direct_address
-      case 120: // address
+      case symbol_kind::S_direct_address: // direct_address
+      case symbol_kind::S_address: // address
         value.move< kasm::AddressData > (YY_MOVE (that.value));
         break;
 
-      case 4: // IDENTIFIER
-      case 6: // STRING
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+      case symbol_kind::S_STRING: // STRING
         value.move< std::string > (YY_MOVE (that.value));
         break;
 
-      case 5: // LITERAL
-      case 7: // REGISTER
-      case 101: // statement
+      case symbol_kind::S_LITERAL: // LITERAL
+      case symbol_kind::S_REGISTER: // REGISTER
+      case symbol_kind::S_statement: // statement
         value.move< std::uint32_t > (YY_MOVE (that.value));
         break;
 
-      case 8: // ARGUMENT_LIST
-      case 117: // identifier_list
-      case 118: // identifier_list_not_empty
+      case symbol_kind::S_ARGUMENT_LIST: // ARGUMENT_LIST
+      case symbol_kind::S_identifier_list: // identifier_list
+      case symbol_kind::S_identifier_list_not_empty: // identifier_list_not_empty
         value.move< std::vector<std::string> > (YY_MOVE (that.value));
         break;
 
-      case 115: // literal_argument
-      case 116: // literal_list
+      case symbol_kind::S_literal_argument: // literal_argument
+      case symbol_kind::S_literal_list: // literal_list
         value.move< std::vector<std::variant<std::uint32_t, kasm::AddressData>> > (YY_MOVE (that.value));
         break;
 
@@ -3486,40 +3845,81 @@ namespace yy {
     }
 
     // that is emptied.
-    that.type = empty_symbol;
+    that.kind_ = symbol_kind::S_YYEMPTY;
   }
 
 #if YY_CPLUSPLUS < 201103L
+  parser::stack_symbol_type&
+  parser::stack_symbol_type::operator= (const stack_symbol_type& that)
+  {
+    state = that.state;
+    switch (that.kind ())
+    {
+      case symbol_kind::S_direct_address: // direct_address
+      case symbol_kind::S_address: // address
+        value.copy< kasm::AddressData > (that.value);
+        break;
+
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+      case symbol_kind::S_STRING: // STRING
+        value.copy< std::string > (that.value);
+        break;
+
+      case symbol_kind::S_LITERAL: // LITERAL
+      case symbol_kind::S_REGISTER: // REGISTER
+      case symbol_kind::S_statement: // statement
+        value.copy< std::uint32_t > (that.value);
+        break;
+
+      case symbol_kind::S_ARGUMENT_LIST: // ARGUMENT_LIST
+      case symbol_kind::S_identifier_list: // identifier_list
+      case symbol_kind::S_identifier_list_not_empty: // identifier_list_not_empty
+        value.copy< std::vector<std::string> > (that.value);
+        break;
+
+      case symbol_kind::S_literal_argument: // literal_argument
+      case symbol_kind::S_literal_list: // literal_list
+        value.copy< std::vector<std::variant<std::uint32_t, kasm::AddressData>> > (that.value);
+        break;
+
+      default:
+        break;
+    }
+
+    location = that.location;
+    return *this;
+  }
+
   parser::stack_symbol_type&
   parser::stack_symbol_type::operator= (stack_symbol_type& that)
   {
     state = that.state;
-    switch (that.type_get ())
+    switch (that.kind ())
     {
-      case 119: // direct_address
-      case 120: // address
+      case symbol_kind::S_direct_address: // direct_address
+      case symbol_kind::S_address: // address
         value.move< kasm::AddressData > (that.value);
         break;
 
-      case 4: // IDENTIFIER
-      case 6: // STRING
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+      case symbol_kind::S_STRING: // STRING
         value.move< std::string > (that.value);
         break;
 
-      case 5: // LITERAL
-      case 7: // REGISTER
-      case 101: // statement
+      case symbol_kind::S_LITERAL: // LITERAL
+      case symbol_kind::S_REGISTER: // REGISTER
+      case symbol_kind::S_statement: // statement
         value.move< std::uint32_t > (that.value);
         break;
 
-      case 8: // ARGUMENT_LIST
-      case 117: // identifier_list
-      case 118: // identifier_list_not_empty
+      case symbol_kind::S_ARGUMENT_LIST: // ARGUMENT_LIST
+      case symbol_kind::S_identifier_list: // identifier_list
+      case symbol_kind::S_identifier_list_not_empty: // identifier_list_not_empty
         value.move< std::vector<std::string> > (that.value);
         break;
 
-      case 115: // literal_argument
-      case 116: // literal_list
+      case symbol_kind::S_literal_argument: // literal_argument
+      case symbol_kind::S_literal_list: // literal_list
         value.move< std::vector<std::variant<std::uint32_t, kasm::AddressData>> > (that.value);
         break;
 
@@ -3545,23 +3945,21 @@ namespace yy {
 #if YYDEBUG
   template <typename Base>
   void
-  parser::yy_print_ (std::ostream& yyo,
-                                     const basic_symbol<Base>& yysym) const
+  parser::yy_print_ (std::ostream& yyo, const basic_symbol<Base>& yysym) const
   {
     std::ostream& yyoutput = yyo;
-    YYUSE (yyoutput);
-    symbol_number_type yytype = yysym.type_get ();
-#if defined __GNUC__ && ! defined __clang__ && ! defined __ICC && __GNUC__ * 100 + __GNUC_MINOR__ <= 408
-    // Avoid a (spurious) G++ 4.8 warning about "array subscript is
-    // below array bounds".
+    YY_USE (yyoutput);
     if (yysym.empty ())
-      std::abort ();
-#endif
-    yyo << (yytype < yyntokens_ ? "token" : "nterm")
-        << ' ' << yytname_[yytype] << " ("
-        << yysym.location << ": ";
-    YYUSE (yytype);
-    yyo << ')';
+      yyo << "empty symbol";
+    else
+      {
+        symbol_kind_type yykind = yysym.kind ();
+        yyo << (yykind < YYNTOKENS ? "token" : "nterm")
+            << ' ' << yysym.name () << " ("
+            << yysym.location << ": ";
+        YY_USE (yykind);
+        yyo << ')';
+      }
   }
 #endif
 
@@ -3585,7 +3983,7 @@ namespace yy {
   }
 
   void
-  parser::yypop_ (int n)
+  parser::yypop_ (int n) YY_NOEXCEPT
   {
     yystack_.pop (n);
   }
@@ -3620,21 +4018,21 @@ namespace yy {
   parser::state_type
   parser::yy_lr_goto_state_ (state_type yystate, int yysym)
   {
-    int yyr = yypgoto_[yysym - yyntokens_] + yystate;
+    int yyr = yypgoto_[yysym - YYNTOKENS] + yystate;
     if (0 <= yyr && yyr <= yylast_ && yycheck_[yyr] == yystate)
       return yytable_[yyr];
     else
-      return yydefgoto_[yysym - yyntokens_];
+      return yydefgoto_[yysym - YYNTOKENS];
   }
 
   bool
-  parser::yy_pact_value_is_default_ (int yyvalue)
+  parser::yy_pact_value_is_default_ (int yyvalue) YY_NOEXCEPT
   {
     return yyvalue == yypact_ninf_;
   }
 
   bool
-  parser::yy_table_value_is_error_ (int yyvalue)
+  parser::yy_table_value_is_error_ (int yyvalue) YY_NOEXCEPT
   {
     return yyvalue == yytable_ninf_;
   }
@@ -3648,7 +4046,6 @@ namespace yy {
   int
   parser::parse ()
   {
-    // State.
     int yyn;
     /// Length of the RHS of the rule being reduced.
     int yylen = 0;
@@ -3684,7 +4081,8 @@ namespace yy {
   | yynewstate -- push a new symbol on the stack.  |
   `-----------------------------------------------*/
   yynewstate:
-    YYCDEBUG << "Entering state " << yystack_[0].state << '\n';
+    YYCDEBUG << "Entering state " << int (yystack_[0].state) << '\n';
+    YY_STACK_PRINT ();
 
     // Accept?
     if (yystack_[0].state == yyfinal_)
@@ -3698,14 +4096,14 @@ namespace yy {
   `-----------*/
   yybackup:
     // Try to take a decision without lookahead.
-    yyn = yypact_[yystack_[0].state];
+    yyn = yypact_[+yystack_[0].state];
     if (yy_pact_value_is_default_ (yyn))
       goto yydefault;
 
     // Read a lookahead token.
     if (yyla.empty ())
       {
-        YYCDEBUG << "Reading a token: ";
+        YYCDEBUG << "Reading a token\n";
 #if YY_EXCEPTIONS
         try
 #endif // YY_EXCEPTIONS
@@ -3724,11 +4122,23 @@ namespace yy {
       }
     YY_SYMBOL_PRINT ("Next token is", yyla);
 
+    if (yyla.kind () == symbol_kind::S_YYerror)
+    {
+      // The scanner already issued an error message, process directly
+      // to error recovery.  But do not keep the error token as
+      // lookahead, it is too special and may lead us to an endless
+      // loop in error recovery. */
+      yyla.kind_ = symbol_kind::S_YYUNDEF;
+      goto yyerrlab1;
+    }
+
     /* If the proper action on seeing token YYLA.TYPE is to reduce or
        to detect an error, take that action.  */
-    yyn += yyla.type_get ();
-    if (yyn < 0 || yylast_ < yyn || yycheck_[yyn] != yyla.type_get ())
-      goto yydefault;
+    yyn += yyla.kind ();
+    if (yyn < 0 || yylast_ < yyn || yycheck_[yyn] != yyla.kind ())
+      {
+        goto yydefault;
+      }
 
     // Reduce or error.
     yyn = yytable_[yyn];
@@ -3745,7 +4155,7 @@ namespace yy {
       --yyerrstatus_;
 
     // Shift the lookahead token.
-    yypush_ ("Shifting", yyn, YY_MOVE (yyla));
+    yypush_ ("Shifting", state_type (yyn), YY_MOVE (yyla));
     goto yynewstate;
 
 
@@ -3753,7 +4163,7 @@ namespace yy {
   | yydefault -- do the default action for the current state.  |
   `-----------------------------------------------------------*/
   yydefault:
-    yyn = yydefact_[yystack_[0].state];
+    yyn = yydefact_[+yystack_[0].state];
     if (yyn == 0)
       goto yyerrlab;
     goto yyreduce;
@@ -3772,30 +4182,30 @@ namespace yy {
          when using variants.  */
       switch (yyr1_[yyn])
     {
-      case 119: // direct_address
-      case 120: // address
+      case symbol_kind::S_direct_address: // direct_address
+      case symbol_kind::S_address: // address
         yylhs.value.emplace< kasm::AddressData > ();
         break;
 
-      case 4: // IDENTIFIER
-      case 6: // STRING
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+      case symbol_kind::S_STRING: // STRING
         yylhs.value.emplace< std::string > ();
         break;
 
-      case 5: // LITERAL
-      case 7: // REGISTER
-      case 101: // statement
+      case symbol_kind::S_LITERAL: // LITERAL
+      case symbol_kind::S_REGISTER: // REGISTER
+      case symbol_kind::S_statement: // statement
         yylhs.value.emplace< std::uint32_t > ();
         break;
 
-      case 8: // ARGUMENT_LIST
-      case 117: // identifier_list
-      case 118: // identifier_list_not_empty
+      case symbol_kind::S_ARGUMENT_LIST: // ARGUMENT_LIST
+      case symbol_kind::S_identifier_list: // identifier_list
+      case symbol_kind::S_identifier_list_not_empty: // identifier_list_not_empty
         yylhs.value.emplace< std::vector<std::string> > ();
         break;
 
-      case 115: // literal_argument
-      case 116: // literal_list
+      case symbol_kind::S_literal_argument: // literal_argument
+      case symbol_kind::S_literal_list: // literal_list
         yylhs.value.emplace< std::vector<std::variant<std::uint32_t, kasm::AddressData>> > ();
         break;
 
@@ -3819,12 +4229,12 @@ namespace yy {
         {
           switch (yyn)
             {
-  case 4:
-    { labelInMacro.push(!macroCallStack.empty()); }
+  case 4: // $@1: %empty
+                     { labelInMacro.push(!macroCallStack.empty()); }
     break;
 
-  case 5:
-    {
+  case 5: // statement: IDENTIFIER ':' $@1 statement
+        {
 		yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > ();
 		if (labelInMacro.top())
 		{
@@ -3846,23 +4256,23 @@ namespace yy {
 	}
     break;
 
-  case 6:
-    { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
+  case 6: // statement: END_OF_LINE statement
+                                { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
     break;
 
-  case 7:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); }
+  case 7: // statement: END_OF_FILE
+                      { yylhs.value.as < std::uint32_t > () = GET_LOC(); }
     break;
 
-  case 8:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); assembler->binary.setSegmentType(kasm::BinaryBuilder::SegmentType::TEXT); }
+  case 8: // statement: TEXT end_of_statement
+                                { yylhs.value.as < std::uint32_t > () = GET_LOC(); assembler->binary.setSegmentType(kasm::BinaryBuilder::SegmentType::TEXT); }
     break;
 
-  case 9:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); assembler->binary.setSegmentType(kasm::BinaryBuilder::SegmentType::DATA); }
+  case 9: // statement: DATA end_of_statement
+                                { yylhs.value.as < std::uint32_t > () = GET_LOC(); assembler->binary.setSegmentType(kasm::BinaryBuilder::SegmentType::DATA); }
     break;
 
-  case 10:
+  case 10: // statement: WORD literal_argument end_of_statement
     {
 		KASM_ASSERT(assembler->binary.getSegmentType() == kasm::BinaryBuilder::SegmentType::DATA, "word must be in data segment");
         assembler->binary.align(kasm::INSTRUCTION_SIZE);
@@ -3885,7 +4295,7 @@ namespace yy {
     }
     break;
 
-  case 11:
+  case 11: // statement: BYTE literal_argument end_of_statement
     {
 		KASM_ASSERT(assembler->binary.getSegmentType() == kasm::BinaryBuilder::SegmentType::DATA, "byte must be in data segment");
         yylhs.value.as < std::uint32_t > () = GET_LOC(); 
@@ -3907,23 +4317,23 @@ namespace yy {
     }
     break;
 
-  case 12:
-    {
+  case 12: // statement: ASCII STRING end_of_statement
+        {
 		KASM_ASSERT(assembler->binary.getSegmentType() == kasm::BinaryBuilder::SegmentType::DATA, "ascii must be in data segment");
 		yylhs.value.as < std::uint32_t > () = GET_LOC(); 
 		assembler->binary.writeString(yystack_[1].value.as < std::string > ().c_str(), yystack_[1].value.as < std::string > ().size());
 	}
     break;
 
-  case 13:
-    {
+  case 13: // statement: ASCIIZ STRING end_of_statement
+        {
 		KASM_ASSERT(assembler->binary.getSegmentType() == kasm::BinaryBuilder::SegmentType::DATA, "asciiz must be in data segment");
 		yylhs.value.as < std::uint32_t > () = GET_LOC(); 
 		assembler->binary.writeString(yystack_[1].value.as < std::string > ().c_str(), yystack_[1].value.as < std::string > ().size() + 1);
 	}
     break;
 
-  case 14:
+  case 14: // statement: ALIGN LITERAL end_of_statement
     {
 		KASM_ASSERT(assembler->binary.getSegmentType() == kasm::BinaryBuilder::SegmentType::DATA, "align must be in data segment");
         yylhs.value.as < std::uint32_t > () = GET_LOC(); 
@@ -3936,396 +4346,412 @@ namespace yy {
     }
     break;
 
-  case 15:
-    {
+  case 15: // statement: SPACE LITERAL end_of_statement
+        {
 		KASM_ASSERT(assembler->binary.getSegmentType() == kasm::BinaryBuilder::SegmentType::DATA, "space must be in data segment");
 		yylhs.value.as < std::uint32_t > () = GET_LOC(); 
 		assembler->binary.pad(yystack_[1].value.as < std::uint32_t > ());
 	}
     break;
 
-  case 16:
-    { in.include(yystack_[1].value.as < std::string > ()); }
+  case 16: // $@2: %empty
+                                          { in.include(yystack_[1].value.as < std::string > ()); }
     break;
 
-  case 17:
-    { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
+  case 17: // statement: INCLUDE STRING end_of_statement $@2 statement
+                                                                        { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
     break;
 
-  case 18:
-    { std::cout << "ERROR: " << yystack_[1].value.as < std::string > () << std::endl; throw std::runtime_error("Assembler user defined error"); }
+  case 18: // $@3: %empty
+                                          { std::cout << "ERROR: " << yystack_[1].value.as < std::string > () << std::endl; throw std::runtime_error("Assembler user defined error"); }
     break;
 
-  case 19:
-    { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
+  case 19: // statement: ERROR STRING end_of_statement $@3 statement
+                                                                                                                                                             { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
     break;
 
-  case 20:
-    { std::cout << "MESSAGE: " << yystack_[1].value.as < std::string > () << std::endl; }
+  case 20: // $@4: %empty
+                                          { std::cout << "MESSAGE: " << yystack_[1].value.as < std::string > () << std::endl; }
     break;
 
-  case 21:
-    { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
+  case 21: // statement: MESSAGE STRING end_of_statement $@4 statement
+                                                                                                     { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
     break;
 
-  case 22:
-    { in.pushString(yystack_[1].value.as < std::string > ()); }
+  case 22: // $@5: %empty
+                                          { in.pushString(yystack_[1].value.as < std::string > ()); }
     break;
 
-  case 23:
-    { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
+  case 23: // statement: DBG STRING end_of_statement $@5 statement
+                                                                           { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
     break;
 
-  case 24:
-    { KASM_BREAKPOINT(); }
+  case 24: // $@6: %empty
+                                          { KASM_BREAKPOINT(); }
     break;
 
-  case 25:
-    { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
+  case 25: // statement: DBGBP end_of_statement $@6 statement
+                                                                           { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
     break;
 
-  case 26:
-    { flag = CTXFlag::LINE_AS_STRING; }
+  case 26: // $@7: %empty
+                            { flag = CTXFlag::LINE_AS_STRING; }
     break;
 
-  case 27:
-    { flag = CTXFlag::None; assembler->defineMacro(yystack_[2].value.as < std::string > (), yystack_[0].value.as < std::string > ()); }
+  case 27: // $@8: %empty
+                                                                       { flag = CTXFlag::None; assembler->defineMacro(yystack_[2].value.as < std::string > (), yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 28:
-    { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
+  case 28: // statement: DEFINE IDENTIFIER $@7 STRING $@8 end_of_statement statement
+                                                                                                                                                            { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
     break;
 
-  case 29:
-    { flag = CTXFlag::BLOCK_AS_STRING; }
+  case 29: // $@9: %empty
+                                                               { flag = CTXFlag::BLOCK_AS_STRING; }
     break;
 
-  case 30:
-    { flag = CTXFlag::None; assembler->defineMacro(yystack_[6].value.as < std::string > (), yystack_[4].value.as < std::vector<std::string> > (), yystack_[0].value.as < std::string > ()); }
+  case 30: // $@10: %empty
+                                                                                                           { flag = CTXFlag::None; assembler->defineMacro(yystack_[6].value.as < std::string > (), yystack_[4].value.as < std::vector<std::string> > (), yystack_[0].value.as < std::string > ()); tokenizeMacro(yystack_[6].value.as < std::string > ()); }
     break;
 
-  case 31:
-    { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
+  case 31: // statement: MACRO IDENTIFIER '(' identifier_list ')' END_OF_LINE $@9 STRING $@10 end_of_statement statement
+                                                                                                                                                                                                                       { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
     break;
 
-  case 32:
-    { flag = CTXFlag::ARGUMENT_LIST; }
+  case 32: // $@11: %empty
+                         { flag = CTXFlag::ARGUMENT_LIST; }
     break;
 
-  case 33:
-    { flag = CTXFlag::None; }
+  case 33: // $@12: %empty
+                                                                          { flag = CTXFlag::None; }
     break;
 
-  case 34:
-    { macroCallStack.push_back({in.pushString(assembler->macroFunctions[yystack_[5].value.as < std::string > ()].body, true), assembler->macroFunctions[yystack_[5].value.as < std::string > ()].paramaters, yystack_[2].value.as < std::vector<std::string> > ()}); }
+  case 34: // $@13: %empty
+                                                                                                                     { callMacro(yystack_[5].value.as < std::string > (), yystack_[2].value.as < std::vector<std::string> > ()); }
     break;
 
-  case 35:
-    { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
+  case 35: // statement: IDENTIFIER '(' $@11 ARGUMENT_LIST $@12 end_of_statement $@13 statement
+                                                                                                                                                      { yylhs.value.as < std::uint32_t > () = yystack_[0].value.as < std::uint32_t > (); }
     break;
 
-  case 36:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(ADD, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 36: // statement: ADD REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                       { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(ADD, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 37:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(ADDI, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 37: // statement: ADDI REGISTER ',' REGISTER ',' LITERAL end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(ADDI, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 38:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(ADDIU, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 38: // statement: ADDIU REGISTER ',' REGISTER ',' LITERAL end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(ADDIU, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 39:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(ADDU, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 39: // statement: ADDU REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(ADDU, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 40:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(AND, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 40: // statement: AND REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(AND, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 41:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(ANDI, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 41: // statement: ANDI REGISTER ',' REGISTER ',' LITERAL end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(ANDI, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 42:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRA(BEQ, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 42: // statement: BEQ REGISTER ',' REGISTER ',' direct_address end_of_statement
+                                                                       { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRA(BEQ, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 43:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(BGEZ, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 43: // statement: BGEZ REGISTER ',' direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(BGEZ, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 44:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(BGEZAL, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 44: // statement: BGEZAL REGISTER ',' direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(BGEZAL, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 45:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(BGTZ, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 45: // statement: BGTZ REGISTER ',' direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(BGTZ, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 46:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(BLEZ, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 46: // statement: BLEZ REGISTER ',' direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(BLEZ, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 47:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(BLTZ, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 47: // statement: BLTZ REGISTER ',' direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(BLTZ, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 48:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(BLTZAL, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 48: // statement: BLTZAL REGISTER ',' direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(BLTZAL, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 49:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRA(BNE, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 49: // statement: BNE REGISTER ',' REGISTER ',' direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRA(BNE, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 50:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(DIV, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 50: // statement: DIV REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(DIV, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 51:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(DIVU, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 51: // statement: DIVU REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(DIVU, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 52:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_A(J, yystack_[1].value.as < kasm::AddressData > (), DirectAddressAbsolute); }
+  case 52: // statement: J address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_A(J, yystack_[1].value.as < kasm::AddressData > (), DirectAddressAbsolute); }
     break;
 
-  case 53:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_A(JAL, yystack_[1].value.as < kasm::AddressData > (), DirectAddressAbsolute); }
+  case 53: // statement: JAL address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_A(JAL, yystack_[1].value.as < kasm::AddressData > (), DirectAddressAbsolute); }
     break;
 
-  case 54:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_R(JR, yystack_[1].value.as < std::uint32_t > ()); }
+  case 54: // statement: JR REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_R(JR, yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 55:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(LB, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), IndirectAddressOffset); }
+  case 55: // statement: LB REGISTER ',' address end_of_statement
+                                                                       { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(LB, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), IndirectAddressOffset); }
     break;
 
-  case 56:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RL(LUI, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 56: // statement: LUI REGISTER ',' LITERAL end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RL(LUI, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 57:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(LW, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), IndirectAddressOffset); }
+  case 57: // statement: LW REGISTER ',' address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(LW, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), IndirectAddressOffset); }
     break;
 
-  case 58:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_R(MFHI, yystack_[1].value.as < std::uint32_t > ()); }
+  case 58: // statement: MFHI REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_R(MFHI, yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 59:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_R(MFLO, yystack_[1].value.as < std::uint32_t > ()); }
+  case 59: // statement: MFLO REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_R(MFLO, yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 60:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(MULT, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 60: // statement: MULT REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(MULT, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 61:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(MULTU, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 61: // statement: MULTU REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(MULTU, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 62:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(OR, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 62: // statement: OR REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(OR, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 63:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(ORI, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 63: // statement: ORI REGISTER ',' REGISTER ',' LITERAL end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(ORI, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 64:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(SB, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), IndirectAddressOffset); }
+  case 64: // statement: SB REGISTER ',' address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(SB, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), IndirectAddressOffset); }
     break;
 
-  case 65:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(SLL, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 65: // statement: SLL REGISTER ',' REGISTER ',' LITERAL end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(SLL, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 66:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLLV, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 66: // statement: SLLV REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLLV, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 67:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLT, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 67: // statement: SLT REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLT, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 68:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(SLTI, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 68: // statement: SLTI REGISTER ',' REGISTER ',' LITERAL end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(SLTI, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 69:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(SLTIU, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 69: // statement: SLTIU REGISTER ',' REGISTER ',' LITERAL end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(SLTIU, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 70:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLTU, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 70: // statement: SLTU REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLTU, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 71:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SNE, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 71: // statement: SNE REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SNE, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 72:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SEQ, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 72: // statement: SEQ REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SEQ, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 73:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(SRA, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 73: // statement: SRA REGISTER ',' REGISTER ',' LITERAL end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(SRA, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 74:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(SRL, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 74: // statement: SRL REGISTER ',' REGISTER ',' LITERAL end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(SRL, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 75:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SRLV, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 75: // statement: SRLV REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SRLV, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 76:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SUB, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 76: // statement: SUB REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SUB, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 77:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SUBU, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 77: // statement: SUBU REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SUBU, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 78:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(SW, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), IndirectAddressOffset); }
+  case 78: // statement: SW REGISTER ',' address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(SW, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < kasm::AddressData > (), IndirectAddressOffset); }
     break;
 
-  case 79:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_O(SYS); }
+  case 79: // statement: SYS end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_O(SYS); }
     break;
 
-  case 80:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(XOR, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 80: // statement: XOR REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(XOR, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 81:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(XORI, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 81: // statement: XORI REGISTER ',' REGISTER ',' LITERAL end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(XORI, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 82:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(JALR, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 82: // statement: JALR REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(JALR, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 83:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(NOR, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 83: // statement: NOR REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(NOR, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 84:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(OR, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > (), kasm::ZERO); }
+  case 84: // statement: CAS REGISTER ',' REGISTER ',' '(' REGISTER ')' end_of_statement
+                                                                             { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(CAS, yystack_[7].value.as < std::uint32_t > (), yystack_[2].value.as < std::uint32_t > (), yystack_[5].value.as < std::uint32_t > ()); }
     break;
 
-  case 85:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(OR, yystack_[1].value.as < std::uint32_t > (), kasm::ZERO, kasm::ZERO); }
+  case 85: // statement: AMOADD REGISTER ',' REGISTER ',' '(' REGISTER ')' end_of_statement
+                                                                             { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(AMOADD, yystack_[7].value.as < std::uint32_t > (), yystack_[2].value.as < std::uint32_t > (), yystack_[5].value.as < std::uint32_t > ()); }
     break;
 
-  case 86:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(ADDI, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
+  case 86: // statement: AMOSWAP REGISTER ',' REGISTER ',' '(' REGISTER ')' end_of_statement
+                                                                              { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(AMOSWAP, yystack_[7].value.as < std::uint32_t > (), yystack_[2].value.as < std::uint32_t > (), yystack_[5].value.as < std::uint32_t > ()); }
     break;
 
-  case 87:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(JALR, yystack_[1].value.as < std::uint32_t > (), kasm::RA); }
+  case 87: // statement: SYNC end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_O(SYNC); }
     break;
 
-  case 88:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(SLL, kasm::ZERO, kasm::ZERO, 0); }
+  case 88: // statement: COPY REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(OR, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > (), kasm::ZERO); }
     break;
 
-  case 89:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRA(BEQ, kasm::ZERO, kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 89: // statement: CLR REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(OR, yystack_[1].value.as < std::uint32_t > (), kasm::ZERO, kasm::ZERO); }
     break;
 
-  case 90:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(BGEZAL, kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 90: // statement: ADD REGISTER ',' REGISTER ',' LITERAL end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(ADDI, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); }
     break;
 
-  case 91:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLT, kasm::AT, yystack_[3].value.as < std::uint32_t > (), yystack_[5].value.as < std::uint32_t > ()); INSTRUCTION_RRA(BNE, kasm::AT, kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 91: // statement: JALR REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(JALR, yystack_[1].value.as < std::uint32_t > (), kasm::RA); }
     break;
 
-  case 92:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLT, kasm::AT, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > ()); INSTRUCTION_RRA(BNE, kasm::AT, kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 92: // statement: NOP end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(SLL, kasm::ZERO, kasm::ZERO, 0); }
     break;
 
-  case 93:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLT, kasm::AT, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > ()); INSTRUCTION_RRA(BEQ, kasm::AT, kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 93: // statement: B direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRA(BEQ, kasm::ZERO, kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 94:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLT, kasm::AT, yystack_[3].value.as < std::uint32_t > (), yystack_[5].value.as < std::uint32_t > ()); INSTRUCTION_RRA(BEQ, kasm::AT, kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 94: // statement: BAL direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RA(BGEZAL, kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 95:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLTU, kasm::AT, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > ()); INSTRUCTION_RRA(BEQ, kasm::AT, kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 95: // statement: BGT REGISTER ',' REGISTER ',' direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLT, kasm::AT, yystack_[3].value.as < std::uint32_t > (), yystack_[5].value.as < std::uint32_t > ()); INSTRUCTION_RRA(BNE, kasm::AT, kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 96:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRA(BEQ, yystack_[3].value.as < std::uint32_t > (), kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 96: // statement: BLT REGISTER ',' REGISTER ',' direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLT, kasm::AT, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > ()); INSTRUCTION_RRA(BNE, kasm::AT, kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 97:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(ORI, kasm::AT, kasm::ZERO, yystack_[3].value.as < std::uint32_t > ()); INSTRUCTION_RRA(BEQ, yystack_[5].value.as < std::uint32_t > (), kasm::AT, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 97: // statement: BGE REGISTER ',' REGISTER ',' direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLT, kasm::AT, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > ()); INSTRUCTION_RRA(BEQ, kasm::AT, kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 98:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(ORI, kasm::AT, kasm::ZERO, yystack_[3].value.as < std::uint32_t > ()); INSTRUCTION_RRA(BNE, yystack_[5].value.as < std::uint32_t > (), kasm::AT, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
+  case 98: // statement: BLE REGISTER ',' REGISTER ',' direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLT, kasm::AT, yystack_[3].value.as < std::uint32_t > (), yystack_[5].value.as < std::uint32_t > ()); INSTRUCTION_RRA(BEQ, kasm::AT, kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 99:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(MULT, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); INSTRUCTION_R(MFLO, yystack_[5].value.as < std::uint32_t > ()); }
+  case 99: // statement: BGTU REGISTER ',' REGISTER ',' direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(SLTU, kasm::AT, yystack_[5].value.as < std::uint32_t > (), yystack_[3].value.as < std::uint32_t > ()); INSTRUCTION_RRA(BEQ, kasm::AT, kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 100:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(DIV, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); INSTRUCTION_R(MFLO, yystack_[5].value.as < std::uint32_t > ()); }
+  case 100: // statement: BEQZ REGISTER ',' direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRA(BEQ, yystack_[3].value.as < std::uint32_t > (), kasm::ZERO, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 101:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(DIV, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); INSTRUCTION_R(MFHI, yystack_[5].value.as < std::uint32_t > ()); }
+  case 101: // statement: BEQ REGISTER ',' LITERAL ',' direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(ORI, kasm::AT, kasm::ZERO, yystack_[3].value.as < std::uint32_t > ()); INSTRUCTION_RRA(BEQ, yystack_[5].value.as < std::uint32_t > (), kasm::AT, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 102:
-    { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(NOR, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > (), kasm::ZERO); }
+  case 102: // statement: BNE REGISTER ',' LITERAL ',' direct_address end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRL(ORI, kasm::AT, kasm::ZERO, yystack_[3].value.as < std::uint32_t > ()); INSTRUCTION_RRA(BNE, yystack_[5].value.as < std::uint32_t > (), kasm::AT, yystack_[1].value.as < kasm::AddressData > (), DirectAddressOffset); }
     break;
 
-  case 103:
-    {
+  case 103: // statement: MULT REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(MULT, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); INSTRUCTION_R(MFLO, yystack_[5].value.as < std::uint32_t > ()); }
+    break;
+
+  case 104: // statement: DIV REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(DIV, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); INSTRUCTION_R(MFLO, yystack_[5].value.as < std::uint32_t > ()); }
+    break;
+
+  case 105: // statement: REM REGISTER ',' REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RR(DIV, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > ()); INSTRUCTION_R(MFHI, yystack_[5].value.as < std::uint32_t > ()); }
+    break;
+
+  case 106: // statement: NOT REGISTER ',' REGISTER end_of_statement
+                                                                           { yylhs.value.as < std::uint32_t > () = GET_LOC(); INSTRUCTION_RRR(NOR, yystack_[3].value.as < std::uint32_t > (), yystack_[1].value.as < std::uint32_t > (), kasm::ZERO); }
+    break;
+
+  case 107: // statement: PUSHW REGISTER end_of_statement
+        {
 		yylhs.value.as < std::uint32_t > () = GET_LOC();
 		INSTRUCTION_RRL(ADDI, kasm::Register::SP, kasm::Register::SP, -kasm::INSTRUCTION_SIZE);
 		INSTRUCTION_RA(SW, yystack_[1].value.as < std::uint32_t > (), stackAddress, IndirectAddressOffset);
 	}
     break;
 
-  case 104:
-    {
+  case 108: // statement: POPW REGISTER end_of_statement
+        {
 		yylhs.value.as < std::uint32_t > () = GET_LOC();
 		INSTRUCTION_RA(LW, yystack_[1].value.as < std::uint32_t > (), stackAddress, IndirectAddressOffset);
 		INSTRUCTION_RRL(ADDI, kasm::Register::SP, kasm::Register::SP, kasm::INSTRUCTION_SIZE);
 	}
     break;
 
-  case 105:
-    {
+  case 109: // statement: PUSHB REGISTER end_of_statement
+        {
 		yylhs.value.as < std::uint32_t > () = GET_LOC();
 		INSTRUCTION_RRL(ADDI, kasm::Register::SP, kasm::Register::SP, -1);
 		INSTRUCTION_RA(SB, yystack_[1].value.as < std::uint32_t > (), stackAddress, IndirectAddressOffset);
 	}
     break;
 
-  case 106:
-    {
+  case 110: // statement: POPB REGISTER end_of_statement
+        {
 		yylhs.value.as < std::uint32_t > () = GET_LOC();
 		INSTRUCTION_RA(LB, yystack_[1].value.as < std::uint32_t > (), stackAddress, IndirectAddressOffset);
 		INSTRUCTION_RRL(ADDI, kasm::Register::SP, kasm::Register::SP, 1);
 	}
     break;
 
-  case 107:
-    {
+  case 111: // statement: ENTER end_of_statement
+        {
 		yylhs.value.as < std::uint32_t > () = GET_LOC();
 		INSTRUCTION_RRL(ADDI, kasm::Register::SP, kasm::Register::SP, -kasm::INSTRUCTION_SIZE);
 		INSTRUCTION_RA(SW, kasm::Register::RA, stackAddress, IndirectAddressOffset);
@@ -4335,8 +4761,8 @@ namespace yy {
 	}
     break;
 
-  case 108:
-    {
+  case 112: // statement: RET end_of_statement
+        {
 		yylhs.value.as < std::uint32_t > () = GET_LOC();
 		INSTRUCTION_RRL(OR, kasm::Register::SP, kasm::Register::FP, kasm::ZERO);
 		INSTRUCTION_RA(LW, kasm::Register::FP, stackAddress, IndirectAddressOffset);
@@ -4347,15 +4773,15 @@ namespace yy {
 	}
     break;
 
-  case 109:
-    {
+  case 113: // statement: CALL direct_address end_of_statement
+        {
 		yylhs.value.as < std::uint32_t > () = GET_LOC();
 		INSTRUCTION_A(JAL, yystack_[1].value.as < kasm::AddressData > (), DirectAddressAbsolute);
 	}
     break;
 
-  case 110:
-    {
+  case 114: // statement: LI REGISTER ',' LITERAL end_of_statement
+        {
 		yylhs.value.as < std::uint32_t > () = GET_LOC(); 
 		SplitWord l = {yystack_[1].value.as < std::uint32_t > ()};
 		if (l.hi)
@@ -4370,8 +4796,8 @@ namespace yy {
 	}
     break;
 
-  case 111:
-    {
+  case 115: // statement: LA REGISTER ',' direct_address end_of_statement
+        {
 		yylhs.value.as < std::uint32_t > () = GET_LOC(); 
 		yystack_[1].value.as < kasm::AddressData > ().type = kasm::AddressType::DirectAddressAbsoluteLoad;
 		yystack_[1].value.as < kasm::AddressData > ().reg = yystack_[3].value.as < std::uint32_t > ();
@@ -4383,64 +4809,64 @@ namespace yy {
 	}
     break;
 
-  case 112:
-    { yylhs.value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > () = yystack_[0].value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > (); }
+  case 116: // literal_argument: literal_list
+                                 { yylhs.value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > () = yystack_[0].value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > (); }
     break;
 
-  case 113:
-    { yylhs.value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > () = std::vector<std::variant<std::uint32_t, kasm::AddressData>>(yystack_[0].value.as < std::uint32_t > (), yystack_[2].value.as < std::uint32_t > ()); }
+  case 117: // literal_argument: LITERAL ':' LITERAL
+                                 { yylhs.value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > () = std::vector<std::variant<std::uint32_t, kasm::AddressData>>(yystack_[0].value.as < std::uint32_t > (), yystack_[2].value.as < std::uint32_t > ()); }
     break;
 
-  case 114:
-    { yylhs.value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > () = std::vector<std::variant<std::uint32_t, kasm::AddressData>>(yystack_[0].value.as < std::uint32_t > (), kasm::AddressData(yystack_[2].value.as < std::string > ())); }
+  case 118: // literal_argument: IDENTIFIER ':' LITERAL
+                                 { yylhs.value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > () = std::vector<std::variant<std::uint32_t, kasm::AddressData>>(yystack_[0].value.as < std::uint32_t > (), kasm::AddressData(yystack_[2].value.as < std::string > ())); }
     break;
 
-  case 115:
-    { yylhs.value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > () = {yystack_[0].value.as < std::uint32_t > ()}; }
+  case 119: // literal_list: LITERAL
+                                  { yylhs.value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > () = {yystack_[0].value.as < std::uint32_t > ()}; }
     break;
 
-  case 116:
-    { yylhs.value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > () = {yystack_[0].value.as < std::string > ()}; }
+  case 120: // literal_list: IDENTIFIER
+                                      { yylhs.value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > () = {yystack_[0].value.as < std::string > ()}; }
     break;
 
-  case 117:
-    { yystack_[2].value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > ().push_back(yystack_[0].value.as < std::uint32_t > ()); yylhs.value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > () = yystack_[2].value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > (); }
+  case 121: // literal_list: literal_list ',' LITERAL
+                                  { yystack_[2].value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > ().push_back(yystack_[0].value.as < std::uint32_t > ()); yylhs.value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > () = yystack_[2].value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > (); }
     break;
 
-  case 118:
-    { yystack_[2].value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > ().push_back(kasm::AddressData(yystack_[0].value.as < std::string > ())); yylhs.value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > () = yystack_[2].value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > (); }
+  case 122: // literal_list: literal_list ',' IDENTIFIER
+                                      { yystack_[2].value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > ().push_back(kasm::AddressData(yystack_[0].value.as < std::string > ())); yylhs.value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > () = yystack_[2].value.as < std::vector<std::variant<std::uint32_t, kasm::AddressData>> > (); }
     break;
 
-  case 119:
-    { yylhs.value.as < std::vector<std::string> > () = yystack_[0].value.as < std::vector<std::string> > (); }
+  case 123: // identifier_list: identifier_list_not_empty
+                                    { yylhs.value.as < std::vector<std::string> > () = yystack_[0].value.as < std::vector<std::string> > (); }
     break;
 
-  case 120:
-    { yylhs.value.as < std::vector<std::string> > () = std::vector<std::string>(); }
+  case 124: // identifier_list: %empty
+                 { yylhs.value.as < std::vector<std::string> > () = std::vector<std::string>(); }
     break;
 
-  case 121:
-    { yylhs.value.as < std::vector<std::string> > () = { yystack_[0].value.as < std::string > () }; }
+  case 125: // identifier_list_not_empty: IDENTIFIER
+                     { yylhs.value.as < std::vector<std::string> > () = { yystack_[0].value.as < std::string > () }; }
     break;
 
-  case 122:
-    { yystack_[2].value.as < std::vector<std::string> > ().push_back(yystack_[0].value.as < std::string > ()); yylhs.value.as < std::vector<std::string> > () = yystack_[2].value.as < std::vector<std::string> > (); }
+  case 126: // identifier_list_not_empty: identifier_list ',' IDENTIFIER
+                                         { yystack_[2].value.as < std::vector<std::string> > ().push_back(yystack_[0].value.as < std::string > ()); yylhs.value.as < std::vector<std::string> > () = yystack_[2].value.as < std::vector<std::string> > (); }
     break;
 
-  case 123:
-    {
+  case 127: // direct_address: IDENTIFIER
+        {
 		kasm::AddressData addr;
 		addr.label = yystack_[0].value.as < std::string > ();
 		yylhs.value.as < kasm::AddressData > () = addr;
 	}
     break;
 
-  case 124:
-    { yylhs.value.as < kasm::AddressData > () = yystack_[0].value.as < kasm::AddressData > (); }
+  case 128: // address: direct_address
+                         { yylhs.value.as < kasm::AddressData > () = yystack_[0].value.as < kasm::AddressData > (); }
     break;
 
-  case 125:
-    {
+  case 129: // address: IDENTIFIER '+' LITERAL
+        {
 		kasm::AddressData addr;
 		addr.label = yystack_[2].value.as < std::string > ();
 		addr.offset = yystack_[0].value.as < std::uint32_t > ();
@@ -4448,16 +4874,16 @@ namespace yy {
 	}
     break;
 
-  case 126:
-    {
+  case 130: // address: '(' REGISTER ')'
+        {
 		kasm::AddressData addr;
 		addr.reg = yystack_[1].value.as < std::uint32_t > ();
 		yylhs.value.as < kasm::AddressData > () = addr;
 	}
     break;
 
-  case 127:
-    {
+  case 131: // address: LITERAL '(' REGISTER ')'
+        {
 		kasm::AddressData addr;
 		addr.offset = yystack_[3].value.as < std::uint32_t > ();
 		addr.reg = yystack_[1].value.as < std::uint32_t > ();
@@ -4465,8 +4891,8 @@ namespace yy {
 	}
     break;
 
-  case 128:
-    {
+  case 132: // address: IDENTIFIER '(' REGISTER ')'
+        {
 		kasm::AddressData addr;
 		addr.label = yystack_[3].value.as < std::string > ();
 		addr.reg = yystack_[1].value.as < std::uint32_t > ();
@@ -4474,8 +4900,8 @@ namespace yy {
 	}
     break;
 
-  case 129:
-    {
+  case 133: // address: IDENTIFIER '+' LITERAL '(' REGISTER ')'
+        {
 		kasm::AddressData addr;
 		addr.label = yystack_[5].value.as < std::string > ();
 		addr.offset = yystack_[3].value.as < std::uint32_t > ();
@@ -4501,7 +4927,6 @@ namespace yy {
       YY_SYMBOL_PRINT ("-> $$ =", yylhs);
       yypop_ (yylen);
       yylen = 0;
-      YY_STACK_PRINT ();
 
       // Shift the result of the reduction.
       yypush_ (YY_NULLPTR, YY_MOVE (yylhs));
@@ -4517,7 +4942,9 @@ namespace yy {
     if (!yyerrstatus_)
       {
         ++yynerrs_;
-        error (yyla.location, yysyntax_error_ (yystack_[0].state, yyla));
+        context yyctx (*this, yyla);
+        std::string msg = yysyntax_error_ (yyctx);
+        error (yyla.location, YY_MOVE (msg));
       }
 
 
@@ -4528,7 +4955,7 @@ namespace yy {
            error, discard it.  */
 
         // Return failure if at end of input.
-        if (yyla.type_get () == yyeof_)
+        if (yyla.kind () == symbol_kind::S_YYEOF)
           YYABORT;
         else if (!yyla.empty ())
           {
@@ -4554,6 +4981,7 @@ namespace yy {
        this YYERROR.  */
     yypop_ (yylen);
     yylen = 0;
+    YY_STACK_PRINT ();
     goto yyerrlab1;
 
 
@@ -4562,37 +4990,39 @@ namespace yy {
   `-------------------------------------------------------------*/
   yyerrlab1:
     yyerrstatus_ = 3;   // Each real token shifted decrements this.
-    {
-      stack_symbol_type error_token;
-      for (;;)
-        {
-          yyn = yypact_[yystack_[0].state];
-          if (!yy_pact_value_is_default_ (yyn))
-            {
-              yyn += yyterror_;
-              if (0 <= yyn && yyn <= yylast_ && yycheck_[yyn] == yyterror_)
-                {
-                  yyn = yytable_[yyn];
-                  if (0 < yyn)
-                    break;
-                }
-            }
+    // Pop stack until we find a state that shifts the error token.
+    for (;;)
+      {
+        yyn = yypact_[+yystack_[0].state];
+        if (!yy_pact_value_is_default_ (yyn))
+          {
+            yyn += symbol_kind::S_YYerror;
+            if (0 <= yyn && yyn <= yylast_
+                && yycheck_[yyn] == symbol_kind::S_YYerror)
+              {
+                yyn = yytable_[yyn];
+                if (0 < yyn)
+                  break;
+              }
+          }
 
-          // Pop the current state because it cannot handle the error token.
-          if (yystack_.size () == 1)
-            YYABORT;
+        // Pop the current state because it cannot handle the error token.
+        if (yystack_.size () == 1)
+          YYABORT;
 
-          yyerror_range[1].location = yystack_[0].location;
-          yy_destroy_ ("Error: popping", yystack_[0]);
-          yypop_ ();
-          YY_STACK_PRINT ();
-        }
+        yyerror_range[1].location = yystack_[0].location;
+        yy_destroy_ ("Error: popping", yystack_[0]);
+        yypop_ ();
+        YY_STACK_PRINT ();
+      }
+    {
+      stack_symbol_type error_token;
 
       yyerror_range[2].location = yyla.location;
       YYLLOC_DEFAULT (error_token.location, yyerror_range, 2);
 
       // Shift the error token.
-      error_token.state = yyn;
+      error_token.state = state_type (yyn);
       yypush_ ("Shifting", YY_MOVE (error_token));
     }
     goto yynewstate;
@@ -4624,6 +5054,7 @@ namespace yy {
     /* Do not reclaim the symbols of the rule whose action triggered
        this YYABORT or YYACCEPT.  */
     yypop_ (yylen);
+    YY_STACK_PRINT ();
     while (1 < yystack_.size ())
       {
         yy_destroy_ ("Cleanup: popping", yystack_[0]);
@@ -4657,18 +5088,103 @@ namespace yy {
     error (yyexc.location, yyexc.what ());
   }
 
-  // Generate an error message.
+  /* Return YYSTR after stripping away unnecessary quotes and
+     backslashes, so that it's suitable for yyerror.  The heuristic is
+     that double-quoting is unnecessary unless the string contains an
+     apostrophe, a comma, or backslash (other than backslash-backslash).
+     YYSTR is taken from yytname.  */
   std::string
-  parser::yysyntax_error_ (state_type yystate, const symbol_type& yyla) const
+  parser::yytnamerr_ (const char *yystr)
   {
-    // Number of reported tokens (one for the "unexpected", one per
-    // "expected").
-    size_t yycount = 0;
-    // Its maximum.
-    enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-    // Arguments of yyformat.
-    char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
+    if (*yystr == '"')
+      {
+        std::string yyr;
+        char const *yyp = yystr;
+
+        for (;;)
+          switch (*++yyp)
+            {
+            case '\'':
+            case ',':
+              goto do_not_strip_quotes;
+
+            case '\\':
+              if (*++yyp != '\\')
+                goto do_not_strip_quotes;
+              else
+                goto append;
+
+            append:
+            default:
+              yyr += *yyp;
+              break;
+
+            case '"':
+              return yyr;
+            }
+      do_not_strip_quotes: ;
+      }
+
+    return yystr;
+  }
+
+  std::string
+  parser::symbol_name (symbol_kind_type yysymbol)
+  {
+    return yytnamerr_ (yytname_[yysymbol]);
+  }
+
+
+
+  // parser::context.
+  parser::context::context (const parser& yyparser, const symbol_type& yyla)
+    : yyparser_ (yyparser)
+    , yyla_ (yyla)
+  {}
+
+  int
+  parser::context::expected_tokens (symbol_kind_type yyarg[], int yyargn) const
+  {
+    // Actual number of expected tokens
+    int yycount = 0;
+
+    const int yyn = yypact_[+yyparser_.yystack_[0].state];
+    if (!yy_pact_value_is_default_ (yyn))
+      {
+        /* Start YYX at -YYN if negative to avoid negative indexes in
+           YYCHECK.  In other words, skip the first -YYN actions for
+           this state because they are default actions.  */
+        const int yyxbegin = yyn < 0 ? -yyn : 0;
+        // Stay within bounds of both yycheck and yytname.
+        const int yychecklim = yylast_ - yyn + 1;
+        const int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+        for (int yyx = yyxbegin; yyx < yyxend; ++yyx)
+          if (yycheck_[yyx + yyn] == yyx && yyx != symbol_kind::S_YYerror
+              && !yy_table_value_is_error_ (yytable_[yyx + yyn]))
+            {
+              if (!yyarg)
+                ++yycount;
+              else if (yycount == yyargn)
+                return 0;
+              else
+                yyarg[yycount++] = YY_CAST (symbol_kind_type, yyx);
+            }
+      }
+
+    if (yyarg && yycount == 0 && 0 < yyargn)
+      yyarg[0] = symbol_kind::S_YYEMPTY;
+    return yycount;
+  }
+
+
 
+
+
+
+  int
+  parser::yy_syntax_error_arguments_ (const context& yyctx,
+                                                 symbol_kind_type yyarg[], int yyargn) const
+  {
     /* There are many possibilities here to consider:
        - If this state is a consistent state with a default action, then
          the only way this function was invoked is if the default action
@@ -4687,41 +5203,32 @@ namespace yy {
        - Of course, the expected token list depends on states to have
          correct lookahead information, and it depends on the parser not
          to perform extra reductions after fetching a lookahead from the
-         scanner and before detecting a syntax error.  Thus, state
-         merging (from LALR or IELR) and default reductions corrupt the
-         expected token list.  However, the list is correct for
-         canonical LR with one exception: it will still contain any
-         token that will not be accepted due to an error action in a
-         later state.
+         scanner and before detecting a syntax error.  Thus, state merging
+         (from LALR or IELR) and default reductions corrupt the expected
+         token list.  However, the list is correct for canonical LR with
+         one exception: it will still contain any token that will not be
+         accepted due to an error action in a later state.
     */
-    if (!yyla.empty ())
+
+    if (!yyctx.lookahead ().empty ())
       {
-        int yytoken = yyla.type_get ();
-        yyarg[yycount++] = yytname_[yytoken];
-        int yyn = yypact_[yystate];
-        if (!yy_pact_value_is_default_ (yyn))
-          {
-            /* Start YYX at -YYN if negative to avoid negative indexes in
-               YYCHECK.  In other words, skip the first -YYN actions for
-               this state because they are default actions.  */
-            int yyxbegin = yyn < 0 ? -yyn : 0;
-            // Stay within bounds of both yycheck and yytname.
-            int yychecklim = yylast_ - yyn + 1;
-            int yyxend = yychecklim < yyntokens_ ? yychecklim : yyntokens_;
-            for (int yyx = yyxbegin; yyx < yyxend; ++yyx)
-              if (yycheck_[yyx + yyn] == yyx && yyx != yyterror_
-                  && !yy_table_value_is_error_ (yytable_[yyx + yyn]))
-                {
-                  if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                    {
-                      yycount = 1;
-                      break;
-                    }
-                  else
-                    yyarg[yycount++] = yytname_[yyx];
-                }
-          }
+        if (yyarg)
+          yyarg[0] = yyctx.token ();
+        int yyn = yyctx.expected_tokens (yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+        return yyn + 1;
       }
+    return 0;
+  }
+
+  // Generate an error message.
+  std::string
+  parser::yysyntax_error_ (const context& yyctx) const
+  {
+    // Its maximum.
+    enum { YYARGS_MAX = 5 };
+    // Arguments of yyformat.
+    symbol_kind_type yyarg[YYARGS_MAX];
+    int yycount = yy_syntax_error_arguments_ (yyctx, yyarg, YYARGS_MAX);
 
     char const* yyformat = YY_NULLPTR;
     switch (yycount)
@@ -4742,11 +5249,11 @@ namespace yy {
 
     std::string yyres;
     // Argument number.
-    size_t yyi = 0;
+    std::ptrdiff_t yyi = 0;
     for (char const* yyp = yyformat; *yyp; ++yyp)
       if (yyp[0] == '%' && yyp[1] == 's' && yyi < yycount)
         {
-          yyres += yytnamerr_ (yyarg[yyi++]);
+          yyres += symbol_name (yyarg[yyi++]);
           ++yyp;
         }
       else
@@ -4755,64 +5262,67 @@ namespace yy {
   }
 
 
-  const signed char parser::yypact_ninf_ = -83;
+  const signed char parser::yypact_ninf_ = -87;
 
   const signed char parser::yytable_ninf_ = -1;
 
   const short
   parser::yypact_[] =
   {
-     -83,   521,   -83,   615,   -72,     9,     9,    20,    20,     8,
-      26,    28,    29,    30,    31,    32,     4,    33,    24,     9,
-      34,    36,    37,    38,    39,    40,    41,    42,    45,    46,
-      47,    48,    49,    50,    51,    52,     6,     6,    53,    54,
-      55,    56,    57,    58,    59,    60,    62,    63,    64,    65,
-      66,    67,    68,    69,    70,    71,    72,    73,    74,    75,
-      76,    77,    78,    79,     9,    81,    82,    83,    84,    85,
-      89,    89,    87,    88,    90,    95,    96,    98,    99,   100,
-     101,     9,   102,   104,   106,   107,   108,     9,    89,     9,
-     -83,   -83,   -83,   -83,   -83,   -83,   -83,   -83,   -83,   -59,
-     -54,     9,    -1,     9,     9,     9,     9,     9,     9,     9,
-       9,    21,     9,   -83,   -83,    25,    43,    44,    80,    86,
-      91,    93,   105,   115,   116,   117,   118,   119,   120,   121,
-     122,   -82,    61,   110,   -83,     9,     9,     9,   123,   124,
-     125,     9,     9,   126,   127,   129,   130,   131,   132,   133,
-     134,   135,   136,   137,   138,   139,   140,   141,   142,   143,
-     144,   145,   146,   -83,   147,   148,     1,   149,     9,   -83,
-       9,     9,   150,   151,   153,   154,   156,   157,   158,   159,
-     160,   -83,   161,     9,     9,     9,     9,   -83,     9,   -83,
-     615,   111,   113,   152,   -83,    22,   -83,   -83,   -83,   -83,
-     -83,   -83,   -83,   -83,   162,   -83,   114,   615,   155,   163,
-     164,   165,   166,   167,    10,    89,    89,    89,    89,    89,
-      89,    13,   168,   169,   171,   174,   173,    27,   -83,   -83,
-     -83,     6,   176,     6,   -83,   -83,   175,   177,   178,   179,
-       6,   185,   198,   252,   253,   254,   255,   256,   257,   258,
-     259,   260,   261,   262,   263,     6,   264,   265,   266,   -83,
-     267,   -83,   -83,   -83,   268,   269,   270,   271,   272,    89,
-     273,   276,    89,   278,   -83,   -83,   -83,   -83,   -83,   -83,
-     -83,   -83,   -83,   -83,   -83,   615,   615,   615,   -83,   -66,
-     -83,   615,   -83,   -83,   189,   190,   192,   193,   194,   195,
-     196,   197,     9,     9,     9,     9,     9,     9,   199,   200,
-       2,     9,   202,   204,   205,   -83,     9,     9,     9,     3,
-       9,   203,   206,     9,   207,   208,   209,   210,   211,   212,
-     213,   214,   215,   216,   217,   218,   219,   220,     9,   221,
-     222,     9,     9,   223,   224,   225,   226,   227,     9,   234,
-       9,     9,     9,     9,   -83,   -83,   -83,   292,   298,   -83,
-       9,    14,   327,   330,   329,   331,   332,    89,    89,   -83,
-     -83,   -83,   -83,   -83,   -83,    89,    89,   337,   -83,   -83,
-     -83,   338,   -83,   -83,   -83,   -83,   342,   -83,   -83,   343,
-     346,   -83,   347,   350,   351,   352,   348,   349,   353,   355,
-     356,   361,   362,   363,   365,   370,   -83,   371,   364,   -83,
-     -83,    89,    89,    89,    89,    89,   -83,   372,   -83,   -83,
-     -83,   -83,   -83,   -83,   615,     9,     9,     9,     9,     9,
-       9,     9,     9,     9,     9,     9,     9,   284,     9,     9,
-       9,     9,     9,     9,     9,     9,     9,     9,     9,     9,
-       9,     9,     9,     9,     9,     9,     9,     9,     9,     9,
-       9,     9,     9,   615,   128,   -83,   -83,   -83,   -83,   -83,
-     -83,   -83,   -83,   -83,   -83,   -83,   -83,   -83,   -83,   -83,
-     -83,   -83,   -83,   -83,   -83,   -83,   -83,   -83,   -83,   -83,
-     -83,   -83,   -83,   -83,   -83,   -83,   -83,   -83,   -83,   -83,
-     -83,   -83,   -83,   -83,   -83,   -83,     9,   615,   -83
+     -87,   538,   -87,   636,   -72,    12,    12,    24,    24,    -1,
+       8,    17,    29,    11,    32,    33,    31,    34,    37,    12,
+      35,    36,    38,    39,    40,    41,    42,    43,    44,    45,
+      46,    48,    49,    50,    51,    52,     4,     4,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    63,    64,    65,
+      66,    67,    68,    70,    71,    72,    73,    74,    75,    76,
+      77,    78,    79,    80,    12,    81,    82,    84,    85,    86,
+      87,    12,    88,    90,    95,    95,    93,    94,    98,    99,
+     100,   102,   104,   113,   115,    12,   116,   117,   118,   119,
+     120,    12,    95,    12,   -87,   -87,   -87,   -87,   -87,   -87,
+     -87,   -87,   -87,   -54,    30,    12,    28,    12,    12,    12,
+      12,    12,    12,    12,    12,    62,    12,   -87,   -87,    47,
+      69,    91,    92,   101,   106,   107,   108,   109,   110,   114,
+     121,   122,   123,   124,   125,   -86,    83,   126,   -87,    12,
+      12,    12,   128,   129,   130,    12,    12,   131,   132,   133,
+     134,   135,   136,   137,   138,   139,   140,   142,   143,   145,
+     146,   147,   148,   149,   150,   151,   152,   -87,   153,   154,
+       1,   155,   156,   157,   -87,   158,    12,   -87,    12,    12,
+     159,   160,   161,   162,   163,   164,   165,   166,   167,   -87,
+     168,    12,    12,    12,    12,   -87,    12,   -87,   636,   127,
+     144,   169,   -87,    26,   -87,   -87,   -87,   -87,   -87,   -87,
+     -87,   -87,   172,   -87,   141,   636,   170,   171,   173,   184,
+     187,   193,    13,    95,    95,    95,    95,    95,    95,    14,
+     196,   198,   207,   174,   209,   175,   -87,   -87,   -87,     4,
+     212,     4,   -87,   -87,   211,   213,   214,   220,     4,   263,
+     264,   265,   266,   267,   269,   270,   271,   272,   273,   274,
+     275,   276,   277,     4,   278,   279,   280,   -87,   281,   282,
+     283,   284,   -87,   -87,   -87,   285,   289,   290,   291,   293,
+      95,   294,   297,    95,   296,   -87,   -87,   -87,   -87,   -87,
+     -87,   -87,   -87,   -87,   -87,   -87,   636,   636,   636,   -87,
+     -68,   -87,   636,   -87,   -87,   203,   204,   205,   206,   208,
+     210,   215,   216,    12,    12,    12,    12,    12,    12,   223,
+     224,     3,    12,   228,   230,   231,   -87,    12,    12,    12,
+       7,    12,   229,   236,    12,   237,   239,   240,   241,   244,
+     245,   246,   247,   248,   249,   252,   254,   255,   257,    12,
+     258,   259,    12,   261,   262,   286,    12,   287,   288,   295,
+     298,   299,    12,   300,    12,    12,    12,    12,   -87,   -87,
+     -87,   305,   306,   -87,    12,    18,   307,   308,   357,   358,
+     309,    95,    95,   -87,   -87,   -87,   -87,   -87,   -87,    95,
+      95,   359,   -87,   -87,   -87,   361,   -87,   -87,   -87,   -87,
+     366,   -87,   -87,   367,   310,   -87,   370,   369,   371,   373,
+     372,   376,   375,   377,   378,   381,   390,   391,   395,   396,
+     -87,   397,   392,   -87,   311,   312,   313,   -87,    95,    95,
+      95,    95,    95,   -87,   398,   -87,   -87,   -87,   -87,   -87,
+     -87,   636,    12,    12,    12,    12,    12,    12,    12,    12,
+      12,    12,    12,    12,   314,    12,    12,    12,    12,    12,
+      12,    12,    12,    12,    12,    12,    12,    12,    12,    12,
+      12,    12,    12,    12,   399,   400,   401,    12,    12,    12,
+      12,    12,    12,   636,   403,   -87,   -87,   -87,   -87,   -87,
+     -87,   -87,   -87,   -87,   -87,   -87,   -87,   -87,   -87,   -87,
+     -87,   -87,   -87,   -87,   -87,   -87,   -87,   -87,   -87,   -87,
+     -87,   -87,   -87,   -87,   -87,   -87,   -87,   -87,   315,   316,
+     317,   -87,   -87,   -87,   -87,   -87,   -87,   -87,   -87,    12,
+      12,    12,    12,   -87,   -87,   -87,   636,   -87
   };
 
   const unsigned char
@@ -4827,222 +5337,231 @@ namespace yy {
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       2,     7,     6,     4,    32,   131,   130,     8,     9,   116,
-     115,     0,   112,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,    26,    24,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     2,     7,     6,     4,    32,   135,
+     134,     8,     9,   120,   119,     0,   116,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    26,    24,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,   123,     0,     0,   124,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,   127,     0,     0,   128,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,    79,     0,     0,     0,     0,     0,   123,
+       0,     0,     0,     0,     0,     0,     0,    79,     0,     0,
+       0,     0,     0,     0,    87,     0,     0,   127,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,    92,
+       0,     0,     0,     0,     0,   112,     0,   111,     0,     0,
+       0,     0,    10,     0,    11,    12,    13,    14,    15,    16,
+      18,    20,   124,    22,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,    88,     0,     0,     0,     0,     0,   108,     0,   107,
-       0,     0,     0,     0,    10,     0,    11,    12,    13,    14,
-      15,    16,    18,    20,   120,    22,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,    52,    53,    54,     0,
+       0,     0,    58,    59,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,    52,    53,
-      54,     0,     0,     0,    58,    59,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    91,     0,     0,
+       0,     0,    89,    93,    94,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,   107,   108,   109,   110,   113,
+       5,    33,   118,   117,   122,   121,     0,     0,     0,   125,
+       0,   123,     0,    27,    25,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,    87,
-       0,    85,    89,    90,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,   103,   104,   105,   106,   109,     5,
-      33,   114,   113,   118,   117,     0,     0,     0,   121,     0,
-     119,     0,    27,    25,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,   129,     0,   130,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,   125,     0,   126,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    17,    19,
+      21,     0,     0,    23,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    43,    44,    45,    46,    47,    48,     0,
+       0,     0,    50,    51,   132,     0,   131,    55,    56,    57,
+       0,    60,    61,     0,     0,    64,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,    17,    19,    21,     0,     0,    23,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,    43,
-      44,    45,    46,    47,    48,     0,     0,     0,    50,    51,
-     128,     0,   127,    55,    56,    57,     0,    60,    61,     0,
-       0,    64,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,    78,     0,     0,    82,
-      84,     0,     0,     0,     0,     0,    96,     0,   110,   111,
-     102,    34,    29,   122,     0,     0,     0,     0,     0,     0,
+      78,     0,     0,    82,     0,     0,     0,    88,     0,     0,
+       0,     0,     0,   100,     0,   114,   115,   106,    34,    29,
+     126,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,    28,    86,    36,    37,    38,
-      39,    40,    41,    97,    42,    98,    49,   100,   129,    99,
+       0,     0,     0,     0,     0,    28,    90,    36,    37,    38,
+      39,    40,    41,   101,    42,   102,    49,   104,   133,   103,
       62,    63,    65,    66,    83,    67,    68,    69,    70,    71,
-      72,    73,    74,    75,    76,    77,    80,    81,    91,    92,
-      93,    94,    95,   101,    35,    30,     0,     0,    31
+      72,    73,    74,    75,    76,    77,    80,    81,     0,     0,
+       0,    95,    96,    97,    98,    99,   105,    35,    30,     0,
+       0,     0,     0,    84,    85,    86,     0,    31
   };
 
   const short
   parser::yypgoto_[] =
   {
-     -83,   -83,    -3,   -83,   -83,   -83,   -83,   -83,   -83,   -83,
-     -83,   -83,   -83,   -83,   -83,   -83,   360,   -83,   -83,   -83,
-     -20,   -30,    23
+     -87,   -87,    -3,   -87,   -87,   -87,   -87,   -87,   -87,   -87,
+     -87,   -87,   -87,   -87,   -87,   -87,   405,   -87,   -87,   -87,
+     -38,   -35,     5
   };
 
   const short
   parser::yydefgoto_[] =
   {
-      -1,     1,    90,   190,   285,   286,   287,   291,   207,   206,
-     360,   464,   506,   191,   353,   463,   101,   102,   289,   290,
-     134,   135,    97
+       0,     1,    94,   198,   296,   297,   298,   302,   215,   214,
+     374,   484,   532,   199,   367,   483,   105,   106,   300,   301,
+     138,   139,   101
   };
 
-  const unsigned short
+  const short
   parser::yytable_[] =
   {
-      92,    95,    95,    95,    96,    96,    96,   136,   111,    95,
-     131,   132,    96,   224,   104,   300,   225,   301,   308,   425,
-     309,   426,    93,    94,    99,   100,   283,   284,   113,    98,
-     357,   358,   105,   106,   107,   192,   108,   109,   110,   112,
-     193,   115,   114,   116,   117,   118,   119,   120,   121,   122,
-     170,   171,   123,   124,   125,   126,   127,   128,   129,   130,
-     137,   138,   139,   140,   141,   142,   143,   144,   188,   145,
-     146,   147,   148,   149,   150,   151,   152,   153,   154,   155,
-     156,   157,   158,   159,   160,   161,   162,   163,   164,   165,
-     166,   167,   168,   169,   172,   173,   195,   174,   258,   377,
-     386,   133,   175,   176,   181,   177,   178,   179,   180,   182,
-     187,   183,   189,   184,   185,   186,   204,   227,   281,   280,
-     292,     0,   208,   315,   194,     0,   196,   197,   198,   199,
-     200,   201,   202,   203,   505,   205,     0,     0,     0,     0,
-     209,   210,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,   226,   282,   228,   229,
-     230,     0,   294,     0,   234,   235,   288,     0,     0,     0,
-     295,   296,   297,   298,   299,   310,   311,   211,   312,   313,
-     314,   317,   319,   212,   320,   321,   322,   279,   213,   259,
-     214,   261,   324,   262,   263,   302,   303,   304,   305,   306,
-     307,   316,   215,   318,   293,   325,   274,   275,   276,   277,
-     323,   278,   216,   217,   218,   219,   220,   221,   222,   223,
-     231,   232,   233,   236,   237,   338,   238,   239,   240,   241,
-     242,   243,   244,   245,   246,   247,   248,   249,   250,   251,
-     252,   253,   254,   255,   256,   257,   260,   264,   265,   348,
-     266,   267,   351,   268,   269,   270,   271,   272,   273,   326,
-     327,   328,   329,   330,   331,   332,   333,   334,   335,   336,
-     337,   339,   340,   341,   342,   343,   344,   345,   346,   347,
-     349,   350,   354,   355,   356,   352,   361,   362,   359,   363,
-     364,   365,   366,   367,   368,   422,   375,   376,   380,   381,
-     389,   382,   423,   390,   392,   393,   394,   395,   396,   397,
-     398,   399,   400,   401,   402,   403,   404,   405,   407,   408,
-     411,   412,   413,   414,   415,   369,   370,   371,   372,   373,
-     374,   417,   427,   378,   379,   428,   429,   431,   430,   383,
-     384,   385,   387,   388,   436,   437,   391,   432,   433,   438,
-     439,   440,   441,   445,   446,   434,   435,   442,   443,   444,
-     447,   406,   448,   449,   409,   410,   450,   451,   103,   456,
-     452,   416,   453,   418,   419,   420,   421,   454,   455,   462,
-     478,     0,     0,   424,     0,     0,     0,     0,     0,     0,
-       0,   457,   458,   459,   460,   461,     0,     0,     0,     0,
+      96,    99,   140,    99,   100,   108,   100,    99,   135,   136,
+     100,   102,    99,   232,   109,   100,   233,   112,   311,   319,
+     312,   320,   110,   442,   118,   443,    97,    98,   103,   104,
+     294,   295,   371,   372,   111,   115,   178,   179,   113,   114,
+     116,   117,   119,   120,   200,   121,   122,   123,   124,   125,
+     126,   127,   128,   129,   196,   130,   131,   132,   133,   134,
+     141,   142,   143,   144,   145,   146,   147,   148,   149,   167,
+     150,   151,   152,   153,   154,   155,   174,   156,   157,   158,
+     159,   160,   161,   162,   163,   164,   165,   166,   168,   169,
+     189,   170,   171,   172,   173,   175,   195,   176,   197,   177,
+     180,   181,   266,   137,   391,   182,   183,   184,   400,   185,
+     202,   186,   204,   205,   206,   207,   208,   209,   210,   211,
+     187,   213,   188,   190,   191,   192,   193,   194,   201,   203,
+       0,     0,     0,   235,     0,   291,     0,     0,     0,     0,
+       0,     0,     0,     0,   236,   237,   238,   303,   216,   292,
+     242,   243,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,   212,     0,     0,     0,     0,     0,     0,     0,     0,
+     217,     0,     0,     0,   293,   267,   299,   305,   306,   324,
+     307,   272,   234,   273,   274,   313,   314,   315,   316,   317,
+     318,   308,   218,   219,   309,   290,   285,   286,   287,   288,
+     310,   289,   220,   321,   327,   322,   329,   221,   222,   223,
+     224,   225,   304,   334,   323,   226,   325,   328,   330,     0,
+     331,   332,   227,   228,   229,   230,   231,   333,   349,   239,
+     240,   241,   244,   245,   246,   247,   248,   249,   250,   251,
+     252,   253,   362,   254,   255,   365,   256,   257,   258,   259,
+     260,   261,   262,   263,   264,   265,   268,   269,   270,   271,
+     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
+     335,   336,   337,   338,   339,   326,   340,   341,   342,   343,
+     344,   345,   346,   347,   348,   350,   351,   352,   353,   354,
+     355,   356,   357,   368,   369,   370,   358,   359,   360,   373,
+     361,   363,   364,   366,   375,   376,   377,   378,   439,   379,
+     440,   380,   444,   445,   448,   457,   381,   382,   383,   384,
+     385,   386,   387,   388,   389,   390,   392,   393,   394,   395,
+     403,   396,   397,   398,   399,   401,   402,   404,   406,   405,
+     407,   408,   409,   449,   450,   410,   411,   412,   413,   414,
+     415,   451,   452,   416,   420,   417,   418,   423,   419,   421,
+     422,   427,   424,   425,   446,   447,   453,   433,   454,   435,
+     436,   437,   438,   455,   456,   458,   459,   462,   460,   441,
+     461,   463,   464,     0,   465,   466,   467,   426,   428,   429,
+     477,   478,   479,   480,   481,   468,   430,   473,   469,   431,
+     432,   434,   470,   471,   472,   482,   518,   519,   520,   528,
+     474,   475,   476,   107,   498,   529,   530,   531,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   485,     0,
+       0,     0,     0,     0,     0,     0,     0,   486,   487,   488,
+     489,   490,   491,   492,   493,   494,   495,   496,   497,     0,
+     499,   500,   501,   502,   503,   504,   505,   506,   507,   508,
+     509,   510,   511,   512,   513,   514,   515,   516,   517,     0,
+     527,     0,   521,   522,   523,   524,   525,   526,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,   465,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,   466,   467,
-     468,   469,   470,   471,   472,   473,   474,   475,   476,   477,
-     504,   479,   480,   481,   482,   483,   484,   485,   486,   487,
-     488,   489,   490,   491,   492,   493,   494,   495,   496,   497,
-     498,   499,   500,   501,   502,   503,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,   508,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     2,     0,     0,     3,     4,     0,     0,     0,   507,
-       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
-      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
-      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
-      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
-      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
-      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
-      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
-      75,    76,    77,    78,    79,    80,    81,    82,    83,    84,
-      85,    86,    87,    88,    89,    91,     0,     0,     3,     4,
-       0,     0,     0,     0,     5,     6,     7,     8,     9,    10,
-      11,    12,    13,    14,    15,    16,    17,    18,    19,    20,
-      21,    22,    23,    24,    25,    26,    27,    28,    29,    30,
-      31,    32,    33,    34,    35,    36,    37,    38,    39,    40,
-      41,    42,    43,    44,    45,    46,    47,    48,    49,    50,
-      51,    52,    53,    54,    55,    56,    57,    58,    59,    60,
-      61,    62,    63,    64,    65,    66,    67,    68,    69,    70,
-      71,    72,    73,    74,    75,    76,    77,    78,    79,    80,
-      81,    82,    83,    84,    85,    86,    87,    88,    89
+       0,     0,     0,   537,   533,   534,   535,   536,     2,     0,
+       0,     3,     4,     0,     0,     0,     0,     5,     6,     7,
+       8,     9,    10,    11,    12,    13,    14,    15,    16,    17,
+      18,    19,    20,    21,    22,    23,    24,    25,    26,    27,
+      28,    29,    30,    31,    32,    33,    34,    35,    36,    37,
+      38,    39,    40,    41,    42,    43,    44,    45,    46,    47,
+      48,    49,    50,    51,    52,    53,    54,    55,    56,    57,
+      58,    59,    60,    61,    62,    63,    64,    65,    66,    67,
+      68,    69,    70,    71,    72,    73,    74,    75,    76,    77,
+      78,    79,    80,    81,    82,    83,    84,    85,    86,    87,
+      88,    89,    90,    91,    92,    93,    95,     0,     0,     3,
+       4,     0,     0,     0,     0,     5,     6,     7,     8,     9,
+      10,    11,    12,    13,    14,    15,    16,    17,    18,    19,
+      20,    21,    22,    23,    24,    25,    26,    27,    28,    29,
+      30,    31,    32,    33,    34,    35,    36,    37,    38,    39,
+      40,    41,    42,    43,    44,    45,    46,    47,    48,    49,
+      50,    51,    52,    53,    54,    55,    56,    57,    58,    59,
+      60,    61,    62,    63,    64,    65,    66,    67,    68,    69,
+      70,    71,    72,    73,    74,    75,    76,    77,    78,    79,
+      80,    81,    82,    83,    84,    85,    86,    87,    88,    89,
+      90,    91,    92,    93
   };
 
   const short
   parser::yycheck_[] =
   {
-       3,     0,     0,     0,     3,     3,     3,    37,     4,     0,
-       4,     5,     3,    95,     6,     5,    98,     7,     5,     5,
-       7,     7,    94,    95,     4,     5,     4,     5,     4,     6,
-      96,    97,     6,     5,     5,    94,     6,     6,     6,     6,
-      94,     7,    19,     7,     7,     7,     7,     7,     7,     7,
-      70,    71,     7,     7,     7,     7,     7,     7,     7,     7,
-       7,     7,     7,     7,     7,     7,     7,     7,    88,     7,
-       7,     7,     7,     7,     7,     7,     7,     7,     7,     7,
-       7,     7,     7,     7,     7,     7,     7,    64,     7,     7,
-       7,     7,     7,     4,     7,     7,    97,     7,    97,    97,
-      97,    95,     7,     7,    81,     7,     7,     7,     7,     7,
-      87,     7,    89,     7,     7,     7,    95,     7,     5,     8,
-       6,    -1,    97,    96,   101,    -1,   103,   104,   105,   106,
-     107,   108,   109,   110,     6,   112,    -1,    -1,    -1,    -1,
-      97,    97,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    95,     5,   135,   136,
-     137,    -1,     7,    -1,   141,   142,     4,    -1,    -1,    -1,
-       7,     7,     7,     7,     7,     7,     7,    97,     7,     5,
-       7,     5,     7,    97,     7,     7,     7,   190,    97,   166,
-      97,   168,     7,   170,   171,   215,   216,   217,   218,   219,
-     220,   231,    97,   233,   207,     7,   183,   184,   185,   186,
-     240,   188,    97,    97,    97,    97,    97,    97,    97,    97,
-      97,    97,    97,    97,    97,   255,    97,    97,    97,    97,
-      97,    97,    97,    97,    97,    97,    97,    97,    97,    97,
-      97,    97,    97,    97,    97,    97,    97,    97,    97,   269,
-      97,    97,   272,    97,    97,    97,    97,    97,    97,     7,
+       3,     0,    37,     0,     3,     6,     3,     0,     4,     5,
+       3,     6,     0,    99,     6,     3,   102,     6,     5,     5,
+       7,     7,     5,     5,    19,     7,    98,    99,     4,     5,
+       4,     5,   100,   101,     5,     4,    74,    75,     6,     6,
+       6,     4,     7,     7,    98,     7,     7,     7,     7,     7,
+       7,     7,     7,     7,    92,     7,     7,     7,     7,     7,
+       7,     7,     7,     7,     7,     7,     7,     7,     7,    64,
+       7,     7,     7,     7,     7,     7,    71,     7,     7,     7,
        7,     7,     7,     7,     7,     7,     7,     7,     7,     7,
+      85,     7,     7,     7,     7,     7,    91,     7,    93,     4,
+       7,     7,   101,    99,   101,     7,     7,     7,   101,     7,
+     105,     7,   107,   108,   109,   110,   111,   112,   113,   114,
+       7,   116,     7,     7,     7,     7,     7,     7,    98,   101,
+      -1,    -1,    -1,     7,    -1,     8,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,   139,   140,   141,     6,   101,     5,
+     145,   146,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    99,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+     101,    -1,    -1,    -1,     5,   170,     4,     7,     7,     5,
+       7,   176,    99,   178,   179,   223,   224,   225,   226,   227,
+     228,     7,   101,   101,     7,   198,   191,   192,   193,   194,
+       7,   196,   101,     7,   239,     7,   241,   101,   101,   101,
+     101,   101,   215,   248,     7,   101,     7,     5,     7,    -1,
+       7,     7,   101,   101,   101,   101,   101,     7,   263,   101,
+     101,   101,   101,   101,   101,   101,   101,   101,   101,   101,
+     101,   101,   280,   101,   101,   283,   101,   101,   101,   101,
+     101,   101,   101,   101,   101,   101,   101,   101,   101,   101,
+     101,   101,   101,   101,   101,   101,   101,   101,   101,   101,
+       7,     7,     7,     7,     7,   100,     7,     7,     7,     7,
        7,     7,     7,     7,     7,     7,     7,     7,     7,     7,
-       7,     5,   285,   286,   287,     7,    97,    97,   291,    97,
-      97,    97,    97,    97,    97,     3,    97,    97,    96,    95,
-      97,    96,     4,    97,    97,    97,    97,    97,    97,    97,
-      97,    97,    97,    97,    97,    97,    97,    97,    97,    97,
-      97,    97,    97,    97,    97,   302,   303,   304,   305,   306,
-     307,    97,     5,   310,   311,     5,     7,     5,     7,   316,
-     317,   318,   319,   320,     7,     7,   323,   367,   368,     7,
-       7,     5,     5,     5,     5,   375,   376,     7,     7,     7,
-       7,   338,     7,     7,   341,   342,     5,     5,     8,     5,
-       7,   348,     7,   350,   351,   352,   353,     7,     7,     7,
-      96,    -1,    -1,   360,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,   411,   412,   413,   414,   415,    -1,    -1,    -1,    -1,
+       7,     7,     7,   296,   297,   298,     7,     7,     7,   302,
+       7,     7,     5,     7,   101,   101,   101,   101,     3,   101,
+       4,   101,     5,     5,     5,     5,   101,   101,   313,   314,
+     315,   316,   317,   318,   101,   101,   321,   322,   100,    99,
+     101,   100,   327,   328,   329,   330,   331,   101,   101,   334,
+     101,   101,   101,   381,   382,   101,   101,   101,   101,   101,
+     101,   389,   390,   101,   349,   101,   101,   352,   101,   101,
+     101,   356,   101,   101,     7,     7,     7,   362,     7,   364,
+     365,   366,   367,     7,     7,     5,     7,     5,     7,   374,
+       7,     5,     7,    -1,     7,     7,     5,   101,   101,   101,
+     428,   429,   430,   431,   432,     5,   101,     5,     7,   101,
+     101,   101,     7,     7,     7,     7,     7,     7,     7,     6,
+      99,    99,    99,     8,   100,   100,   100,   100,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   441,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,   442,   443,   444,
+     445,   446,   447,   448,   449,   450,   451,   452,   453,    -1,
+     455,   456,   457,   458,   459,   460,   461,   462,   463,   464,
+     465,   466,   467,   468,   469,   470,   471,   472,   473,    -1,
+     483,    -1,   477,   478,   479,   480,   481,   482,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,   424,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   425,   426,
-     427,   428,   429,   430,   431,   432,   433,   434,   435,   436,
-     463,   438,   439,   440,   441,   442,   443,   444,   445,   446,
-     447,   448,   449,   450,   451,   452,   453,   454,   455,   456,
-     457,   458,   459,   460,   461,   462,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,   507,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,     0,    -1,    -1,     3,     4,    -1,    -1,    -1,   506,
-       9,    10,    11,    12,    13,    14,    15,    16,    17,    18,
-      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
-      29,    30,    31,    32,    33,    34,    35,    36,    37,    38,
-      39,    40,    41,    42,    43,    44,    45,    46,    47,    48,
-      49,    50,    51,    52,    53,    54,    55,    56,    57,    58,
-      59,    60,    61,    62,    63,    64,    65,    66,    67,    68,
-      69,    70,    71,    72,    73,    74,    75,    76,    77,    78,
-      79,    80,    81,    82,    83,    84,    85,    86,    87,    88,
-      89,    90,    91,    92,    93,     0,    -1,    -1,     3,     4,
-      -1,    -1,    -1,    -1,     9,    10,    11,    12,    13,    14,
-      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
-      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
-      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
-      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
-      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
-      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
-      75,    76,    77,    78,    79,    80,    81,    82,    83,    84,
-      85,    86,    87,    88,    89,    90,    91,    92,    93
+      -1,    -1,    -1,   536,   529,   530,   531,   532,     0,    -1,
+      -1,     3,     4,    -1,    -1,    -1,    -1,     9,    10,    11,
+      12,    13,    14,    15,    16,    17,    18,    19,    20,    21,
+      22,    23,    24,    25,    26,    27,    28,    29,    30,    31,
+      32,    33,    34,    35,    36,    37,    38,    39,    40,    41,
+      42,    43,    44,    45,    46,    47,    48,    49,    50,    51,
+      52,    53,    54,    55,    56,    57,    58,    59,    60,    61,
+      62,    63,    64,    65,    66,    67,    68,    69,    70,    71,
+      72,    73,    74,    75,    76,    77,    78,    79,    80,    81,
+      82,    83,    84,    85,    86,    87,    88,    89,    90,    91,
+      92,    93,    94,    95,    96,    97,     0,    -1,    -1,     3,
+       4,    -1,    -1,    -1,    -1,     9,    10,    11,    12,    13,
+      14,    15,    16,    17,    18,    19,    20,    21,    22,    23,
+      24,    25,    26,    27,    28,    29,    30,    31,    32,    33,
+      34,    35,    36,    37,    38,    39,    40,    41,    42,    43,
+      44,    45,    46,    47,    48,    49,    50,    51,    52,    53,
+      54,    55,    56,    57,    58,    59,    60,    61,    62,    63,
+      64,    65,    66,    67,    68,    69,    70,    71,    72,    73,
+      74,    75,    76,    77,    78,    79,    80,    81,    82,    83,
+      84,    85,    86,    87,    88,    89,    90,    91,    92,    93,
+      94,    95,    96,    97
   };
 
-  const unsigned char
+  const signed char
   parser::yystos_[] =
   {
-       0,   100,     0,     3,     4,     9,    10,    11,    12,    13,
+       0,   104,     0,     3,     4,     9,    10,    11,    12,    13,
       14,    15,    16,    17,    18,    19,    20,    21,    22,    23,
       24,    25,    26,    27,    28,    29,    30,    31,    32,    33,
       34,    35,    36,    37,    38,    39,    40,    41,    42,    43,
@@ -5051,70 +5570,73 @@ namespace yy {
       64,    65,    66,    67,    68,    69,    70,    71,    72,    73,
       74,    75,    76,    77,    78,    79,    80,    81,    82,    83,
       84,    85,    86,    87,    88,    89,    90,    91,    92,    93,
-     101,     0,   101,    94,    95,     0,     3,   121,   121,     4,
-       5,   115,   116,   115,     6,     6,     5,     5,     6,     6,
-       6,     4,     6,     4,   121,     7,     7,     7,     7,     7,
+      94,    95,    96,    97,   105,     0,   105,    98,    99,     0,
+       3,   125,   125,     4,     5,   119,   120,   119,     6,     6,
+       5,     5,     6,     6,     6,     4,     6,     4,   125,     7,
        7,     7,     7,     7,     7,     7,     7,     7,     7,     7,
-       7,     4,     5,    95,   119,   120,   120,     7,     7,     7,
+       7,     7,     7,     7,     7,     4,     5,    99,   123,   124,
+     124,     7,     7,     7,     7,     7,     7,     7,     7,     7,
        7,     7,     7,     7,     7,     7,     7,     7,     7,     7,
+       7,     7,     7,     7,     7,     7,     7,   125,     7,     7,
+       7,     7,     7,     7,   125,     7,     7,     4,   123,   123,
+       7,     7,     7,     7,     7,     7,     7,     7,     7,   125,
+       7,     7,     7,     7,     7,   125,   123,   125,   106,   116,
+      98,    98,   125,   101,   125,   125,   125,   125,   125,   125,
+     125,   125,    99,   125,   112,   111,   101,   101,   101,   101,
+     101,   101,   101,   101,   101,   101,   101,   101,   101,   101,
+     101,   101,    99,   102,    99,     7,   125,   125,   125,   101,
+     101,   101,   125,   125,   101,   101,   101,   101,   101,   101,
+     101,   101,   101,   101,   101,   101,   101,   101,   101,   101,
+     101,   101,   101,   101,   101,   101,   101,   125,   101,   101,
+     101,   101,   125,   125,   125,   101,   101,   101,   101,   101,
+     101,   101,   101,   101,   101,   125,   125,   125,   125,   125,
+     105,     8,     5,     5,     4,     5,   107,   108,   109,     4,
+     121,   122,   110,     6,   105,     7,     7,     7,     7,     7,
+       7,     5,     7,   123,   123,   123,   123,   123,   123,     5,
+       7,     7,     7,     7,     5,     7,   100,   124,     5,   124,
+       7,     7,     7,     7,   124,     7,     7,     7,     7,     7,
+       7,     7,     7,     7,     7,     7,     7,     7,     7,   124,
        7,     7,     7,     7,     7,     7,     7,     7,     7,     7,
-       7,     7,     7,   121,     7,     7,     7,     7,     7,     4,
-     119,   119,     7,     7,     7,     7,     7,     7,     7,     7,
-       7,   121,     7,     7,     7,     7,     7,   121,   119,   121,
-     102,   112,    94,    94,   121,    97,   121,   121,   121,   121,
-     121,   121,   121,   121,    95,   121,   108,   107,    97,    97,
-      97,    97,    97,    97,    97,    97,    97,    97,    97,    97,
-      97,    97,    97,    97,    95,    98,    95,     7,   121,   121,
-     121,    97,    97,    97,   121,   121,    97,    97,    97,    97,
-      97,    97,    97,    97,    97,    97,    97,    97,    97,    97,
-      97,    97,    97,    97,    97,    97,    97,    97,    97,   121,
-      97,   121,   121,   121,    97,    97,    97,    97,    97,    97,
-      97,    97,    97,    97,   121,   121,   121,   121,   121,   101,
-       8,     5,     5,     4,     5,   103,   104,   105,     4,   117,
-     118,   106,     6,   101,     7,     7,     7,     7,     7,     7,
-       5,     7,   119,   119,   119,   119,   119,   119,     5,     7,
-       7,     7,     7,     5,     7,    96,   120,     5,   120,     7,
-       7,     7,     7,   120,     7,     7,     7,     7,     7,     7,
-       7,     7,     7,     7,     7,     7,     7,     7,   120,     7,
-       7,     7,     7,     7,     7,     7,     7,     7,   119,     7,
-       5,   119,     7,   113,   101,   101,   101,    96,    97,   101,
-     109,    97,    97,    97,    97,    97,    97,    97,    97,   121,
-     121,   121,   121,   121,   121,    97,    97,    97,   121,   121,
-      96,    95,    96,   121,   121,   121,    97,   121,   121,    97,
-      97,   121,    97,    97,    97,    97,    97,    97,    97,    97,
-      97,    97,    97,    97,    97,    97,   121,    97,    97,   121,
-     121,    97,    97,    97,    97,    97,   121,    97,   121,   121,
-     121,   121,     3,     4,   121,     5,     7,     5,     5,     7,
-       7,     5,   119,   119,   119,   119,     7,     7,     7,     7,
-       5,     5,     7,     7,     7,     5,     5,     7,     7,     7,
-       5,     5,     7,     7,     7,     7,     5,   119,   119,   119,
-     119,   119,     7,   114,   110,   101,   121,   121,   121,   121,
-     121,   121,   121,   121,   121,   121,   121,   121,    96,   121,
-     121,   121,   121,   121,   121,   121,   121,   121,   121,   121,
-     121,   121,   121,   121,   121,   121,   121,   121,   121,   121,
-     121,   121,   121,   121,   101,     6,   111,   121,   101
+       7,     7,   123,     7,     5,   123,     7,   117,   105,   105,
+     105,   100,   101,   105,   113,   101,   101,   101,   101,   101,
+     101,   101,   101,   125,   125,   125,   125,   125,   125,   101,
+     101,   101,   125,   125,   100,    99,   100,   125,   125,   125,
+     101,   125,   125,   101,   101,   125,   101,   101,   101,   101,
+     101,   101,   101,   101,   101,   101,   101,   101,   101,   101,
+     125,   101,   101,   125,   101,   101,   101,   125,   101,   101,
+     101,   101,   101,   125,   101,   125,   125,   125,   125,     3,
+       4,   125,     5,     7,     5,     5,     7,     7,     5,   123,
+     123,   123,   123,     7,     7,     7,     7,     5,     5,     7,
+       7,     7,     5,     5,     7,     7,     7,     5,     5,     7,
+       7,     7,     7,     5,    99,    99,    99,   123,   123,   123,
+     123,   123,     7,   118,   114,   105,   125,   125,   125,   125,
+     125,   125,   125,   125,   125,   125,   125,   125,   100,   125,
+     125,   125,   125,   125,   125,   125,   125,   125,   125,   125,
+     125,   125,   125,   125,   125,   125,   125,   125,     7,     7,
+       7,   125,   125,   125,   125,   125,   125,   105,     6,   100,
+     100,   100,   115,   125,   125,   125,   125,   105
   };
 
-  const unsigned char
+  const signed char
   parser::yyr1_[] =
   {
-       0,    99,   100,   100,   102,   101,   101,   101,   101,   101,
-     101,   101,   101,   101,   101,   101,   103,   101,   104,   101,
-     105,   101,   106,   101,   107,   101,   108,   109,   101,   110,
-     111,   101,   112,   113,   114,   101,   101,   101,   101,   101,
-     101,   101,   101,   101,   101,   101,   101,   101,   101,   101,
-     101,   101,   101,   101,   101,   101,   101,   101,   101,   101,
-     101,   101,   101,   101,   101,   101,   101,   101,   101,   101,
-     101,   101,   101,   101,   101,   101,   101,   101,   101,   101,
-     101,   101,   101,   101,   101,   101,   101,   101,   101,   101,
-     101,   101,   101,   101,   101,   101,   101,   101,   101,   101,
-     101,   101,   101,   101,   101,   101,   101,   101,   101,   101,
-     101,   101,   115,   115,   115,   116,   116,   116,   116,   117,
-     117,   118,   118,   119,   120,   120,   120,   120,   120,   120,
-     121,   121
+       0,   103,   104,   104,   106,   105,   105,   105,   105,   105,
+     105,   105,   105,   105,   105,   105,   107,   105,   108,   105,
+     109,   105,   110,   105,   111,   105,   112,   113,   105,   114,
+     115,   105,   116,   117,   118,   105,   105,   105,   105,   105,
+     105,   105,   105,   105,   105,   105,   105,   105,   105,   105,
+     105,   105,   105,   105,   105,   105,   105,   105,   105,   105,
+     105,   105,   105,   105,   105,   105,   105,   105,   105,   105,
+     105,   105,   105,   105,   105,   105,   105,   105,   105,   105,
+     105,   105,   105,   105,   105,   105,   105,   105,   105,   105,
+     105,   105,   105,   105,   105,   105,   105,   105,   105,   105,
+     105,   105,   105,   105,   105,   105,   105,   105,   105,   105,
+     105,   105,   105,   105,   105,   105,   119,   119,   119,   120,
+     120,   120,   120,   121,   121,   122,   122,   123,   124,   124,
+     124,   124,   124,   124,   125,   125
   };
 
-  const unsigned char
+  const signed char
   parser::yyr2_[] =
   {
        0,     2,     2,     0,     0,     4,     2,     1,     2,     2,
@@ -5125,77 +5647,78 @@ namespace yy {
        5,     5,     3,     3,     3,     5,     5,     5,     3,     3,
        5,     5,     7,     7,     5,     7,     7,     7,     7,     7,
        7,     7,     7,     7,     7,     7,     7,     7,     5,     2,
-       7,     7,     5,     7,     5,     3,     7,     3,     2,     3,
-       3,     7,     7,     7,     7,     7,     5,     7,     7,     7,
-       7,     7,     5,     3,     3,     3,     3,     2,     2,     3,
-       5,     5,     1,     3,     3,     1,     1,     3,     3,     1,
-       0,     1,     3,     1,     1,     3,     3,     4,     4,     6,
-       1,     1
+       7,     7,     5,     7,     9,     9,     9,     2,     5,     3,
+       7,     3,     2,     3,     3,     7,     7,     7,     7,     7,
+       5,     7,     7,     7,     7,     7,     5,     3,     3,     3,
+       3,     2,     2,     3,     5,     5,     1,     3,     3,     1,
+       1,     3,     3,     1,     0,     1,     3,     1,     1,     3,
+       3,     4,     4,     6,     1,     1
   };
 
 
-
+#if YYDEBUG || 1
   // YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
-  // First, the terminals, then, starting at \a yyntokens_, nonterminals.
+  // First, the terminals, then, starting at \a YYNTOKENS, nonterminals.
   const char*
   const parser::yytname_[] =
   {
-  "END_OF_FILE", "error", "$undefined", "END_OF_LINE", "IDENTIFIER",
-  "LITERAL", "STRING", "REGISTER", "ARGUMENT_LIST", "TEXT", "DATA", "WORD",
-  "BYTE", "ASCII", "ASCIIZ", "ALIGN", "SPACE", "INCLUDE", "ERROR",
-  "MESSAGE", "MACRO", "DBG", "DEFINE", "DBGBP", "ADD", "ADDI", "ADDIU",
-  "ADDU", "AND", "ANDI", "BEQ", "BGEZ", "BGEZAL", "BGTZ", "BLEZ", "BLTZ",
-  "BLTZAL", "BNE", "DIV", "DIVU", "J", "JAL", "JR", "LB", "LUI", "LW",
-  "MFHI", "MFLO", "MULT", "MULTU", "OR", "ORI", "SB", "SLL", "SLLV", "NOR",
-  "SLT", "SLTI", "SLTIU", "SLTU", "SNE", "SEQ", "SRA", "SRL", "SRLV",
-  "SUB", "SUBU", "SW", "SYS", "XOR", "XORI", "JALR", "COPY", "CLR", "B",
-  "BAL", "BGT", "BLT", "BGE", "BLE", "BGTU", "BEQZ", "REM", "LI", "LA",
-  "NOP", "NOT", "PUSHW", "POPW", "PUSHB", "POPB", "RET", "CALL", "ENTER",
-  "':'", "'('", "')'", "','", "'+'", "$accept", "statement_list",
-  "statement", "$@1", "$@2", "$@3", "$@4", "$@5", "$@6", "$@7", "$@8",
-  "$@9", "$@10", "$@11", "$@12", "$@13", "literal_argument",
-  "literal_list", "identifier_list", "identifier_list_not_empty",
-  "direct_address", "address", "end_of_statement", YY_NULLPTR
+  "END_OF_FILE", "error", "\"invalid token\"", "END_OF_LINE",
+  "IDENTIFIER", "LITERAL", "STRING", "REGISTER", "ARGUMENT_LIST", "TEXT",
+  "DATA", "WORD", "BYTE", "ASCII", "ASCIIZ", "ALIGN", "SPACE", "INCLUDE",
+  "ERROR", "MESSAGE", "MACRO", "DBG", "DEFINE", "DBGBP", "ADD", "ADDI",
+  "ADDIU", "ADDU", "AND", "ANDI", "BEQ", "BGEZ", "BGEZAL", "BGTZ", "BLEZ",
+  "BLTZ", "BLTZAL", "BNE", "DIV", "DIVU", "J", "JAL", "JR", "LB", "LUI",
+  "LW", "MFHI", "MFLO", "MULT", "MULTU", "OR", "ORI", "SB", "SLL", "SLLV",
+  "NOR", "SLT", "SLTI", "SLTIU", "SLTU", "SNE", "SEQ", "SRA", "SRL",
+  "SRLV", "SUB", "SUBU", "SW", "SYS", "XOR", "XORI", "JALR", "CAS",
+  "AMOADD", "AMOSWAP", "SYNC", "COPY", "CLR", "B", "BAL", "BGT", "BLT",
+  "BGE", "BLE", "BGTU", "BEQZ", "REM", "LI", "LA", "NOP", "NOT", "PUSHW",
+  "POPW", "PUSHB", "POPB", "RET", "CALL", "ENTER", "':'", "'('", "')'",
+  "','", "'+'", "$accept", "statement_list", "statement", "$@1", "$@2",
+  "$@3", "$@4", "$@5", "$@6", "$@7", "$@8", "$@9", "$@10", "$@11", "$@12",
+  "$@13", "literal_argument", "literal_list", "identifier_list",
+  "identifier_list_not_empty", "direct_address", "address",
+  "end_of_statement", YY_NULLPTR
   };
+#endif
+
 
 #if YYDEBUG
-  const unsigned short
+  const short
   parser::yyrline_[] =
   {
-       0,   189,   189,   190,   194,   194,   215,   216,   218,   219,
-     220,   241,   261,   267,   273,   284,   290,   290,   291,   291,
-     292,   292,   293,   293,   294,   294,   295,   295,   295,   296,
-     296,   296,   297,   297,   297,   297,   300,   301,   302,   303,
-     304,   305,   306,   307,   308,   309,   310,   311,   312,   313,
-     314,   315,   316,   317,   318,   319,   320,   321,   322,   323,
-     324,   325,   326,   327,   328,   329,   330,   331,   332,   333,
-     334,   335,   336,   337,   338,   339,   340,   341,   342,   343,
-     344,   345,   346,   347,   350,   351,   352,   353,   354,   355,
-     356,   357,   358,   359,   360,   361,   362,   363,   364,   365,
-     366,   367,   368,   369,   375,   381,   387,   393,   402,   412,
-     417,   431,   445,   446,   447,   451,   452,   453,   454,   458,
-     459,   463,   464,   468,   477,   478,   485,   491,   498,   505,
-     516,   517
+       0,   283,   283,   284,   288,   288,   309,   310,   312,   313,
+     314,   335,   355,   361,   367,   378,   384,   384,   385,   385,
+     386,   386,   387,   387,   388,   388,   389,   389,   389,   390,
+     390,   390,   391,   391,   391,   391,   394,   395,   396,   397,
+     398,   399,   400,   401,   402,   403,   404,   405,   406,   407,
+     408,   409,   410,   411,   412,   413,   414,   415,   416,   417,
+     418,   419,   420,   421,   422,   423,   424,   425,   426,   427,
+     428,   429,   430,   431,   432,   433,   434,   435,   436,   437,
+     438,   439,   440,   441,   442,   443,   444,   445,   448,   449,
+     450,   451,   452,   453,   454,   455,   456,   457,   458,   459,
+     460,   461,   462,   463,   464,   465,   466,   467,   473,   479,
+     485,   491,   500,   510,   515,   529,   543,   544,   545,   549,
+     550,   551,   552,   556,   557,   561,   562,   566,   575,   576,
+     583,   589,   596,   603,   614,   615
   };
 
-  // Print the state stack on the debug stream.
   void
-  parser::yystack_print_ ()
+  parser::yy_stack_print_ () const
   {
     *yycdebug_ << "Stack now";
     for (stack_type::const_iterator
            i = yystack_.begin (),
            i_end = yystack_.end ();
          i != i_end; ++i)
-      *yycdebug_ << ' ' << i->state;
+      *yycdebug_ << ' ' << int (i->state);
     *yycdebug_ << '\n';
   }
 
-  // Report on the debug stream that the rule \a yyrule is going to be reduced.
   void
-  parser::yy_reduce_print_ (int yyrule)
+  parser::yy_reduce_print_ (int yyrule) const
   {
-    unsigned yylno = yyrline_[yyrule];
+    int yylno = yyrline_[yyrule];
     int yynrhs = yyr2_[yyrule];
     // Print the symbols being reduced, and their result.
     *yycdebug_ << "Reducing stack by rule " << yyrule - 1
@@ -5244,13 +5767,13 @@ static std::string lexStringLiteral(bool resolve = true)
 {
 	std::string str;
 
-	std::streampos mar;
+	[[maybe_unused]] const char* mar; // only used if the DFA needs to back up
 	for (;;)
 	{
 		
 {
 	char yych;
-	yych = in.peek();
+	yych = *in.cursor;
 	switch (yych) {
 	case '\n':	goto yy4;
 	case '"':	goto yy6;
@@ -5258,17 +5781,17 @@ static std::string lexStringLiteral(bool resolve = true)
 	default:	goto yy2;
 	}
 yy2:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed string"); } while(0);
+	if (++in.cursor > in.limit) throw std::runtime_error("Unclosed string");
 	{ str.push_back(yych); continue; }
 yy4:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed string"); } while(0);
+	if (++in.cursor > in.limit) throw std::runtime_error("Unclosed string");
 	{ throw std::runtime_error("Unclosed string"); }
 yy6:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed string"); } while(0);
+	if (++in.cursor > in.limit) throw std::runtime_error("Unclosed string");
 	{ break; }
 yy8:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed string"); } while(0);
-	yych = in.peek();
+	if (++in.cursor > in.limit) throw std::runtime_error("Unclosed string");
+	yych = *in.cursor;
 	switch (yych) {
 	case '"':
 	case '\'':
@@ -5285,7 +5808,7 @@ yy8:
 yy9:
 	{ throw std::runtime_error("Illegal escape character in string"); }
 yy10:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed string"); } while(0);
+	if (++in.cursor > in.limit) throw std::runtime_error("Unclosed string");
 	{ if (resolve) { str.push_back(ESCAPE_SEQUENCES.at(yych)); } else { str.push_back('\\'); str.push_back(yych); } continue; }
 }
 
@@ -5294,99 +5817,56 @@ yy10:
 	return str;
 }
 
+// Up to the end of the line or a comment, which are left to the lexer
 static std::string lineAsString()
 {
-	std::string str;
-	char c;
-	std::streampos mar;
-	for (;;)
+	const char* start = in.cursor;
+	while (in.cursor < in.limit && *in.cursor != '\0' && *in.cursor != '#' && *in.cursor != '\n' && *in.cursor != '\r')
 	{
-		
-{
-	char yych;
-	yych = in.peek();
-	switch (yych) {
-	case 0x00:
-	case '\n':
-	case '\r':
-	case '#':	goto yy14;
-	default:	goto yy16;
+		in.cursor++;
 	}
-yy14:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed line as string"); } while(0);
-	{ c = yych; break; }
-yy16:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed line as string"); } while(0);
-	{ str.push_back(yych); continue; }
-}
-
-	}
-
-	in.put(c);
-	return str;
+	return std::string(start, in.cursor);
 }
 
+// Up to .end, in any case
 static std::string blockAsString()
 {
-	std::string str;
-	
-	for (;;)
+	const char* start = in.cursor;
+	for (; in.limit - in.cursor >= 4; in.cursor++)
 	{
-		char c;
-		in.get(c);
-		str.push_back(c);
-		if (str.length() >= 4)
+		if (in.cursor[0] == '.' && std::tolower(in.cursor[1]) == 'e' && std::tolower(in.cursor[2]) == 'n' && std::tolower(in.cursor[3]) == 'd')
 		{
-			std::string eos = str.substr(str.length() - 4, 4);
-			for (char& c : eos)
-			{
-				c = std::tolower(c);
-			}
-			if (eos == ".end") break;
+			std::string block(start, in.cursor);
+			in.cursor += 4;
+			return block;
 		}
 	}
-
-	return str.substr(0, str.length() - 4);
+	throw std::runtime_error("Unclosed block");
 }
 
-static std::string getString(std::streampos start, std::streampos end)
-{
-	std::string buffer;
-	buffer.resize(end - start);
-	in.seekg(start);
-	in.read(buffer.data(), end - start);
-	return buffer;
-}
-
-static char getChar(std::streampos start, std::streampos end)
-{
-	in.seekg(start);
-	char c;
-	in.get(c);
-	in.seekg(end);
-	return c;
-}
-
-#define GET_STRING() getString(s, e)
-#define GET_CHAR() getChar(s, e)
+// The text of a token, between its tags
+#define GET_STRING() std::string(s, e)
+#define GET_CHAR() (*s)
 
 static std::vector<std::string> argumentList()
 {
 	std::string argument;
 	std::vector<std::string> arguments;
-	std::streampos mar, s, e;
-	std::streampos yyt1;
+	[[maybe_unused]] const char* mar; // only used if the DFA needs to back up
+	const char* s;
+	const char* e;
+	const char* yyt1;
 	bool empty = true;
 	for (;;)
 	{
 		
 {
 	char yych;
-	yych = in.peek();
+	yych = *in.cursor;
 	switch (yych) {
-	case '"':	goto yy22;
-	case ')':	goto yy24;
-	case ',':	goto yy26;
+	case '"':	goto yy16;
+	case ')':	goto yy18;
+	case ',':	goto yy20;
 	case 'A':
 	case 'B':
 	case 'C':
@@ -5440,25 +5920,25 @@ static std::vector<std::string> argumentList()
 	case 'x':
 	case 'y':
 	case 'z':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy28;
-	default:	goto yy20;
+		yyt1 = in.cursor;
+		goto yy22;
+	default:	goto yy14;
 	}
-yy20:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed argument list"); } while(0);
+yy14:
+	if (++in.cursor > in.limit) throw std::runtime_error("Unclosed argument list");
 	{ argument.push_back(yych); empty = false; continue; }
-yy22:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed argument list"); } while(0);
+yy16:
+	if (++in.cursor > in.limit) throw std::runtime_error("Unclosed argument list");
 	{ argument += std::string(1, '\"') + lexStringLiteral(false) + std::string(1, '\"'); empty = false; }
-yy24:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed argument list"); } while(0);
+yy18:
+	if (++in.cursor > in.limit) throw std::runtime_error("Unclosed argument list");
 	{ if (!empty) { arguments.push_back(argument); } break; }
-yy26:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed argument list"); } while(0);
+yy20:
+	if (++in.cursor > in.limit) throw std::runtime_error("Unclosed argument list");
 	{ arguments.push_back(argument); argument = ""; continue; }
-yy28:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed argument list"); } while(0);
-	yych = in.peek();
+yy22:
+	if (++in.cursor > in.limit) throw std::runtime_error("Unclosed argument list");
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -5522,12 +6002,12 @@ yy28:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy28;
-	default:	goto yy30;
+	case 'z':	goto yy22;
+	default:	goto yy24;
 	}
-yy30:
+yy24:
 	s = yyt1;
-	e = in.eof() ? std::streampos(0) : in.tellg();
+	e = in.cursor;
 	{
 			std::string identifier = GET_STRING();
 			if (!macroCallStack.empty())
@@ -5559,10 +6039,36 @@ yy30:
 	return arguments;
 }
 
+// Pushes the argument or the value of the .define an identifier stands for, if any
+static bool substituteIdentifier(const std::string& identifier)
+{
+	if (!macroCallStack.empty())
+	{
+		MacroCall& mc = macroCallStack.back();
+		auto it = std::find(mc.paramaters.begin(), mc.paramaters.end(), identifier);
+		if (it != mc.paramaters.end())
+		{
+			auto index = std::distance(mc.paramaters.begin(), it);
+			in.pushString(mc.arguments[index]);
+			return true;
+		}
+	}
+
+	auto it = assembler->macros.find(identifier);
+	if (it != assembler->macros.end())
+	{
+		in.pushString(it->second);
+		return true;
+	}
+	return false;
+}
+
 yy::parser::symbol_type yy::yylex()
 {
-    std::streampos mar, s, e;
-    std::streampos yyt1;
+    const char* mar;
+    const char* s;
+    const char* e;
+    const char* yyt1;
 
 #define TOKEN(name) do { return parser::make_##name(loc); } while(0)
 #define TOKENV(name, ...) do { return parser::make_##name(__VA_ARGS__, loc); } while(0)
@@ -5584,39 +6090,102 @@ yy::parser::symbol_type yy::yylex()
 
 	for (;;)
 	{
+		if (!in.next()) TOKEN(END_OF_FILE);
+		tokenStart = in.cursor;
+
+		while (!replays.empty() && replays.back().depth > in.getDepth())
+		{
+			replays.pop_back();
+		}
+		if (!tokenizing && !replays.empty() && replays.back().depth == in.getDepth())
+		{
+			Replay& replay = replays.back();
+			const char* text = replay.body->text->data();
+			const std::vector<MacroToken>& tokens = replay.body->tokens;
+			std::size_t offset = in.cursor - text;
+			while (replay.index < tokens.size() && tokens[replay.index].begin < offset)
+			{
+				replay.index++;
+			}
+
+			// If the parser read part of the body as text and stopped between two tokens, lexing the rest of it as
+			// text gives the same tokens again. Otherwise it has to be lexed.
+			bool aligned = offset == 0 || (replay.index > 0 && tokens[replay.index - 1].end == offset) || (replay.index < tokens.size() && tokens[replay.index].begin == offset);
+			if (!aligned)
+			{
+				replays.pop_back();
+			}
+			else if (replay.index == tokens.size())
+			{
+				in.cursor = in.limit;
+				continue;
+			}
+			else
+			{
+				const MacroToken& token = tokens[replay.index++];
+				in.cursor = text + token.end;
+				if (token.symbol.kind() == parser::symbol_kind::S_END_OF_LINE)
+				{
+					loc.lines();
+					loc.step();
+				}
+				else
+				{
+					loc.columns(token.columns);
+				}
+
+				if (token.symbol.kind() == parser::symbol_kind::S_IDENTIFIER)
+				{
+					if (token.slot >= 0)
+					{
+						in.pushString(macroCallStack.back().arguments[token.slot]);
+						continue;
+					}
+					if (substituteIdentifier(token.symbol.value.as<std::string>()))
+					{
+						continue;
+					}
+				}
+
+				parser::symbol_type symbol(token.symbol);
+				symbol.location = loc;
+				return symbol;
+			}
+		}
+
 		
 {
 	char yych;
 	unsigned int yyaccept = 0;
-	yych = in.peek();
+	yych = *in.cursor;
 	switch (yych) {
 	case 0x08:
 	case '\t':
 	case '\v':
 	case '\f':
-	case ' ':	goto yy35;
-	case '\n':	goto yy37;
-	case '\r':	goto yy39;
-	case '"':	goto yy40;
+	case ' ':	goto yy29;
+	case '\n':	goto yy31;
+	case '\r':	goto yy33;
+	case '"':	goto yy34;
 	case '#':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy42;
-	case '$':	goto yy45;
-	case '\'':	goto yy46;
+		yyt1 = in.cursor;
+		goto yy36;
+	case '$':	goto yy39;
+	case '\'':	goto yy40;
 	case '(':
 	case ')':
 	case ',':
-	case ':':	goto yy47;
+	case ':':	goto yy41;
 	case '+':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy49;
+		yyt1 = in.cursor;
+		goto yy43;
 	case '-':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy50;
-	case '.':	goto yy51;
+		yyt1 = in.cursor;
+		goto yy44;
+	case '.':	goto yy45;
 	case '0':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy52;
+		yyt1 = in.cursor;
+		goto yy46;
 	case '1':
 	case '2':
 	case '3':
@@ -5626,28 +6195,28 @@ yy::parser::symbol_type yy::yylex()
 	case '7':
 	case '8':
 	case '9':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy54;
+		yyt1 = in.cursor;
+		goto yy48;
 	case 'A':
 	case 'a':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy56;
+		yyt1 = in.cursor;
+		goto yy50;
 	case 'B':
 	case 'b':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy58;
+		yyt1 = in.cursor;
+		goto yy52;
 	case 'C':
 	case 'c':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy60;
+		yyt1 = in.cursor;
+		goto yy54;
 	case 'D':
 	case 'd':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy61;
+		yyt1 = in.cursor;
+		goto yy55;
 	case 'E':
 	case 'e':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy62;
+		yyt1 = in.cursor;
+		goto yy56;
 	case 'F':
 	case 'G':
 	case 'H':
@@ -5673,84 +6242,84 @@ yy::parser::symbol_type yy::yylex()
 	case 'w':
 	case 'y':
 	case 'z':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy63;
+		yyt1 = in.cursor;
+		goto yy57;
 	case 'J':
 	case 'j':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy65;
+		yyt1 = in.cursor;
+		goto yy59;
 	case 'L':
 	case 'l':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy67;
+		yyt1 = in.cursor;
+		goto yy61;
 	case 'M':
 	case 'm':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy68;
+		yyt1 = in.cursor;
+		goto yy62;
 	case 'N':
 	case 'n':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy69;
+		yyt1 = in.cursor;
+		goto yy63;
 	case 'O':
 	case 'o':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy70;
+		yyt1 = in.cursor;
+		goto yy64;
 	case 'P':
 	case 'p':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy71;
+		yyt1 = in.cursor;
+		goto yy65;
 	case 'R':
 	case 'r':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy72;
+		yyt1 = in.cursor;
+		goto yy66;
 	case 'S':
 	case 's':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy73;
+		yyt1 = in.cursor;
+		goto yy67;
 	case 'X':
 	case 'x':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy74;
-	default:	goto yy33;
+		yyt1 = in.cursor;
+		goto yy68;
+	default:	goto yy27;
 	}
-yy33:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-yy34:
-	{ throw std::runtime_error(std::string("Invalid character of value: " + std::to_string(GET_CHAR())).c_str()); }
-yy35:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy27:
+	if (++in.cursor > in.limit) continue;
+yy28:
+	{ throw std::runtime_error(std::string("Invalid character of value: " + std::to_string(yych)).c_str()); }
+yy29:
+	if (++in.cursor > in.limit) continue;
 	{ loc.columns(); continue; }
-yy37:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-yy38:
+yy31:
+	if (++in.cursor > in.limit) continue;
+yy32:
 	{ loc.lines(); loc.step(); TOKEN(END_OF_LINE); }
-yy39:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy33:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
-	case '\n':	goto yy37;
-	default:	goto yy38;
+	case '\n':	goto yy31;
+	default:	goto yy32;
 	}
-yy40:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy34:
+	if (++in.cursor > in.limit) continue;
 	{ TOKENV(STRING, lexStringLiteral()); }
-yy42:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy36:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '\n':
-	case '\r':	goto yy44;
-	default:	goto yy42;
+	case '\r':	goto yy38;
+	default:	goto yy36;
 	}
-yy44:
+yy38:
 	s = yyt1;
-	e = in.eof() ? std::streampos(0) : in.tellg();
+	e = in.cursor;
 	{ continue; }
-yy45:
+yy39:
 	yyaccept = 0;
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	mar = in.tellg();
-	yych = in.peek();
+	if (++in.cursor > in.limit) continue;
+	mar = in.cursor;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '4':
@@ -5759,61 +6328,61 @@ yy45:
 	case '7':
 	case '8':
 	case '9':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy75;
+		yyt1 = in.cursor;
+		goto yy69;
 	case '1':
 	case '2':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy77;
+		yyt1 = in.cursor;
+		goto yy71;
 	case '3':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy78;
+		yyt1 = in.cursor;
+		goto yy72;
 	case 'a':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy79;
+		yyt1 = in.cursor;
+		goto yy73;
 	case 'f':
 	case 'g':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy81;
+		yyt1 = in.cursor;
+		goto yy75;
 	case 'k':
 	case 'v':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy82;
+		yyt1 = in.cursor;
+		goto yy76;
 	case 'r':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy83;
+		yyt1 = in.cursor;
+		goto yy77;
 	case 's':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy84;
+		yyt1 = in.cursor;
+		goto yy78;
 	case 't':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy85;
+		yyt1 = in.cursor;
+		goto yy79;
 	case 'z':
-		yyt1 = in.eof() ? std::streampos(0) : in.tellg();
-		goto yy86;
-	default:	goto yy34;
+		yyt1 = in.cursor;
+		goto yy80;
+	default:	goto yy28;
 	}
-yy46:
+yy40:
 	yyaccept = 0;
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	mar = in.tellg();
-	yych = in.peek();
+	if (++in.cursor > in.limit) continue;
+	mar = in.cursor;
+	yych = *in.cursor;
 	switch (yych) {
 	case '"':
-	case '\'':	goto yy34;
-	case '\\':	goto yy88;
-	default:	goto yy87;
+	case '\'':	goto yy28;
+	case '\\':	goto yy82;
+	default:	goto yy81;
 	}
-yy47:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-yy48:
-	s = in.eof() ? std::streampos(0) : in.tellg();
+yy41:
+	if (++in.cursor > in.limit) continue;
+yy42:
+	s = in.cursor;
 	s += -1;
-	e = in.eof() ? std::streampos(0) : in.tellg();
+	e = in.cursor;
 	{ return parser::symbol_type(parser::token_type(GET_CHAR()), loc); }
-yy49:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy43:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -5824,12 +6393,12 @@ yy49:
 	case '6':
 	case '7':
 	case '8':
-	case '9':	goto yy54;
-	default:	goto yy48;
+	case '9':	goto yy48;
+	default:	goto yy42;
 	}
-yy50:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy44:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -5840,53 +6409,53 @@ yy50:
 	case '6':
 	case '7':
 	case '8':
-	case '9':	goto yy54;
-	default:	goto yy34;
+	case '9':	goto yy48;
+	default:	goto yy28;
 	}
-yy51:
+yy45:
 	yyaccept = 0;
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	mar = in.tellg();
-	yych = in.peek();
+	if (++in.cursor > in.limit) continue;
+	mar = in.cursor;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'A':
-	case 'a':	goto yy89;
+	case 'a':	goto yy83;
 	case 'B':
-	case 'b':	goto yy90;
+	case 'b':	goto yy84;
 	case 'D':
-	case 'd':	goto yy91;
+	case 'd':	goto yy85;
 	case 'E':
-	case 'e':	goto yy92;
+	case 'e':	goto yy86;
 	case 'I':
-	case 'i':	goto yy93;
+	case 'i':	goto yy87;
 	case 'M':
-	case 'm':	goto yy94;
+	case 'm':	goto yy88;
 	case 'S':
-	case 's':	goto yy95;
+	case 's':	goto yy89;
 	case 'T':
-	case 't':	goto yy96;
+	case 't':	goto yy90;
 	case 'W':
-	case 'w':	goto yy97;
-	default:	goto yy34;
+	case 'w':	goto yy91;
+	default:	goto yy28;
 	}
-yy52:
+yy46:
 	yyaccept = 1;
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	mar = in.tellg();
-	yych = in.peek();
+	if (++in.cursor > in.limit) continue;
+	mar = in.cursor;
+	yych = *in.cursor;
 	switch (yych) {
-	case 'b':	goto yy98;
-	case 'x':	goto yy99;
-	default:	goto yy55;
+	case 'b':	goto yy92;
+	case 'x':	goto yy93;
+	default:	goto yy49;
 	}
-yy53:
+yy47:
 	s = yyt1;
-	e = in.eof() ? std::streampos(0) : in.tellg();
+	e = in.cursor;
 	{ TOKENV(LITERAL, std::stoi(GET_STRING(), nullptr, 10)); }
-yy54:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
-yy55:
+yy48:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
+yy49:
 	switch (yych) {
 	case '0':
 	case '1':
@@ -5897,47 +6466,35 @@ yy55:
 	case '6':
 	case '7':
 	case '8':
-	case '9':	goto yy54;
-	default:	goto yy53;
+	case '9':	goto yy48;
+	default:	goto yy47;
 	}
-yy56:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy50:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'D':
-	case 'd':	goto yy100;
+	case 'd':	goto yy94;
+	case 'M':
+	case 'm':	goto yy95;
 	case 'N':
-	case 'n':	goto yy101;
-	default:	goto yy64;
+	case 'n':	goto yy96;
+	default:	goto yy58;
 	}
-yy57:
+yy51:
 	s = yyt1;
-	e = in.eof() ? std::streampos(0) : in.tellg();
+	e = in.cursor;
 	{
 			std::string identifier = GET_STRING();
-			if (!macroCallStack.empty())
-			{
-				MacroCall& mc = macroCallStack.back();
-				auto it = std::find(mc.paramaters.begin(), mc.paramaters.end(), identifier);
-				if (it != mc.paramaters.end())
-				{
-					auto index = std::distance(mc.paramaters.begin(), it);
-					in.pushString(mc.arguments[index]);
-					continue;
-				}
-			}
-			
-			if (assembler->macros.count(identifier))
+			if (!tokenizing && substituteIdentifier(identifier))
 			{
-				in.pushString(assembler->macros[identifier]);
 				continue;
 			}
-			
 			TOKENV(IDENTIFIER, identifier);
 		}
-yy58:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy52:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -5991,53 +6548,53 @@ yy58:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'A':
-	case 'a':	goto yy102;
+	case 'a':	goto yy97;
 	case 'E':
-	case 'e':	goto yy103;
+	case 'e':	goto yy98;
 	case 'G':
-	case 'g':	goto yy104;
+	case 'g':	goto yy99;
 	case 'L':
-	case 'l':	goto yy105;
+	case 'l':	goto yy100;
 	case 'N':
-	case 'n':	goto yy106;
-	default:	goto yy59;
+	case 'n':	goto yy101;
+	default:	goto yy53;
 	}
-yy59:
+yy53:
 	{ TOKEN(B); }
-yy60:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy54:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'A':
-	case 'a':	goto yy107;
+	case 'a':	goto yy102;
 	case 'L':
-	case 'l':	goto yy108;
+	case 'l':	goto yy103;
 	case 'O':
-	case 'o':	goto yy109;
-	default:	goto yy64;
+	case 'o':	goto yy104;
+	default:	goto yy58;
 	}
-yy61:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy55:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'I':
-	case 'i':	goto yy110;
-	default:	goto yy64;
+	case 'i':	goto yy105;
+	default:	goto yy58;
 	}
-yy62:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy56:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'N':
-	case 'n':	goto yy111;
-	default:	goto yy64;
+	case 'n':	goto yy106;
+	default:	goto yy58;
 	}
-yy63:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
-yy64:
+yy57:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
+yy58:
 	switch (yych) {
 	case '0':
 	case '1':
@@ -6101,12 +6658,12 @@ yy64:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy57;
+	case 'z':	goto yy57;
+	default:	goto yy51;
 	}
-yy65:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy59:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -6166,114 +6723,114 @@ yy65:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'A':
-	case 'a':	goto yy112;
+	case 'a':	goto yy107;
 	case 'R':
-	case 'r':	goto yy113;
-	default:	goto yy66;
+	case 'r':	goto yy108;
+	default:	goto yy60;
 	}
-yy66:
+yy60:
 	{ TOKEN(J); }
-yy67:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy61:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'A':
-	case 'a':	goto yy115;
+	case 'a':	goto yy110;
 	case 'B':
-	case 'b':	goto yy117;
+	case 'b':	goto yy112;
 	case 'I':
-	case 'i':	goto yy119;
+	case 'i':	goto yy114;
 	case 'U':
-	case 'u':	goto yy121;
+	case 'u':	goto yy116;
 	case 'W':
-	case 'w':	goto yy122;
-	default:	goto yy64;
+	case 'w':	goto yy117;
+	default:	goto yy58;
 	}
-yy68:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy62:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'F':
-	case 'f':	goto yy124;
+	case 'f':	goto yy119;
 	case 'U':
-	case 'u':	goto yy125;
-	default:	goto yy64;
+	case 'u':	goto yy120;
+	default:	goto yy58;
 	}
-yy69:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy63:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'O':
-	case 'o':	goto yy126;
-	default:	goto yy64;
+	case 'o':	goto yy121;
+	default:	goto yy58;
 	}
-yy70:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy64:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'R':
-	case 'r':	goto yy127;
-	default:	goto yy64;
+	case 'r':	goto yy122;
+	default:	goto yy58;
 	}
-yy71:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy65:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'O':
-	case 'o':	goto yy129;
+	case 'o':	goto yy124;
 	case 'U':
-	case 'u':	goto yy130;
-	default:	goto yy64;
+	case 'u':	goto yy125;
+	default:	goto yy58;
 	}
-yy72:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy66:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'E':
-	case 'e':	goto yy131;
-	default:	goto yy64;
+	case 'e':	goto yy126;
+	default:	goto yy58;
 	}
-yy73:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy67:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'B':
-	case 'b':	goto yy132;
+	case 'b':	goto yy127;
 	case 'E':
-	case 'e':	goto yy134;
+	case 'e':	goto yy129;
 	case 'L':
-	case 'l':	goto yy135;
+	case 'l':	goto yy130;
 	case 'N':
-	case 'n':	goto yy136;
+	case 'n':	goto yy131;
 	case 'R':
-	case 'r':	goto yy137;
+	case 'r':	goto yy132;
 	case 'U':
-	case 'u':	goto yy138;
+	case 'u':	goto yy133;
 	case 'W':
-	case 'w':	goto yy139;
+	case 'w':	goto yy134;
 	case 'Y':
-	case 'y':	goto yy141;
-	default:	goto yy64;
+	case 'y':	goto yy136;
+	default:	goto yy58;
 	}
-yy74:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy68:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'O':
-	case 'o':	goto yy142;
-	default:	goto yy64;
+	case 'o':	goto yy137;
+	default:	goto yy58;
 	}
-yy75:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-yy76:
+yy69:
+	if (++in.cursor > in.limit) continue;
+yy70:
 	s = yyt1;
-	e = in.eof() ? std::streampos(0) : in.tellg();
+	e = in.cursor;
 	{ TOKENV(REGISTER, std::stoi(GET_STRING())); }
-yy77:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy71:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -6284,63 +6841,63 @@ yy77:
 	case '6':
 	case '7':
 	case '8':
-	case '9':	goto yy75;
-	default:	goto yy76;
+	case '9':	goto yy69;
+	default:	goto yy70;
 	}
-yy78:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy72:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
-	case '1':	goto yy75;
-	default:	goto yy76;
+	case '1':	goto yy69;
+	default:	goto yy70;
 	}
-yy79:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy73:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
 	case '2':
 	case '3':
-	case 't':	goto yy143;
-	default:	goto yy80;
+	case 't':	goto yy138;
+	default:	goto yy74;
 	}
-yy80:
-	in.seekg(mar);
+yy74:
+	in.cursor = mar;
 	switch (yyaccept) {
 	case 0:
-		goto yy34;
+		goto yy28;
 	case 1:
-		goto yy53;
+		goto yy47;
 	default:
-		goto yy240;
+		goto yy239;
 	}
-yy81:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy75:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
-	case 'p':	goto yy143;
-	default:	goto yy80;
+	case 'p':	goto yy138;
+	default:	goto yy74;
 	}
-yy82:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy76:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
-	case '1':	goto yy143;
-	default:	goto yy80;
+	case '1':	goto yy138;
+	default:	goto yy74;
 	}
-yy83:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy77:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
-	case 'a':	goto yy143;
-	default:	goto yy80;
+	case 'a':	goto yy138;
+	default:	goto yy74;
 	}
-yy84:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy78:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -6350,12 +6907,12 @@ yy84:
 	case '5':
 	case '6':
 	case '7':
-	case 'p':	goto yy143;
-	default:	goto yy80;
+	case 'p':	goto yy138;
+	default:	goto yy74;
 	}
-yy85:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy79:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -6366,121 +6923,121 @@ yy85:
 	case '6':
 	case '7':
 	case '8':
-	case '9':	goto yy143;
-	default:	goto yy80;
+	case '9':	goto yy138;
+	default:	goto yy74;
 	}
-yy86:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy80:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
-	case 'e':	goto yy145;
-	default:	goto yy80;
+	case 'e':	goto yy140;
+	default:	goto yy74;
 	}
-yy87:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy81:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
-	case '\'':	goto yy146;
-	default:	goto yy80;
+	case '\'':	goto yy141;
+	default:	goto yy74;
 	}
-yy88:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy82:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
-	case '\n':	goto yy80;
-	default:	goto yy148;
+	case '\n':	goto yy74;
+	default:	goto yy143;
 	}
-yy89:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy83:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'L':
-	case 'l':	goto yy149;
+	case 'l':	goto yy144;
 	case 'S':
-	case 's':	goto yy150;
-	default:	goto yy80;
+	case 's':	goto yy145;
+	default:	goto yy74;
 	}
-yy90:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy84:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'Y':
-	case 'y':	goto yy151;
-	default:	goto yy80;
+	case 'y':	goto yy146;
+	default:	goto yy74;
 	}
-yy91:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy85:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'A':
-	case 'a':	goto yy152;
+	case 'a':	goto yy147;
 	case 'B':
-	case 'b':	goto yy153;
+	case 'b':	goto yy148;
 	case 'E':
-	case 'e':	goto yy154;
-	default:	goto yy80;
+	case 'e':	goto yy149;
+	default:	goto yy74;
 	}
-yy92:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy86:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'R':
-	case 'r':	goto yy155;
-	default:	goto yy80;
+	case 'r':	goto yy150;
+	default:	goto yy74;
 	}
-yy93:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy87:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'N':
-	case 'n':	goto yy156;
-	default:	goto yy80;
+	case 'n':	goto yy151;
+	default:	goto yy74;
 	}
-yy94:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy88:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'A':
-	case 'a':	goto yy157;
+	case 'a':	goto yy152;
 	case 'E':
-	case 'e':	goto yy158;
-	default:	goto yy80;
+	case 'e':	goto yy153;
+	default:	goto yy74;
 	}
-yy95:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy89:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'P':
-	case 'p':	goto yy159;
-	default:	goto yy80;
+	case 'p':	goto yy154;
+	default:	goto yy74;
 	}
-yy96:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy90:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'E':
-	case 'e':	goto yy160;
-	default:	goto yy80;
+	case 'e':	goto yy155;
+	default:	goto yy74;
 	}
-yy97:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy91:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'O':
-	case 'o':	goto yy161;
-	default:	goto yy80;
+	case 'o':	goto yy156;
+	default:	goto yy74;
 	}
-yy98:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy92:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
-	case '1':	goto yy162;
-	default:	goto yy80;
+	case '1':	goto yy157;
+	default:	goto yy74;
 	}
-yy99:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy93:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -6503,120 +7060,130 @@ yy99:
 	case 'c':
 	case 'd':
 	case 'e':
-	case 'f':	goto yy165;
-	default:	goto yy80;
+	case 'f':	goto yy160;
+	default:	goto yy74;
 	}
-yy100:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy94:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'D':
-	case 'd':	goto yy168;
-	default:	goto yy64;
+	case 'd':	goto yy163;
+	default:	goto yy58;
 	}
-yy101:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy95:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
+	switch (yych) {
+	case 'O':
+	case 'o':	goto yy165;
+	default:	goto yy58;
+	}
+yy96:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'D':
-	case 'd':	goto yy170;
-	default:	goto yy64;
+	case 'd':	goto yy166;
+	default:	goto yy58;
 	}
-yy102:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy97:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'L':
-	case 'l':	goto yy172;
-	default:	goto yy64;
+	case 'l':	goto yy168;
+	default:	goto yy58;
 	}
-yy103:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy98:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'Q':
-	case 'q':	goto yy174;
-	default:	goto yy64;
+	case 'q':	goto yy170;
+	default:	goto yy58;
 	}
-yy104:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy99:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'E':
-	case 'e':	goto yy176;
+	case 'e':	goto yy172;
 	case 'T':
-	case 't':	goto yy178;
-	default:	goto yy64;
+	case 't':	goto yy174;
+	default:	goto yy58;
 	}
-yy105:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy100:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'E':
-	case 'e':	goto yy180;
+	case 'e':	goto yy176;
 	case 'T':
-	case 't':	goto yy182;
-	default:	goto yy64;
+	case 't':	goto yy178;
+	default:	goto yy58;
 	}
-yy106:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy101:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'E':
-	case 'e':	goto yy184;
-	default:	goto yy64;
+	case 'e':	goto yy180;
+	default:	goto yy58;
 	}
-yy107:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy102:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'L':
-	case 'l':	goto yy186;
-	default:	goto yy64;
+	case 'l':	goto yy182;
+	case 'S':
+	case 's':	goto yy183;
+	default:	goto yy58;
 	}
-yy108:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy103:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'R':
-	case 'r':	goto yy187;
-	default:	goto yy64;
+	case 'r':	goto yy185;
+	default:	goto yy58;
 	}
-yy109:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy104:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'P':
-	case 'p':	goto yy189;
-	default:	goto yy64;
+	case 'p':	goto yy187;
+	default:	goto yy58;
 	}
-yy110:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy105:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'V':
-	case 'v':	goto yy190;
-	default:	goto yy64;
+	case 'v':	goto yy188;
+	default:	goto yy58;
 	}
-yy111:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy106:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'T':
-	case 't':	goto yy192;
-	default:	goto yy64;
+	case 't':	goto yy190;
+	default:	goto yy58;
 	}
-yy112:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy107:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'L':
-	case 'l':	goto yy193;
-	default:	goto yy64;
+	case 'l':	goto yy191;
+	default:	goto yy58;
 	}
-yy113:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy108:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -6680,14 +7247,14 @@ yy113:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy114;
+	case 'z':	goto yy57;
+	default:	goto yy109;
 	}
-yy114:
+yy109:
 	{ TOKEN(JR); }
-yy115:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy110:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -6751,14 +7318,14 @@ yy115:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy116;
+	case 'z':	goto yy57;
+	default:	goto yy111;
 	}
-yy116:
+yy111:
 	{ TOKEN(LA); }
-yy117:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy112:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -6822,14 +7389,14 @@ yy117:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy118;
+	case 'z':	goto yy57;
+	default:	goto yy113;
 	}
-yy118:
+yy113:
 	{ TOKEN(LB); }
-yy119:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy114:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -6893,22 +7460,22 @@ yy119:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy120;
+	case 'z':	goto yy57;
+	default:	goto yy115;
 	}
-yy120:
+yy115:
 	{ TOKEN(LI); }
-yy121:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy116:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'I':
-	case 'i':	goto yy195;
-	default:	goto yy64;
+	case 'i':	goto yy193;
+	default:	goto yy58;
 	}
-yy122:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy117:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -6972,44 +7539,44 @@ yy122:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy123;
+	case 'z':	goto yy57;
+	default:	goto yy118;
 	}
-yy123:
+yy118:
 	{ TOKEN(LW); }
-yy124:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy119:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'H':
-	case 'h':	goto yy197;
+	case 'h':	goto yy195;
 	case 'L':
-	case 'l':	goto yy198;
-	default:	goto yy64;
+	case 'l':	goto yy196;
+	default:	goto yy58;
 	}
-yy125:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy120:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'L':
-	case 'l':	goto yy199;
-	default:	goto yy64;
+	case 'l':	goto yy197;
+	default:	goto yy58;
 	}
-yy126:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy121:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'P':
-	case 'p':	goto yy200;
+	case 'p':	goto yy198;
 	case 'R':
-	case 'r':	goto yy202;
+	case 'r':	goto yy200;
 	case 'T':
-	case 't':	goto yy204;
-	default:	goto yy64;
+	case 't':	goto yy202;
+	default:	goto yy58;
 	}
-yy127:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy122:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -7071,42 +7638,42 @@ yy127:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'I':
-	case 'i':	goto yy206;
-	default:	goto yy128;
+	case 'i':	goto yy204;
+	default:	goto yy123;
 	}
-yy128:
+yy123:
 	{ TOKEN(OR); }
-yy129:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy124:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'P':
-	case 'p':	goto yy208;
-	default:	goto yy64;
+	case 'p':	goto yy206;
+	default:	goto yy58;
 	}
-yy130:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy125:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'S':
-	case 's':	goto yy209;
-	default:	goto yy64;
+	case 's':	goto yy207;
+	default:	goto yy58;
 	}
-yy131:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy126:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'M':
-	case 'm':	goto yy210;
+	case 'm':	goto yy208;
 	case 'T':
-	case 't':	goto yy212;
-	default:	goto yy64;
+	case 't':	goto yy210;
+	default:	goto yy58;
 	}
-yy132:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy127:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -7170,58 +7737,58 @@ yy132:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy133;
+	case 'z':	goto yy57;
+	default:	goto yy128;
 	}
-yy133:
+yy128:
 	{ TOKEN(SB); }
-yy134:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy129:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'Q':
-	case 'q':	goto yy214;
-	default:	goto yy64;
+	case 'q':	goto yy212;
+	default:	goto yy58;
 	}
-yy135:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy130:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'L':
-	case 'l':	goto yy216;
+	case 'l':	goto yy214;
 	case 'T':
-	case 't':	goto yy218;
-	default:	goto yy64;
+	case 't':	goto yy216;
+	default:	goto yy58;
 	}
-yy136:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy131:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'E':
-	case 'e':	goto yy220;
-	default:	goto yy64;
+	case 'e':	goto yy218;
+	default:	goto yy58;
 	}
-yy137:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy132:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'A':
-	case 'a':	goto yy222;
+	case 'a':	goto yy220;
 	case 'L':
-	case 'l':	goto yy224;
-	default:	goto yy64;
+	case 'l':	goto yy222;
+	default:	goto yy58;
 	}
-yy138:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy133:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'B':
-	case 'b':	goto yy226;
-	default:	goto yy64;
+	case 'b':	goto yy224;
+	default:	goto yy58;
 	}
-yy139:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy134:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -7285,171 +7852,173 @@ yy139:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy140;
+	case 'z':	goto yy57;
+	default:	goto yy135;
 	}
-yy140:
+yy135:
 	{ TOKEN(SW); }
-yy141:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy136:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
+	case 'N':
+	case 'n':	goto yy226;
 	case 'S':
-	case 's':	goto yy228;
-	default:	goto yy64;
+	case 's':	goto yy227;
+	default:	goto yy58;
 	}
-yy142:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy137:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'R':
-	case 'r':	goto yy230;
-	default:	goto yy64;
+	case 'r':	goto yy229;
+	default:	goto yy58;
 	}
-yy143:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy138:
+	if (++in.cursor > in.limit) continue;
 	s = yyt1;
-	e = in.eof() ? std::streampos(0) : in.tellg();
+	e = in.cursor;
 	{ TOKENV(REGISTER, REGISTER_NAMES.at(GET_STRING())); }
-yy145:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy140:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
-	case 'r':	goto yy232;
-	default:	goto yy80;
+	case 'r':	goto yy231;
+	default:	goto yy74;
 	}
-yy146:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	s = in.eof() ? std::streampos(0) : in.tellg();
+yy141:
+	if (++in.cursor > in.limit) continue;
+	s = in.cursor;
 	s += -2;
-	e = in.eof() ? std::streampos(0) : in.tellg();
+	e = in.cursor;
 	{ TOKENV(LITERAL, GET_CHAR()); }
-yy148:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy143:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
-	case '\'':	goto yy233;
-	default:	goto yy80;
+	case '\'':	goto yy232;
+	default:	goto yy74;
 	}
-yy149:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy144:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'I':
-	case 'i':	goto yy235;
-	default:	goto yy80;
+	case 'i':	goto yy234;
+	default:	goto yy74;
 	}
-yy150:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy145:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'C':
-	case 'c':	goto yy236;
-	default:	goto yy80;
+	case 'c':	goto yy235;
+	default:	goto yy74;
 	}
-yy151:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy146:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'T':
-	case 't':	goto yy237;
-	default:	goto yy80;
+	case 't':	goto yy236;
+	default:	goto yy74;
 	}
-yy152:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy147:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'T':
-	case 't':	goto yy238;
-	default:	goto yy80;
+	case 't':	goto yy237;
+	default:	goto yy74;
 	}
-yy153:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy148:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'G':
-	case 'g':	goto yy239;
-	default:	goto yy80;
+	case 'g':	goto yy238;
+	default:	goto yy74;
 	}
-yy154:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy149:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'F':
-	case 'f':	goto yy241;
-	default:	goto yy80;
+	case 'f':	goto yy240;
+	default:	goto yy74;
 	}
-yy155:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy150:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'R':
-	case 'r':	goto yy242;
-	default:	goto yy80;
+	case 'r':	goto yy241;
+	default:	goto yy74;
 	}
-yy156:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy151:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'C':
-	case 'c':	goto yy243;
-	default:	goto yy80;
+	case 'c':	goto yy242;
+	default:	goto yy74;
 	}
-yy157:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy152:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'C':
-	case 'c':	goto yy244;
-	default:	goto yy80;
+	case 'c':	goto yy243;
+	default:	goto yy74;
 	}
-yy158:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy153:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'S':
-	case 's':	goto yy245;
-	default:	goto yy80;
+	case 's':	goto yy244;
+	default:	goto yy74;
 	}
-yy159:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy154:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'A':
-	case 'a':	goto yy246;
-	default:	goto yy80;
+	case 'a':	goto yy245;
+	default:	goto yy74;
 	}
-yy160:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy155:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'X':
-	case 'x':	goto yy247;
-	default:	goto yy80;
+	case 'x':	goto yy246;
+	default:	goto yy74;
 	}
-yy161:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy156:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'R':
-	case 'r':	goto yy248;
-	default:	goto yy80;
+	case 'r':	goto yy247;
+	default:	goto yy74;
 	}
-yy162:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy157:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
-	case '1':	goto yy162;
-	default:	goto yy164;
+	case '1':	goto yy157;
+	default:	goto yy159;
 	}
-yy164:
+yy159:
 	s = yyt1;
-	e = in.eof() ? std::streampos(0) : in.tellg();
+	e = in.cursor;
 	{ TOKENV(LITERAL, std::stoi(GET_STRING(), nullptr, 2)); }
-yy165:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy160:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -7472,16 +8041,16 @@ yy165:
 	case 'c':
 	case 'd':
 	case 'e':
-	case 'f':	goto yy165;
-	default:	goto yy167;
+	case 'f':	goto yy160;
+	default:	goto yy162;
 	}
-yy167:
+yy162:
 	s = yyt1;
-	e = in.eof() ? std::streampos(0) : in.tellg();
+	e = in.cursor;
 	{ TOKENV(LITERAL, std::stoi(GET_STRING(), nullptr, 16)); }
-yy168:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy163:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -7541,18 +8110,28 @@ yy168:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'I':
-	case 'i':	goto yy249;
+	case 'i':	goto yy248;
 	case 'U':
-	case 'u':	goto yy251;
-	default:	goto yy169;
+	case 'u':	goto yy250;
+	default:	goto yy164;
 	}
-yy169:
+yy164:
 	{ TOKEN(ADD); }
-yy170:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy165:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
+	switch (yych) {
+	case 'A':
+	case 'a':	goto yy252;
+	case 'S':
+	case 's':	goto yy253;
+	default:	goto yy58;
+	}
+yy166:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -7614,16 +8193,16 @@ yy170:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'I':
-	case 'i':	goto yy253;
-	default:	goto yy171;
+	case 'i':	goto yy254;
+	default:	goto yy167;
 	}
-yy171:
+yy167:
 	{ TOKEN(AND); }
-yy172:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy168:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -7687,14 +8266,14 @@ yy172:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy173;
+	case 'z':	goto yy57;
+	default:	goto yy169;
 	}
-yy173:
+yy169:
 	{ TOKEN(BAL); }
-yy174:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy170:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -7756,16 +8335,16 @@ yy174:
 	case 'v':
 	case 'w':
 	case 'x':
-	case 'y':	goto yy63;
+	case 'y':	goto yy57;
 	case 'Z':
-	case 'z':	goto yy255;
-	default:	goto yy175;
+	case 'z':	goto yy256;
+	default:	goto yy171;
 	}
-yy175:
+yy171:
 	{ TOKEN(BEQ); }
-yy176:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy172:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -7827,16 +8406,16 @@ yy176:
 	case 'v':
 	case 'w':
 	case 'x':
-	case 'y':	goto yy63;
+	case 'y':	goto yy57;
 	case 'Z':
-	case 'z':	goto yy257;
-	default:	goto yy177;
+	case 'z':	goto yy258;
+	default:	goto yy173;
 	}
-yy177:
+yy173:
 	{ TOKEN(BGE); }
-yy178:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy174:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -7896,18 +8475,18 @@ yy178:
 	case 'v':
 	case 'w':
 	case 'x':
-	case 'y':	goto yy63;
+	case 'y':	goto yy57;
 	case 'U':
-	case 'u':	goto yy259;
+	case 'u':	goto yy260;
 	case 'Z':
-	case 'z':	goto yy261;
-	default:	goto yy179;
+	case 'z':	goto yy262;
+	default:	goto yy175;
 	}
-yy179:
+yy175:
 	{ TOKEN(BGT); }
-yy180:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy176:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -7969,16 +8548,16 @@ yy180:
 	case 'v':
 	case 'w':
 	case 'x':
-	case 'y':	goto yy63;
+	case 'y':	goto yy57;
 	case 'Z':
-	case 'z':	goto yy263;
-	default:	goto yy181;
+	case 'z':	goto yy264;
+	default:	goto yy177;
 	}
-yy181:
+yy177:
 	{ TOKEN(BLE); }
-yy182:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy178:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -8040,16 +8619,16 @@ yy182:
 	case 'v':
 	case 'w':
 	case 'x':
-	case 'y':	goto yy63;
+	case 'y':	goto yy57;
 	case 'Z':
-	case 'z':	goto yy265;
-	default:	goto yy183;
+	case 'z':	goto yy266;
+	default:	goto yy179;
 	}
-yy183:
+yy179:
 	{ TOKEN(BLT); }
-yy184:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy180:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -8113,22 +8692,22 @@ yy184:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy185;
+	case 'z':	goto yy57;
+	default:	goto yy181;
 	}
-yy185:
+yy181:
 	{ TOKEN(BNE); }
-yy186:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy182:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'L':
-	case 'l':	goto yy267;
-	default:	goto yy64;
+	case 'l':	goto yy268;
+	default:	goto yy58;
 	}
-yy187:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy183:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -8192,22 +8771,93 @@ yy187:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy188;
+	case 'z':	goto yy57;
+	default:	goto yy184;
 	}
-yy188:
+yy184:
+	{ TOKEN(CAS); }
+yy185:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
+	switch (yych) {
+	case '0':
+	case '1':
+	case '2':
+	case '3':
+	case '4':
+	case '5':
+	case '6':
+	case '7':
+	case '8':
+	case '9':
+	case 'A':
+	case 'B':
+	case 'C':
+	case 'D':
+	case 'E':
+	case 'F':
+	case 'G':
+	case 'H':
+	case 'I':
+	case 'J':
+	case 'K':
+	case 'L':
+	case 'M':
+	case 'N':
+	case 'O':
+	case 'P':
+	case 'Q':
+	case 'R':
+	case 'S':
+	case 'T':
+	case 'U':
+	case 'V':
+	case 'W':
+	case 'X':
+	case 'Y':
+	case 'Z':
+	case '_':
+	case 'a':
+	case 'b':
+	case 'c':
+	case 'd':
+	case 'e':
+	case 'f':
+	case 'g':
+	case 'h':
+	case 'i':
+	case 'j':
+	case 'k':
+	case 'l':
+	case 'm':
+	case 'n':
+	case 'o':
+	case 'p':
+	case 'q':
+	case 'r':
+	case 's':
+	case 't':
+	case 'u':
+	case 'v':
+	case 'w':
+	case 'x':
+	case 'y':
+	case 'z':	goto yy57;
+	default:	goto yy186;
+	}
+yy186:
 	{ TOKEN(CLR); }
-yy189:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy187:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'Y':
-	case 'y':	goto yy269;
-	default:	goto yy64;
+	case 'y':	goto yy270;
+	default:	goto yy58;
 	}
-yy190:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy188:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -8269,24 +8919,24 @@ yy190:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'U':
-	case 'u':	goto yy271;
-	default:	goto yy191;
+	case 'u':	goto yy272;
+	default:	goto yy189;
 	}
-yy191:
+yy189:
 	{ TOKEN(DIV); }
-yy192:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy190:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'E':
-	case 'e':	goto yy273;
-	default:	goto yy64;
+	case 'e':	goto yy274;
+	default:	goto yy58;
 	}
-yy193:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy191:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -8348,16 +8998,16 @@ yy193:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'R':
-	case 'r':	goto yy274;
-	default:	goto yy194;
+	case 'r':	goto yy275;
+	default:	goto yy192;
 	}
-yy194:
+yy192:
 	{ TOKEN(JAL); }
-yy195:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy193:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -8421,38 +9071,38 @@ yy195:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy196;
+	case 'z':	goto yy57;
+	default:	goto yy194;
 	}
-yy196:
+yy194:
 	{ TOKEN(LUI); }
-yy197:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy195:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'I':
-	case 'i':	goto yy276;
-	default:	goto yy64;
+	case 'i':	goto yy277;
+	default:	goto yy58;
 	}
-yy198:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy196:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'O':
-	case 'o':	goto yy278;
-	default:	goto yy64;
+	case 'o':	goto yy279;
+	default:	goto yy58;
 	}
-yy199:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy197:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'T':
-	case 't':	goto yy280;
-	default:	goto yy64;
+	case 't':	goto yy281;
+	default:	goto yy58;
 	}
-yy200:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy198:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -8516,14 +9166,14 @@ yy200:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy201;
+	case 'z':	goto yy57;
+	default:	goto yy199;
 	}
-yy201:
+yy199:
 	{ TOKEN(NOP); }
-yy202:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy200:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -8587,14 +9237,14 @@ yy202:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy203;
+	case 'z':	goto yy57;
+	default:	goto yy201;
 	}
-yy203:
+yy201:
 	{ TOKEN(NOR); }
-yy204:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy202:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -8658,14 +9308,14 @@ yy204:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy205;
+	case 'z':	goto yy57;
+	default:	goto yy203;
 	}
-yy205:
+yy203:
 	{ TOKEN(NOT); }
-yy206:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy204:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -8729,32 +9379,32 @@ yy206:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy207;
+	case 'z':	goto yy57;
+	default:	goto yy205;
 	}
-yy207:
+yy205:
 	{ TOKEN(ORI); }
-yy208:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy206:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'B':
-	case 'b':	goto yy282;
+	case 'b':	goto yy283;
 	case 'W':
-	case 'w':	goto yy284;
-	default:	goto yy64;
+	case 'w':	goto yy285;
+	default:	goto yy58;
 	}
-yy209:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy207:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'H':
-	case 'h':	goto yy286;
-	default:	goto yy64;
+	case 'h':	goto yy287;
+	default:	goto yy58;
 	}
-yy210:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy208:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -8818,14 +9468,14 @@ yy210:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy211;
+	case 'z':	goto yy57;
+	default:	goto yy209;
 	}
-yy211:
+yy209:
 	{ TOKEN(REM); }
-yy212:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy210:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -8889,14 +9539,14 @@ yy212:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy213;
+	case 'z':	goto yy57;
+	default:	goto yy211;
 	}
-yy213:
+yy211:
 	{ TOKEN(RET); }
-yy214:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy212:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -8960,14 +9610,14 @@ yy214:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy215;
+	case 'z':	goto yy57;
+	default:	goto yy213;
 	}
-yy215:
+yy213:
 	{ TOKEN(SEQ); }
-yy216:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy214:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -9029,16 +9679,16 @@ yy216:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'V':
-	case 'v':	goto yy287;
-	default:	goto yy217;
+	case 'v':	goto yy288;
+	default:	goto yy215;
 	}
-yy217:
+yy215:
 	{ TOKEN(SLL); }
-yy218:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy216:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -9098,18 +9748,18 @@ yy218:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'I':
-	case 'i':	goto yy289;
+	case 'i':	goto yy290;
 	case 'U':
-	case 'u':	goto yy291;
-	default:	goto yy219;
+	case 'u':	goto yy292;
+	default:	goto yy217;
 	}
-yy219:
+yy217:
 	{ TOKEN(SLT); }
-yy220:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy218:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -9173,14 +9823,14 @@ yy220:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy221;
+	case 'z':	goto yy57;
+	default:	goto yy219;
 	}
-yy221:
+yy219:
 	{ TOKEN(SNE); }
-yy222:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy220:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -9244,14 +9894,14 @@ yy222:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy223;
+	case 'z':	goto yy57;
+	default:	goto yy221;
 	}
-yy223:
+yy221:
 	{ TOKEN(SRA); }
-yy224:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy222:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -9313,16 +9963,16 @@ yy224:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'V':
-	case 'v':	goto yy293;
-	default:	goto yy225;
+	case 'v':	goto yy294;
+	default:	goto yy223;
 	}
-yy225:
+yy223:
 	{ TOKEN(SRL); }
-yy226:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy224:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -9384,16 +10034,24 @@ yy226:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'U':
-	case 'u':	goto yy295;
-	default:	goto yy227;
+	case 'u':	goto yy296;
+	default:	goto yy225;
 	}
-yy227:
+yy225:
 	{ TOKEN(SUB); }
-yy228:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy226:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
+	switch (yych) {
+	case 'C':
+	case 'c':	goto yy298;
+	default:	goto yy58;
+	}
+yy227:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -9457,14 +10115,14 @@ yy228:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy229;
+	case 'z':	goto yy57;
+	default:	goto yy228;
 	}
-yy229:
+yy228:
 	{ TOKEN(SYS); }
-yy230:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy229:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -9526,137 +10184,137 @@ yy230:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'I':
-	case 'i':	goto yy297;
-	default:	goto yy231;
+	case 'i':	goto yy300;
+	default:	goto yy230;
 	}
-yy231:
+yy230:
 	{ TOKEN(XOR); }
-yy232:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy231:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
-	case 'o':	goto yy143;
-	default:	goto yy80;
+	case 'o':	goto yy138;
+	default:	goto yy74;
 	}
-yy233:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	s = in.eof() ? std::streampos(0) : in.tellg();
+yy232:
+	if (++in.cursor > in.limit) continue;
+	s = in.cursor;
 	s += -2;
-	e = in.eof() ? std::streampos(0) : in.tellg();
+	e = in.cursor;
 	{ TOKENV(LITERAL, ESCAPE_SEQUENCES.at(GET_CHAR())); }
-yy235:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy234:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'G':
-	case 'g':	goto yy299;
-	default:	goto yy80;
+	case 'g':	goto yy302;
+	default:	goto yy74;
 	}
-yy236:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy235:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'I':
-	case 'i':	goto yy300;
-	default:	goto yy80;
+	case 'i':	goto yy303;
+	default:	goto yy74;
 	}
-yy237:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy236:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'E':
-	case 'e':	goto yy301;
-	default:	goto yy80;
+	case 'e':	goto yy304;
+	default:	goto yy74;
 	}
-yy238:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy237:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'A':
-	case 'a':	goto yy303;
-	default:	goto yy80;
+	case 'a':	goto yy306;
+	default:	goto yy74;
 	}
-yy239:
+yy238:
 	yyaccept = 2;
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	mar = in.tellg();
-	yych = in.peek();
+	if (++in.cursor > in.limit) continue;
+	mar = in.cursor;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'B':
-	case 'b':	goto yy305;
-	default:	goto yy240;
+	case 'b':	goto yy308;
+	default:	goto yy239;
 	}
-yy240:
+yy239:
 	{ TOKEN(DBG); }
-yy241:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy240:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'I':
-	case 'i':	goto yy306;
-	default:	goto yy80;
+	case 'i':	goto yy309;
+	default:	goto yy74;
 	}
-yy242:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy241:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'O':
-	case 'o':	goto yy307;
-	default:	goto yy80;
+	case 'o':	goto yy310;
+	default:	goto yy74;
 	}
-yy243:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy242:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'L':
-	case 'l':	goto yy308;
-	default:	goto yy80;
+	case 'l':	goto yy311;
+	default:	goto yy74;
 	}
-yy244:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy243:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'R':
-	case 'r':	goto yy309;
-	default:	goto yy80;
+	case 'r':	goto yy312;
+	default:	goto yy74;
 	}
-yy245:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy244:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'S':
-	case 's':	goto yy310;
-	default:	goto yy80;
+	case 's':	goto yy313;
+	default:	goto yy74;
 	}
-yy246:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy245:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'C':
-	case 'c':	goto yy311;
-	default:	goto yy80;
+	case 'c':	goto yy314;
+	default:	goto yy74;
 	}
-yy247:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy246:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'T':
-	case 't':	goto yy312;
-	default:	goto yy80;
+	case 't':	goto yy315;
+	default:	goto yy74;
 	}
-yy248:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy247:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'D':
-	case 'd':	goto yy314;
-	default:	goto yy80;
+	case 'd':	goto yy317;
+	default:	goto yy74;
 	}
-yy249:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy248:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -9718,16 +10376,16 @@ yy249:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'U':
-	case 'u':	goto yy316;
-	default:	goto yy250;
+	case 'u':	goto yy319;
+	default:	goto yy249;
 	}
-yy250:
+yy249:
 	{ TOKEN(ADDI); }
-yy251:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy250:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -9791,14 +10449,30 @@ yy251:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy252;
+	case 'z':	goto yy57;
+	default:	goto yy251;
 	}
-yy252:
+yy251:
 	{ TOKEN(ADDU); }
+yy252:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
+	switch (yych) {
+	case 'D':
+	case 'd':	goto yy321;
+	default:	goto yy58;
+	}
 yy253:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
+	switch (yych) {
+	case 'W':
+	case 'w':	goto yy322;
+	default:	goto yy58;
+	}
+yy254:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -9862,14 +10536,14 @@ yy253:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy254;
+	case 'z':	goto yy57;
+	default:	goto yy255;
 	}
-yy254:
-	{ TOKEN(ANDI); }
 yy255:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(ANDI); }
+yy256:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -9933,14 +10607,14 @@ yy255:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy256;
+	case 'z':	goto yy57;
+	default:	goto yy257;
 	}
-yy256:
-	{ TOKEN(BEQZ); }
 yy257:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(BEQZ); }
+yy258:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -10002,16 +10676,16 @@ yy257:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'A':
-	case 'a':	goto yy318;
-	default:	goto yy258;
+	case 'a':	goto yy323;
+	default:	goto yy259;
 	}
-yy258:
-	{ TOKEN(BGEZ); }
 yy259:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(BGEZ); }
+yy260:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -10075,14 +10749,14 @@ yy259:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy260;
+	case 'z':	goto yy57;
+	default:	goto yy261;
 	}
-yy260:
-	{ TOKEN(BGTU); }
 yy261:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(BGTU); }
+yy262:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -10146,14 +10820,14 @@ yy261:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy262;
+	case 'z':	goto yy57;
+	default:	goto yy263;
 	}
-yy262:
-	{ TOKEN(BGTZ); }
 yy263:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(BGTZ); }
+yy264:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -10217,14 +10891,14 @@ yy263:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy264;
+	case 'z':	goto yy57;
+	default:	goto yy265;
 	}
-yy264:
-	{ TOKEN(BLEZ); }
 yy265:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(BLEZ); }
+yy266:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -10286,16 +10960,16 @@ yy265:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'A':
-	case 'a':	goto yy319;
-	default:	goto yy266;
+	case 'a':	goto yy324;
+	default:	goto yy267;
 	}
-yy266:
-	{ TOKEN(BLTZ); }
 yy267:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(BLTZ); }
+yy268:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -10359,14 +11033,14 @@ yy267:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy268;
+	case 'z':	goto yy57;
+	default:	goto yy269;
 	}
-yy268:
-	{ TOKEN(CALL); }
 yy269:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(CALL); }
+yy270:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -10430,14 +11104,14 @@ yy269:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy270;
+	case 'z':	goto yy57;
+	default:	goto yy271;
 	}
-yy270:
-	{ TOKEN(COPY); }
 yy271:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(COPY); }
+yy272:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -10501,22 +11175,22 @@ yy271:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy272;
+	case 'z':	goto yy57;
+	default:	goto yy273;
 	}
-yy272:
-	{ TOKEN(DIVU); }
 yy273:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(DIVU); }
+yy274:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'R':
-	case 'r':	goto yy320;
-	default:	goto yy64;
+	case 'r':	goto yy325;
+	default:	goto yy58;
 	}
-yy274:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy275:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -10580,14 +11254,14 @@ yy274:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy275;
+	case 'z':	goto yy57;
+	default:	goto yy276;
 	}
-yy275:
-	{ TOKEN(JALR); }
 yy276:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(JALR); }
+yy277:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -10651,14 +11325,14 @@ yy276:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy277;
+	case 'z':	goto yy57;
+	default:	goto yy278;
 	}
-yy277:
-	{ TOKEN(MFHI); }
 yy278:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(MFHI); }
+yy279:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -10722,14 +11396,14 @@ yy278:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy279;
+	case 'z':	goto yy57;
+	default:	goto yy280;
 	}
-yy279:
-	{ TOKEN(MFLO); }
 yy280:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(MFLO); }
+yy281:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -10791,16 +11465,16 @@ yy280:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
+	case 'z':	goto yy57;
 	case 'U':
-	case 'u':	goto yy322;
-	default:	goto yy281;
+	case 'u':	goto yy327;
+	default:	goto yy282;
 	}
-yy281:
-	{ TOKEN(MULT); }
 yy282:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(MULT); }
+yy283:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -10864,14 +11538,14 @@ yy282:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy283;
+	case 'z':	goto yy57;
+	default:	goto yy284;
 	}
-yy283:
-	{ TOKEN(POPB); }
 yy284:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(POPB); }
+yy285:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -10935,24 +11609,95 @@ yy284:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy285;
+	case 'z':	goto yy57;
+	default:	goto yy286;
 	}
-yy285:
-	{ TOKEN(POPW); }
 yy286:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+	{ TOKEN(POPW); }
+yy287:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
+	switch (yych) {
+	case 'B':
+	case 'b':	goto yy329;
+	case 'W':
+	case 'w':	goto yy331;
+	default:	goto yy58;
+	}
+yy288:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
+	case '0':
+	case '1':
+	case '2':
+	case '3':
+	case '4':
+	case '5':
+	case '6':
+	case '7':
+	case '8':
+	case '9':
+	case 'A':
 	case 'B':
-	case 'b':	goto yy324;
+	case 'C':
+	case 'D':
+	case 'E':
+	case 'F':
+	case 'G':
+	case 'H':
+	case 'I':
+	case 'J':
+	case 'K':
+	case 'L':
+	case 'M':
+	case 'N':
+	case 'O':
+	case 'P':
+	case 'Q':
+	case 'R':
+	case 'S':
+	case 'T':
+	case 'U':
+	case 'V':
 	case 'W':
-	case 'w':	goto yy326;
-	default:	goto yy64;
+	case 'X':
+	case 'Y':
+	case 'Z':
+	case '_':
+	case 'a':
+	case 'b':
+	case 'c':
+	case 'd':
+	case 'e':
+	case 'f':
+	case 'g':
+	case 'h':
+	case 'i':
+	case 'j':
+	case 'k':
+	case 'l':
+	case 'm':
+	case 'n':
+	case 'o':
+	case 'p':
+	case 'q':
+	case 'r':
+	case 's':
+	case 't':
+	case 'u':
+	case 'v':
+	case 'w':
+	case 'x':
+	case 'y':
+	case 'z':	goto yy57;
+	default:	goto yy289;
 	}
-yy287:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy289:
+	{ TOKEN(SLLV); }
+yy290:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -10984,7 +11729,6 @@ yy287:
 	case 'R':
 	case 'S':
 	case 'T':
-	case 'U':
 	case 'V':
 	case 'W':
 	case 'X':
@@ -11011,19 +11755,20 @@ yy287:
 	case 'r':
 	case 's':
 	case 't':
-	case 'u':
 	case 'v':
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy288;
+	case 'z':	goto yy57;
+	case 'U':
+	case 'u':	goto yy333;
+	default:	goto yy291;
 	}
-yy288:
-	{ TOKEN(SLLV); }
-yy289:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy291:
+	{ TOKEN(SLTI); }
+yy292:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -11055,6 +11800,7 @@ yy289:
 	case 'R':
 	case 'S':
 	case 'T':
+	case 'U':
 	case 'V':
 	case 'W':
 	case 'X':
@@ -11081,20 +11827,19 @@ yy289:
 	case 'r':
 	case 's':
 	case 't':
+	case 'u':
 	case 'v':
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	case 'U':
-	case 'u':	goto yy328;
-	default:	goto yy290;
+	case 'z':	goto yy57;
+	default:	goto yy293;
 	}
-yy290:
-	{ TOKEN(SLTI); }
-yy291:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy293:
+	{ TOKEN(SLTU); }
+yy294:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -11158,14 +11903,14 @@ yy291:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy292;
+	case 'z':	goto yy57;
+	default:	goto yy295;
 	}
-yy292:
-	{ TOKEN(SLTU); }
-yy293:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy295:
+	{ TOKEN(SRLV); }
+yy296:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -11229,14 +11974,14 @@ yy293:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy294;
+	case 'z':	goto yy57;
+	default:	goto yy297;
 	}
-yy294:
-	{ TOKEN(SRLV); }
-yy295:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy297:
+	{ TOKEN(SUBU); }
+yy298:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -11300,14 +12045,14 @@ yy295:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy296;
+	case 'z':	goto yy57;
+	default:	goto yy299;
 	}
-yy296:
-	{ TOKEN(SUBU); }
-yy297:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy299:
+	{ TOKEN(SYNC); }
+yy300:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -11371,98 +12116,98 @@ yy297:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy298;
+	case 'z':	goto yy57;
+	default:	goto yy301;
 	}
-yy298:
+yy301:
 	{ TOKEN(XORI); }
-yy299:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy302:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'N':
-	case 'n':	goto yy330;
-	default:	goto yy80;
+	case 'n':	goto yy335;
+	default:	goto yy74;
 	}
-yy300:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy303:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'I':
-	case 'i':	goto yy332;
-	default:	goto yy80;
+	case 'i':	goto yy337;
+	default:	goto yy74;
 	}
-yy301:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy304:
+	if (++in.cursor > in.limit) continue;
 	{ TOKEN(BYTE); }
-yy303:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy306:
+	if (++in.cursor > in.limit) continue;
 	{ TOKEN(DATA); }
-yy305:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy308:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'P':
-	case 'p':	goto yy334;
-	default:	goto yy80;
+	case 'p':	goto yy339;
+	default:	goto yy74;
 	}
-yy306:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy309:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'N':
-	case 'n':	goto yy336;
-	default:	goto yy80;
+	case 'n':	goto yy341;
+	default:	goto yy74;
 	}
-yy307:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy310:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'R':
-	case 'r':	goto yy337;
-	default:	goto yy80;
+	case 'r':	goto yy342;
+	default:	goto yy74;
 	}
-yy308:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy311:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'U':
-	case 'u':	goto yy339;
-	default:	goto yy80;
+	case 'u':	goto yy344;
+	default:	goto yy74;
 	}
-yy309:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy312:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'O':
-	case 'o':	goto yy340;
-	default:	goto yy80;
+	case 'o':	goto yy345;
+	default:	goto yy74;
 	}
-yy310:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy313:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'A':
-	case 'a':	goto yy342;
-	default:	goto yy80;
+	case 'a':	goto yy347;
+	default:	goto yy74;
 	}
-yy311:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy314:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'E':
-	case 'e':	goto yy343;
-	default:	goto yy80;
+	case 'e':	goto yy348;
+	default:	goto yy74;
 	}
-yy312:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy315:
+	if (++in.cursor > in.limit) continue;
 	{ TOKEN(TEXT); }
-yy314:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy317:
+	if (++in.cursor > in.limit) continue;
 	{ TOKEN(WORD); }
-yy316:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy319:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -11526,30 +12271,46 @@ yy316:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy317;
+	case 'z':	goto yy57;
+	default:	goto yy320;
 	}
-yy317:
+yy320:
 	{ TOKEN(ADDIU); }
-yy318:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy321:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
+	switch (yych) {
+	case 'D':
+	case 'd':	goto yy350;
+	default:	goto yy58;
+	}
+yy322:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
+	switch (yych) {
+	case 'A':
+	case 'a':	goto yy352;
+	default:	goto yy58;
+	}
+yy323:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'L':
-	case 'l':	goto yy345;
-	default:	goto yy64;
+	case 'l':	goto yy353;
+	default:	goto yy58;
 	}
-yy319:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy324:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'L':
-	case 'l':	goto yy347;
-	default:	goto yy64;
+	case 'l':	goto yy355;
+	default:	goto yy58;
 	}
-yy320:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy325:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -11613,14 +12374,14 @@ yy320:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy321;
+	case 'z':	goto yy57;
+	default:	goto yy326;
 	}
-yy321:
+yy326:
 	{ TOKEN(ENTER); }
-yy322:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy327:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -11684,14 +12445,14 @@ yy322:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy323;
+	case 'z':	goto yy57;
+	default:	goto yy328;
 	}
-yy323:
+yy328:
 	{ TOKEN(MULTU); }
-yy324:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy329:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -11755,14 +12516,14 @@ yy324:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy325;
+	case 'z':	goto yy57;
+	default:	goto yy330;
 	}
-yy325:
+yy330:
 	{ TOKEN(PUSHB); }
-yy326:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy331:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -11826,14 +12587,14 @@ yy326:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy327;
+	case 'z':	goto yy57;
+	default:	goto yy332;
 	}
-yy327:
+yy332:
 	{ TOKEN(PUSHW); }
-yy328:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy333:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -11897,63 +12658,142 @@ yy328:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy329;
+	case 'z':	goto yy57;
+	default:	goto yy334;
 	}
-yy329:
+yy334:
 	{ TOKEN(SLTIU); }
-yy330:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy335:
+	if (++in.cursor > in.limit) continue;
 	{ TOKEN(ALIGN); }
-yy332:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy337:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'Z':
-	case 'z':	goto yy349;
-	default:	goto yy333;
+	case 'z':	goto yy357;
+	default:	goto yy338;
 	}
-yy333:
+yy338:
 	{ TOKEN(ASCII); }
-yy334:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy339:
+	if (++in.cursor > in.limit) continue;
 	{ TOKEN(DBGBP); }
-yy336:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy341:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'E':
-	case 'e':	goto yy351;
-	default:	goto yy80;
+	case 'e':	goto yy359;
+	default:	goto yy74;
 	}
-yy337:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy342:
+	if (++in.cursor > in.limit) continue;
 	{ TOKEN(ERROR); }
-yy339:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy344:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'D':
-	case 'd':	goto yy353;
-	default:	goto yy80;
+	case 'd':	goto yy361;
+	default:	goto yy74;
 	}
-yy340:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy345:
+	if (++in.cursor > in.limit) continue;
 	{ TOKEN(MACRO); }
-yy342:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy347:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'G':
-	case 'g':	goto yy354;
-	default:	goto yy80;
+	case 'g':	goto yy362;
+	default:	goto yy74;
 	}
-yy343:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy348:
+	if (++in.cursor > in.limit) continue;
 	{ TOKEN(SPACE); }
-yy345:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy350:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
+	switch (yych) {
+	case '0':
+	case '1':
+	case '2':
+	case '3':
+	case '4':
+	case '5':
+	case '6':
+	case '7':
+	case '8':
+	case '9':
+	case 'A':
+	case 'B':
+	case 'C':
+	case 'D':
+	case 'E':
+	case 'F':
+	case 'G':
+	case 'H':
+	case 'I':
+	case 'J':
+	case 'K':
+	case 'L':
+	case 'M':
+	case 'N':
+	case 'O':
+	case 'P':
+	case 'Q':
+	case 'R':
+	case 'S':
+	case 'T':
+	case 'U':
+	case 'V':
+	case 'W':
+	case 'X':
+	case 'Y':
+	case 'Z':
+	case '_':
+	case 'a':
+	case 'b':
+	case 'c':
+	case 'd':
+	case 'e':
+	case 'f':
+	case 'g':
+	case 'h':
+	case 'i':
+	case 'j':
+	case 'k':
+	case 'l':
+	case 'm':
+	case 'n':
+	case 'o':
+	case 'p':
+	case 'q':
+	case 'r':
+	case 's':
+	case 't':
+	case 'u':
+	case 'v':
+	case 'w':
+	case 'x':
+	case 'y':
+	case 'z':	goto yy57;
+	default:	goto yy351;
+	}
+yy351:
+	{ TOKEN(AMOADD); }
+yy352:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
+	switch (yych) {
+	case 'P':
+	case 'p':	goto yy363;
+	default:	goto yy58;
+	}
+yy353:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -12017,14 +12857,14 @@ yy345:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy346;
+	case 'z':	goto yy57;
+	default:	goto yy354;
 	}
-yy346:
+yy354:
 	{ TOKEN(BGEZAL); }
-yy347:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy355:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -12088,38 +12928,109 @@ yy347:
 	case 'w':
 	case 'x':
 	case 'y':
-	case 'z':	goto yy63;
-	default:	goto yy348;
+	case 'z':	goto yy57;
+	default:	goto yy356;
 	}
-yy348:
+yy356:
 	{ TOKEN(BLTZAL); }
-yy349:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy357:
+	if (++in.cursor > in.limit) continue;
 	{ TOKEN(ASCIIZ); }
-yy351:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy359:
+	if (++in.cursor > in.limit) continue;
 	{ TOKEN(DEFINE); }
-yy353:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy361:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'E':
-	case 'e':	goto yy355;
-	default:	goto yy80;
+	case 'e':	goto yy365;
+	default:	goto yy74;
 	}
-yy354:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = in.peek();
+yy362:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
 	switch (yych) {
 	case 'E':
-	case 'e':	goto yy357;
-	default:	goto yy80;
+	case 'e':	goto yy367;
+	default:	goto yy74;
 	}
-yy355:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy363:
+	if (++in.cursor > in.limit) continue;
+	yych = *in.cursor;
+	switch (yych) {
+	case '0':
+	case '1':
+	case '2':
+	case '3':
+	case '4':
+	case '5':
+	case '6':
+	case '7':
+	case '8':
+	case '9':
+	case 'A':
+	case 'B':
+	case 'C':
+	case 'D':
+	case 'E':
+	case 'F':
+	case 'G':
+	case 'H':
+	case 'I':
+	case 'J':
+	case 'K':
+	case 'L':
+	case 'M':
+	case 'N':
+	case 'O':
+	case 'P':
+	case 'Q':
+	case 'R':
+	case 'S':
+	case 'T':
+	case 'U':
+	case 'V':
+	case 'W':
+	case 'X':
+	case 'Y':
+	case 'Z':
+	case '_':
+	case 'a':
+	case 'b':
+	case 'c':
+	case 'd':
+	case 'e':
+	case 'f':
+	case 'g':
+	case 'h':
+	case 'i':
+	case 'j':
+	case 'k':
+	case 'l':
+	case 'm':
+	case 'n':
+	case 'o':
+	case 'p':
+	case 'q':
+	case 'r':
+	case 's':
+	case 't':
+	case 'u':
+	case 'v':
+	case 'w':
+	case 'x':
+	case 'y':
+	case 'z':	goto yy57;
+	default:	goto yy364;
+	}
+yy364:
+	{ TOKEN(AMOSWAP); }
+yy365:
+	if (++in.cursor > in.limit) continue;
 	{ TOKEN(INCLUDE); }
-yy357:
-	do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);
+yy367:
+	if (++in.cursor > in.limit) continue;
 	{ TOKEN(MESSAGE); }
 }
 
@@ -12129,10 +13040,7 @@ yy357:
 void yy::parser::error(const location_type& l, const std::string& message)
 {
     std::cerr << l.begin.filename->c_str() << ':' << l.begin.line << ':' << l.begin.column << '-' << l.end.column << ": " << message << '\n';
-	char buffer[20];
-	in.read(buffer, 19);
-	buffer[19] = 0;
-	std::cerr << buffer << std::endl;
+	std::cerr << std::string_view(in.cursor, std::min<std::ptrdiff_t>(in.limit - in.cursor, 19)) << std::endl;
 }
 
 namespace kasm
@@ -12143,6 +13051,8 @@ namespace kasm
         unresolvedAddressLocations.clear();
 		macros.clear();
 		macroFunctions.clear();
+		macroBodies.clear();
+		replays.clear();
 
 		in.setCallback(eofCallback);
 		in.open(asmPath);
@@ -12157,25 +13067,33 @@ namespace kasm
         yy::parser parser;
         if (parser.parse()) return;
 
-        for (AddressData unresolvedAddressLocation : unresolvedAddressLocations)
+        for (AddressData& unresolvedAddressLocation : unresolvedAddressLocations)
         {
-			binary.setLocation(unresolvedAddressLocation.position);
-			
 			resolveAddress(unresolvedAddressLocation, MUST_RESOLVE);
 
+			std::uint32_t position = unresolvedAddressLocation.position;
 			if (unresolvedAddressLocation.type == AddressType::DirectAddressAbsoluteByte)
 			{
-				binary.writeByte(static_cast<std::uint8_t>(unresolvedAddressLocation.instructionData.instruction));
+				binary.patchByte(position, static_cast<std::uint8_t>(unresolvedAddressLocation.instructionData.instruction));
 			}
 			else if (unresolvedAddressLocation.type == AddressType::DirectAddressAbsoluteLoad)
 			{
 				SplitWord l = { unresolvedAddressLocation.instructionData.instruction };
-				INSTRUCTION_RL(LUI, unresolvedAddressLocation.reg, l.hi);
-				INSTRUCTION_RRL(ORI, unresolvedAddressLocation.reg, unresolvedAddressLocation.reg, l.lo);
+				InstructionData upper{};
+				upper.opcode = Opcode::LUI;
+				upper.register0 = unresolvedAddressLocation.reg;
+				upper.immediate = l.hi;
+				InstructionData lower{};
+				lower.opcode = Opcode::ORI;
+				lower.register0 = unresolvedAddressLocation.reg;
+				lower.register1 = unresolvedAddressLocation.reg;
+				lower.immediate = l.lo;
+				binary.patchWord(position, upper.instruction);
+				binary.patchWord(position + INSTRUCTION_SIZE, lower.instruction);
 			}
 			else
 			{
-				binary.writeWord(unresolvedAddressLocation.instructionData.instruction);
+				binary.patchWord(position, unresolvedAddressLocation.instructionData.instruction);
 			}
         }
 
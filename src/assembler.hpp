@@ -28,6 +28,8 @@ namespace kasm
 
 		bool expandMacro(const std::string& name);
 		void assemble(const std::string& asmPath, const std::string& programPath, const std::string& symbolTablePath = "");
+		void setStackSize(std::uint32_t size) { binary.setStackSize(size); }
+		void setGlobalSize(std::uint32_t size) { binary.setGlobalSize(size); }
 		std::unordered_map<std::string, std::string> macros;
 		std::unordered_map<std::string, MacroFunction> macroFunctions;
 	private:
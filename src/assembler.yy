@@ -22,12 +22,15 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <stack>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
-#include "compoundInputFileStream.hpp"
+#include "inputStack.hpp"
 
 }//%code requires
 
@@ -48,13 +51,42 @@ struct MacroCall
 	std::vector<std::string> arguments;
 };
 
-static kasm::CompoundInputFileStream in;
+static kasm::InputStack in;
 static yy::location loc;
 static kasm::Assembler* assembler;
 static CTXFlag flag;
 static std::vector<MacroCall> macroCallStack;
 static std::stack<bool> labelInMacro;
 
+// A macro body lexed once, when the macro is defined. Calls replay its tokens instead of lexing the text again, but
+// the text is still pushed for the argument lists and lines the parser reads as text.
+struct MacroToken
+{
+	yy::parser::symbol_type symbol;
+	std::size_t begin; // offsets into the body
+	std::size_t end;
+	unsigned columns; // of whitespace before the token
+	int slot; // the parameter an identifier names, -1 for none
+};
+
+struct MacroBody
+{
+	std::shared_ptr<const std::string> text;
+	std::vector<MacroToken> tokens;
+};
+
+struct Replay
+{
+	std::shared_ptr<const MacroBody> body;
+	std::size_t depth; // of the view of the body in the input
+	std::size_t index;
+};
+
+static std::unordered_map<std::string, std::shared_ptr<const MacroBody>> macroBodies;
+static std::vector<Replay> replays;
+static bool tokenizing;
+static const char* tokenStart;
+
 void eofCallback(unsigned uid)
 {
 	KASM_ASSERT(!macroCallStack.empty(), "Trying to pop empty macro stack");
@@ -64,6 +96,67 @@ void eofCallback(unsigned uid)
 
 namespace yy { parser::symbol_type yylex(); }
 
+// Identifiers naming a parameter keep its index. A body that fails to lex is left to be lexed as text on every call,
+// where the error shows up.
+static void tokenizeMacro(const std::string& name)
+{
+	const kasm::Assembler::MacroFunction& macroFunction = assembler->macroFunctions[name];
+	auto body = std::make_shared<MacroBody>();
+	body->text = std::make_shared<const std::string>(macroFunction.body);
+
+	kasm::InputStack input;
+	input.pushString(body->text);
+	std::swap(in, input);
+	yy::location savedLoc = loc;
+	tokenizing = true;
+	try
+	{
+		for (;;)
+		{
+			loc.initialize();
+			yy::parser::symbol_type symbol = yy::yylex();
+			if (symbol.kind() == yy::parser::symbol_kind::S_YYEOF)
+			{
+				break;
+			}
+
+			int slot = -1;
+			if (symbol.kind() == yy::parser::symbol_kind::S_IDENTIFIER)
+			{
+				auto it = std::find(macroFunction.paramaters.begin(), macroFunction.paramaters.end(), symbol.value.as<std::string>());
+				if (it != macroFunction.paramaters.end())
+				{
+					slot = static_cast<int>(std::distance(macroFunction.paramaters.begin(), it));
+				}
+			}
+
+			const char* text = body->text->data();
+			body->tokens.push_back({ std::move(symbol), static_cast<std::size_t>(tokenStart - text), static_cast<std::size_t>(in.cursor - text), static_cast<unsigned>(loc.end.column - 1), slot });
+		}
+		macroBodies[name] = body;
+	}
+	catch (const std::exception&)
+	{
+	}
+	tokenizing = false;
+	loc = savedLoc;
+	std::swap(in, input);
+}
+
+static void callMacro(const std::string& name, const std::vector<std::string>& arguments)
+{
+	const kasm::Assembler::MacroFunction& macroFunction = assembler->macroFunctions[name];
+	auto it = macroBodies.find(name);
+	if (it == macroBodies.end())
+	{
+		macroCallStack.push_back({ in.pushString(macroFunction.body, true), macroFunction.paramaters, arguments });
+		return;
+	}
+
+	macroCallStack.push_back({ in.pushString(it->second->text, true), macroFunction.paramaters, arguments });
+	replays.push_back({ it->second, in.getDepth(), 0 });
+}
+
 #define INSTRUCTION_RRR(op, r0, r1, r2) {                           \
 	kasm::InstructionData instructionData;                          \
 	instructionData.opcode = kasm::Opcode::op;                    \
@@ -171,6 +264,7 @@ kasm::AddressData returnAddress(kasm::Register::RA);
 %token ADD ADDI ADDIU ADDU AND ANDI BEQ BGEZ BGEZAL BGTZ BLEZ BLTZ BLTZAL BNE
 %token DIV DIVU J JAL JR LB LUI LW MFHI MFLO MULT MULTU OR ORI SB SLL SLLV NOR
 %token SLT SLTI SLTIU SLTU SNE SEQ SRA SRL SRLV SUB SUBU SW SYS XOR XORI JALR
+%token CAS AMOADD AMOSWAP SYNC
 
 %token COPY CLR B BAL BGT BLT BGE BLE BGTU BEQZ REM LI LA NOP NOT PUSHW POPW PUSHB POPB RET CALL ENTER
 
@@ -293,8 +387,8 @@ statement
 	| DBG     STRING end_of_statement { in.pushString($2); } statement { $$ = $5; }
 	| DBGBP          end_of_statement { KASM_BREAKPOINT(); } statement { $$ = $4; }
 	| DEFINE IDENTIFIER { flag = CTXFlag::LINE_AS_STRING; } STRING { flag = CTXFlag::None; assembler->defineMacro($2, $4); } end_of_statement statement { $$ = $7; }
-	| MACRO IDENTIFIER '(' identifier_list ')' END_OF_LINE { flag = CTXFlag::BLOCK_AS_STRING; } STRING { flag = CTXFlag::None; assembler->defineMacro($2, $4, $8); } end_of_statement statement { $$ = $11; }
-	| IDENTIFIER '(' { flag = CTXFlag::ARGUMENT_LIST; } ARGUMENT_LIST { flag = CTXFlag::None; } end_of_statement { macroCallStack.push_back({in.pushString(assembler->macroFunctions[$1].body, true), assembler->macroFunctions[$1].paramaters, $4}); } statement { $$ = $8; }
+	| MACRO IDENTIFIER '(' identifier_list ')' END_OF_LINE { flag = CTXFlag::BLOCK_AS_STRING; } STRING { flag = CTXFlag::None; assembler->defineMacro($2, $4, $8); tokenizeMacro($2); } end_of_statement statement { $$ = $11; }
+	| IDENTIFIER '(' { flag = CTXFlag::ARGUMENT_LIST; } ARGUMENT_LIST { flag = CTXFlag::None; } end_of_statement { callMacro($1, $4); } statement { $$ = $8; }
 
 	// Instructions
     | ADD    REGISTER ',' REGISTER ',' REGISTER       end_of_statement { $$ = GET_LOC(); INSTRUCTION_RRR(ADD, $2, $4, $6); }
@@ -345,6 +439,10 @@ statement
 	| XORI   REGISTER ',' REGISTER ',' LITERAL        end_of_statement { $$ = GET_LOC(); INSTRUCTION_RRL(XORI, $2, $4, $6); }
 	| JALR   REGISTER ',' REGISTER                    end_of_statement { $$ = GET_LOC(); INSTRUCTION_RR(JALR, $2, $4); }
 	| NOR    REGISTER ',' REGISTER ',' REGISTER       end_of_statement { $$ = GET_LOC(); INSTRUCTION_RRR(NOR, $2, $4, $6); }
+	| CAS    REGISTER ',' REGISTER ',' '(' REGISTER ')' end_of_statement { $$ = GET_LOC(); INSTRUCTION_RRR(CAS, $2, $7, $4); }
+	| AMOADD REGISTER ',' REGISTER ',' '(' REGISTER ')' end_of_statement { $$ = GET_LOC(); INSTRUCTION_RRR(AMOADD, $2, $7, $4); }
+	| AMOSWAP REGISTER ',' REGISTER ',' '(' REGISTER ')' end_of_statement { $$ = GET_LOC(); INSTRUCTION_RRR(AMOSWAP, $2, $7, $4); }
+	| SYNC                                            end_of_statement { $$ = GET_LOC(); INSTRUCTION_O(SYNC); }
 
 	// Pseudoinstructions
 	| COPY   REGISTER ',' REGISTER                    end_of_statement { $$ = GET_LOC(); INSTRUCTION_RRL(OR, $2, $4, kasm::ZERO); }
@@ -551,7 +649,7 @@ static std::string lexStringLiteral(bool resolve = true)
 {
 	std::string str;
 
-	std::streampos mar;
+	[[maybe_unused]] const char* mar; // only used if the DFA needs to back up
 	for (;;)
 	{
 		%{ /* Begin re2c lexer */
@@ -559,10 +657,10 @@ static std::string lexStringLiteral(bool resolve = true)
 		re2c:flags:input = custom;
 		re2c:api:style = free-form;
 		re2c:define:YYCTYPE   = char;
-		re2c:define:YYPEEK    = "in.peek()";
-		re2c:define:YYSKIP    = "do { in.ignore(); if (in.eof()) throw std::runtime_error(\"Unclosed string\"); } while(0);";
-		re2c:define:YYBACKUP  = "mar = in.tellg();";
-		re2c:define:YYRESTORE = "in.seekg(mar);";
+		re2c:define:YYPEEK    = "*in.cursor";
+		re2c:define:YYSKIP    = "if (++in.cursor > in.limit) throw std::runtime_error(\"Unclosed string\");";
+		re2c:define:YYBACKUP  = "mar = in.cursor;";
+		re2c:define:YYRESTORE = "in.cursor = mar;";
 		
 		"\n" { throw std::runtime_error("Unclosed string"); }
 
@@ -577,82 +675,45 @@ static std::string lexStringLiteral(bool resolve = true)
 	return str;
 }
 
+// Up to the end of the line or a comment, which are left to the lexer
 static std::string lineAsString()
 {
-	std::string str;
-	char c;
-	std::streampos mar;
-	for (;;)
+	const char* start = in.cursor;
+	while (in.cursor < in.limit && *in.cursor != '\0' && *in.cursor != '#' && *in.cursor != '\n' && *in.cursor != '\r')
 	{
-		%{ /* Begin re2c lexer */
-		re2c:yyfill:enable = 0;
-		re2c:flags:input = custom;
-		re2c:api:style = free-form;
-		re2c:define:YYCTYPE   = char;
-		re2c:define:YYPEEK    = "in.peek()";
-		re2c:define:YYSKIP    = "do { in.ignore(); if (in.eof()) throw std::runtime_error(\"Unclosed line as string\"); } while(0);";
-		re2c:define:YYBACKUP  = "mar = in.tellg();";
-		re2c:define:YYRESTORE = "in.seekg(mar);";
-		
-		[\x00]|"#"|[\n\r] { c = yych; break; }
-		* { str.push_back(yych); continue; }
-		%}
+		in.cursor++;
 	}
-
-	in.put(c);
-	return str;
+	return std::string(start, in.cursor);
 }
 
+// Up to .end, in any case
 static std::string blockAsString()
 {
-	std::string str;
-	
-	for (;;)
+	const char* start = in.cursor;
+	for (; in.limit - in.cursor >= 4; in.cursor++)
 	{
-		char c;
-		in.get(c);
-		str.push_back(c);
-		if (str.length() >= 4)
+		if (in.cursor[0] == '.' && std::tolower(in.cursor[1]) == 'e' && std::tolower(in.cursor[2]) == 'n' && std::tolower(in.cursor[3]) == 'd')
 		{
-			std::string eos = str.substr(str.length() - 4, 4);
-			for (char& c : eos)
-			{
-				c = std::tolower(c);
-			}
-			if (eos == ".end") break;
+			std::string block(start, in.cursor);
+			in.cursor += 4;
+			return block;
 		}
 	}
-
-	return str.substr(0, str.length() - 4);
-}
-
-static std::string getString(std::streampos start, std::streampos end)
-{
-	std::string buffer;
-	buffer.resize(end - start);
-	in.seekg(start);
-	in.read(buffer.data(), end - start);
-	return buffer;
+	throw std::runtime_error("Unclosed block");
 }
 
-static char getChar(std::streampos start, std::streampos end)
-{
-	in.seekg(start);
-	char c;
-	in.get(c);
-	in.seekg(end);
-	return c;
-}
-
-#define GET_STRING() getString(s, e)
-#define GET_CHAR() getChar(s, e)
+// The text of a token, between its tags
+#define GET_STRING() std::string(s, e)
+#define GET_CHAR() (*s)
 
 static std::vector<std::string> argumentList()
 {
 	std::string argument;
 	std::vector<std::string> arguments;
-	std::streampos mar, s, e;
-	/*!stags:re2c format = 'std::streampos @@;'; */
+	[[maybe_unused]] const char* mar; // only used if the DFA needs to back up
+	const char* s;
+	const char* e;
+	/*!stags:re2c format = 'const char* @@;'; */
 	bool empty = true;
 	for (;;)
 	{
@@ -661,12 +722,12 @@ static std::vector<std::string> argumentList()
 		re2c:flags:input = custom;
 		re2c:api:style = free-form;
 		re2c:define:YYCTYPE   = char;
-		re2c:define:YYPEEK    = "in.peek()";
-		re2c:define:YYSKIP    = "do { in.ignore(); if (in.eof()) throw std::runtime_error(\"Unclosed argument list\"); } while(0);";
-		re2c:define:YYBACKUP  = "mar = in.tellg();";
-		re2c:define:YYRESTORE = "in.seekg(mar);";
-		re2c:define:YYSTAGP      = "@@{tag} = in.eof() ? std::streampos(0) : in.tellg();";
-		re2c:define:YYSTAGN      = "@@{tag} = 0;";
+		re2c:define:YYPEEK    = "*in.cursor";
+		re2c:define:YYSKIP    = "if (++in.cursor > in.limit) throw std::runtime_error(\"Unclosed argument list\");";
+		re2c:define:YYBACKUP  = "mar = in.cursor;";
+		re2c:define:YYRESTORE = "in.cursor = mar;";
+		re2c:define:YYSTAGP      = "@@{tag} = in.cursor;";
+		re2c:define:YYSTAGN      = "@@{tag} = nullptr;";
 		re2c:define:YYSHIFTSTAG  = "@@{tag} += @@{shift};";
         re2c:flags:tags = 1;
 		
@@ -706,10 +767,36 @@ static std::vector<std::string> argumentList()
 	return arguments;
 }
 
+// Pushes the argument or the value of the .define an identifier stands for, if any
+static bool substituteIdentifier(const std::string& identifier)
+{
+	if (!macroCallStack.empty())
+	{
+		MacroCall& mc = macroCallStack.back();
+		auto it = std::find(mc.paramaters.begin(), mc.paramaters.end(), identifier);
+		if (it != mc.paramaters.end())
+		{
+			auto index = std::distance(mc.paramaters.begin(), it);
+			in.pushString(mc.arguments[index]);
+			return true;
+		}
+	}
+
+	auto it = assembler->macros.find(identifier);
+	if (it != assembler->macros.end())
+	{
+		in.pushString(it->second);
+		return true;
+	}
+	return false;
+}
+
 yy::parser::symbol_type yy::yylex()
 {
-    std::streampos mar, s, e;
-    /*!stags:re2c format = 'std::streampos @@;'; */
+    const char* mar;
+    const char* s;
+    const char* e;
+    /*!stags:re2c format = 'const char* @@;'; */
 
 #define TOKEN(name) do { return parser::make_##name(loc); } while(0)
 #define TOKENV(name, ...) do { return parser::make_##name(__VA_ARGS__, loc); } while(0)
@@ -731,17 +818,80 @@ yy::parser::symbol_type yy::yylex()
 
 	for (;;)
 	{
+		if (!in.next()) TOKEN(END_OF_FILE);
+		tokenStart = in.cursor;
+
+		while (!replays.empty() && replays.back().depth > in.getDepth())
+		{
+			replays.pop_back();
+		}
+		if (!tokenizing && !replays.empty() && replays.back().depth == in.getDepth())
+		{
+			Replay& replay = replays.back();
+			const char* text = replay.body->text->data();
+			const std::vector<MacroToken>& tokens = replay.body->tokens;
+			std::size_t offset = in.cursor - text;
+			while (replay.index < tokens.size() && tokens[replay.index].begin < offset)
+			{
+				replay.index++;
+			}
+
+			// If the parser read part of the body as text and stopped between two tokens, lexing the rest of it as
+			// text gives the same tokens again. Otherwise it has to be lexed.
+			bool aligned = offset == 0 || (replay.index > 0 && tokens[replay.index - 1].end == offset) || (replay.index < tokens.size() && tokens[replay.index].begin == offset);
+			if (!aligned)
+			{
+				replays.pop_back();
+			}
+			else if (replay.index == tokens.size())
+			{
+				in.cursor = in.limit;
+				continue;
+			}
+			else
+			{
+				const MacroToken& token = tokens[replay.index++];
+				in.cursor = text + token.end;
+				if (token.symbol.kind() == parser::symbol_kind::S_END_OF_LINE)
+				{
+					loc.lines();
+					loc.step();
+				}
+				else
+				{
+					loc.columns(token.columns);
+				}
+
+				if (token.symbol.kind() == parser::symbol_kind::S_IDENTIFIER)
+				{
+					if (token.slot >= 0)
+					{
+						in.pushString(macroCallStack.back().arguments[token.slot]);
+						continue;
+					}
+					if (substituteIdentifier(token.symbol.value.as<std::string>()))
+					{
+						continue;
+					}
+				}
+
+				parser::symbol_type symbol(token.symbol);
+				symbol.location = loc;
+				return symbol;
+			}
+		}
+
 		%{ /* Begin re2c lexer */
 		re2c:yyfill:enable = 0;
 		re2c:flags:input = custom;
 		re2c:api:style = free-form;
 		re2c:define:YYCTYPE      = char;
-		re2c:define:YYPEEK       = "in.peek()";
-		re2c:define:YYSKIP       = "do { in.ignore(); if (in.eof()) TOKEN(END_OF_FILE); } while(0);";
-		re2c:define:YYBACKUP     = "mar = in.tellg();";
-		re2c:define:YYRESTORE    = "in.seekg(mar);";
-		re2c:define:YYSTAGP      = "@@{tag} = in.eof() ? std::streampos(0) : in.tellg();";
-		re2c:define:YYSTAGN      = "@@{tag} = 0;";
+		re2c:define:YYPEEK       = "*in.cursor";
+		re2c:define:YYSKIP       = "if (++in.cursor > in.limit) continue;";
+		re2c:define:YYBACKUP     = "mar = in.cursor;";
+		re2c:define:YYRESTORE    = "in.cursor = mar;";
+		re2c:define:YYSTAGP      = "@@{tag} = in.cursor;";
+		re2c:define:YYSTAGN      = "@@{tag} = nullptr;";
 		re2c:define:YYSHIFTSTAG  = "@@{tag} += @@{shift};";
         re2c:flags:tags = 1;
 
@@ -811,6 +961,10 @@ yy::parser::symbol_type yy::yylex()
 		'xori'         { TOKEN(XORI); }
 		'jalr'         { TOKEN(JALR); }
 		'nor'           { TOKEN(NOR); }
+		'cas'           { TOKEN(CAS); }
+		'amoadd'     { TOKEN(AMOADD); }
+		'amoswap'   { TOKEN(AMOSWAP); }
+		'sync'         { TOKEN(SYNC); }
 
 		// Pseudoinstructions
 		'copy'         { TOKEN(COPY); }
@@ -840,24 +994,10 @@ yy::parser::symbol_type yy::yylex()
 		@s [a-zA-Z_][a-zA-Z_0-9]* @e
 		{
 			std::string identifier = GET_STRING();
-			if (!macroCallStack.empty())
+			if (!tokenizing && substituteIdentifier(identifier))
 			{
-				MacroCall& mc = macroCallStack.back();
-				auto it = std::find(mc.paramaters.begin(), mc.paramaters.end(), identifier);
-				if (it != mc.paramaters.end())
-				{
-					auto index = std::distance(mc.paramaters.begin(), it);
-					in.pushString(mc.arguments[index]);
-					continue;
-				}
-			}
-			
-			if (assembler->macros.count(identifier))
-			{
-				in.pushString(assembler->macros[identifier]);
 				continue;
 			}
-			
 			TOKENV(IDENTIFIER, identifier);
 		}
 
@@ -885,7 +1025,7 @@ yy::parser::symbol_type yy::yylex()
 		// Single character operators
 		@s [:,+()] @e { return parser::symbol_type(parser::token_type(GET_CHAR()), loc); }
 
-		* { throw std::runtime_error(std::string("Invalid character of value: " + std::to_string(GET_CHAR())).c_str()); }
+		* { throw std::runtime_error(std::string("Invalid character of value: " + std::to_string(yych)).c_str()); }
 		%}
 	}
 }
@@ -893,10 +1033,7 @@ yy::parser::symbol_type yy::yylex()
 void yy::parser::error(const location_type& l, const std::string& message)
 {
     std::cerr << l.begin.filename->c_str() << ':' << l.begin.line << ':' << l.begin.column << '-' << l.end.column << ": " << message << '\n';
-	char buffer[20];
-	in.read(buffer, 19);
-	buffer[19] = 0;
-	std::cerr << buffer << std::endl;
+	std::cerr << std::string_view(in.cursor, std::min<std::ptrdiff_t>(in.limit - in.cursor, 19)) << std::endl;
 }
 
 namespace kasm
@@ -907,6 +1044,8 @@ namespace kasm
         unresolvedAddressLocations.clear();
 		macros.clear();
 		macroFunctions.clear();
+		macroBodies.clear();
+		replays.clear();
 
 		in.setCallback(eofCallback);
 		in.open(asmPath);
@@ -921,25 +1060,33 @@ namespace kasm
         yy::parser parser;
         if (parser.parse()) return;
 
-        for (AddressData unresolvedAddressLocation : unresolvedAddressLocations)
+        for (AddressData& unresolvedAddressLocation : unresolvedAddressLocations)
         {
-			binary.setLocation(unresolvedAddressLocation.position);
-			
 			resolveAddress(unresolvedAddressLocation, MUST_RESOLVE);
 
+			std::uint32_t position = unresolvedAddressLocation.position;
 			if (unresolvedAddressLocation.type == AddressType::DirectAddressAbsoluteByte)
 			{
-				binary.writeByte(static_cast<std::uint8_t>(unresolvedAddressLocation.instructionData.instruction));
+				binary.patchByte(position, static_cast<std::uint8_t>(unresolvedAddressLocation.instructionData.instruction));
 			}
 			else if (unresolvedAddressLocation.type == AddressType::DirectAddressAbsoluteLoad)
 			{
 				SplitWord l = { unresolvedAddressLocation.instructionData.instruction };
-				INSTRUCTION_RL(LUI, unresolvedAddressLocation.reg, l.hi);
-				INSTRUCTION_RRL(ORI, unresolvedAddressLocation.reg, unresolvedAddressLocation.reg, l.lo);
+				InstructionData upper{};
+				upper.opcode = Opcode::LUI;
+				upper.register0 = unresolvedAddressLocation.reg;
+				upper.immediate = l.hi;
+				InstructionData lower{};
+				lower.opcode = Opcode::ORI;
+				lower.register0 = unresolvedAddressLocation.reg;
+				lower.register1 = unresolvedAddressLocation.reg;
+				lower.immediate = l.lo;
+				binary.patchWord(position, upper.instruction);
+				binary.patchWord(position + INSTRUCTION_SIZE, lower.instruction);
 			}
 			else
 			{
-				binary.writeWord(unresolvedAddressLocation.instructionData.instruction);
+				binary.patchWord(position, unresolvedAddressLocation.instructionData.instruction);
 			}
         }
 
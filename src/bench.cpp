@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "assembler.hpp"
+#include "bench_util.hpp"
+#include "virtualMachine.hpp"
+
+// Measures the throughput of the execution engines on the workloads in data/bench. Every workload is assembled once
+// and run on every engine, first to warm up and then for the measured repetitions, with its console on the null
+// device. Results can be written as JSON and compared against such a file from an earlier build.
+
+#ifndef KASM_BENCH_DIR
+#define KASM_BENCH_DIR "data/bench"
+#endif
+
+struct Result
+{
+	std::string workload;
+	std::string engine;
+	std::uint64_t instructions = 0;
+	double medianSeconds = 0;
+	double p95Seconds = 0;
+	std::uint64_t peakResidentSize = 0;
+
+	double getInstructionsPerSecond() const { return medianSeconds > 0 ? instructions / medianSeconds : 0; }
+	double getNanosecondsPerInstruction() const { return instructions ? medianSeconds * 1e9 / instructions : 0; }
+};
+
+// The value of "key" in a JSON object written on a single line by writeResults, empty if it is missing
+static std::string getField(const std::string& line, const std::string& key)
+{
+	std::string quotedKey = "\"" + key + "\":";
+	std::size_t begin = line.find(quotedKey);
+	if (begin == std::string::npos)
+	{
+		return "";
+	}
+	begin = line.find_first_not_of(' ', begin + quotedKey.size());
+	if (begin == std::string::npos)
+	{
+		return "";
+	}
+
+	if (line[begin] == '"')
+	{
+		std::size_t end = line.find('"', begin + 1);
+		return end == std::string::npos ? "" : line.substr(begin + 1, end - begin - 1);
+	}
+	std::size_t end = line.find_first_of(",}", begin);
+	return line.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+}
+
+static void writeResults(std::ostream& out, const std::vector<Result>& results)
+{
+	out << "{\n  \"results\": [\n";
+	for (std::size_t i = 0; i < results.size(); i++)
+	{
+		const Result& result = results[i];
+		out << "    {\"workload\": \"" << result.workload << "\", \"engine\": \"" << result.engine << "\""
+			<< ", \"instructions\": " << result.instructions
+			<< std::fixed << std::setprecision(9)
+			<< ", \"median_seconds\": " << result.medianSeconds
+			<< ", \"p95_seconds\": " << result.p95Seconds
+			<< std::setprecision(0)
+			<< ", \"instructions_per_second\": " << result.getInstructionsPerSecond()
+			<< std::setprecision(3)
+			<< ", \"ns_per_instruction\": " << result.getNanosecondsPerInstruction()
+			<< ", \"peak_rss_bytes\": " << result.peakResidentSize << "}"
+			<< (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	out << "  ]\n}\n";
+}
+
+// Returns false if a workload got slower per instruction than tolerance percent
+static bool compareResults(const std::string& baselinePath, const std::vector<Result>& results, double tolerance)
+{
+	std::ifstream baselineFile(baselinePath);
+	if (!baselineFile)
+	{
+		throw std::runtime_error("Failed to open baseline " + baselinePath);
+	}
+
+	std::map<std::pair<std::string, std::string>, double> baseline;
+	std::string line;
+	while (std::getline(baselineFile, line))
+	{
+		std::string workload = getField(line, "workload");
+		std::string nanoseconds = getField(line, "ns_per_instruction");
+		if (!workload.empty() && !nanoseconds.empty())
+		{
+			baseline[{ workload, getField(line, "engine") }] = std::stod(nanoseconds);
+		}
+	}
+
+	bool passed = true;
+	std::cout << "\n" << std::left << std::setw(12) << "workload" << std::setw(10) << "engine" << std::right
+		<< std::setw(14) << "baseline ns" << std::setw(14) << "current ns" << std::setw(10) << "change" << "\n";
+	for (const Result& result : results)
+	{
+		auto it = baseline.find({ result.workload, result.engine });
+		if (it == baseline.end() || it->second <= 0)
+		{
+			continue;
+		}
+
+		double change = (result.getNanosecondsPerInstruction() - it->second) / it->second * 100;
+		bool slower = change > tolerance;
+		passed = passed && !slower;
+		std::cout << std::left << std::setw(12) << result.workload << std::setw(10) << result.engine << std::right
+			<< std::fixed << std::setprecision(3) << std::setw(14) << it->second << std::setw(14) << result.getNanosecondsPerInstruction()
+			<< std::setprecision(1) << std::setw(9) << std::showpos << change << std::noshowpos << "%"
+			<< (slower ? "  slower" : "") << "\n";
+	}
+	return passed;
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<std::string> engines = { "switch", "threaded" };
+	if (kasm::Jit::isSupported())
+	{
+		engines.push_back("jit");
+	}
+	std::uint64_t warmup = 1;
+	std::uint64_t repetitions = 5;
+	std::string outputPath;
+	std::string baselinePath;
+	double tolerance = 5;
+	std::vector<std::string> workloads;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+		std::string value;
+
+		if (kasm::parseOption(argument, "--engines", value))
+		{
+			engines.clear();
+			std::istringstream list(value);
+			std::string engine;
+			while (std::getline(list, engine, ','))
+			{
+				if (engine != "switch" && engine != "threaded" && (engine != "jit" || !kasm::Jit::isSupported()))
+				{
+					std::cerr << "Invalid engine " << engine << "\n";
+					return -1;
+				}
+				engines.push_back(engine);
+			}
+		}
+		else if (kasm::parseOption(argument, "--warmup", value))
+		{
+			if (!kasm::parseCount(value, warmup))
+			{
+				std::cerr << "Invalid warmup count\n";
+				return -1;
+			}
+		}
+		else if (kasm::parseOption(argument, "--repetitions", value))
+		{
+			if (!kasm::parseCount(value, repetitions) || repetitions == 0)
+			{
+				std::cerr << "Invalid repetition count\n";
+				return -1;
+			}
+		}
+		else if (kasm::parseOption(argument, "--output", value))
+		{
+			outputPath = value;
+		}
+		else if (kasm::parseOption(argument, "--baseline", value))
+		{
+			baselinePath = value;
+		}
+		else if (kasm::parseOption(argument, "--tolerance", value))
+		{
+			try
+			{
+				tolerance = std::stod(value);
+			}
+			catch (const std::exception&)
+			{
+				std::cerr << "Invalid tolerance\n";
+				return -1;
+			}
+		}
+		else if (argument == "--help")
+		{
+			std::cout << "Usage: kasm_bench [--engines=switch,threaded,jit] [--warmup=N] [--repetitions=N] [--output=PATH] [--baseline=PATH] [--tolerance=PERCENT] [workload.kasm...]\n";
+			return 0;
+		}
+		else
+		{
+			workloads.push_back(argument);
+		}
+	}
+
+	try
+	{
+		if (workloads.empty())
+		{
+			for (const auto& entry : std::filesystem::directory_iterator(KASM_BENCH_DIR))
+			{
+				if (entry.path().extension() == ".kasm")
+				{
+					workloads.push_back(entry.path().string());
+				}
+			}
+			std::sort(workloads.begin(), workloads.end());
+		}
+
+#if defined(_WIN32)
+		int nullFd = _open("NUL", _O_RDWR);
+#else
+		int nullFd = ::open("/dev/null", O_RDWR | O_CLOEXEC);
+#endif
+		if (nullFd == -1)
+		{
+			throw std::runtime_error("Failed to open the null device");
+		}
+
+		std::cout << std::left << std::setw(12) << "workload" << std::setw(10) << "engine" << std::right
+			<< std::setw(14) << "instructions" << std::setw(12) << "median ms" << std::setw(12) << "p95 ms"
+			<< std::setw(12) << "Minstr/s" << std::setw(10) << "ns/instr" << std::setw(12) << "peak RSS K" << "\n";
+
+		std::vector<Result> results;
+		for (const std::string& workloadPath : workloads)
+		{
+			std::filesystem::path path(workloadPath);
+			std::string programPath = (std::filesystem::temp_directory_path() / ("kasm_bench_" + path.stem().string() + ".kexe")).string();
+			kasm::Assembler assembler;
+			assembler.assemble(workloadPath, programPath);
+
+			for (const std::string& engine : engines)
+			{
+				Result result;
+				result.workload = path.stem().string();
+				result.engine = engine;
+
+				// A machine of its own, so no decoded text or compiled code carries over between engines
+				kasm::VirtualMachine virtualMachine;
+				virtualMachine.setEngine(engine == "switch" ? kasm::VirtualMachine::Engine::SWITCH : kasm::VirtualMachine::Engine::THREADED);
+				virtualMachine.setJit(engine == "jit");
+				virtualMachine.getConsole().setDescriptors(nullFd, nullFd);
+				std::shared_ptr<const kasm::VirtualMachine::Image> image = virtualMachine.loadImage(programPath);
+
+				kasm::resetPeakResidentSize();
+				std::vector<double> times;
+				for (std::uint64_t run = 0; run < warmup + repetitions; run++)
+				{
+					virtualMachine.loadProgram(image);
+					auto start = std::chrono::steady_clock::now();
+					int exitCode = virtualMachine.execute();
+					auto end = std::chrono::steady_clock::now();
+
+					if (exitCode != 0 || virtualMachine.getExitReason() != kasm::VirtualMachine::ExitReason::NORMAL)
+					{
+						throw std::runtime_error(workloadPath + " failed on the " + engine + " engine");
+					}
+					if (run >= warmup)
+					{
+						times.push_back(std::chrono::duration<double>(end - start).count());
+					}
+					result.instructions = virtualMachine.getRetiredInstructions();
+				}
+				result.peakResidentSize = kasm::getPeakResidentSize();
+
+				std::sort(times.begin(), times.end());
+				std::size_t middle = times.size() / 2;
+				result.medianSeconds = times.size() % 2 ? times[middle] : (times[middle - 1] + times[middle]) / 2;
+				result.p95Seconds = times[static_cast<std::size_t>(std::ceil(times.size() * 0.95)) - 1];
+				results.push_back(result);
+
+				std::cout << std::left << std::setw(12) << result.workload << std::setw(10) << result.engine << std::right
+					<< std::setw(14) << result.instructions
+					<< std::fixed << std::setprecision(2)
+					<< std::setw(12) << result.medianSeconds * 1e3 << std::setw(12) << result.p95Seconds * 1e3
+					<< std::setw(12) << result.getInstructionsPerSecond() / 1e6
+					<< std::setprecision(3) << std::setw(10) << result.getNanosecondsPerInstruction()
+					<< std::setw(12) << result.peakResidentSize / 1024 << std::endl;
+			}
+
+			std::filesystem::remove(programPath);
+		}
+
+		if (!outputPath.empty())
+		{
+			std::ofstream outputFile(outputPath);
+			writeResults(outputFile, results);
+		}
+
+		if (!baselinePath.empty() && !compareResults(baselinePath, results, tolerance))
+		{
+			return 1;
+		}
+	}
+	catch (kasm::VirtualMachine::Signal signal)
+	{
+		std::cerr << kasm::VirtualMachine::getSignalDescription(signal) << std::endl;
+		return -1;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return -1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+namespace kasm
+{
+	// Helpers shared by kasm and the benchmark programs
+
+	// Matches arguments of the form --name=value
+	inline bool parseOption(const std::string& argument, const std::string& name, std::string& value)
+	{
+		if (argument.compare(0, name.size(), name) || argument.size() <= name.size() || argument[name.size()] != '=')
+		{
+			return false;
+		}
+
+		value = argument.substr(name.size() + 1);
+		return true;
+	}
+
+	// Parses a plain decimal count
+	inline bool parseCount(const std::string& value, std::uint64_t& count)
+	{
+		if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos)
+		{
+			return false;
+		}
+
+		try
+		{
+			count = std::stoull(value);
+		}
+		catch (const std::out_of_range&)
+		{
+			return false;
+		}
+		return true;
+	}
+
+	// Lets the next getPeakResidentSize report the peak from here on, where the platform allows it
+	inline void resetPeakResidentSize()
+	{
+	#if defined(__linux__)
+		std::ofstream clearRefs("/proc/self/clear_refs");
+		clearRefs << "5";
+	#endif
+	}
+
+	// In bytes, 0 if unknown
+	inline std::uint64_t getPeakResidentSize()
+	{
+	#if defined(__linux__)
+		std::ifstream status("/proc/self/status");
+		std::string line;
+		while (std::getline(status, line))
+		{
+			if (line.compare(0, 6, "VmHWM:") == 0)
+			{
+				return std::stoull(line.substr(6)) * 1024;
+			}
+		}
+		return 0;
+	#elif defined(_WIN32)
+		return 0;
+	#else
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+	#if defined(__APPLE__)
+		return usage.ru_maxrss;
+	#else
+		return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+	#endif
+	#endif
+	}
+}
@@ -1,7 +1,8 @@
 #include "binaryBuilder.hpp"
 
-#include <exception>
+#include <cstring>
 #include <fstream>
+#include <stdexcept>
 
 #include "common.hpp"
 
@@ -17,28 +18,45 @@ namespace kasm
 		programPath = aProgramPath;
 		cursor = 0;
 		textSegment.clear();
-		textSegment.str("");
+		textSegment.reserve(INITIAL_SEGMENT_CAPACITY);
 		dataSegment.clear();
-		dataSegment.str("");
+		dataSegment.reserve(INITIAL_SEGMENT_CAPACITY);
+		fixups.clear();
 	}
 
 	void BinaryBuilder::close()
 	{
-		std::ofstream programFile(programPath, std::ios::binary);
-
-		std::string textSegmentString = textSegment.str();
-		std::string dataSegmentString = dataSegment.str();
+		for (const Fixup& fixup : fixups)
+		{
+			std::vector<std::uint8_t>& segment = getSegment(fixup.location);
+			std::size_t offset = getOffset(fixup.location);
+			if (offset + fixup.size > segment.size())
+			{
+				throw std::runtime_error("Fixup out of bounds at " + std::to_string(fixup.location));
+			}
+			std::memcpy(segment.data() + offset, &fixup.value, fixup.size);
+		}
 
 		ProgramHeader programHeader;
 		programHeader.textSegmentBegin = sizeof(programHeader);
-		programHeader.textSegmentLength = textSegmentString.size();
+		programHeader.textSegmentLength = textSegment.size();
 		programHeader.dataSegmentBegin = programHeader.textSegmentBegin + programHeader.textSegmentLength;
-		programHeader.dataSegmentLength = dataSegmentString.size();
-		programFile.write(reinterpret_cast<char*>(&programHeader), sizeof(programHeader));
-		programFile.write(textSegmentString.c_str(), programHeader.textSegmentLength);
-		programFile.write(dataSegmentString.c_str(), programHeader.dataSegmentLength);
+		programHeader.dataSegmentLength = dataSegment.size();
+		programHeader.stackSize = stackSize;
+		programHeader.globalSize = globalSize;
 
+		std::vector<char> image(sizeof(programHeader) + textSegment.size() + dataSegment.size());
+		std::memcpy(image.data(), &programHeader, sizeof(programHeader));
+		std::memcpy(image.data() + programHeader.textSegmentBegin, textSegment.data(), textSegment.size());
+		std::memcpy(image.data() + programHeader.dataSegmentBegin, dataSegment.data(), dataSegment.size());
+
+		std::ofstream programFile(programPath, std::ios::binary);
+		programFile.write(image.data(), image.size());
 		programFile.close();
+		if (!programFile)
+		{
+			throw std::runtime_error("Failed to write " + programPath);
+		}
 	}
 
 	void BinaryBuilder::align(unsigned int alignment)
@@ -49,33 +67,22 @@ namespace kasm
 
 	void BinaryBuilder::writeWord(std::uint32_t word)
 	{
-		if (cursor < DATA_SEGMENT_OFFSET)
-		{
-			textSegment.write(reinterpret_cast<char*>(&word), sizeof(word));
-		}
-		else
-		{
-			dataSegment.write(reinterpret_cast<char*>(&word), sizeof(word));
-		}
-		cursor += 4;
+		write(&word, sizeof(word));
 	}
 
 	void BinaryBuilder::writeByte(std::uint8_t byte)
 	{
-		dataSegment.put(byte);
-		cursor++;
+		write(&byte, sizeof(byte));
 	}
 
 	void BinaryBuilder::writeData(const std::uint8_t* pData, unsigned int size)
 	{
-		dataSegment.write(reinterpret_cast<const char*>(pData), size);
-		cursor += size;
+		write(pData, size);
 	}
 
 	void BinaryBuilder::writeString(const char* string, unsigned int size)
 	{
-		dataSegment.write(string, size);
-		cursor += size;
+		write(string, size);
 	}
 
 	void BinaryBuilder::pad(unsigned int size)
@@ -92,60 +99,27 @@ namespace kasm
 	{
 		if (location == END)
 		{
-			dataSegment.clear();
-			dataSegment.seekp(0, std::ios::end);
-			dataSegment.clear();
-			cursor = DATA_SEGMENT_OFFSET + dataSegment.tellp();
-			dataSegment.clear();
+			cursor = DATA_SEGMENT_OFFSET + dataSegment.size();
+			return;
 		}
-		else
+
+		std::vector<std::uint8_t>& segment = getSegment(location);
+		std::size_t offset = getOffset(location);
+		if (offset > segment.size())
 		{
-			if (location < DATA_SEGMENT_OFFSET)
-			{
-				textSegment.clear();
-				textSegment.seekp(0, std::ios::end);
-				textSegment.clear();
-				if (location > textSegment.tellp())
-				{
-					textSegment.clear();
-					cursor = textSegment.tellp();
-					textSegment.clear();
-					while (cursor < location)
-					{
-						writeByte(0);
-					}
-				}
-				else
-				{
-					textSegment.clear();
-					textSegment.seekp(location, std::ios::beg);
-					textSegment.clear();
-				}
-			}
-			else
-			{
-				dataSegment.clear();
-				dataSegment.seekp(0, std::ios::end);
-				dataSegment.clear();
-				if (location - DATA_SEGMENT_OFFSET > dataSegment.tellp())
-				{
-					dataSegment.clear();
-					cursor = DATA_SEGMENT_OFFSET + dataSegment.tellp();
-					dataSegment.clear();
-					while (cursor < location)
-					{
-						writeByte(0);
-					}
-				}
-				else
-				{
-					dataSegment.clear();
-					dataSegment.seekp(location - DATA_SEGMENT_OFFSET, std::ios::beg);
-					dataSegment.clear();
-				}
-			}
-			cursor = location;
+			segment.resize(offset);
 		}
+		cursor = location;
+	}
+
+	void BinaryBuilder::patchWord(std::uint32_t location, std::uint32_t word)
+	{
+		fixups.push_back({ location, word, sizeof(word) });
+	}
+
+	void BinaryBuilder::patchByte(std::uint32_t location, std::uint8_t byte)
+	{
+		fixups.push_back({ location, byte, sizeof(byte) });
 	}
 
 	BinaryBuilder::SegmentType BinaryBuilder::getSegmentType() const
@@ -158,15 +132,33 @@ namespace kasm
 	{
 		if (segmentType == SegmentType::TEXT)
 		{
-			textSegment.seekp(0, std::ios::end);
-			textSegment.clear();
-			cursor = textSegment.tellp();
+			cursor = textSegment.size();
 		}
 		else
 		{
-			dataSegment.seekp(0, std::ios::end);
-			dataSegment.clear();
-			cursor = DATA_SEGMENT_OFFSET + dataSegment.tellp();
+			cursor = DATA_SEGMENT_OFFSET + dataSegment.size();
+		}
+	}
+
+	void BinaryBuilder::write(const void* pData, std::size_t size)
+	{
+		std::vector<std::uint8_t>& segment = getSegment(cursor);
+		std::size_t offset = getOffset(cursor);
+		if (offset + size > segment.size())
+		{
+			segment.resize(offset + size);
 		}
+		std::memcpy(segment.data() + offset, pData, size);
+		cursor += size;
+	}
+
+	std::vector<std::uint8_t>& BinaryBuilder::getSegment(std::uint32_t location)
+	{
+		return location < DATA_SEGMENT_OFFSET ? textSegment : dataSegment;
+	}
+
+	std::size_t BinaryBuilder::getOffset(std::uint32_t location) const
+	{
+		return location < DATA_SEGMENT_OFFSET ? location : location - DATA_SEGMENT_OFFSET;
 	}
 }
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <limits>
-#include <sstream>
 #include <string>
 #include <vector>
 
 namespace kasm
 {
+	// Builds a program image in two growable segments written in place at the cursor, gaps filled with zeros. Words
+	// and bytes that can only be resolved once the whole source has been read are patched from a table on close.
 	class BinaryBuilder
 	{
 	public:
@@ -29,17 +32,39 @@ namespace kasm
 		void pad(unsigned int size);
 		std::uint32_t getLocation();
 		void setLocation(std::uint32_t location);
+		// Overwrite what was written at location when close is called, the cursor stays where it is
+		void patchWord(std::uint32_t location, std::uint32_t word);
+		void patchByte(std::uint32_t location, std::uint8_t byte);
 		SegmentType getSegmentType() const;
 		void setSegmentType(SegmentType segmentType);
+		// Written to the program header, zero leaves the choice to the virtual machine
+		void setStackSize(std::uint32_t size) { stackSize = size; }
+		void setGlobalSize(std::uint32_t size) { globalSize = size; }
 
 		static const std::uint32_t BEG = 0;
 		static const std::uint32_t END = std::numeric_limits<std::uint32_t>::max();
 
 	private:
+		struct Fixup
+		{
+			std::uint32_t location;
+			std::uint32_t value;
+			std::uint8_t size;
+		};
+
+		static const std::size_t INITIAL_SEGMENT_CAPACITY = 0x10000;
+
+		void write(const void* pData, std::size_t size);
+		std::vector<std::uint8_t>& getSegment(std::uint32_t location);
+		std::size_t getOffset(std::uint32_t location) const;
+
 		std::string programPath;
 		std::uint32_t cursor;
+		std::uint32_t stackSize = 0;
+		std::uint32_t globalSize = 0;
 
-		std::ostringstream textSegment;
-		std::ostringstream dataSegment;
+		std::vector<std::uint8_t> textSegment;
+		std::vector<std::uint8_t> dataSegment;
+		std::vector<Fixup> fixups;
 	};
 }
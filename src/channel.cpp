@@ -0,0 +1,177 @@
+#include "channel.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace kasm
+{
+    Channel::Channel(std::uint32_t aCapacity, std::uint32_t aMessageSize)
+        : messageSize(aMessageSize)
+    {
+        // With a single slot a sender could not tell a full slot from a free one a lap later
+        std::uint32_t capacity = 2;
+        while (capacity < aCapacity)
+        {
+            capacity <<= 1;
+        }
+        mask = capacity - 1;
+
+        slots = std::make_unique<Slot[]>(capacity);
+        for (std::uint32_t i = 0; i < capacity; i++)
+        {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+            slots[i].size = 0;
+        }
+        messages = std::make_unique<char[]>(static_cast<std::size_t>(capacity) * messageSize);
+    }
+
+    bool Channel::trySend(const char* message, std::uint32_t size)
+    {
+        std::uint64_t position = sendPosition.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true)
+        {
+            slot = &slots[position & mask];
+            std::int64_t turn = static_cast<std::int64_t>(slot->sequence.load(std::memory_order_acquire) - position);
+            if (turn == 0)
+            {
+                if (sendPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (turn < 0)
+            {
+                // The slot still holds the message sent a lap ago
+                return false;
+            }
+            else
+            {
+                position = sendPosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::memcpy(&messages[(position & mask) * messageSize], message, size);
+        slot->size = size;
+        slot->sequence.store(position + 1, std::memory_order_release);
+
+        wake(waitingReceivers);
+        return true;
+    }
+
+    std::int64_t Channel::tryReceive(char* buffer, std::uint32_t size)
+    {
+        std::uint64_t position = receivePosition.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true)
+        {
+            slot = &slots[position & mask];
+            std::int64_t turn = static_cast<std::int64_t>(slot->sequence.load(std::memory_order_acquire) - (position + 1));
+            if (turn == 0)
+            {
+                if (receivePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (turn < 0)
+            {
+                return -1;
+            }
+            else
+            {
+                position = receivePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::uint32_t messageLength = slot->size;
+        std::memcpy(buffer, &messages[(position & mask) * messageSize], std::min(size, messageLength));
+        // Hands the slot to the sender one lap ahead
+        slot->sequence.store(position + mask + 1, std::memory_order_release);
+
+        wake(waitingSenders);
+        return messageLength;
+    }
+
+    bool Channel::hasSpace() const
+    {
+        std::uint64_t position = sendPosition.load(std::memory_order_acquire);
+        return static_cast<std::int64_t>(slots[position & mask].sequence.load(std::memory_order_acquire) - position) >= 0;
+    }
+
+    bool Channel::hasMessage() const
+    {
+        std::uint64_t position = receivePosition.load(std::memory_order_acquire);
+        return static_cast<std::int64_t>(slots[position & mask].sequence.load(std::memory_order_acquire) - (position + 1)) >= 0;
+    }
+
+    void Channel::wake(std::atomic<std::uint32_t>& waiting)
+    {
+        // Pairs with the increment in the wait functions, either the waiter sees the new state or we see the waiter
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(waitMutex);
+            waitCondition.notify_all();
+        }
+    }
+
+    void Channel::waitForSpace(std::chrono::milliseconds timeout)
+    {
+        waitingSenders++;
+        {
+            std::unique_lock<std::mutex> lock(waitMutex);
+            waitCondition.wait_for(lock, timeout, [this]() { return hasSpace() || isClosed(); });
+        }
+        waitingSenders--;
+    }
+
+    void Channel::waitForMessage(std::chrono::milliseconds timeout)
+    {
+        waitingReceivers++;
+        {
+            std::unique_lock<std::mutex> lock(waitMutex);
+            waitCondition.wait_for(lock, timeout, [this]() { return hasMessage() || isClosed(); });
+        }
+        waitingReceivers--;
+    }
+
+    void Channel::close()
+    {
+        closed.store(true, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(waitMutex);
+        waitCondition.notify_all();
+    }
+
+    std::uint32_t ChannelTable::create(std::uint32_t capacity, std::uint32_t messageSize)
+    {
+        std::uint64_t slotCount = 2;
+        while (slotCount < capacity)
+        {
+            slotCount <<= 1;
+        }
+        if (capacity == 0 || messageSize == 0 || slotCount * messageSize > Channel::MAX_BUFFER_SIZE)
+        {
+            return 0;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::uint32_t index = count.load(std::memory_order_relaxed);
+        if (index == MAX_CHANNELS)
+        {
+            return 0;
+        }
+        channels[index] = std::make_unique<Channel>(capacity, messageSize);
+        count.store(index + 1, std::memory_order_release);
+        return index + 1;
+    }
+
+    Channel* ChannelTable::get(std::uint32_t id) const
+    {
+        if (id == 0 || id > count.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return channels[id - 1].get();
+    }
+}
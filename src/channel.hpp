@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace kasm
+{
+	// Bounded multi-producer multi-consumer queue of messages up to a fixed size, held by the host so virtual machines
+	// on different threads can pass data without going through files. Each slot carries a sequence number telling
+	// whose turn it is, so senders only contend with senders for the next position and receivers with receivers, and
+	// the two sides meet only at the slot handed over. Waiting is left to the caller: after a
+	// failed attempt it may sleep on waitForSpace or waitForMessage, which are woken by the other side.
+	class Channel
+	{
+	public:
+		// The capacity is rounded up to a power of two, at least 2
+		Channel(std::uint32_t aCapacity, std::uint32_t aMessageSize);
+
+		Channel(const Channel&) = delete;
+		Channel& operator=(const Channel&) = delete;
+
+		// Returns false if the channel is full. size must not exceed getMessageSize().
+		bool trySend(const char* message, std::uint32_t size);
+		// Copies out the oldest message, truncated to size bytes, and returns its full size, or -1 if there is none
+		std::int64_t tryReceive(char* buffer, std::uint32_t size);
+
+		// Return once the channel might have room, might hold a message or was closed, or after timeout
+		void waitForSpace(std::chrono::milliseconds timeout);
+		void waitForMessage(std::chrono::milliseconds timeout);
+
+		// Sends fail from now on, receives fail once the remaining messages are drained
+		void close();
+		bool isClosed() const { return closed.load(std::memory_order_acquire); }
+
+		std::uint32_t getCapacity() const { return mask + 1; }
+		std::uint32_t getMessageSize() const { return messageSize; }
+
+		static const std::uint64_t MAX_BUFFER_SIZE = 64 << 20; // capacity times message size
+
+	private:
+		struct Slot
+		{
+			std::atomic<std::uint64_t> sequence;
+			std::uint32_t size;
+		};
+
+		bool hasSpace() const;
+		bool hasMessage() const;
+		void wake(std::atomic<std::uint32_t>& waiting);
+
+		std::uint32_t mask;
+		std::uint32_t messageSize;
+		std::unique_ptr<Slot[]> slots;
+		std::unique_ptr<char[]> messages;
+
+		alignas(64) std::atomic<std::uint64_t> sendPosition{ 0 };
+		alignas(64) std::atomic<std::uint64_t> receivePosition{ 0 };
+
+		alignas(64) std::atomic<bool> closed{ false };
+		std::atomic<std::uint32_t> waitingSenders{ 0 };
+		std::atomic<std::uint32_t> waitingReceivers{ 0 };
+		std::mutex waitMutex;
+		std::condition_variable waitCondition;
+	};
+
+	// Channels created by a process, or shared by the stages of a pipeline. Channels live as long as the table, so
+	// looking one up by id takes no lock. Ids start at 1, 0 is never a valid id.
+	class ChannelTable
+	{
+	public:
+		ChannelTable() {}
+
+		ChannelTable(const ChannelTable&) = delete;
+		ChannelTable& operator=(const ChannelTable&) = delete;
+
+		// Returns 0 if the table is full or the sizes are out of range
+		std::uint32_t create(std::uint32_t capacity, std::uint32_t messageSize);
+		// nullptr if there is no such channel
+		Channel* get(std::uint32_t id) const;
+
+		static const std::uint32_t MAX_CHANNELS = 256;
+
+	private:
+		std::mutex mutex;
+		std::unique_ptr<Channel> channels[MAX_CHANNELS];
+		std::atomic<std::uint32_t> count{ 0 };
+	};
+}
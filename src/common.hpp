@@ -1,7 +1,11 @@
 #pragma once
 
 #include <climits>
+#include <cstddef>
 #include <cstdint>
+#include <istream>
+#include <string>
+#include <unordered_map>
 
 #include "debug.hpp"
 
@@ -110,10 +114,17 @@ namespace kasm
         XORI,
         JALR,
         NOR,
+        CAS,
+        AMOADD,
+        AMOSWAP,
+        SYNC,
 
         ERR = 0x111111 // reserved invalid opcode
     };
 
+    // Mnemonics by opcode, up to SYNC
+    static const char* const OPCODE_NAMES[] = { "add", "addi", "addiu", "addu", "and", "andi", "beq", "bgez", "bgezal", "bgtz", "blez", "bltz", "bltzal", "bne", "div", "divu", "j", "jal", "jr", "lb", "lui", "lw", "mfhi", "mflo", "mult", "multu", "or", "ori", "sb", "sll", "sllv", "slt", "slti", "sltiu", "sltu", "sne", "seq", "sra", "srl", "srlv", "sub", "subu", "sw", "sys", "xor", "xori", "jalr", "nor", "cas", "amoadd", "amoswap", "sync" };
+
     enum Register : std::uint32_t
     {
         ZERO,
@@ -166,13 +177,76 @@ namespace kasm
         std::uint32_t textSegmentLength;
         std::uint32_t dataSegmentBegin;
         std::uint32_t dataSegmentLength;
+        // Only present if the text segment begins after them, zero selects the default size
+        std::uint32_t stackSize;
+        std::uint32_t globalSize;
     };
 
-    static const std::uint32_t GLOBAL_SIZE = 256;
-    static const std::uint32_t STACK_SIZE = 256;
+    static const std::uint32_t PROGRAM_HEADER_BASE_SIZE = offsetof(ProgramHeader, stackSize);
+
+    // Reads either header layout and leaves the stream at the beginning of the text segment
+    inline void readProgramHeader(std::istream& programFile, ProgramHeader& programHeader)
+    {
+        programHeader = {};
+        programFile.read(reinterpret_cast<char*>(&programHeader), PROGRAM_HEADER_BASE_SIZE);
+        if (programHeader.textSegmentBegin >= sizeof(ProgramHeader))
+        {
+            programFile.read(reinterpret_cast<char*>(&programHeader) + PROGRAM_HEADER_BASE_SIZE, sizeof(ProgramHeader) - PROGRAM_HEADER_BASE_SIZE);
+        }
+        programFile.seekg(programHeader.textSegmentBegin);
+    }
+
+    // Reads the label locations written by Assembler::saveSymbolTable
+    inline std::unordered_map<std::string, std::uint32_t> readSymbolTable(std::istream& symbolTableFile)
+    {
+        std::unordered_map<std::string, std::uint32_t> symbolTable;
+
+        std::uint8_t labelSize;
+        while (symbolTableFile.read(reinterpret_cast<char*>(&labelSize), sizeof(labelSize)))
+        {
+            std::string label(labelSize, '\0');
+            std::uint32_t location;
+            if (!symbolTableFile.read(label.data(), labelSize) || !symbolTableFile.read(reinterpret_cast<char*>(&location), sizeof(location)))
+            {
+                break;
+            }
+            symbolTable.insert({ label, location });
+        }
+
+        return symbolTable;
+    }
+
+    // Inverts a symbol table, where several labels share a location the first in alphabetical order names it
+    inline std::unordered_map<std::uint32_t, std::string> nameLocations(const std::unordered_map<std::string, std::uint32_t>& symbolTable)
+    {
+        std::unordered_map<std::uint32_t, std::string> names;
+
+        for (const auto& symbol : symbolTable)
+        {
+            auto it = names.find(symbol.second);
+            if (it == names.end())
+            {
+                names.insert({ symbol.second, symbol.first });
+            }
+            else if (symbol.first < it->second)
+            {
+                it->second = symbol.first;
+            }
+        }
+
+        return names;
+    }
 
     static const std::uint32_t GLOBAL_OFFSET       = 0xFFFF0000;
     static const std::uint32_t STACK_OFFSET        = 0x80000000;
     static const std::uint32_t DATA_SEGMENT_OFFSET = 0x10010000;
     static const std::uint32_t TEXT_SEGMENT_OFFSET = 0x00000000;
+
+    static const std::uint32_t DEFAULT_STACK_SIZE  = 0x00100000;
+    static const std::uint32_t DEFAULT_GLOBAL_SIZE = 0x00010000;
+    static const std::uint32_t MAX_STACK_SIZE      = GLOBAL_OFFSET - STACK_OFFSET;
+    static const std::uint32_t MAX_GLOBAL_SIZE     = 0 - GLOBAL_OFFSET;
+
+    // Never committed, the heap stops short of it and running the stack into it raises a stack overflow
+    static const std::uint32_t STACK_GUARD_SIZE    = 0x00010000;
 }
@@ -1,9 +1,9 @@
 /* Generated by re2c 2.0.3 on Fri Jun 11 00:46:34 2021 */
-// A Bison parser, made by GNU Bison 3.4.1.
+// A Bison parser, made by GNU Bison 3.8.2.
 
 // Skeleton implementation for Bison LALR(1) parsers in C++
 
-// Copyright (C) 2002-2015, 2018-2019 Free Software Foundation, Inc.
+// Copyright (C) 2002-2015, 2018-2021 Free Software Foundation, Inc.
 
 // This program is free software: you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
@@ -16,7 +16,7 @@
 // GNU General Public License for more details.
 
 // You should have received a copy of the GNU General Public License
-// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 // As a special exception, you may create a larger work that contains
 // part or all of the Bison parser skeleton and distribute that work
@@ -31,8 +31,9 @@
 // This special exception was added by the Free Software Foundation in
 // version 2.2 of Bison.
 
-// Undocumented macros, especially those whose name start with YY_,
-// are private implementation details.  Do not rely on them.
+// DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+// especially those whose name start with YY_ or yy_.  They are
+// private implementation details that can be changed or removed.
 
 
 
@@ -59,6 +60,7 @@
 # endif
 #endif
 
+
 // Whether we are compiled with exception support.
 #ifndef YY_EXCEPTIONS
 # if defined __GNUC__ && !defined __EXCEPTIONS
@@ -89,9 +91,6 @@
 # endif
 
 
-// Suppress unused-variable warnings by "using" E.
-#define YYUSE(E) ((void) (E))
-
 // Enable debugging if requested.
 #if YYDEBUG
 
@@ -117,13 +116,13 @@
 # define YY_STACK_PRINT()               \
   do {                                  \
     if (yydebug_)                       \
-      yystack_print_ ();                \
+      yy_stack_print_ ();                \
   } while (false)
 
 #else // !YYDEBUG
 
 # define YYCDEBUG if (false) std::cerr
-# define YY_SYMBOL_PRINT(Title, Symbol)  YYUSE (Symbol)
+# define YY_SYMBOL_PRINT(Title, Symbol)  YY_USE (Symbol)
 # define YY_REDUCE_PRINT(Rule)           static_cast<void> (0)
 # define YY_STACK_PRINT()                static_cast<void> (0)
 
@@ -139,54 +138,13 @@
 
 namespace  cyy  {
 
-
-  /* Return YYSTR after stripping away unnecessary quotes and
-     backslashes, so that it's suitable for yyerror.  The heuristic is
-     that double-quoting is unnecessary unless the string contains an
-     apostrophe, a comma, or backslash (other than backslash-backslash).
-     YYSTR is taken from yytname.  */
-  std::string
-  parser::yytnamerr_ (const char *yystr)
-  {
-    if (*yystr == '"')
-      {
-        std::string yyr;
-        char const *yyp = yystr;
-
-        for (;;)
-          switch (*++yyp)
-            {
-            case '\'':
-            case ',':
-              goto do_not_strip_quotes;
-
-            case '\\':
-              if (*++yyp != '\\')
-                goto do_not_strip_quotes;
-              else
-                goto append;
-
-            append:
-            default:
-              yyr += *yyp;
-              break;
-
-            case '"':
-              return yyr;
-            }
-      do_not_strip_quotes: ;
-      }
-
-    return yystr;
-  }
-
-
   /// Build a parser object.
   parser::parser (kasm::Compiler& compiler_yyarg)
-    :
 #if YYDEBUG
-      yydebug_ (false),
+    : yydebug_ (false),
       yycdebug_ (&std::cerr),
+#else
+    :
 #endif
       compiler (compiler_yyarg)
   {}
@@ -197,9 +155,9 @@ namespace  cyy  {
   parser::syntax_error::~syntax_error () YY_NOEXCEPT YY_NOTHROW
   {}
 
-  /*---------------.
-  | Symbol types.  |
-  `---------------*/
+  /*---------.
+  | symbol.  |
+  `---------*/
 
 
 
@@ -229,13 +187,13 @@ namespace  cyy  {
     : state (s)
   {}
 
-  parser::symbol_number_type
-  parser::by_state::type_get () const YY_NOEXCEPT
+  parser::symbol_kind_type
+  parser::by_state::kind () const YY_NOEXCEPT
   {
     if (state == empty_state)
-      return empty_symbol;
+      return symbol_kind::S_YYEMPTY;
     else
-      return yystos_[state];
+      return YY_CAST (symbol_kind_type, yystos_[+state]);
   }
 
   parser::stack_symbol_type::stack_symbol_type ()
@@ -244,30 +202,30 @@ namespace  cyy  {
   parser::stack_symbol_type::stack_symbol_type (YY_RVREF (stack_symbol_type) that)
     : super_type (YY_MOVE (that.state), YY_MOVE (that.location))
   {
-    switch (that.type_get ())
+    switch (that.kind ())
     {
-      case 36: // statement
-      case 39: // compound_statement
-      case 40: // expression
-      case 41: // expression_or_nothing
-      case 42: // function_definition
-      case 43: // type
-      case 44: // identifier
-      case 45: // literal
-      case 46: // string_literal
+      case symbol_kind::S_statement: // statement
+      case symbol_kind::S_compound_statement: // compound_statement
+      case symbol_kind::S_expression: // expression
+      case symbol_kind::S_expression_or_nothing: // expression_or_nothing
+      case symbol_kind::S_function_definition: // function_definition
+      case symbol_kind::S_type: // type
+      case symbol_kind::S_identifier: // identifier
+      case symbol_kind::S_literal: // literal
+      case symbol_kind::S_string_literal: // string_literal
         value.YY_MOVE_OR_COPY< kasm::ast::Node* > (YY_MOVE (that.value));
         break;
 
-      case 17: // TYPE
+      case symbol_kind::S_TYPE: // TYPE
         value.YY_MOVE_OR_COPY< kasm::ast::Type > (YY_MOVE (that.value));
         break;
 
-      case 14: // IDENTIFIER
-      case 15: // STRING
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+      case symbol_kind::S_STRING: // STRING
         value.YY_MOVE_OR_COPY< std::string > (YY_MOVE (that.value));
         break;
 
-      case 16: // LITERAL
+      case symbol_kind::S_LITERAL: // LITERAL
         value.YY_MOVE_OR_COPY< std::uint32_t > (YY_MOVE (that.value));
         break;
 
@@ -284,30 +242,30 @@ namespace  cyy  {
   parser::stack_symbol_type::stack_symbol_type (state_type s, YY_MOVE_REF (symbol_type) that)
     : super_type (s, YY_MOVE (that.location))
   {
-    switch (that.type_get ())
+    switch (that.kind ())
     {
-      case 36: // statement
-      case 39: // compound_statement
-      case 40: // expression
-      case 41: // expression_or_nothing
-      case 42: // function_definition
-      case 43: // type
-      case 44: // identifier
-      case 45: // literal
-      case 46: // string_literal
+      case symbol_kind::S_statement: // statement
+      case symbol_kind::S_compound_statement: // compound_statement
+      case symbol_kind::S_expression: // expression
+      case symbol_kind::S_expression_or_nothing: // expression_or_nothing
+      case symbol_kind::S_function_definition: // function_definition
+      case symbol_kind::S_type: // type
+      case symbol_kind::S_identifier: // identifier
+      case symbol_kind::S_literal: // literal
+      case symbol_kind::S_string_literal: // string_literal
         value.move< kasm::ast::Node* > (YY_MOVE (that.value));
         break;
 
-      case 17: // TYPE
+      case symbol_kind::S_TYPE: // TYPE
         value.move< kasm::ast::Type > (YY_MOVE (that.value));
         break;
 
-      case 14: // IDENTIFIER
-      case 15: // STRING
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+      case symbol_kind::S_STRING: // STRING
         value.move< std::string > (YY_MOVE (that.value));
         break;
 
-      case 16: // LITERAL
+      case symbol_kind::S_LITERAL: // LITERAL
         value.move< std::uint32_t > (YY_MOVE (that.value));
         break;
 
@@ -316,38 +274,77 @@ namespace  cyy  {
     }
 
     // that is emptied.
-    that.type = empty_symbol;
+    that.kind_ = symbol_kind::S_YYEMPTY;
   }
 
 #if YY_CPLUSPLUS < 201103L
+  parser::stack_symbol_type&
+  parser::stack_symbol_type::operator= (const stack_symbol_type& that)
+  {
+    state = that.state;
+    switch (that.kind ())
+    {
+      case symbol_kind::S_statement: // statement
+      case symbol_kind::S_compound_statement: // compound_statement
+      case symbol_kind::S_expression: // expression
+      case symbol_kind::S_expression_or_nothing: // expression_or_nothing
+      case symbol_kind::S_function_definition: // function_definition
+      case symbol_kind::S_type: // type
+      case symbol_kind::S_identifier: // identifier
+      case symbol_kind::S_literal: // literal
+      case symbol_kind::S_string_literal: // string_literal
+        value.copy< kasm::ast::Node* > (that.value);
+        break;
+
+      case symbol_kind::S_TYPE: // TYPE
+        value.copy< kasm::ast::Type > (that.value);
+        break;
+
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+      case symbol_kind::S_STRING: // STRING
+        value.copy< std::string > (that.value);
+        break;
+
+      case symbol_kind::S_LITERAL: // LITERAL
+        value.copy< std::uint32_t > (that.value);
+        break;
+
+      default:
+        break;
+    }
+
+    location = that.location;
+    return *this;
+  }
+
   parser::stack_symbol_type&
   parser::stack_symbol_type::operator= (stack_symbol_type& that)
   {
     state = that.state;
-    switch (that.type_get ())
+    switch (that.kind ())
     {
-      case 36: // statement
-      case 39: // compound_statement
-      case 40: // expression
-      case 41: // expression_or_nothing
-      case 42: // function_definition
-      case 43: // type
-      case 44: // identifier
-      case 45: // literal
-      case 46: // string_literal
+      case symbol_kind::S_statement: // statement
+      case symbol_kind::S_compound_statement: // compound_statement
+      case symbol_kind::S_expression: // expression
+      case symbol_kind::S_expression_or_nothing: // expression_or_nothing
+      case symbol_kind::S_function_definition: // function_definition
+      case symbol_kind::S_type: // type
+      case symbol_kind::S_identifier: // identifier
+      case symbol_kind::S_literal: // literal
+      case symbol_kind::S_string_literal: // string_literal
         value.move< kasm::ast::Node* > (that.value);
         break;
 
-      case 17: // TYPE
+      case symbol_kind::S_TYPE: // TYPE
         value.move< kasm::ast::Type > (that.value);
         break;
 
-      case 14: // IDENTIFIER
-      case 15: // STRING
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+      case symbol_kind::S_STRING: // STRING
         value.move< std::string > (that.value);
         break;
 
-      case 16: // LITERAL
+      case symbol_kind::S_LITERAL: // LITERAL
         value.move< std::uint32_t > (that.value);
         break;
 
@@ -373,23 +370,21 @@ namespace  cyy  {
 #if YYDEBUG
   template <typename Base>
   void
-  parser::yy_print_ (std::ostream& yyo,
-                                     const basic_symbol<Base>& yysym) const
+  parser::yy_print_ (std::ostream& yyo, const basic_symbol<Base>& yysym) const
   {
     std::ostream& yyoutput = yyo;
-    YYUSE (yyoutput);
-    symbol_number_type yytype = yysym.type_get ();
-#if defined __GNUC__ && ! defined __clang__ && ! defined __ICC && __GNUC__ * 100 + __GNUC_MINOR__ <= 408
-    // Avoid a (spurious) G++ 4.8 warning about "array subscript is
-    // below array bounds".
+    YY_USE (yyoutput);
     if (yysym.empty ())
-      std::abort ();
-#endif
-    yyo << (yytype < yyntokens_ ? "token" : "nterm")
-        << ' ' << yytname_[yytype] << " ("
-        << yysym.location << ": ";
-    YYUSE (yytype);
-    yyo << ')';
+      yyo << "empty symbol";
+    else
+      {
+        symbol_kind_type yykind = yysym.kind ();
+        yyo << (yykind < YYNTOKENS ? "token" : "nterm")
+            << ' ' << yysym.name () << " ("
+            << yysym.location << ": ";
+        YY_USE (yykind);
+        yyo << ')';
+      }
   }
 #endif
 
@@ -413,7 +408,7 @@ namespace  cyy  {
   }
 
   void
-  parser::yypop_ (int n)
+  parser::yypop_ (int n) YY_NOEXCEPT
   {
     yystack_.pop (n);
   }
@@ -448,21 +443,21 @@ namespace  cyy  {
   parser::state_type
   parser::yy_lr_goto_state_ (state_type yystate, int yysym)
   {
-    int yyr = yypgoto_[yysym - yyntokens_] + yystate;
+    int yyr = yypgoto_[yysym - YYNTOKENS] + yystate;
     if (0 <= yyr && yyr <= yylast_ && yycheck_[yyr] == yystate)
       return yytable_[yyr];
     else
-      return yydefgoto_[yysym - yyntokens_];
+      return yydefgoto_[yysym - YYNTOKENS];
   }
 
   bool
-  parser::yy_pact_value_is_default_ (int yyvalue)
+  parser::yy_pact_value_is_default_ (int yyvalue) YY_NOEXCEPT
   {
     return yyvalue == yypact_ninf_;
   }
 
   bool
-  parser::yy_table_value_is_error_ (int yyvalue)
+  parser::yy_table_value_is_error_ (int yyvalue) YY_NOEXCEPT
   {
     return yyvalue == yytable_ninf_;
   }
@@ -476,7 +471,6 @@ namespace  cyy  {
   int
   parser::parse ()
   {
-    // State.
     int yyn;
     /// Length of the RHS of the rule being reduced.
     int yylen = 0;
@@ -512,7 +506,8 @@ namespace  cyy  {
   | yynewstate -- push a new symbol on the stack.  |
   `-----------------------------------------------*/
   yynewstate:
-    YYCDEBUG << "Entering state " << yystack_[0].state << '\n';
+    YYCDEBUG << "Entering state " << int (yystack_[0].state) << '\n';
+    YY_STACK_PRINT ();
 
     // Accept?
     if (yystack_[0].state == yyfinal_)
@@ -526,14 +521,14 @@ namespace  cyy  {
   `-----------*/
   yybackup:
     // Try to take a decision without lookahead.
-    yyn = yypact_[yystack_[0].state];
+    yyn = yypact_[+yystack_[0].state];
     if (yy_pact_value_is_default_ (yyn))
       goto yydefault;
 
     // Read a lookahead token.
     if (yyla.empty ())
       {
-        YYCDEBUG << "Reading a token: ";
+        YYCDEBUG << "Reading a token\n";
 #if YY_EXCEPTIONS
         try
 #endif // YY_EXCEPTIONS
@@ -552,11 +547,23 @@ namespace  cyy  {
       }
     YY_SYMBOL_PRINT ("Next token is", yyla);
 
+    if (yyla.kind () == symbol_kind::S_YYerror)
+    {
+      // The scanner already issued an error message, process directly
+      // to error recovery.  But do not keep the error token as
+      // lookahead, it is too special and may lead us to an endless
+      // loop in error recovery. */
+      yyla.kind_ = symbol_kind::S_YYUNDEF;
+      goto yyerrlab1;
+    }
+
     /* If the proper action on seeing token YYLA.TYPE is to reduce or
        to detect an error, take that action.  */
-    yyn += yyla.type_get ();
-    if (yyn < 0 || yylast_ < yyn || yycheck_[yyn] != yyla.type_get ())
-      goto yydefault;
+    yyn += yyla.kind ();
+    if (yyn < 0 || yylast_ < yyn || yycheck_[yyn] != yyla.kind ())
+      {
+        goto yydefault;
+      }
 
     // Reduce or error.
     yyn = yytable_[yyn];
@@ -573,7 +580,7 @@ namespace  cyy  {
       --yyerrstatus_;
 
     // Shift the lookahead token.
-    yypush_ ("Shifting", yyn, YY_MOVE (yyla));
+    yypush_ ("Shifting", state_type (yyn), YY_MOVE (yyla));
     goto yynewstate;
 
 
@@ -581,7 +588,7 @@ namespace  cyy  {
   | yydefault -- do the default action for the current state.  |
   `-----------------------------------------------------------*/
   yydefault:
-    yyn = yydefact_[yystack_[0].state];
+    yyn = yydefact_[+yystack_[0].state];
     if (yyn == 0)
       goto yyerrlab;
     goto yyreduce;
@@ -600,28 +607,28 @@ namespace  cyy  {
          when using variants.  */
       switch (yyr1_[yyn])
     {
-      case 36: // statement
-      case 39: // compound_statement
-      case 40: // expression
-      case 41: // expression_or_nothing
-      case 42: // function_definition
-      case 43: // type
-      case 44: // identifier
-      case 45: // literal
-      case 46: // string_literal
+      case symbol_kind::S_statement: // statement
+      case symbol_kind::S_compound_statement: // compound_statement
+      case symbol_kind::S_expression: // expression
+      case symbol_kind::S_expression_or_nothing: // expression_or_nothing
+      case symbol_kind::S_function_definition: // function_definition
+      case symbol_kind::S_type: // type
+      case symbol_kind::S_identifier: // identifier
+      case symbol_kind::S_literal: // literal
+      case symbol_kind::S_string_literal: // string_literal
         yylhs.value.emplace< kasm::ast::Node* > ();
         break;
 
-      case 17: // TYPE
+      case symbol_kind::S_TYPE: // TYPE
         yylhs.value.emplace< kasm::ast::Type > ();
         break;
 
-      case 14: // IDENTIFIER
-      case 15: // STRING
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+      case symbol_kind::S_STRING: // STRING
         yylhs.value.emplace< std::string > ();
         break;
 
-      case 16: // LITERAL
+      case symbol_kind::S_LITERAL: // LITERAL
         yylhs.value.emplace< std::uint32_t > ();
         break;
 
@@ -645,160 +652,160 @@ namespace  cyy  {
         {
           switch (yyn)
             {
-  case 2:
-    { compiler.astRoot = kasm::ast::makeEmpty(); }
+  case 2: // program: %empty
+                 { compiler.astRoot = kasm::ast::makeEmpty(); }
     break;
 
-  case 3:
-    { compiler.astRoot = kasm::ast::makeCompound(compiler.astRoot, yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 3: // program: program statement
+                            { compiler.astRoot = kasm::ast::makeCompound(compiler.astRoot, yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 4:
-    { compiler.astRoot = kasm::ast::makeCompound(compiler.astRoot, yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 4: // program: program function_definition
+                                      { compiler.astRoot = kasm::ast::makeCompound(compiler.astRoot, yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 5:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeEmpty(); }
+  case 5: // statement: ';'
+              { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeEmpty(); }
     break;
 
-  case 6:
-    { yylhs.value.as < kasm::ast::Node* > () = yystack_[1].value.as < kasm::ast::Node* > (); }
+  case 6: // statement: expression ';'
+                         { yylhs.value.as < kasm::ast::Node* > () = yystack_[1].value.as < kasm::ast::Node* > (); }
     break;
 
-  case 7:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeReturn(yystack_[1].value.as < kasm::ast::Node* > ()); }
+  case 7: // statement: RETURN expression ';'
+                                { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeReturn(yystack_[1].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 8:
-    { compiler.parseFlag = kasm::Compiler::ParseFlag::BLOCK_AS_STRING; }
+  case 8: // $@1: %empty
+                  { compiler.parseFlag = kasm::Compiler::ParseFlag::BLOCK_AS_STRING; }
     break;
 
-  case 9:
-    {compiler.parseFlag = kasm::Compiler::ParseFlag::NONE;}
+  case 9: // $@2: %empty
+                                                                                              {compiler.parseFlag = kasm::Compiler::ParseFlag::NONE;}
     break;
 
-  case 10:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeASM(yystack_[2].value.as < std::string > ()); }
+  case 10: // statement: ASM '{' $@1 STRING $@2 ';'
+                                                                                                                                                          { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeASM(yystack_[2].value.as < std::string > ()); }
     break;
 
-  case 11:
-    { yylhs.value.as < kasm::ast::Node* > () = yystack_[1].value.as < kasm::ast::Node* > (); }
+  case 11: // statement: '{' compound_statement '}'
+                                     { yylhs.value.as < kasm::ast::Node* > () = yystack_[1].value.as < kasm::ast::Node* > (); }
     break;
 
-  case 12:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeIfThen(yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 12: // statement: IF '(' expression ')' statement
+                                          { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeIfThen(yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 13:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeIfThenElse(yystack_[4].value.as < kasm::ast::Node* > (), yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 13: // statement: IF '(' expression ')' statement ELSE statement
+                                                         { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeIfThenElse(yystack_[4].value.as < kasm::ast::Node* > (), yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 14:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeWhile(yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 14: // statement: WHILE '(' expression ')' statement
+                                             { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeWhile(yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 15:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeFor(yystack_[6].value.as < kasm::ast::Node* > (), yystack_[4].value.as < kasm::ast::Node* > (), yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 15: // statement: FOR '(' expression_or_nothing ';' expression_or_nothing ';' expression_or_nothing ')' statement
+                                                                                                          { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeFor(yystack_[6].value.as < kasm::ast::Node* > (), yystack_[4].value.as < kasm::ast::Node* > (), yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 16:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeDoWhile(yystack_[2].value.as < kasm::ast::Node* > (), yystack_[5].value.as < kasm::ast::Node* > ()); }
+  case 16: // statement: DO statement WHILE '(' expression ')' ';'
+                                                    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeDoWhile(yystack_[2].value.as < kasm::ast::Node* > (), yystack_[5].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 17:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeEmpty(); }
+  case 17: // compound_statement: %empty
+                 { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeEmpty(); }
     break;
 
-  case 18:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeCompound(yystack_[1].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 18: // compound_statement: compound_statement statement
+                                       { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeCompound(yystack_[1].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 19:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeBinaryOperator(kasm::ast::BinaryOperator::ADD, yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 19: // expression: expression '+' expression
+                                    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeBinaryOperator(kasm::ast::BinaryOperator::ADD, yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 20:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeBinaryOperator(kasm::ast::BinaryOperator::MODULUS, yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 20: // expression: expression '%' expression
+                                    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeBinaryOperator(kasm::ast::BinaryOperator::MODULUS, yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 21:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeBinaryOperator(kasm::ast::BinaryOperator::ASSIGNMENT, yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 21: // expression: expression '=' expression
+                                    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeBinaryOperator(kasm::ast::BinaryOperator::ASSIGNMENT, yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 22:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeFunctionCall(yystack_[3].value.as < kasm::ast::Node* > (), yystack_[1].value.as < kasm::ast::Node* > ()); }
+  case 22: // expression: identifier '(' expression_or_nothing ')'
+                                                   { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeFunctionCall(yystack_[3].value.as < kasm::ast::Node* > (), yystack_[1].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 23:
-    { yylhs.value.as < kasm::ast::Node* > () = yystack_[1].value.as < kasm::ast::Node* > (); }
+  case 23: // expression: '(' expression ')'
+                             { yylhs.value.as < kasm::ast::Node* > () = yystack_[1].value.as < kasm::ast::Node* > (); }
     break;
 
-  case 24:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeCompound(yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 24: // expression: expression ',' expression
+                                    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeCompound(yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 25:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeVariableDeclaration(yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 25: // expression: identifier ':' type
+                              { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeVariableDeclaration(yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 26:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeBinaryOperator(kasm::ast::BinaryOperator::EQUAL, yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 26: // expression: expression "==" expression
+                                     { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeBinaryOperator(kasm::ast::BinaryOperator::EQUAL, yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 27:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeBinaryOperator(kasm::ast::BinaryOperator::LESS_THAN_OR_EQUAL, yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 27: // expression: expression "<=" expression
+                                     { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeBinaryOperator(kasm::ast::BinaryOperator::LESS_THAN_OR_EQUAL, yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 28:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeBinaryOperator(kasm::ast::BinaryOperator::LOGICAL_AND, yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 28: // expression: expression "&&" expression
+                                     { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeBinaryOperator(kasm::ast::BinaryOperator::LOGICAL_AND, yystack_[2].value.as < kasm::ast::Node* > (), yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 29:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeUnaryOperator(kasm::ast::UnaryOperator::ADDRESS_OF, yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 29: // expression: '&' expression
+                         { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeUnaryOperator(kasm::ast::UnaryOperator::ADDRESS_OF, yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 30:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeUnaryOperator(kasm::ast::UnaryOperator::INDIRECTION, yystack_[0].value.as < kasm::ast::Node* > ()); }
+  case 30: // expression: '@' expression
+                         { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeUnaryOperator(kasm::ast::UnaryOperator::INDIRECTION, yystack_[0].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 31:
-    { yylhs.value.as < kasm::ast::Node* > () = yystack_[0].value.as < kasm::ast::Node* > (); }
+  case 31: // expression: literal
+                  { yylhs.value.as < kasm::ast::Node* > () = yystack_[0].value.as < kasm::ast::Node* > (); }
     break;
 
-  case 32:
-    { yylhs.value.as < kasm::ast::Node* > () = yystack_[0].value.as < kasm::ast::Node* > (); }
+  case 32: // expression: identifier
+                     { yylhs.value.as < kasm::ast::Node* > () = yystack_[0].value.as < kasm::ast::Node* > (); }
     break;
 
-  case 33:
-    { yylhs.value.as < kasm::ast::Node* > () = yystack_[0].value.as < kasm::ast::Node* > (); }
+  case 33: // expression: string_literal
+                         { yylhs.value.as < kasm::ast::Node* > () = yystack_[0].value.as < kasm::ast::Node* > (); }
     break;
 
-  case 34:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeEmpty(); }
+  case 34: // expression_or_nothing: %empty
+                 { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeEmpty(); }
     break;
 
-  case 35:
-    { yylhs.value.as < kasm::ast::Node* > () = yystack_[0].value.as < kasm::ast::Node* > (); }
+  case 35: // expression_or_nothing: expression
+                     { yylhs.value.as < kasm::ast::Node* > () = yystack_[0].value.as < kasm::ast::Node* > (); }
     break;
 
-  case 36:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeFunctionDefinition(yystack_[8].value.as < kasm::ast::Node* > (), yystack_[3].value.as < kasm::ast::Node* > (), yystack_[6].value.as < kasm::ast::Node* > (), yystack_[1].value.as < kasm::ast::Node* > ()); }
+  case 36: // function_definition: identifier '(' expression_or_nothing ')' ':' type '{' compound_statement '}'
+                                                                                       { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeFunctionDefinition(yystack_[8].value.as < kasm::ast::Node* > (), yystack_[3].value.as < kasm::ast::Node* > (), yystack_[6].value.as < kasm::ast::Node* > (), yystack_[1].value.as < kasm::ast::Node* > ()); }
     break;
 
-  case 37:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeType(yystack_[0].value.as < kasm::ast::Type > ()); }
+  case 37: // type: TYPE
+               { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeType(yystack_[0].value.as < kasm::ast::Type > ()); }
     break;
 
-  case 38:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeIdentifier(yystack_[0].value.as < std::string > ()); }
+  case 38: // identifier: IDENTIFIER
+                     { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeIdentifier(yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 39:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeLiteral(yystack_[0].value.as < std::uint32_t > ()); }
+  case 39: // literal: LITERAL
+                  { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeLiteral(yystack_[0].value.as < std::uint32_t > ()); }
     break;
 
-  case 40:
-    { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeStringLiteral(yystack_[0].value.as < std::string > ()); }
+  case 40: // string_literal: STRING
+                 { yylhs.value.as < kasm::ast::Node* > () = kasm::ast::makeStringLiteral(yystack_[0].value.as < std::string > ()); }
     break;
 
 
@@ -818,7 +825,6 @@ namespace  cyy  {
       YY_SYMBOL_PRINT ("-> $$ =", yylhs);
       yypop_ (yylen);
       yylen = 0;
-      YY_STACK_PRINT ();
 
       // Shift the result of the reduction.
       yypush_ (YY_NULLPTR, YY_MOVE (yylhs));
@@ -834,7 +840,9 @@ namespace  cyy  {
     if (!yyerrstatus_)
       {
         ++yynerrs_;
-        error (yyla.location, yysyntax_error_ (yystack_[0].state, yyla));
+        context yyctx (*this, yyla);
+        std::string msg = yysyntax_error_ (yyctx);
+        error (yyla.location, YY_MOVE (msg));
       }
 
 
@@ -845,7 +853,7 @@ namespace  cyy  {
            error, discard it.  */
 
         // Return failure if at end of input.
-        if (yyla.type_get () == yyeof_)
+        if (yyla.kind () == symbol_kind::S_YYEOF)
           YYABORT;
         else if (!yyla.empty ())
           {
@@ -871,6 +879,7 @@ namespace  cyy  {
        this YYERROR.  */
     yypop_ (yylen);
     yylen = 0;
+    YY_STACK_PRINT ();
     goto yyerrlab1;
 
 
@@ -879,37 +888,39 @@ namespace  cyy  {
   `-------------------------------------------------------------*/
   yyerrlab1:
     yyerrstatus_ = 3;   // Each real token shifted decrements this.
-    {
-      stack_symbol_type error_token;
-      for (;;)
-        {
-          yyn = yypact_[yystack_[0].state];
-          if (!yy_pact_value_is_default_ (yyn))
-            {
-              yyn += yyterror_;
-              if (0 <= yyn && yyn <= yylast_ && yycheck_[yyn] == yyterror_)
-                {
-                  yyn = yytable_[yyn];
-                  if (0 < yyn)
-                    break;
-                }
-            }
+    // Pop stack until we find a state that shifts the error token.
+    for (;;)
+      {
+        yyn = yypact_[+yystack_[0].state];
+        if (!yy_pact_value_is_default_ (yyn))
+          {
+            yyn += symbol_kind::S_YYerror;
+            if (0 <= yyn && yyn <= yylast_
+                && yycheck_[yyn] == symbol_kind::S_YYerror)
+              {
+                yyn = yytable_[yyn];
+                if (0 < yyn)
+                  break;
+              }
+          }
 
-          // Pop the current state because it cannot handle the error token.
-          if (yystack_.size () == 1)
-            YYABORT;
+        // Pop the current state because it cannot handle the error token.
+        if (yystack_.size () == 1)
+          YYABORT;
 
-          yyerror_range[1].location = yystack_[0].location;
-          yy_destroy_ ("Error: popping", yystack_[0]);
-          yypop_ ();
-          YY_STACK_PRINT ();
-        }
+        yyerror_range[1].location = yystack_[0].location;
+        yy_destroy_ ("Error: popping", yystack_[0]);
+        yypop_ ();
+        YY_STACK_PRINT ();
+      }
+    {
+      stack_symbol_type error_token;
 
       yyerror_range[2].location = yyla.location;
       YYLLOC_DEFAULT (error_token.location, yyerror_range, 2);
 
       // Shift the error token.
-      error_token.state = yyn;
+      error_token.state = state_type (yyn);
       yypush_ ("Shifting", YY_MOVE (error_token));
     }
     goto yynewstate;
@@ -941,6 +952,7 @@ namespace  cyy  {
     /* Do not reclaim the symbols of the rule whose action triggered
        this YYABORT or YYACCEPT.  */
     yypop_ (yylen);
+    YY_STACK_PRINT ();
     while (1 < yystack_.size ())
       {
         yy_destroy_ ("Cleanup: popping", yystack_[0]);
@@ -974,18 +986,103 @@ namespace  cyy  {
     error (yyexc.location, yyexc.what ());
   }
 
-  // Generate an error message.
+  /* Return YYSTR after stripping away unnecessary quotes and
+     backslashes, so that it's suitable for yyerror.  The heuristic is
+     that double-quoting is unnecessary unless the string contains an
+     apostrophe, a comma, or backslash (other than backslash-backslash).
+     YYSTR is taken from yytname.  */
   std::string
-  parser::yysyntax_error_ (state_type yystate, const symbol_type& yyla) const
+  parser::yytnamerr_ (const char *yystr)
   {
-    // Number of reported tokens (one for the "unexpected", one per
-    // "expected").
-    size_t yycount = 0;
-    // Its maximum.
-    enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-    // Arguments of yyformat.
-    char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
+    if (*yystr == '"')
+      {
+        std::string yyr;
+        char const *yyp = yystr;
+
+        for (;;)
+          switch (*++yyp)
+            {
+            case '\'':
+            case ',':
+              goto do_not_strip_quotes;
+
+            case '\\':
+              if (*++yyp != '\\')
+                goto do_not_strip_quotes;
+              else
+                goto append;
+
+            append:
+            default:
+              yyr += *yyp;
+              break;
+
+            case '"':
+              return yyr;
+            }
+      do_not_strip_quotes: ;
+      }
+
+    return yystr;
+  }
+
+  std::string
+  parser::symbol_name (symbol_kind_type yysymbol)
+  {
+    return yytnamerr_ (yytname_[yysymbol]);
+  }
+
+
+
+  // parser::context.
+  parser::context::context (const parser& yyparser, const symbol_type& yyla)
+    : yyparser_ (yyparser)
+    , yyla_ (yyla)
+  {}
+
+  int
+  parser::context::expected_tokens (symbol_kind_type yyarg[], int yyargn) const
+  {
+    // Actual number of expected tokens
+    int yycount = 0;
+
+    const int yyn = yypact_[+yyparser_.yystack_[0].state];
+    if (!yy_pact_value_is_default_ (yyn))
+      {
+        /* Start YYX at -YYN if negative to avoid negative indexes in
+           YYCHECK.  In other words, skip the first -YYN actions for
+           this state because they are default actions.  */
+        const int yyxbegin = yyn < 0 ? -yyn : 0;
+        // Stay within bounds of both yycheck and yytname.
+        const int yychecklim = yylast_ - yyn + 1;
+        const int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+        for (int yyx = yyxbegin; yyx < yyxend; ++yyx)
+          if (yycheck_[yyx + yyn] == yyx && yyx != symbol_kind::S_YYerror
+              && !yy_table_value_is_error_ (yytable_[yyx + yyn]))
+            {
+              if (!yyarg)
+                ++yycount;
+              else if (yycount == yyargn)
+                return 0;
+              else
+                yyarg[yycount++] = YY_CAST (symbol_kind_type, yyx);
+            }
+      }
+
+    if (yyarg && yycount == 0 && 0 < yyargn)
+      yyarg[0] = symbol_kind::S_YYEMPTY;
+    return yycount;
+  }
+
+
+
 
+
+
+  int
+  parser::yy_syntax_error_arguments_ (const context& yyctx,
+                                                 symbol_kind_type yyarg[], int yyargn) const
+  {
     /* There are many possibilities here to consider:
        - If this state is a consistent state with a default action, then
          the only way this function was invoked is if the default action
@@ -1004,41 +1101,32 @@ namespace  cyy  {
        - Of course, the expected token list depends on states to have
          correct lookahead information, and it depends on the parser not
          to perform extra reductions after fetching a lookahead from the
-         scanner and before detecting a syntax error.  Thus, state
-         merging (from LALR or IELR) and default reductions corrupt the
-         expected token list.  However, the list is correct for
-         canonical LR with one exception: it will still contain any
-         token that will not be accepted due to an error action in a
-         later state.
+         scanner and before detecting a syntax error.  Thus, state merging
+         (from LALR or IELR) and default reductions corrupt the expected
+         token list.  However, the list is correct for canonical LR with
+         one exception: it will still contain any token that will not be
+         accepted due to an error action in a later state.
     */
-    if (!yyla.empty ())
+
+    if (!yyctx.lookahead ().empty ())
       {
-        int yytoken = yyla.type_get ();
-        yyarg[yycount++] = yytname_[yytoken];
-        int yyn = yypact_[yystate];
-        if (!yy_pact_value_is_default_ (yyn))
-          {
-            /* Start YYX at -YYN if negative to avoid negative indexes in
-               YYCHECK.  In other words, skip the first -YYN actions for
-               this state because they are default actions.  */
-            int yyxbegin = yyn < 0 ? -yyn : 0;
-            // Stay within bounds of both yycheck and yytname.
-            int yychecklim = yylast_ - yyn + 1;
-            int yyxend = yychecklim < yyntokens_ ? yychecklim : yyntokens_;
-            for (int yyx = yyxbegin; yyx < yyxend; ++yyx)
-              if (yycheck_[yyx + yyn] == yyx && yyx != yyterror_
-                  && !yy_table_value_is_error_ (yytable_[yyx + yyn]))
-                {
-                  if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                    {
-                      yycount = 1;
-                      break;
-                    }
-                  else
-                    yyarg[yycount++] = yytname_[yyx];
-                }
-          }
+        if (yyarg)
+          yyarg[0] = yyctx.token ();
+        int yyn = yyctx.expected_tokens (yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+        return yyn + 1;
       }
+    return 0;
+  }
+
+  // Generate an error message.
+  std::string
+  parser::yysyntax_error_ (const context& yyctx) const
+  {
+    // Its maximum.
+    enum { YYARGS_MAX = 5 };
+    // Arguments of yyformat.
+    symbol_kind_type yyarg[YYARGS_MAX];
+    int yycount = yy_syntax_error_arguments_ (yyctx, yyarg, YYARGS_MAX);
 
     char const* yyformat = YY_NULLPTR;
     switch (yycount)
@@ -1059,11 +1147,11 @@ namespace  cyy  {
 
     std::string yyres;
     // Argument number.
-    size_t yyi = 0;
+    std::ptrdiff_t yyi = 0;
     for (char const* yyp = yyformat; *yyp; ++yyp)
       if (yyp[0] == '%' && yyp[1] == 's' && yyi < yycount)
         {
-          yyres += yytnamerr_ (yyarg[yyi++]);
+          yyres += symbol_name (yyarg[yyi++]);
           ++yyp;
         }
       else
@@ -1091,7 +1179,7 @@ namespace  cyy  {
      -40,   -40
   };
 
-  const unsigned char
+  const signed char
   parser::yydefact_[] =
   {
        2,     0,     1,     0,     0,     0,     0,     0,     0,    38,
@@ -1116,11 +1204,11 @@ namespace  cyy  {
   const signed char
   parser::yydefgoto_[] =
   {
-      -1,     1,    53,    46,    73,    30,    18,    50,    19,    63,
+       0,     1,    53,    46,    73,    30,    18,    50,    19,    63,
       24,    21,    22
   };
 
-  const unsigned char
+  const signed char
   parser::yytable_[] =
   {
       17,    25,    42,    23,    64,    26,    65,    29,    42,    34,
@@ -1182,7 +1270,7 @@ namespace  cyy  {
       -1,    21,    -1,    -1,    -1,    25
   };
 
-  const unsigned char
+  const signed char
   parser::yystos_[] =
   {
        0,    35,     0,     3,     5,     6,     7,     9,    10,    14,
@@ -1197,7 +1285,7 @@ namespace  cyy  {
       36,    29
   };
 
-  const unsigned char
+  const signed char
   parser::yyr1_[] =
   {
        0,    34,    35,    35,    35,    36,    36,    36,    37,    38,
@@ -1207,7 +1295,7 @@ namespace  cyy  {
       46
   };
 
-  const unsigned char
+  const signed char
   parser::yyr2_[] =
   {
        0,     2,     0,     2,     2,     1,     2,     3,     0,     0,
@@ -1218,13 +1306,13 @@ namespace  cyy  {
   };
 
 
-
+#if YYDEBUG || 1
   // YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
-  // First, the terminals, then, starting at \a yyntokens_, nonterminals.
+  // First, the terminals, then, starting at \a YYNTOKENS, nonterminals.
   const char*
   const parser::yytname_[] =
   {
-  "END_OF_FILE", "error", "$undefined", "RETURN", "INCLUDE", "ASM",
+  "END_OF_FILE", "error", "\"invalid token\"", "RETURN", "INCLUDE", "ASM",
   "WHILE", "IF", "ELSE", "FOR", "DO", "\"==\"", "\"<=\"", "\"&&\"",
   "IDENTIFIER", "STRING", "LITERAL", "TYPE", "','", "'='", "':'", "'+'",
   "'-'", "'*'", "'/'", "'%'", "'~'", "';'", "'{'", "'}'", "'('", "')'",
@@ -1232,6 +1320,8 @@ namespace  cyy  {
   "compound_statement", "expression", "expression_or_nothing",
   "function_definition", "type", "identifier", "literal", "string_literal", YY_NULLPTR
   };
+#endif
+
 
 #if YYDEBUG
   const unsigned char
@@ -1244,24 +1334,22 @@ namespace  cyy  {
      136
   };
 
-  // Print the state stack on the debug stream.
   void
-  parser::yystack_print_ ()
+  parser::yy_stack_print_ () const
   {
     *yycdebug_ << "Stack now";
     for (stack_type::const_iterator
            i = yystack_.begin (),
            i_end = yystack_.end ();
          i != i_end; ++i)
-      *yycdebug_ << ' ' << i->state;
+      *yycdebug_ << ' ' << int (i->state);
     *yycdebug_ << '\n';
   }
 
-  // Report on the debug stream that the rule \a yyrule is going to be reduced.
   void
-  parser::yy_reduce_print_ (int yyrule)
+  parser::yy_reduce_print_ (int yyrule) const
   {
-    unsigned yylno = yyrline_[yyrule];
+    int yylno = yyrline_[yyrule];
     int yynrhs = yyr2_[yyrule];
     // Print the symbols being reduced, and their result.
     *yycdebug_ << "Reducing stack by rule " << yyrule - 1
@@ -1291,17 +1379,17 @@ const static std::unordered_map<char, char> ESCAPE_SEQUENCES = {
 	{ '\"', '\"' },
 };
 
-static std::string lexStringLiteral(kasm::CompoundInputFileStream& in)
+static std::string lexStringLiteral(kasm::InputStack& in)
 {
 	std::string str;
 
-	std::streampos mar;
+	[[maybe_unused]] const char* mar; // only used if the DFA needs to back up
 	for (;;)
 	{
 		
 {
 	char yych;
-	yych = in.peek();
+	yych = *in.cursor;
 	switch (yych) {
 	case '\n':	goto yy4;
 	case '"':	goto yy6;
@@ -1309,17 +1397,17 @@ static std::string lexStringLiteral(kasm::CompoundInputFileStream& in)
 	default:	goto yy2;
 	}
 yy2:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed string"); } while(0);
+	if (++in.cursor > in.limit) throw std::runtime_error("Unclosed string");
 	{ str.push_back(yych); continue; }
 yy4:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed string"); } while(0);
+	if (++in.cursor > in.limit) throw std::runtime_error("Unclosed string");
 	{ throw std::runtime_error("Unclosed string"); }
 yy6:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed string"); } while(0);
+	if (++in.cursor > in.limit) throw std::runtime_error("Unclosed string");
 	{ break; }
 yy8:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed string"); } while(0);
-	yych = in.peek();
+	if (++in.cursor > in.limit) throw std::runtime_error("Unclosed string");
+	yych = *in.cursor;
 	switch (yych) {
 	case '"':
 	case '\'':
@@ -1336,7 +1424,7 @@ yy8:
 yy9:
 	{ throw std::runtime_error("Illegal escape character in string"); }
 yy10:
-	do { in.ignore(); if (in.eof()) throw std::runtime_error("Unclosed string"); } while(0);
+	if (++in.cursor > in.limit) throw std::runtime_error("Unclosed string");
 	{ str.push_back('\\'); str.push_back(yych); continue; }
 }
 
@@ -1345,46 +1433,31 @@ yy10:
 	return str;
 }
 
-static std::string blockAsString(kasm::CompoundInputFileStream& in)
+// Up to the closing brace
+static std::string blockAsString(kasm::InputStack& in)
 {
-	std::string str;
-	
-	char c;
-	for (;;)
+	const char* start = in.cursor;
+	while (in.cursor < in.limit && *in.cursor != '}')
 	{
-		in.get(c);
-		if (c == '}') break;
-		str.push_back(c);
+		in.cursor++;
 	}
-
-	return str;
-}
-
-static std::string getString(kasm::CompoundInputFileStream& in, std::streampos start, std::streampos end)
-{
-	std::string buffer;
-	buffer.resize(end - start);
-	in.seekg(start);
-	in.read(buffer.data(), end - start);
-	return buffer;
-}
-
-static char getChar(kasm::CompoundInputFileStream& in, std::streampos start, std::streampos end)
-{
-	in.seekg(start);
-	char c;
-	in.get(c);
-	in.seekg(end);
-	return c;
+	if (in.cursor == in.limit)
+	{
+		throw std::runtime_error("Unclosed block");
+	}
+	return std::string(start, in.cursor++);
 }
 
-#define GET_STRING() getString(compiler.in, s, e)
-#define GET_CHAR() getChar(compiler.in, s, e)
+// The text of a token, between its tags
+#define GET_STRING() std::string(s, e)
+#define GET_CHAR() (*s)
 
 cyy::parser::symbol_type cyy::yylex(kasm::Compiler& compiler)
 {
-    std::streampos mar, s, e;
-    std::streampos yyt1;
+    const char* mar;
+    const char* s;
+    const char* e;
+    const char* yyt1;
 
 #define TOKEN(name) do { return parser::make_##name(compiler.loc); } while(0)
 #define TOKENV(name, ...) do { return parser::make_##name(__VA_ARGS__, compiler.loc); } while(0)
@@ -1400,12 +1473,14 @@ cyy::parser::symbol_type cyy::yylex(kasm::Compiler& compiler)
 
 	for (;;)
 	{
+		if (!compiler.in.next()) TOKEN(END_OF_FILE);
+
 		
 {
 	char yych;
 	unsigned int yyaccept = 0;
-	mar = compiler.in.tellg();
-	yych = compiler.in.peek();
+	mar = compiler.in.cursor;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 0x08:
 	case '\t':
@@ -1434,13 +1509,13 @@ cyy::parser::symbol_type cyy::yylex(kasm::Compiler& compiler)
 	case '~':	goto yy27;
 	case '+':
 	case '-':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy28;
 	case '/':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy29;
 	case '0':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy30;
 	case '1':
 	case '3':
@@ -1450,10 +1525,10 @@ cyy::parser::symbol_type cyy::yylex(kasm::Compiler& compiler)
 	case '7':
 	case '8':
 	case '9':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy32;
 	case '2':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy34;
 	case '<':	goto yy35;
 	case '=':	goto yy36;
@@ -1499,90 +1574,90 @@ cyy::parser::symbol_type cyy::yylex(kasm::Compiler& compiler)
 	case 'x':
 	case 'y':
 	case 'z':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy37;
 	case 'a':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy40;
 	case 'd':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy41;
 	case 'e':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy42;
 	case 'f':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy43;
 	case 'i':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy44;
 	case 'r':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy45;
 	case 's':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy46;
 	case 't':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy47;
 	case 'u':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy48;
 	case 'v':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy49;
 	case 'w':
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy50;
 	default:
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy14;
 	}
 yy14:
 	s = yyt1;
-	e = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+	e = compiler.in.cursor;
 	{ throw std::runtime_error(std::string("Invalid character of value: " + std::to_string(GET_CHAR())).c_str()); }
 yy15:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
+	if (++compiler.in.cursor > compiler.in.limit) continue;
 	{ compiler.loc.columns(); continue; }
 yy17:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
+	if (++compiler.in.cursor > compiler.in.limit) continue;
 yy18:
 	{ compiler.loc.lines(); compiler.loc.step(); continue; }
 yy19:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '\n':	goto yy17;
 	default:	goto yy18;
 	}
 yy20:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
+	if (++compiler.in.cursor > compiler.in.limit) continue;
 	{ TOKENV(STRING, lexStringLiteral(compiler.in)); }
 yy22:
 	yyaccept = 1;
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	mar = compiler.in.tellg();
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	mar = compiler.in.cursor;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'i':	goto yy51;
 	default:	goto yy23;
 	}
 yy23:
-	s = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+	s = compiler.in.cursor;
 	s += -1;
-	e = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+	e = compiler.in.cursor;
 	{ return parser::symbol_type(parser::token_type(GET_CHAR()), compiler.loc); }
 yy24:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '&':	goto yy52;
 	default:	goto yy23;
 	}
 yy25:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '"':
 	case '\'':	goto yy26;
@@ -1590,10 +1665,10 @@ yy25:
 	default:	goto yy54;
 	}
 yy26:
-	compiler.in.seekg(mar);
+	compiler.in.cursor = mar;
 	switch (yyaccept) {
 	case 0:
-		yyt1 = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+		yyt1 = compiler.in.cursor;
 		goto yy14;
 	case 1:
 		goto yy23;
@@ -1601,11 +1676,11 @@ yy26:
 		goto yy31;
 	}
 yy27:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
+	if (++compiler.in.cursor > compiler.in.limit) continue;
 	goto yy23;
 yy28:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -1620,17 +1695,17 @@ yy28:
 	default:	goto yy23;
 	}
 yy29:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '/':	goto yy56;
 	default:	goto yy23;
 	}
 yy30:
 	yyaccept = 2;
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	mar = compiler.in.tellg();
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	mar = compiler.in.cursor;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'b':	goto yy59;
 	case 'x':	goto yy60;
@@ -1638,11 +1713,11 @@ yy30:
 	}
 yy31:
 	s = yyt1;
-	e = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+	e = compiler.in.cursor;
 	{ TOKENV(LITERAL, std::stoi(GET_STRING(), nullptr, 10)); }
 yy32:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 yy33:
 	switch (yych) {
 	case '0':
@@ -1658,29 +1733,29 @@ yy33:
 	default:	goto yy31;
 	}
 yy34:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '8':	goto yy61;
 	default:	goto yy33;
 	}
 yy35:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '=':	goto yy63;
 	default:	goto yy23;
 	}
 yy36:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '=':	goto yy65;
 	default:	goto yy23;
 	}
 yy37:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 yy38:
 	switch (yych) {
 	case '0':
@@ -1750,113 +1825,113 @@ yy38:
 	}
 yy39:
 	s = yyt1;
-	e = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+	e = compiler.in.cursor;
 	{ TOKENV(IDENTIFIER, GET_STRING()); }
 yy40:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 's':	goto yy67;
 	default:	goto yy38;
 	}
 yy41:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'o':	goto yy68;
 	default:	goto yy38;
 	}
 yy42:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'l':	goto yy70;
 	default:	goto yy38;
 	}
 yy43:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'o':	goto yy71;
 	default:	goto yy38;
 	}
 yy44:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'f':	goto yy72;
 	default:	goto yy38;
 	}
 yy45:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'e':	goto yy74;
 	default:	goto yy38;
 	}
 yy46:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '3':	goto yy75;
 	default:	goto yy38;
 	}
 yy47:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'y':	goto yy76;
 	default:	goto yy38;
 	}
 yy48:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '3':	goto yy77;
 	case '8':	goto yy78;
 	default:	goto yy38;
 	}
 yy49:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'o':	goto yy80;
 	default:	goto yy38;
 	}
 yy50:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'h':	goto yy81;
 	default:	goto yy38;
 	}
 yy51:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'n':	goto yy82;
 	default:	goto yy26;
 	}
 yy52:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
+	if (++compiler.in.cursor > compiler.in.limit) continue;
 	{ TOKEN(LOGICAL_AND); }
 yy54:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '\'':	goto yy83;
 	default:	goto yy26;
 	}
 yy55:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '\n':	goto yy26;
 	default:	goto yy85;
 	}
 yy56:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '\n':
 	case '\r':	goto yy58;
@@ -1864,19 +1939,19 @@ yy56:
 	}
 yy58:
 	s = yyt1;
-	e = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+	e = compiler.in.cursor;
 	{ continue; }
 yy59:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':	goto yy86;
 	default:	goto yy26;
 	}
 yy60:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -1903,8 +1978,8 @@ yy60:
 	default:	goto yy26;
 	}
 yy61:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -1921,21 +1996,21 @@ yy61:
 yy62:
 	{ TOKENV(TYPE, kasm::ast::Type::S8); }
 yy63:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
+	if (++compiler.in.cursor > compiler.in.limit) continue;
 	{ TOKEN(LESS_THAN_OR_EQUAL); }
 yy65:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
+	if (++compiler.in.cursor > compiler.in.limit) continue;
 	{ TOKEN(EQUAL); }
 yy67:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'm':	goto yy92;
 	default:	goto yy38;
 	}
 yy68:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -2005,22 +2080,22 @@ yy68:
 yy69:
 	{ TOKEN(DO); }
 yy70:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 's':	goto yy94;
 	default:	goto yy38;
 	}
 yy71:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'r':	goto yy95;
 	default:	goto yy38;
 	}
 yy72:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -2090,36 +2165,36 @@ yy72:
 yy73:
 	{ TOKEN(IF); }
 yy74:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 't':	goto yy97;
 	default:	goto yy38;
 	}
 yy75:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '2':	goto yy98;
 	default:	goto yy38;
 	}
 yy76:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'p':	goto yy100;
 	default:	goto yy38;
 	}
 yy77:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '2':	goto yy101;
 	default:	goto yy38;
 	}
 yy78:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -2189,42 +2264,42 @@ yy78:
 yy79:
 	{ TOKENV(TYPE, kasm::ast::Type::U8); }
 yy80:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'i':	goto yy103;
 	default:	goto yy38;
 	}
 yy81:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'i':	goto yy104;
 	default:	goto yy38;
 	}
 yy82:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'c':	goto yy105;
 	default:	goto yy26;
 	}
 yy83:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	s = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	s = compiler.in.cursor;
 	s += -2;
-	e = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+	e = compiler.in.cursor;
 	{ TOKENV(LITERAL, GET_CHAR()); }
 yy85:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '\'':	goto yy106;
 	default:	goto yy26;
 	}
 yy86:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':	goto yy86;
@@ -2232,11 +2307,11 @@ yy86:
 	}
 yy88:
 	s = yyt1;
-	e = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+	e = compiler.in.cursor;
 	{ TOKENV(LITERAL, std::stoi(GET_STRING(), nullptr, 2)); }
 yy89:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -2264,11 +2339,11 @@ yy89:
 	}
 yy91:
 	s = yyt1;
-	e = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+	e = compiler.in.cursor;
 	{ TOKENV(LITERAL, std::stoi(GET_STRING(), nullptr, 16)); }
 yy92:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -2338,15 +2413,15 @@ yy92:
 yy93:
 	{ TOKEN(ASM); }
 yy94:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'e':	goto yy108;
 	default:	goto yy38;
 	}
 yy95:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -2416,15 +2491,15 @@ yy95:
 yy96:
 	{ TOKEN(FOR); }
 yy97:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'u':	goto yy110;
 	default:	goto yy38;
 	}
 yy98:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -2494,15 +2569,15 @@ yy98:
 yy99:
 	{ TOKENV(TYPE, kasm::ast::Type::S32); }
 yy100:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'e':	goto yy111;
 	default:	goto yy38;
 	}
 yy101:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -2572,35 +2647,35 @@ yy101:
 yy102:
 	{ TOKENV(TYPE, kasm::ast::Type::U32); }
 yy103:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'd':	goto yy113;
 	default:	goto yy38;
 	}
 yy104:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'l':	goto yy115;
 	default:	goto yy38;
 	}
 yy105:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'l':	goto yy116;
 	default:	goto yy26;
 	}
 yy106:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	s = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	s = compiler.in.cursor;
 	s += -2;
-	e = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();
+	e = compiler.in.cursor;
 	{ TOKENV(LITERAL, ESCAPE_SEQUENCES.at(GET_CHAR())); }
 yy108:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -2670,15 +2745,15 @@ yy108:
 yy109:
 	{ TOKEN(ELSE); }
 yy110:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'r':	goto yy117;
 	default:	goto yy38;
 	}
 yy111:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -2748,8 +2823,8 @@ yy111:
 yy112:
 	{ TOKENV(TYPE, kasm::ast::Type::TYPE); }
 yy113:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -2819,29 +2894,29 @@ yy113:
 yy114:
 	{ TOKENV(TYPE, kasm::ast::Type::VOID); }
 yy115:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'e':	goto yy118;
 	default:	goto yy38;
 	}
 yy116:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'u':	goto yy120;
 	default:	goto yy26;
 	}
 yy117:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'n':	goto yy121;
 	default:	goto yy38;
 	}
 yy118:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -2911,15 +2986,15 @@ yy118:
 yy119:
 	{ TOKEN(WHILE); }
 yy120:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'd':	goto yy123;
 	default:	goto yy26;
 	}
 yy121:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case '0':
 	case '1':
@@ -2989,14 +3064,14 @@ yy121:
 yy122:
 	{ TOKEN(RETURN); }
 yy123:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
-	yych = compiler.in.peek();
+	if (++compiler.in.cursor > compiler.in.limit) continue;
+	yych = *compiler.in.cursor;
 	switch (yych) {
 	case 'e':	goto yy124;
 	default:	goto yy26;
 	}
 yy124:
-	do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);
+	if (++compiler.in.cursor > compiler.in.limit) continue;
 	{ TOKEN(INCLUDE); }
 }
 
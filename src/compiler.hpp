@@ -7,7 +7,7 @@
 #include <vector>
 
 #include "ast.hpp"
-#include "compoundInputFileStream.hpp"
+#include "inputStack.hpp"
 #include "compiler.tab.hpp"
 
 namespace kasm
@@ -33,7 +33,7 @@ namespace kasm
 		void optimize(const ast::Node* astNode);
 		void codeGeneration(const ast::Node* astNode);
 
-		CompoundInputFileStream in;
+		InputStack in;
 		cyy::location loc;
 		ast::Node* astRoot;
 
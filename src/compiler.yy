@@ -31,7 +31,7 @@ namespace kasm { class Compiler; };
 #include <vector>
 
 #include "ast.hpp"
-#include "compoundInputFileStream.hpp"
+#include "inputStack.hpp"
 }//%code requires
 
 %code provides
@@ -151,11 +151,11 @@ const static std::unordered_map<char, char> ESCAPE_SEQUENCES = {
 	{ '\"', '\"' },
 };
 
-static std::string lexStringLiteral(kasm::CompoundInputFileStream& in)
+static std::string lexStringLiteral(kasm::InputStack& in)
 {
 	std::string str;
 
-	std::streampos mar;
+	[[maybe_unused]] const char* mar; // only used if the DFA needs to back up
 	for (;;)
 	{
 		%{ /* Begin re2c lexer */
@@ -163,10 +163,10 @@ static std::string lexStringLiteral(kasm::CompoundInputFileStream& in)
 		re2c:flags:input = custom;
 		re2c:api:style = free-form;
 		re2c:define:YYCTYPE   = char;
-		re2c:define:YYPEEK    = "in.peek()";
-		re2c:define:YYSKIP    = "do { in.ignore(); if (in.eof()) throw std::runtime_error(\"Unclosed string\"); } while(0);";
-		re2c:define:YYBACKUP  = "mar = in.tellg();";
-		re2c:define:YYRESTORE = "in.seekg(mar);";
+		re2c:define:YYPEEK    = "*in.cursor";
+		re2c:define:YYSKIP    = "if (++in.cursor > in.limit) throw std::runtime_error(\"Unclosed string\");";
+		re2c:define:YYBACKUP  = "mar = in.cursor;";
+		re2c:define:YYRESTORE = "in.cursor = mar;";
 		
 		"\n" { throw std::runtime_error("Unclosed string"); }
 
@@ -181,46 +181,31 @@ static std::string lexStringLiteral(kasm::CompoundInputFileStream& in)
 	return str;
 }
 
-static std::string blockAsString(kasm::CompoundInputFileStream& in)
+// Up to the closing brace
+static std::string blockAsString(kasm::InputStack& in)
 {
-	std::string str;
-	
-	char c;
-	for (;;)
+	const char* start = in.cursor;
+	while (in.cursor < in.limit && *in.cursor != '}')
 	{
-		in.get(c);
-		if (c == '}') break;
-		str.push_back(c);
+		in.cursor++;
 	}
-
-	return str;
-}
-
-static std::string getString(kasm::CompoundInputFileStream& in, std::streampos start, std::streampos end)
-{
-	std::string buffer;
-	buffer.resize(end - start);
-	in.seekg(start);
-	in.read(buffer.data(), end - start);
-	return buffer;
-}
-
-static char getChar(kasm::CompoundInputFileStream& in, std::streampos start, std::streampos end)
-{
-	in.seekg(start);
-	char c;
-	in.get(c);
-	in.seekg(end);
-	return c;
+	if (in.cursor == in.limit)
+	{
+		throw std::runtime_error("Unclosed block");
+	}
+	return std::string(start, in.cursor++);
 }
 
-#define GET_STRING() getString(compiler.in, s, e)
-#define GET_CHAR() getChar(compiler.in, s, e)
+// The text of a token, between its tags
+#define GET_STRING() std::string(s, e)
+#define GET_CHAR() (*s)
 
 cyy::parser::symbol_type cyy::yylex(kasm::Compiler& compiler)
 {
-    std::streampos mar, s, e;
-    /*!stags:re2c format = 'std::streampos @@;'; */
+    const char* mar;
+    const char* s;
+    const char* e;
+    /*!stags:re2c format = 'const char* @@;'; */
 
 #define TOKEN(name) do { return parser::make_##name(compiler.loc); } while(0)
 #define TOKENV(name, ...) do { return parser::make_##name(__VA_ARGS__, compiler.loc); } while(0)
@@ -236,17 +221,19 @@ cyy::parser::symbol_type cyy::yylex(kasm::Compiler& compiler)
 
 	for (;;)
 	{
+		if (!compiler.in.next()) TOKEN(END_OF_FILE);
+
 		%{ /* Begin re2c lexer */
 		re2c:yyfill:enable = 0;
 		re2c:flags:input = custom;
 		re2c:api:style = free-form;
 		re2c:define:YYCTYPE      = char;
-		re2c:define:YYPEEK       = "compiler.in.peek()";
-		re2c:define:YYSKIP       = "do { compiler.in.ignore(); if (compiler.in.eof()) TOKEN(END_OF_FILE); } while(0);";
-		re2c:define:YYBACKUP     = "mar = compiler.in.tellg();";
-		re2c:define:YYRESTORE    = "compiler.in.seekg(mar);";
-		re2c:define:YYSTAGP      = "@@{tag} = compiler.in.eof() ? std::streampos(0) : compiler.in.tellg();";
-		re2c:define:YYSTAGN      = "@@{tag} = 0;";
+		re2c:define:YYPEEK       = "*compiler.in.cursor";
+		re2c:define:YYSKIP       = "if (++compiler.in.cursor > compiler.in.limit) continue;";
+		re2c:define:YYBACKUP     = "mar = compiler.in.cursor;";
+		re2c:define:YYRESTORE    = "compiler.in.cursor = mar;";
+		re2c:define:YYSTAGP      = "@@{tag} = compiler.in.cursor;";
+		re2c:define:YYSTAGN      = "@@{tag} = nullptr;";
 		re2c:define:YYSHIFTSTAG  = "@@{tag} += @@{shift};";
         re2c:flags:tags = 1;
 
@@ -0,0 +1,345 @@
+#include "console.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <limits>
+
+#if defined(_WIN32)
+#include <io.h>
+#define read _read
+#define write _write
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace kasm
+{
+    Console::Console(int aInputFd, int aOutputFd)
+        : inputFd(aInputFd), outputFd(aOutputFd), lastFlush(std::chrono::steady_clock::now())
+    {
+    }
+
+    Console::~Console()
+    {
+        flush();
+    }
+
+    void Console::setDescriptors(int aInputFd, int aOutputFd)
+    {
+        flush();
+        // Whatever a non-blocking descriptor did not take belongs to it, not to the next one
+        outputSize = 0;
+        outputBlocked = false;
+        inputFd = aInputFd;
+        outputFd = aOutputFd;
+        inputBegin = 0;
+        inputEnd = 0;
+        inputEnded = false;
+    }
+
+    void Console::setBufferSize(std::size_t size)
+    {
+        flush();
+        unbuffered = size == 0;
+        // Always leave room for a formatted integer
+        outputCapacity = std::max<std::size_t>(size, std::numeric_limits<std::uint32_t>::digits10 + 1);
+        if (!output.empty())
+        {
+            output.resize(outputCapacity);
+        }
+    }
+
+    void Console::setFlushInterval(std::uint32_t milliseconds)
+    {
+        flushInterval = std::chrono::milliseconds(milliseconds);
+    }
+
+    void Console::writeChar(char c)
+    {
+        reserve(1);
+        output[outputSize++] = c;
+        written();
+    }
+
+    void Console::writeInt(std::uint32_t value)
+    {
+        reserve(std::numeric_limits<std::uint32_t>::digits10 + 1);
+        std::to_chars_result result = std::to_chars(output.data() + outputSize, output.data() + output.size(), value);
+        outputSize = result.ptr - output.data();
+        written();
+    }
+
+    void Console::writeString(const char* string, std::size_t length)
+    {
+        reserve(0);
+        if (length > output.size() - outputSize)
+        {
+            flush();
+            if (length > output.size() && !outputBlocked)
+            {
+                std::size_t count = writeAll(string, length);
+                string += count;
+                length -= count;
+            }
+            if (length > output.size() - outputSize)
+            {
+                // Only when the descriptor is blocked, the rest waits for the next flush
+                output.resize(outputSize + length);
+            }
+        }
+
+        std::copy(string, string + length, output.data() + outputSize);
+        outputSize += length;
+        written();
+    }
+
+    void Console::flush()
+    {
+        std::size_t count = writeAll(output.data(), outputSize);
+        std::copy(output.begin() + count, output.begin() + outputSize, output.begin());
+        outputSize -= count;
+        if (outputSize == 0 && output.size() > outputCapacity)
+        {
+            output.resize(outputCapacity);
+            output.shrink_to_fit();
+        }
+        lastFlush = std::chrono::steady_clock::now();
+    }
+
+    bool Console::readInt(std::uint32_t& value)
+    {
+        value = 0;
+
+        while (std::isspace(peek()))
+        {
+            get();
+        }
+
+        char digits[std::numeric_limits<std::uint64_t>::digits10 + 2];
+        std::size_t length = 0;
+        bool negative = false;
+        if (peek() == '-' || peek() == '+')
+        {
+            negative = get() == '-';
+        }
+        while (std::isdigit(peek()) && length < sizeof(digits))
+        {
+            digits[length++] = static_cast<char>(get());
+        }
+
+        if (length == 0)
+        {
+            return false;
+        }
+
+        std::from_chars_result result = std::from_chars(digits, digits + length, value);
+        if (result.ec == std::errc::result_out_of_range)
+        {
+            value = std::numeric_limits<std::uint32_t>::max();
+            return false;
+        }
+
+        // Matches formatted stream input of unsigned integers, which wraps negative numbers around
+        if (negative)
+        {
+            value = 0 - value;
+        }
+
+        return true;
+    }
+
+    int Console::readChar()
+    {
+        int c;
+        do
+        {
+            c = get();
+        } while (c != -1 && std::isspace(c));
+
+        int rest = c;
+        while (rest != -1 && rest != '\n')
+        {
+            rest = get();
+        }
+
+        return c;
+    }
+
+    std::size_t Console::readLine(char* buffer, std::size_t size)
+    {
+        if (size == 0)
+        {
+            return 0;
+        }
+
+        std::size_t length = 0;
+        int c;
+        while ((c = get()) != -1 && c != '\n' && length < size - 1)
+        {
+            buffer[length++] = static_cast<char>(c);
+        }
+        buffer[length] = '\0';
+
+        return length;
+    }
+
+    bool Console::isInputReady(bool skipWhitespace)
+    {
+        if (input.empty())
+        {
+            input.resize(INPUT_BUFFER_SIZE);
+        }
+
+        // Make room behind what is buffered and take whatever is there without waiting
+        if (inputBegin)
+        {
+            std::copy(input.begin() + inputBegin, input.begin() + inputEnd, input.begin());
+            inputEnd -= inputBegin;
+            inputBegin = 0;
+        }
+        while (!inputEnded && inputEnd < input.size())
+        {
+            long count = read(inputFd, input.data() + inputEnd, static_cast<unsigned int>(input.size() - inputEnd));
+            if (count < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (count == 0)
+            {
+                inputEnded = true;
+            }
+            if (count <= 0)
+            {
+                break;
+            }
+            inputEnd += static_cast<std::size_t>(count);
+        }
+
+        if (inputEnded || inputEnd == input.size())
+        {
+            return true;
+        }
+
+        auto begin = input.begin();
+        auto end = input.begin() + inputEnd;
+        if (skipWhitespace)
+        {
+            begin = std::find_if(begin, end, [](char c) { return !std::isspace(static_cast<unsigned char>(c)); });
+        }
+        return std::find(begin, end, '\n') != end;
+    }
+
+    int Console::peek()
+    {
+        if (inputBegin == inputEnd && !fill())
+        {
+            return -1;
+        }
+
+        return static_cast<unsigned char>(input[inputBegin]);
+    }
+
+    int Console::get()
+    {
+        int c = peek();
+        if (c != -1)
+        {
+            inputBegin++;
+        }
+
+        return c;
+    }
+
+    bool Console::fill()
+    {
+        // Whatever the guest wrote so far has to be visible before it waits for input
+        flush();
+
+        if (input.empty())
+        {
+            input.resize(INPUT_BUFFER_SIZE);
+        }
+        inputBegin = 0;
+        inputEnd = 0;
+
+        long count;
+        do
+        {
+            count = read(inputFd, input.data(), static_cast<unsigned int>(input.size()));
+        } while (count < 0 && errno == EINTR);
+
+        if (count <= 0)
+        {
+            return false;
+        }
+
+        inputEnd = static_cast<std::size_t>(count);
+        return true;
+    }
+
+    void Console::reserve(std::size_t size)
+    {
+        if (output.empty())
+        {
+            output.resize(outputCapacity);
+        }
+        if (output.size() - outputSize < size)
+        {
+            flush();
+            if (output.size() - outputSize < size)
+            {
+                output.resize(outputSize + size);
+            }
+        }
+    }
+
+    void Console::written()
+    {
+        if (unbuffered || (flushInterval.count() && std::chrono::steady_clock::now() - lastFlush >= flushInterval))
+        {
+            flush();
+        }
+    }
+
+    std::size_t Console::writeAll(const char* data, std::size_t size)
+    {
+        std::size_t remaining = size;
+        outputBlocked = false;
+        while (remaining)
+        {
+            long count = write(outputFd, data, static_cast<unsigned int>(std::min<std::size_t>(remaining, std::numeric_limits<int>::max())));
+            if (count < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+#if !defined(_WIN32)
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    if (nonBlockingOutput)
+                    {
+                        outputBlocked = true;
+                        return size - remaining;
+                    }
+
+                    // Descriptors shared with non-blocking input have to wait for room here
+                    pollfd descriptor = { outputFd, POLLOUT, 0 };
+                    poll(&descriptor, 1, -1);
+                    continue;
+                }
+#endif
+
+                // Nowhere left to report to, drop the output like a failed stream would
+                return size;
+            }
+
+            data += count;
+            remaining -= static_cast<std::size_t>(count);
+        }
+        return size;
+    }
+}
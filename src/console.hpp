@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace kasm
+{
+	// Console I/O of the virtual machine, buffered in user space straight over the standard file descriptors.
+	// Output is flushed when the buffer fills up, before reading input, when the flush interval elapses and on
+	// destruction or an explicit flush(). Buffers are only allocated once they are first used, so idle instances stay
+	// small.
+	class Console
+	{
+	public:
+		Console(int aInputFd = 0, int aOutputFd = 1);
+		~Console();
+
+		// Switches to other descriptors, flushing pending output and dropping buffered input first
+		void setDescriptors(int aInputFd, int aOutputFd);
+		// A size of zero writes everything through immediately
+		void setBufferSize(std::size_t size);
+		// Flushes output at the first write after this many milliseconds since the last flush, zero disables it
+		void setFlushInterval(std::uint32_t milliseconds);
+		// For an output descriptor in non-blocking mode: output it does not take without waiting stays buffered, past
+		// the buffer size if it has to, and isOutputBlocked() is set until a later flush writes it
+		void setNonBlockingOutput(bool enabled) { nonBlockingOutput = enabled; }
+
+		void writeChar(char c);
+		void writeInt(std::uint32_t value);
+		void writeString(const char* string, std::size_t length);
+		void flush();
+
+		// Skips leading whitespace like formatted stream input. Returns false and sets value to 0 if no integer follows.
+		bool readInt(std::uint32_t& value);
+		// Returns the next character that is not whitespace, dropping the rest of its line, or -1 at the end of input
+		int readChar();
+		// Reads up to size - 1 characters of a line into buffer and terminates it, the newline is consumed
+		std::size_t readLine(char* buffer, std::size_t size);
+
+		// Buffers whatever input is available without waiting and returns true if the next read can complete from the
+		// buffer alone: a line is buffered, after the leading whitespace when skipWhitespace is set as for readInt and
+		// readChar, or the input ended or the buffer is full. Meant for descriptors in non-blocking mode.
+		bool isInputReady(bool skipWhitespace);
+		int getInputFd() const { return inputFd; }
+		int getOutputFd() const { return outputFd; }
+		bool isOutputBlocked() const { return outputBlocked; }
+
+		static const std::size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+		static const std::size_t INPUT_BUFFER_SIZE = 64 * 1024;
+
+	private:
+		int peek();
+		int get();
+		bool fill();
+		void reserve(std::size_t size);
+		void written();
+		// Returns how much was written, all of it unless the descriptor is full in non-blocking mode
+		std::size_t writeAll(const char* data, std::size_t size);
+
+		int inputFd;
+		int outputFd;
+
+		std::vector<char> output;
+		std::size_t outputCapacity = DEFAULT_BUFFER_SIZE;
+		std::size_t outputSize = 0;
+		bool unbuffered = false;
+		bool nonBlockingOutput = false;
+		bool outputBlocked = false;
+		std::chrono::milliseconds flushInterval{ 0 };
+		std::chrono::steady_clock::time_point lastFlush;
+
+		std::vector<char> input;
+		std::size_t inputBegin = 0;
+		std::size_t inputEnd = 0;
+		bool inputEnded = false;
+	};
+}
@@ -45,7 +45,7 @@ namespace kasm
 					run();
 					break;
 				case 'i':
-					step();
+					runGuarded(&Debugger::step);
 					break;
 				case 'd':
 					std::cout << "0x" << std::hex << std::setw(8) << std::setfill('0') << pc << std::endl;
@@ -78,6 +78,14 @@ namespace kasm
 						std::cout << "breakpoint hit at " << "0x" << std::hex << std::setw(8) << std::setfill('0') << pc << std::endl;
 					}
 				}
+				else if (signal == Signal::SEGMENTATION_FAULT)
+				{
+					std::cout << "segmentation fault at " << "0x" << std::hex << std::setw(8) << std::setfill('0') << pc << std::endl;
+				}
+				else if (signal == Signal::STACK_OVERFLOW)
+				{
+					std::cout << "stack overflow at " << "0x" << std::hex << std::setw(8) << std::setfill('0') << pc << std::endl;
+				}
 			}
 
 			lastInput = input;
@@ -94,17 +102,7 @@ namespace kasm
 		VirtualMachine::loadProgram(programPath);
 
 		std::ifstream symbolTableFile(symbolTablePath, std::ios::binary);
-		while (!symbolTableFile.eof())
-		{
-			std::uint8_t labelSize;
-			symbolTableFile.read(reinterpret_cast<char*>(&labelSize), sizeof(labelSize));
-			std::string label;
-			label.resize(labelSize);
-			symbolTableFile.read(reinterpret_cast<char*>(label.data()), labelSize);
-			std::uint32_t location;
-			symbolTableFile.read(reinterpret_cast<char*>(&location), sizeof(location));
-			symbolTable.insert({ label, location });
-		}
+		symbolTable = readSymbolTable(symbolTableFile);
 	}
 
 	void Debugger::setBreakpoint(const std::string& label)
@@ -117,10 +115,11 @@ namespace kasm
 
 	void Debugger::setBreakpoint(std::uint32_t address)
 	{
-		if (!breakpoints.count(address))
+		if (!breakpoints.count(address) && program.getMemory().isCommitted(address, INSTRUCTION_SIZE))
 		{
 			breakpoints.insert({ address, program.getWord(address) });
 			program.getWord(address) = 0xFFFFFFFF;
+			invalidateInstruction(address);
 		}
 	}
 
@@ -137,6 +136,7 @@ namespace kasm
 		if (breakpoints.count(address))
 		{
 			program.getWord(address) = breakpoints.at(address);
+			invalidateInstruction(address);
 			breakpoints.erase(address);
 		}
 	}
@@ -148,6 +148,11 @@ namespace kasm
 
 	std::uint32_t Debugger::peakMemory(std::uint32_t address)
 	{
+		if (!program.getMemory().isCommitted(address, 1))
+		{
+			executeSignal(Signal::SEGMENTATION_FAULT);
+		}
+
 		return program[address];
 	}
 }
@@ -14,7 +14,6 @@ namespace kasm
 		std::ifstream programFile(programPath, std::ios::binary);
 		std::ofstream asmFile(asmPath);
 
-		static const char* instructionNames[] = { "add", "addi", "addiu", "addu", "and", "andi", "beq", "bgez", "bgezal", "bgtz", "blez", "bltz", "bltzal", "bne", "div", "divu", "j", "jal", "jr", "lb", "lui", "lw", "mfhi", "mflo", "mult", "multu", "or", "ori", "sb", "sll", "sllv", "slt", "slti", "sltiu", "sltu", "sne", "seq", "sra", "srl", "srlv", "sub", "subu", "sw", "sys", "xor", "xori", "jalr", "nor", ".text", ".data" };
 		static const char* registerNames[] = { "$zero", "$at", "$v0", "v1", "$a0", "$a1", "$a2", "$a3", "$t0", "$t1", "$t2", "$t3", "$t4", "$t5", "$t6", "$t7", "$s0", "$s1", "$s2", "$s3", "$s4", "$s5", "$s6", "$s7", "$t8", "$t9", "$k0", "$k1", "$gp", "$sp", "$fp", "$ra" };
 
 		enum InstrucionElement
@@ -27,6 +26,7 @@ namespace kasm
 			DAO = 1 << 4,
 			I = 1 << 5,
 			IDA = 1 << 6,
+			IRA = 1 << 7, // register indirect address
 
 			RRR = R0 | R1 | R2,
 			RRI = R0 | R1 | I,
@@ -35,6 +35,7 @@ namespace kasm
 			RI = R0 | I,
 			RDAA = R0 | DAA,
 			RIDA = R0 | IDA,
+			RRIRA = R0 | R2 | IRA,
 		};
 
 		static const std::unordered_map<std::uint32_t, std::uint32_t>  instructionFormats =
@@ -87,26 +88,20 @@ namespace kasm
 			{ XORI, RRI },
 			{ JALR, RR },
 			{ NOR, RRR },
+			{ CAS, RRIRA },
+			{ AMOADD, RRIRA },
+			{ AMOSWAP, RRIRA },
+			{ SYNC, NONE },
 		};
 
 		ProgramHeader programHeader;
-		programFile.read(reinterpret_cast<char*>(&programHeader), sizeof(programHeader));
+		readProgramHeader(programFile, programHeader);
 		std::uint32_t pc = 0;
 
 		if (!symbolTablePath.empty())
 		{
 			std::ifstream symbolTableFile(symbolTablePath, std::ios::binary);
-			while (!symbolTableFile.eof())
-			{
-				std::uint8_t labelSize;
-				symbolTableFile.read(reinterpret_cast<char*>(&labelSize), sizeof(labelSize));
-				std::string label;
-				label.resize(labelSize);
-				symbolTableFile.read(reinterpret_cast<char*>(label.data()), labelSize);
-				std::uint32_t location;
-				symbolTableFile.read(reinterpret_cast<char*>(&location), sizeof(location));
-				symbolTable.insert({ location, label });
-			}
+			symbolTable = nameLocations(readSymbolTable(symbolTableFile));
 		}
 
 		if (programHeader.textSegmentLength)
@@ -126,7 +121,7 @@ namespace kasm
 			programFile.read(reinterpret_cast<char*>(&d), sizeof(d));
 
 			std::uint32_t instructionFormat = instructionFormats.at(d.opcode);
-			asmFile << std::hex << std::setw(0) << instructionNames[d.opcode] << " ";
+			asmFile << std::hex << std::setw(0) << OPCODE_NAMES[d.opcode] << " ";
 				
 			if (instructionFormat & R0)
 			{
@@ -174,6 +169,10 @@ namespace kasm
 				}
 				asmFile << ", ";
 			}
+			if (instructionFormat & IRA)
+			{
+				asmFile << "(" << registerNames[d.register1] << "), ";
+			}
 
 			if (instructionFormat != NONE)
 			{
@@ -0,0 +1,242 @@
+#include "fileTable.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace kasm
+{
+    namespace
+    {
+        // Single transfers are capped so the count always fits the return value of every platform's read and write
+        const std::size_t MAX_TRANSFER_SIZE = std::numeric_limits<int>::max();
+
+#if defined(_WIN32)
+        int openFd(const char* path, int flags) { return _open(path, flags | _O_BINARY, _S_IREAD | _S_IWRITE); }
+        void closeFd(int fd) { _close(fd); }
+        std::int64_t readFd(int fd, void* buffer, std::size_t size) { return _read(fd, buffer, static_cast<unsigned int>(size)); }
+        std::int64_t writeFd(int fd, const void* buffer, std::size_t size) { return _write(fd, buffer, static_cast<unsigned int>(size)); }
+        std::int64_t seekFd(int fd, std::int64_t offset, int whence) { return _lseeki64(fd, offset, whence); }
+        int duplicateFd(int fd) { return _dup(fd); }
+#else
+        int openFd(const char* path, int flags) { return ::open(path, flags | O_CLOEXEC, 0666); }
+        void closeFd(int fd) { ::close(fd); }
+        std::int64_t readFd(int fd, void* buffer, std::size_t size) { return ::read(fd, buffer, size); }
+        std::int64_t writeFd(int fd, const void* buffer, std::size_t size) { return ::write(fd, buffer, size); }
+        std::int64_t seekFd(int fd, std::int64_t offset, int whence) { return ::lseek(fd, offset, whence); }
+        int duplicateFd(int fd) { return ::fcntl(fd, F_DUPFD_CLOEXEC, 0); }
+#endif
+    }
+
+    FileTable::~FileTable()
+    {
+        closeAll();
+    }
+
+    std::uint32_t FileTable::open(const char* path, bool read, bool write)
+    {
+        int flags = read && write ? O_RDWR : write ? O_WRONLY | O_CREAT | O_TRUNC : O_RDONLY;
+        int fd = openFd(path, flags);
+        if (fd == -1)
+        {
+            return 0;
+        }
+
+        auto slot = std::find(fds.begin(), fds.end(), -1);
+        if (slot == fds.end())
+        {
+            slot = fds.insert(fds.end(), fd);
+        }
+        else
+        {
+            *slot = fd;
+        }
+
+        return static_cast<std::uint32_t>(slot - fds.begin()) + 1;
+    }
+
+    void FileTable::close(std::uint32_t handle)
+    {
+        int fd = get(handle);
+        fds[handle - 1] = -1;
+        closeFd(fd);
+    }
+
+    std::int64_t FileTable::read(std::uint32_t handle, void* buffer, std::size_t size)
+    {
+        int fd = get(handle);
+        std::int64_t count;
+        do
+        {
+            count = readFd(fd, buffer, std::min(size, MAX_TRANSFER_SIZE));
+        } while (count < 0 && errno == EINTR);
+
+        return count;
+    }
+
+    std::int64_t FileTable::write(std::uint32_t handle, const void* buffer, std::size_t size)
+    {
+        int fd = get(handle);
+        std::int64_t count;
+        do
+        {
+            count = writeFd(fd, buffer, std::min(size, MAX_TRANSFER_SIZE));
+        } while (count < 0 && errno == EINTR);
+
+        return count;
+    }
+
+    std::int64_t FileTable::pread(std::uint32_t handle, void* buffer, std::size_t size, std::int64_t offset)
+    {
+        int fd = get(handle);
+        std::int64_t count;
+#if defined(_WIN32)
+        std::int64_t position = seekFd(fd, 0, SEEK_CUR);
+        if (position < 0 || seekFd(fd, offset, SEEK_SET) < 0)
+        {
+            return -1;
+        }
+        count = readFd(fd, buffer, std::min(size, MAX_TRANSFER_SIZE));
+        seekFd(fd, position, SEEK_SET);
+#else
+        do
+        {
+            count = ::pread(fd, buffer, std::min(size, MAX_TRANSFER_SIZE), offset);
+        } while (count < 0 && errno == EINTR);
+#endif
+
+        return count;
+    }
+
+    std::int64_t FileTable::pwrite(std::uint32_t handle, const void* buffer, std::size_t size, std::int64_t offset)
+    {
+        int fd = get(handle);
+        std::int64_t count;
+#if defined(_WIN32)
+        std::int64_t position = seekFd(fd, 0, SEEK_CUR);
+        if (position < 0 || seekFd(fd, offset, SEEK_SET) < 0)
+        {
+            return -1;
+        }
+        count = writeFd(fd, buffer, std::min(size, MAX_TRANSFER_SIZE));
+        seekFd(fd, position, SEEK_SET);
+#else
+        do
+        {
+            count = ::pwrite(fd, buffer, std::min(size, MAX_TRANSFER_SIZE), offset);
+        } while (count < 0 && errno == EINTR);
+#endif
+
+        return count;
+    }
+
+    std::int64_t FileTable::seek(std::uint32_t handle, std::int64_t offset, Whence whence)
+    {
+        int origin = whence == Whence::BEGIN ? SEEK_SET : whence == Whence::END ? SEEK_END : SEEK_CUR;
+        return seekFd(get(handle), offset, origin);
+    }
+
+    std::int64_t FileTable::size(std::uint32_t handle)
+    {
+        int fd = get(handle);
+#if defined(_WIN32)
+        struct _stat64 status;
+        if (_fstat64(fd, &status))
+#else
+        struct stat status;
+        if (fstat(fd, &status))
+#endif
+        {
+            return -1;
+        }
+
+        return status.st_size;
+    }
+
+    bool FileTable::stat(const char* path, Status& status)
+    {
+#if defined(_WIN32)
+        struct _stat64 hostStatus;
+        if (_stat64(path, &hostStatus))
+#else
+        struct stat hostStatus;
+        if (::stat(path, &hostStatus))
+#endif
+        {
+            return false;
+        }
+
+        status.size = hostStatus.st_size;
+        status.directory = (hostStatus.st_mode & S_IFMT) == S_IFDIR;
+        status.modificationTime = hostStatus.st_mtime;
+        return true;
+    }
+
+    int FileTable::get(std::uint32_t handle) const
+    {
+        if (handle == 0 || handle > fds.size() || fds[handle - 1] == -1)
+        {
+            throw std::runtime_error("Invalid file handle");
+        }
+
+        return fds[handle - 1];
+    }
+
+    std::uint32_t FileTable::getOpenCount() const
+    {
+        return static_cast<std::uint32_t>(fds.size() - std::count(fds.begin(), fds.end(), -1));
+    }
+
+    void FileTable::save(FileTable& copy) const
+    {
+        for (int fd : fds)
+        {
+            int duplicate = fd == -1 ? -1 : duplicateFd(fd);
+            if (fd != -1 && duplicate == -1)
+            {
+                throw std::runtime_error("Failed to duplicate file handle");
+            }
+
+            copy.fds.push_back(duplicate);
+            copy.offsets.push_back(fd == -1 ? -1 : seekFd(fd, 0, SEEK_CUR));
+        }
+    }
+
+    void FileTable::restore(const FileTable& copy)
+    {
+        closeAll();
+        fds.clear();
+
+        for (std::size_t i = 0; i < copy.fds.size(); i++)
+        {
+            int fd = copy.fds[i] == -1 ? -1 : duplicateFd(copy.fds[i]);
+            if (fd != -1 && copy.offsets[i] != -1)
+            {
+                seekFd(fd, copy.offsets[i], SEEK_SET);
+            }
+            fds.push_back(fd);
+        }
+    }
+
+    void FileTable::closeAll()
+    {
+        for (int fd : fds)
+        {
+            if (fd != -1)
+            {
+                closeFd(fd);
+            }
+        }
+    }
+}
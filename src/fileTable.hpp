@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace kasm
+{
+	// Host file descriptors opened by the guest. Handles are indices into the table offset by one, so 0 is never a
+	// valid handle, and the lowest free handle is reused first. Operations on a handle that is not open throw, the
+	// data transfers return -1 on failure like the system calls underneath.
+	class FileTable
+	{
+	public:
+		FileTable() {}
+		~FileTable();
+
+		FileTable(const FileTable&) = delete;
+		FileTable& operator=(const FileTable&) = delete;
+
+		enum class Whence
+		{
+			BEGIN,
+			END,
+			CURRENT
+		};
+
+		struct Status
+		{
+			std::int64_t size;
+			bool directory;
+			std::int64_t modificationTime;
+		};
+
+		// Returns 0 if the file could not be opened
+		std::uint32_t open(const char* path, bool read, bool write);
+		void close(std::uint32_t handle);
+
+		std::int64_t read(std::uint32_t handle, void* buffer, std::size_t size);
+		std::int64_t write(std::uint32_t handle, const void* buffer, std::size_t size);
+		std::int64_t pread(std::uint32_t handle, void* buffer, std::size_t size, std::int64_t offset);
+		std::int64_t pwrite(std::uint32_t handle, const void* buffer, std::size_t size, std::int64_t offset);
+		std::int64_t seek(std::uint32_t handle, std::int64_t offset, Whence whence);
+		std::int64_t size(std::uint32_t handle);
+
+		static bool stat(const char* path, Status& status);
+
+		// Host descriptor of an open handle
+		int get(std::uint32_t handle) const;
+		std::uint32_t getOpenCount() const;
+
+		// Fills copy, which must be empty, with duplicates of the open descriptors and remembers their offsets
+		void save(FileTable& copy) const;
+		// Replaces every open file with a duplicate of the saved one, seeked back to the saved offset. Like the files
+		// of a forked process the duplicates share their offset with the saved descriptors.
+		void restore(const FileTable& copy);
+
+	private:
+		void closeAll();
+
+		std::vector<int> fds; // -1 marks a free slot
+		std::vector<std::int64_t> offsets; // saved offsets, -1 if not seekable, only kept by saved copies
+	};
+}
@@ -0,0 +1,195 @@
+#include "guestHeap.hpp"
+
+#include <algorithm>
+
+namespace kasm
+{
+    namespace
+    {
+        std::uint64_t roundUp(std::uint64_t value, std::uint64_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    GuestHeap& GuestHeap::operator=(const GuestHeap& other)
+    {
+        begin = other.begin;
+        limit = other.limit;
+        brk = other.brk;
+        committedEnd = other.committedEnd;
+        allocatedSize = other.allocatedSize;
+        std::copy(std::begin(other.smallFree), std::end(other.smallFree), std::begin(smallFree));
+        largeFree = other.largeFree;
+        largeFreeBySize = other.largeFreeBySize;
+        liveBlocks = other.liveBlocks;
+        return *this;
+    }
+
+    void GuestHeap::reset(std::uint32_t aBegin, std::uint32_t aLimit)
+    {
+        if (committedEnd > begin)
+        {
+            memory.decommit(begin, committedEnd - begin);
+        }
+
+        // Start on a fresh page so decommitting the heap never touches the data segment
+        begin = static_cast<std::uint32_t>(std::min<std::uint64_t>(roundUp(aBegin, GuestMemory::getPageSize()), aLimit));
+        limit = aLimit;
+        brk = begin;
+        committedEnd = begin;
+
+        for (auto& freeList : smallFree)
+        {
+            freeList.clear();
+        }
+        largeFree.clear();
+        largeFreeBySize.clear();
+        liveBlocks.clear();
+        allocatedSize = 0;
+    }
+
+    std::uint32_t GuestHeap::allocate(std::uint32_t size)
+    {
+        std::uint64_t roundedSize = roundUp(size ? size : 1, ALIGNMENT);
+        if (roundedSize > limit - begin)
+        {
+            return 0;
+        }
+
+        std::uint32_t blockSize = static_cast<std::uint32_t>(roundedSize);
+        std::uint32_t address;
+        if (blockSize <= MAX_SMALL_SIZE)
+        {
+            std::vector<std::uint32_t>& freeList = smallFree[blockSize / ALIGNMENT - 1];
+            if (!freeList.empty())
+            {
+                address = freeList.back();
+                freeList.pop_back();
+            }
+            else
+            {
+                address = grow(blockSize);
+            }
+        }
+        else
+        {
+            address = allocateLarge(blockSize);
+        }
+
+        if (address)
+        {
+            liveBlocks[address] = blockSize;
+            allocatedSize += blockSize;
+        }
+
+        return address;
+    }
+
+    bool GuestHeap::deallocate(std::uint32_t address)
+    {
+        auto it = liveBlocks.find(address);
+        if (it == liveBlocks.end())
+        {
+            return false;
+        }
+
+        std::uint32_t blockSize = it->second;
+        liveBlocks.erase(it);
+        allocatedSize -= blockSize;
+
+        if (blockSize <= MAX_SMALL_SIZE)
+        {
+            smallFree[blockSize / ALIGNMENT - 1].push_back(address);
+        }
+        else
+        {
+            deallocateLarge(address, blockSize);
+        }
+
+        return true;
+    }
+
+    std::uint32_t GuestHeap::allocateLarge(std::uint32_t size)
+    {
+        auto fit = largeFreeBySize.lower_bound({ size, 0 });
+        if (fit == largeFreeBySize.end())
+        {
+            return grow(size);
+        }
+
+        std::uint32_t freeSize = fit->first;
+        std::uint32_t address = fit->second;
+        eraseFree(largeFree.find(address));
+        if (freeSize > size)
+        {
+            insertFree(address + size, freeSize - size);
+        }
+
+        return address;
+    }
+
+    void GuestHeap::deallocateLarge(std::uint32_t address, std::uint32_t size)
+    {
+        // Coalesce with the free neighbours on both sides
+        auto next = largeFree.find(address + size);
+        if (next != largeFree.end())
+        {
+            size += next->second;
+            eraseFree(next);
+        }
+
+        auto previous = largeFree.lower_bound(address);
+        if (previous != largeFree.begin())
+        {
+            previous--;
+            if (previous->first + previous->second == address)
+            {
+                address = previous->first;
+                size += previous->second;
+                eraseFree(previous);
+            }
+        }
+
+        // A block ending at the break is handed back to it, the pages stay committed for the next growth
+        if (address + size == brk)
+        {
+            brk = address;
+            return;
+        }
+
+        insertFree(address, size);
+    }
+
+    std::uint32_t GuestHeap::grow(std::uint32_t size)
+    {
+        if (size > limit - brk)
+        {
+            return 0;
+        }
+
+        std::uint32_t address = brk;
+        brk += size;
+
+        if (brk > committedEnd)
+        {
+            std::uint32_t newCommittedEnd = static_cast<std::uint32_t>(std::min<std::uint64_t>(roundUp(brk, GROWTH_SIZE), limit));
+            memory.commit(committedEnd, newCommittedEnd - committedEnd);
+            committedEnd = newCommittedEnd;
+        }
+
+        return address;
+    }
+
+    void GuestHeap::insertFree(std::uint32_t address, std::uint32_t size)
+    {
+        largeFree[address] = size;
+        largeFreeBySize.insert({ size, address });
+    }
+
+    void GuestHeap::eraseFree(std::map<std::uint32_t, std::uint32_t>::iterator it)
+    {
+        largeFreeBySize.erase({ it->second, it->first });
+        largeFree.erase(it);
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "guestMemory.hpp"
+
+namespace kasm
+{
+	// Heap living in the guest address space between the end of the data segment and the stack. Small blocks come
+	// from per size class free lists, larger ones from a best fit, coalescing free map. Both carve fresh space off the
+	// break, which commits guest pages as it grows. Bookkeeping is kept on the host so the guest cannot corrupt it.
+	class GuestHeap
+	{
+	public:
+		GuestHeap(GuestMemory& aMemory) : memory(aMemory) {}
+
+		// Copies keep committing into the memory of the original, assignment only takes over the bookkeeping. Saving
+		// a heap as a copy and assigning it back later restores it, given its pages are restored along with it.
+		GuestHeap(const GuestHeap&) = default;
+		GuestHeap& operator=(const GuestHeap& other);
+
+		// Drops every allocation and decommits the heap, the next allocation starts at begin
+		void reset(std::uint32_t aBegin, std::uint32_t aLimit);
+
+		// Returns 0 when the heap is exhausted
+		std::uint32_t allocate(std::uint32_t size);
+		// Returns false if address is not a live allocation
+		bool deallocate(std::uint32_t address);
+
+		// Lets other users of the address space claim everything from limit upwards, which must not be below
+		// getCommittedEnd()
+		void setLimit(std::uint32_t aLimit) { limit = aLimit; }
+		std::uint32_t getCommittedEnd() const { return committedEnd; }
+		// Bytes in live allocations, rounded up to the alignment
+		std::uint64_t getAllocatedSize() const { return allocatedSize; }
+
+		static const std::uint32_t ALIGNMENT = 8;
+		static const std::uint32_t MAX_SMALL_SIZE = 512;
+		static const std::uint32_t SIZE_CLASS_COUNT = MAX_SMALL_SIZE / ALIGNMENT;
+		static const std::uint32_t GROWTH_SIZE = 0x10000;
+
+	private:
+		std::uint32_t allocateLarge(std::uint32_t size);
+		void deallocateLarge(std::uint32_t address, std::uint32_t size);
+		std::uint32_t grow(std::uint32_t size);
+		void insertFree(std::uint32_t address, std::uint32_t size);
+		void eraseFree(std::map<std::uint32_t, std::uint32_t>::iterator it);
+
+		GuestMemory& memory;
+		std::uint32_t begin = 0;
+		std::uint32_t limit = 0;
+		std::uint32_t brk = 0; // end of the space handed out so far
+		std::uint32_t committedEnd = 0;
+		std::uint64_t allocatedSize = 0;
+
+		std::vector<std::uint32_t> smallFree[SIZE_CLASS_COUNT];
+		std::map<std::uint32_t, std::uint32_t> largeFree; // address -> size
+		std::set<std::pair<std::uint32_t, std::uint32_t>> largeFreeBySize; // (size, address)
+		std::unordered_map<std::uint32_t, std::uint32_t> liveBlocks; // address -> rounded size
+	};
+}
@@ -0,0 +1,539 @@
+#include "guestMemory.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <csignal>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace kasm
+{
+#if KASM_GUEST_FAULTS
+    namespace
+    {
+        thread_local GuestMemory* faultMemory = nullptr;
+        thread_local sigjmp_buf* faultJump = nullptr;
+        thread_local std::uint32_t faultAddress = 0;
+
+        struct sigaction previousSegvAction;
+        struct sigaction previousBusAction;
+
+        void faultHandler(int signal, siginfo_t* info, void*)
+        {
+            if (faultMemory != nullptr)
+            {
+                std::uint8_t* address = static_cast<std::uint8_t*>(info->si_addr);
+                if (address >= faultMemory->base() && address < faultMemory->base() + GuestMemory::RESERVATION_SIZE)
+                {
+                    // Retries the write now that the page is writable
+                    if (faultMemory->trackWrite(address - faultMemory->base()))
+                    {
+                        return;
+                    }
+
+                    if (faultJump != nullptr)
+                    {
+                        faultAddress = static_cast<std::uint32_t>(address - faultMemory->base());
+                        siglongjmp(*faultJump, 1);
+                    }
+                }
+            }
+
+            // Not a guest access, let the previous disposition handle the fault when the instruction is retried
+            sigaction(signal, signal == SIGSEGV ? &previousSegvAction : &previousBusAction, nullptr);
+        }
+
+        void installFaultHandler()
+        {
+            static const bool installed = []()
+            {
+                struct sigaction action = {};
+                action.sa_sigaction = faultHandler;
+                action.sa_flags = SA_SIGINFO | SA_NODEFER;
+                sigemptyset(&action.sa_mask);
+                sigaction(SIGSEGV, &action, &previousSegvAction);
+                sigaction(SIGBUS, &action, &previousBusAction);
+                return true;
+            }();
+            (void)installed;
+        }
+    }
+
+    GuestMemory::FaultScope::FaultScope(GuestMemory& memory, sigjmp_buf& jump)
+        : previousMemory(faultMemory), previousJump(faultJump)
+    {
+        installFaultHandler();
+        faultMemory = &memory;
+        faultJump = &jump;
+    }
+
+    GuestMemory::FaultScope::~FaultScope()
+    {
+        faultMemory = previousMemory;
+        faultJump = previousJump;
+    }
+
+    std::uint32_t GuestMemory::FaultScope::getFaultAddress()
+    {
+        return faultAddress;
+    }
+
+    bool GuestMemory::trackWrite(std::uint64_t offset)
+    {
+        std::uint64_t page = offset / getPageSize();
+        if (page >= pageStates.size() || pageStates[page] != PAGE_TRACKED)
+        {
+            return false;
+        }
+
+        if (mprotect(memory + page * getPageSize(), getPageSize(), PROT_READ | PROT_WRITE))
+        {
+            return false;
+        }
+
+        pageStates[page] |= PAGE_DIRTY;
+        dirtyPages.push_back(static_cast<std::uint32_t>(page));
+        return true;
+    }
+#endif
+
+    GuestMemory::GuestMemory()
+    {
+#if defined(_WIN32)
+        memory = static_cast<std::uint8_t*>(VirtualAlloc(nullptr, RESERVATION_SIZE, MEM_RESERVE, PAGE_NOACCESS));
+        if (memory == nullptr)
+#else
+        void* reservation = mmap(nullptr, RESERVATION_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        memory = static_cast<std::uint8_t*>(reservation);
+        if (reservation == MAP_FAILED)
+#endif
+        {
+            throw std::runtime_error("Failed to reserve guest address space");
+        }
+    }
+
+    GuestMemory::~GuestMemory()
+    {
+#if defined(_WIN32)
+        VirtualFree(memory, 0, MEM_RELEASE);
+#else
+        munmap(memory, RESERVATION_SIZE);
+#endif
+    }
+
+    void GuestMemory::commit(std::uint32_t address, std::uint32_t size)
+    {
+        if (size == 0)
+        {
+            return;
+        }
+
+        std::uint64_t pageSize = getPageSize();
+        std::uint64_t start = address / pageSize * pageSize;
+        std::uint64_t end = (std::uint64_t(address) + size + pageSize - 1) / pageSize * pageSize;
+
+#if defined(_WIN32)
+        if (VirtualAlloc(memory + start, end - start, MEM_COMMIT, PAGE_READWRITE) == nullptr)
+#else
+        if (mprotect(memory + start, end - start, PROT_READ | PROT_WRITE))
+#endif
+        {
+            throw std::runtime_error("Failed to commit guest memory");
+        }
+
+        markDirty(start, end);
+        eraseRange(readOnlyRegions, start, end);
+        insertRange(regions, start, end);
+    }
+
+    bool GuestMemory::mapFile(std::uint32_t address, std::uint32_t size, int fd, std::uint64_t offset, bool copyOnWrite)
+    {
+        std::uint64_t pageSize = getPageSize();
+        if (size == 0 || address % pageSize || offset % pageSize)
+        {
+            return false;
+        }
+
+#if defined(_WIN32)
+        // Views can not be placed inside an existing reservation without placeholder support
+        return false;
+#else
+        std::uint64_t end = (std::uint64_t(address) + size + pageSize - 1) / pageSize * pageSize;
+        int protection = copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+        if (mmap(memory + address, end - address, protection, MAP_PRIVATE | MAP_FIXED, fd, static_cast<off_t>(offset)) == MAP_FAILED)
+        {
+            // The reservation may have been replaced already, put inaccessible pages back in either case
+            mmap(memory + address, end - address, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
+            return false;
+        }
+
+        markDirty(address, end);
+        eraseRange(readOnlyRegions, address, end);
+        if (!copyOnWrite)
+        {
+            insertRange(readOnlyRegions, address, end);
+        }
+        insertRange(regions, address, end);
+        return true;
+#endif
+    }
+
+    void GuestMemory::insertRange(RegionMap& map, std::uint64_t start, std::uint64_t end)
+    {
+        // Merge with every overlapping or adjacent range
+        auto it = map.upper_bound(start);
+        if (it != map.begin() && std::prev(it)->second >= start)
+        {
+            it--;
+        }
+        while (it != map.end() && it->first <= end)
+        {
+            start = std::min(start, it->first);
+            end = std::max(end, it->second);
+            it = map.erase(it);
+        }
+        map[start] = end;
+    }
+
+    void GuestMemory::eraseRange(RegionMap& map, std::uint64_t start, std::uint64_t end)
+    {
+        auto it = map.upper_bound(start);
+        if (it != map.begin() && std::prev(it)->second > start)
+        {
+            it--;
+        }
+        while (it != map.end() && it->first < end)
+        {
+            std::uint64_t rangeStart = it->first;
+            std::uint64_t rangeEnd = it->second;
+            it = map.erase(it);
+            if (rangeStart < start)
+            {
+                map[rangeStart] = start;
+            }
+            if (rangeEnd > end)
+            {
+                map[end] = rangeEnd;
+            }
+        }
+    }
+
+    void GuestMemory::decommit(std::uint32_t address, std::uint32_t size)
+    {
+        if (size == 0)
+        {
+            return;
+        }
+
+        std::uint64_t pageSize = getPageSize();
+        std::uint64_t start = address / pageSize * pageSize;
+        std::uint64_t end = (std::uint64_t(address) + size + pageSize - 1) / pageSize * pageSize;
+
+#if defined(_WIN32)
+        VirtualFree(memory + start, end - start, MEM_DECOMMIT);
+#else
+        // Mapping fresh inaccessible pages over the range also hands the old ones back to the system
+        mmap(memory + start, end - start, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
+#endif
+
+        markDirty(start, end);
+        eraseRange(readOnlyRegions, start, end);
+        eraseRange(regions, start, end);
+    }
+
+    void GuestMemory::reset()
+    {
+        stopTracking();
+
+        while (!regions.empty())
+        {
+            auto region = *regions.begin();
+            decommit(static_cast<std::uint32_t>(region.first), static_cast<std::uint32_t>(region.second - region.first));
+        }
+    }
+
+    bool GuestMemory::isCommitted(std::uint32_t address, std::uint32_t size) const
+    {
+        return getCommittedLength(address) >= size;
+    }
+
+    bool GuestMemory::isWritable(std::uint32_t address, std::uint32_t size) const
+    {
+        if (!isCommitted(address, size))
+        {
+            return false;
+        }
+        if (size == 0)
+        {
+            return true;
+        }
+
+        // Only the last read only region starting at or below address and the first one above it can overlap
+        auto it = readOnlyRegions.upper_bound(address);
+        if (it != readOnlyRegions.begin() && std::prev(it)->second > address)
+        {
+            return false;
+        }
+        return it == readOnlyRegions.end() || it->first >= std::uint64_t(address) + size;
+    }
+
+    std::uint64_t GuestMemory::getCommittedLength(std::uint32_t address) const
+    {
+        auto it = regions.upper_bound(address);
+        if (it == regions.begin())
+        {
+            return 0;
+        }
+        it--;
+
+        // Adjacent regions are always merged, so the one containing address ends the accessible range
+        return it->second > address ? it->second - address : 0;
+    }
+
+    std::uint32_t GuestMemory::getPageSize()
+    {
+#if defined(_WIN32)
+        SYSTEM_INFO systemInfo;
+        GetSystemInfo(&systemInfo);
+        return systemInfo.dwPageSize;
+#else
+        static const std::uint32_t pageSize = static_cast<std::uint32_t>(sysconf(_SC_PAGESIZE));
+        return pageSize;
+#endif
+    }
+
+    std::shared_ptr<const GuestMemory::Snapshot> GuestMemory::snapshot()
+    {
+        stopTracking();
+
+        trackedSnapshot = std::make_shared<const Snapshot>(*this);
+        startTracking();
+
+        return trackedSnapshot;
+    }
+
+    void GuestMemory::restore(const std::shared_ptr<const Snapshot>& aSnapshot)
+    {
+        if (aSnapshot != trackedSnapshot)
+        {
+            reset();
+
+            for (const auto& region : aSnapshot->regions)
+            {
+                commit(static_cast<std::uint32_t>(region.first), static_cast<std::uint32_t>(region.second - region.first));
+                std::memcpy(memory + region.first, aSnapshot->getPage(region.first), region.second - region.first);
+            }
+            readOnlyRegions = aSnapshot->readOnlyRegions;
+
+            trackedSnapshot = aSnapshot;
+            startTracking();
+            return;
+        }
+
+        // Drop whatever was committed since, then bring back whatever was released since. Both leave the pages of
+        // the snapshot that changed marked dirty.
+        RegionMap added = regions;
+        for (const auto& region : aSnapshot->regions)
+        {
+            eraseRange(added, region.first, region.second);
+        }
+        for (const auto& region : added)
+        {
+            decommit(static_cast<std::uint32_t>(region.first), static_cast<std::uint32_t>(region.second - region.first));
+        }
+
+        RegionMap removed = aSnapshot->regions;
+        for (const auto& region : regions)
+        {
+            eraseRange(removed, region.first, region.second);
+        }
+        for (const auto& region : removed)
+        {
+            commit(static_cast<std::uint32_t>(region.first), static_cast<std::uint32_t>(region.second - region.first));
+        }
+
+        readOnlyRegions = aSnapshot->readOnlyRegions;
+
+        // Copy back runs of consecutive dirty pages and protect each run with a single call
+        std::uint64_t pageSize = getPageSize();
+        std::sort(dirtyPages.begin(), dirtyPages.end());
+        for (std::size_t i = 0; i < dirtyPages.size();)
+        {
+            std::size_t j = i + 1;
+            while (j < dirtyPages.size() && dirtyPages[j] == dirtyPages[j - 1] + 1)
+            {
+                j++;
+            }
+
+            std::uint64_t start = std::uint64_t(dirtyPages[i]) * pageSize;
+            std::uint64_t end = std::uint64_t(dirtyPages[j - 1] + 1) * pageSize;
+            // Regions are contiguous in the copy as well, but a run may span two of them
+            for (std::uint64_t page = start; page < end; page += pageSize)
+            {
+                std::memcpy(memory + page, aSnapshot->getPage(page), pageSize);
+            }
+
+#if KASM_GUEST_FAULTS
+            protect(start, end, false);
+            for (std::size_t k = i; k < j; k++)
+            {
+                pageStates[dirtyPages[k]] &= ~PAGE_DIRTY;
+            }
+#endif
+            i = j;
+        }
+
+#if KASM_GUEST_FAULTS
+        dirtyPages.clear();
+#endif
+    }
+
+    void GuestMemory::prepareWrite(std::uint32_t address, std::uint32_t size)
+    {
+#if KASM_GUEST_FAULTS
+        if (!trackedSnapshot || size == 0)
+        {
+            return;
+        }
+
+        std::uint64_t pageSize = getPageSize();
+        for (std::uint64_t page = address / pageSize; page <= (std::uint64_t(address) + size - 1) / pageSize; page++)
+        {
+            trackWrite(page * pageSize);
+        }
+#else
+        (void)address;
+        (void)size;
+#endif
+    }
+
+    void GuestMemory::startTracking()
+    {
+        std::uint64_t pageSize = getPageSize();
+        pageStates.assign(RESERVATION_SIZE / pageSize, 0);
+        dirtyPages.clear();
+
+        std::size_t trackedPages = 0;
+        for (const auto& region : regions)
+        {
+            for (std::uint64_t page = region.first / pageSize; page < region.second / pageSize; page++)
+            {
+                pageStates[page] = PAGE_TRACKED;
+            }
+            trackedPages += (region.second - region.first) / pageSize;
+        }
+        for (const auto& region : readOnlyRegions)
+        {
+            for (std::uint64_t page = region.first / pageSize; page < region.second / pageSize; page++)
+            {
+                pageStates[page] |= PAGE_READ_ONLY;
+            }
+        }
+        dirtyPages.reserve(trackedPages);
+
+#if KASM_GUEST_FAULTS
+        for (const auto& region : regions)
+        {
+            protect(region.first, region.second, false);
+        }
+#else
+        // Without fault handling writes can not be tracked, every page is copied back on restore instead
+        for (const auto& region : regions)
+        {
+            for (std::uint64_t page = region.first / pageSize; page < region.second / pageSize; page++)
+            {
+                pageStates[page] |= PAGE_DIRTY;
+                dirtyPages.push_back(static_cast<std::uint32_t>(page));
+            }
+        }
+#endif
+    }
+
+    void GuestMemory::stopTracking()
+    {
+        if (!trackedSnapshot)
+        {
+            return;
+        }
+
+        // Tracked pages that were never written are still write protected
+        std::uint64_t pageSize = getPageSize();
+        for (const auto& region : regions)
+        {
+            for (std::uint64_t page = region.first / pageSize; page < region.second / pageSize; page++)
+            {
+                if (pageStates[page] == PAGE_TRACKED)
+                {
+                    protect(page * pageSize, (page + 1) * pageSize, true);
+                }
+            }
+        }
+
+        trackedSnapshot = nullptr;
+        pageStates.clear();
+        pageStates.shrink_to_fit();
+        dirtyPages.clear();
+    }
+
+    void GuestMemory::markDirty(std::uint64_t start, std::uint64_t end)
+    {
+        if (!trackedSnapshot)
+        {
+            return;
+        }
+
+        std::uint64_t pageSize = getPageSize();
+        for (std::uint64_t page = start / pageSize; page < end / pageSize; page++)
+        {
+            if ((pageStates[page] & (PAGE_TRACKED | PAGE_DIRTY)) == PAGE_TRACKED)
+            {
+                pageStates[page] |= PAGE_DIRTY;
+                dirtyPages.push_back(static_cast<std::uint32_t>(page));
+            }
+        }
+    }
+
+    void GuestMemory::protect(std::uint64_t start, std::uint64_t end, bool writable)
+    {
+        if (start == end)
+        {
+            return;
+        }
+
+#if defined(_WIN32)
+        DWORD previous;
+        VirtualProtect(memory + start, end - start, writable ? PAGE_READWRITE : PAGE_READONLY, &previous);
+#else
+        mprotect(memory + start, end - start, writable ? PROT_READ | PROT_WRITE : PROT_READ);
+#endif
+    }
+
+    GuestMemory::Snapshot::Snapshot(const GuestMemory& memory)
+        : regions(memory.regions), readOnlyRegions(memory.readOnlyRegions)
+    {
+        std::size_t size = 0;
+        for (const auto& region : regions)
+        {
+            offsets[region.first] = size;
+            size += region.second - region.first;
+        }
+
+        contents.resize(size);
+        for (const auto& region : regions)
+        {
+            std::memcpy(contents.data() + offsets[region.first], memory.base() + region.first, region.second - region.first);
+        }
+    }
+
+    const std::uint8_t* GuestMemory::Snapshot::getPage(std::uint64_t address) const
+    {
+        auto it = std::prev(offsets.upper_bound(address));
+        return contents.data() + it->second + (address - it->first);
+    }
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#if defined(_WIN32)
+#define KASM_GUEST_FAULTS 0
+#else
+#define KASM_GUEST_FAULTS 1
+#include <csetjmp>
+#endif
+
+namespace kasm
+{
+	// The whole 32 bit guest address space reserved as one host mapping, so translating a guest address is just
+	// base + address. Only committed regions are accessible, touching anything else faults and the fault is turned
+	// into a jump back to the innermost FaultScope on the faulting thread.
+	class GuestMemory
+	{
+	public:
+		GuestMemory();
+		~GuestMemory();
+
+		GuestMemory(const GuestMemory&) = delete;
+		GuestMemory& operator=(const GuestMemory&) = delete;
+
+		std::uint8_t* base() const { return memory; }
+
+		void commit(std::uint32_t address, std::uint32_t size);
+		void decommit(std::uint32_t address, std::uint32_t size);
+		void reset();
+
+		// Maps size bytes of the file open as fd, starting at the page aligned offset, over the guest pages at address.
+		// Writes fault unless the mapping is private, in which case they stay private to this address space. Returns
+		// false if the platform or the file does not allow it. Released with decommit like any other region.
+		bool mapFile(std::uint32_t address, std::uint32_t size, int fd, std::uint64_t offset, bool copyOnWrite);
+
+		bool isCommitted(std::uint32_t address, std::uint32_t size) const;
+		// Committed and outside every read only file mapping, so the host can write to the range without faulting
+		bool isWritable(std::uint32_t address, std::uint32_t size) const;
+		// Number of accessible bytes starting at address
+		std::uint64_t getCommittedLength(std::uint32_t address) const;
+
+		static std::uint32_t getPageSize();
+
+		class Snapshot;
+
+		// Copies every committed page and starts tracking writes against the copy, so a later restore of the same
+		// snapshot only has to copy back the pages written since. Writes are tracked by write protecting the pages
+		// and unprotecting each one at its first write fault.
+		std::shared_ptr<const Snapshot> snapshot();
+		// Puts the committed regions and their contents back as they were in a snapshot of any GuestMemory. Restoring
+		// the snapshot that is being tracked against only copies the dirty pages, any other one copies everything.
+		void restore(const std::shared_ptr<const Snapshot>& aSnapshot);
+		// Gives write access to the tracked pages of a range up front, for writes that do not fault such as those of
+		// system calls, which fail on write protected pages instead
+		void prepareWrite(std::uint32_t address, std::uint32_t size);
+		// Drops the write tracking, the next restore copies everything again. Needed before the memory is written
+		// from several threads, which the tracking does not support.
+		void stopTracking();
+
+		// 4 GiB plus a guard page for word accesses straddling the top of the address space
+		static const std::uint64_t RESERVATION_SIZE = (std::uint64_t(1) << 32) + 0x10000;
+
+#if KASM_GUEST_FAULTS
+		class FaultScope
+		{
+		public:
+			FaultScope(GuestMemory& memory, sigjmp_buf& jump);
+			~FaultScope();
+
+			static std::uint32_t getFaultAddress();
+		private:
+			GuestMemory* previousMemory;
+			sigjmp_buf* previousJump;
+		};
+
+		// Called from the fault handler, returns true if the fault was the first write to a tracked page
+		bool trackWrite(std::uint64_t offset);
+#endif
+
+	private:
+		typedef std::map<std::uint64_t, std::uint64_t> RegionMap; // page ranges, start -> end
+
+		static void insertRange(RegionMap& map, std::uint64_t start, std::uint64_t end);
+		static void eraseRange(RegionMap& map, std::uint64_t start, std::uint64_t end);
+		void startTracking();
+		// Pages of a tracked range whose contents no longer match the snapshot
+		void markDirty(std::uint64_t start, std::uint64_t end);
+		// Only ever makes pages writable that are not part of a read only region
+		void protect(std::uint64_t start, std::uint64_t end, bool writable);
+
+		enum PageState : std::uint8_t
+		{
+			PAGE_TRACKED = 1,
+			PAGE_DIRTY = 2,
+			PAGE_READ_ONLY = 4
+		};
+
+		std::uint8_t* memory;
+		RegionMap regions; // committed
+		RegionMap readOnlyRegions; // committed without write access
+
+		std::shared_ptr<const Snapshot> trackedSnapshot;
+		std::vector<std::uint8_t> pageStates; // indexed by page number, only sized while tracking
+		std::vector<std::uint32_t> dirtyPages; // reserved up front, the fault handler must not allocate
+	};
+
+	// Contents of the committed pages at one point, immutable and shareable between any number of GuestMemory
+	class GuestMemory::Snapshot
+	{
+	public:
+		Snapshot(const GuestMemory& memory);
+
+		// Host copy of the page at a guest address, which must lie in one of the regions
+		const std::uint8_t* getPage(std::uint64_t address) const;
+
+	private:
+		RegionMap regions;
+		RegionMap readOnlyRegions;
+		std::map<std::uint64_t, std::size_t> offsets; // region start -> offset of its contents
+		std::vector<std::uint8_t> contents;
+
+		friend class GuestMemory;
+	};
+}
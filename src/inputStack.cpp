@@ -0,0 +1,90 @@
+#include "inputStack.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace kasm
+{
+	void InputStack::setCallback(void(*aEndCallback)(unsigned))
+	{
+		endCallback = aEndCallback;
+	}
+
+	void InputStack::open(const std::string& fileName)
+	{
+		files.clear();
+		views.clear();
+		cursor = nullptr;
+		limit = nullptr;
+		include(fileName);
+	}
+
+	unsigned InputStack::include(const std::string& fileName, bool setUid)
+	{
+		auto it = files.find(fileName);
+		if (it == files.end())
+		{
+			std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+			if (!file)
+			{
+				throw std::runtime_error("Failed to open " + fileName);
+			}
+
+			std::string text(static_cast<std::size_t>(file.tellg()), '\0');
+			file.seekg(0, std::ios::beg);
+			file.read(text.data(), text.size());
+			it = files.emplace(fileName, std::move(text)).first;
+		}
+
+		identifier = fileName;
+		return push(it->second.data(), it->second.size(), nullptr, setUid);
+	}
+
+	unsigned InputStack::pushString(const std::string& str, bool setUid)
+	{
+		return pushString(std::make_shared<const std::string>(str), setUid);
+	}
+
+	unsigned InputStack::pushString(std::shared_ptr<const std::string> str, bool setUid)
+	{
+		const char* begin = str->data();
+		std::size_t size = str->size();
+		return push(begin, size, std::move(str), setUid);
+	}
+
+	std::string& InputStack::getIdentifier()
+	{
+		return identifier;
+	}
+
+	bool InputStack::pop()
+	{
+		while (!views.empty() && cursor >= limit)
+		{
+			unsigned poppedUid = views.back().uid;
+			views.pop_back();
+			cursor = views.empty() ? nullptr : views.back().cursor;
+			limit = views.empty() ? nullptr : views.back().limit;
+
+			if (endCallback != nullptr && poppedUid != 0)
+			{
+				endCallback(poppedUid);
+			}
+		}
+		return cursor < limit;
+	}
+
+	unsigned InputStack::push(const char* begin, std::size_t size, std::shared_ptr<const std::string> text, bool setUid)
+	{
+		if (!views.empty())
+		{
+			views.back().cursor = cursor;
+		}
+
+		unsigned newUid = setUid ? ++uid : 0;
+		views.push_back({ begin, begin + size, newUid, std::move(text) });
+		cursor = begin;
+		limit = begin + size;
+		return newUid;
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace kasm
+{
+	// Input of the re2c lexers. Every file is read once into a buffer of its own, and includes and macro expansions
+	// push a view of their text over the one being read, which resumes where it stopped once they are popped. The
+	// lexers scan from cursor to limit directly, limit pointing at the NUL that ends every buffer, so a token never
+	// runs past the end of a view.
+	class InputStack
+	{
+	public:
+		// Called with the uid of a view once it is popped
+		void setCallback(void(*aEndCallback)(unsigned));
+
+		void open(const std::string& fileName);
+		unsigned include(const std::string& fileName, bool setUid = false);
+		unsigned pushString(const std::string& str, bool setUid = false);
+		// Shares the string instead of copying it
+		unsigned pushString(std::shared_ptr<const std::string> str, bool setUid = false);
+
+		// Pops the views read to their end, the lexers call it before every token. False once all input is read.
+		bool next()
+		{
+			return cursor < limit || pop();
+		}
+
+		std::string& getIdentifier();
+		// Number of views, the one being read is the deepest
+		std::size_t getDepth() const { return views.size(); }
+
+		const char* cursor = nullptr;
+		const char* limit = nullptr;
+
+	private:
+		struct View
+		{
+			const char* cursor;
+			const char* limit;
+			unsigned uid;
+			std::shared_ptr<const std::string> text; // of pushed strings, files stay in files
+		};
+
+		bool pop();
+		unsigned push(const char* begin, std::size_t size, std::shared_ptr<const std::string> text, bool setUid);
+
+		std::string identifier;
+		unsigned uid = 0;
+		void(*endCallback)(unsigned) = nullptr;
+
+		std::unordered_map<std::string, std::string> files;
+		std::vector<View> views;
+	};
+}
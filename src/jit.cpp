@@ -0,0 +1,615 @@
+#include "jit.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "virtualMachine.hpp"
+
+#if KASM_JIT
+#include <sys/mman.h>
+#endif
+
+namespace kasm
+{
+#if KASM_JIT
+    namespace
+    {
+        enum HostRegister : std::uint8_t
+        {
+            EAX = 0,
+            ECX = 1,
+            EDX = 2,
+            EBX = 3,
+            ESI = 6,
+            EDI = 7
+        };
+
+        enum Condition : std::uint8_t
+        {
+            CONDITION_AE = 0x3,
+            CONDITION_E = 0x4,
+            CONDITION_NE = 0x5,
+            CONDITION_L = 0xC,
+            CONDITION_GE = 0xD,
+            CONDITION_LE = 0xE,
+            CONDITION_G = 0xF
+        };
+
+        const std::uint8_t CONTEXT_REGISTERS = offsetof(Jit::Context, registers);
+        const std::uint8_t CONTEXT_HI = offsetof(Jit::Context, hi);
+        const std::uint8_t CONTEXT_LO = offsetof(Jit::Context, lo);
+        const std::uint8_t CONTEXT_VIRTUAL_MACHINE = offsetof(Jit::Context, virtualMachine);
+        const std::uint8_t CONTEXT_MEMORY = offsetof(Jit::Context, memory);
+        const std::uint8_t CONTEXT_PC = offsetof(Jit::Context, pc);
+        const std::uint8_t CONTEXT_REMAINING_INSTRUCTIONS = offsetof(Jit::Context, remainingInstructions);
+
+        std::uint8_t registerDisplacement(std::uint32_t guestRegister)
+        {
+            return static_cast<std::uint8_t>(guestRegister * sizeof(std::uint32_t));
+        }
+    }
+
+    Jit::Jit(VirtualMachine& aVirtualMachine)
+        : virtualMachine(aVirtualMachine)
+    {
+        void* buffer = mmap(nullptr, CODE_BUFFER_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (buffer == MAP_FAILED)
+        {
+            throw std::runtime_error("Failed to allocate JIT code buffer");
+        }
+        code = static_cast<std::uint8_t*>(buffer);
+        writable = true;
+
+        context.registers = &virtualMachine.registers[0];
+        context.hi = &virtualMachine.hi;
+        context.lo = &virtualMachine.lo;
+        context.virtualMachine = &virtualMachine;
+        context.memory = virtualMachine.program.getMemory().base();
+        context.pc = 0;
+        context.remainingInstructions = 0;
+
+        // void enter(Context* context, const std::uint8_t* block)
+        emit({ 0x53 });                         // push rbx
+        emit({ 0x41, 0x54 });                   // push r12
+        emit({ 0x41, 0x55 });                   // push r13
+        emit({ 0x49, 0x89, 0xFC });             // mov r12, rdi
+        emit({ 0x49, 0x8B, 0x5C, 0x24, CONTEXT_REGISTERS }); // mov rbx, [r12 + registers]
+        emit({ 0x4D, 0x8B, 0x6C, 0x24, CONTEXT_MEMORY }); // mov r13, [r12 + memory]
+        emit({ 0xFF, 0xE6 });                   // jmp rsi
+
+        // Every block exit that is not chained to another block returns to the interpreter from here
+        epilogue = codeSize;
+        emit({ 0x41, 0x5D });                   // pop r13
+        emit({ 0x41, 0x5C });                   // pop r12
+        emit({ 0x5B });                         // pop rbx
+        emit({ 0xC3 });                         // ret
+        blocksBegin = codeSize;
+
+        setWritable(false);
+    }
+
+    Jit::~Jit()
+    {
+        munmap(code, CODE_BUFFER_SIZE);
+    }
+
+    bool Jit::execute(std::uint32_t& pc)
+    {
+        std::uint32_t instructionCount = virtualMachine.program.getTextSegmentLength() / INSTRUCTION_SIZE;
+        if (entries.size() != instructionCount)
+        {
+            flush();
+        }
+
+        if (pc % INSTRUCTION_SIZE || pc / INSTRUCTION_SIZE >= instructionCount)
+        {
+            return false;
+        }
+
+        std::uint32_t index = pc / INSTRUCTION_SIZE;
+        const std::uint8_t* entry = entries[index];
+        if (entry == nullptr)
+        {
+            if (counters[index] < HOT_THRESHOLD)
+            {
+                counters[index]++;
+                return false;
+            }
+
+            // Blocks that could not be compiled stay interpreted for good
+            if (counters[index] != HOT_THRESHOLD)
+            {
+                return false;
+            }
+
+            entry = compile(pc);
+            if (entry == nullptr)
+            {
+                counters[index] = std::numeric_limits<std::uint32_t>::max();
+                return false;
+            }
+        }
+
+        context.pc = pc;
+        context.remainingInstructions = virtualMachine.remainingInstructions;
+        running = true;
+        reinterpret_cast<void(*)(Context*, const std::uint8_t*)>(code)(&context, entry);
+        running = false;
+        pc = context.pc;
+        virtualMachine.remainingInstructions = context.remainingInstructions;
+
+        return true;
+    }
+
+    bool Jit::recoverFault(std::uint32_t& pc)
+    {
+        if (!running)
+        {
+            return false;
+        }
+
+        running = false;
+        pc = context.pc;
+        virtualMachine.remainingInstructions = context.remainingInstructions;
+        return true;
+    }
+
+    void Jit::flush()
+    {
+        std::size_t instructionCount = virtualMachine.program.getTextSegmentLength() / INSTRUCTION_SIZE;
+        entries.assign(instructionCount, nullptr);
+        counters.assign(instructionCount, 0);
+        pendingLinks.clear();
+        codeSize = blocksBegin;
+    }
+
+    const std::uint8_t* Jit::compile(std::uint32_t pc)
+    {
+        // Worst case a guest instruction expands to a few dozen bytes, make sure the whole block fits
+        if (codeSize + MAX_BLOCK_LENGTH * 64 > CODE_BUFFER_SIZE)
+        {
+            flush();
+        }
+
+        setWritable(true);
+
+        const std::uint32_t textSegmentLength = virtualMachine.program.getTextSegmentLength();
+        const std::size_t start = codeSize;
+        std::uint32_t location = pc;
+        std::uint32_t length = 0;
+        bool ended = false;
+
+        while (!ended)
+        {
+            if (length == MAX_BLOCK_LENGTH || location >= textSegmentLength)
+            {
+                emitExit(location, true, length);
+                break;
+            }
+
+            const VirtualMachine::DecodedInstruction& d = (*virtualMachine.executedText)[location / INSTRUCTION_SIZE];
+            const std::uint8_t r0 = registerDisplacement(d.register0);
+            const std::uint8_t r1 = registerDisplacement(d.register1);
+            const std::uint8_t r2 = registerDisplacement(d.register2);
+
+            switch (d.opcode)
+            {
+            case ADD:
+            case ADDU:
+                emitLoad(EAX, d.register1);
+                emit({ 0x03, 0x43, r2 });                   // add eax, [rbx + r2]
+                emitStore(EAX, d.register0);
+                break;
+            case ADDI:
+                emitLoad(EAX, d.register1);
+                emit({ 0x05 });                             // add eax, imm32
+                emit32(static_cast<std::uint32_t>(d.signedImmediate));
+                emitStore(EAX, d.register0);
+                break;
+            case ADDIU:
+                emitLoad(EAX, d.register1);
+                emit({ 0x05 });                             // add eax, imm32
+                emit32(d.immediate);
+                emitStore(EAX, d.register0);
+                break;
+            case AND:
+                emitLoad(EAX, d.register1);
+                emit({ 0x23, 0x43, r2 });                   // and eax, [rbx + r2]
+                emitStore(EAX, d.register0);
+                break;
+            case ANDI:
+                emitLoad(EAX, d.register1);
+                emit({ 0x25 });                             // and eax, imm32
+                emit32(d.immediate);
+                emitStore(EAX, d.register0);
+                break;
+            case OR:
+                emitLoad(EAX, d.register1);
+                emit({ 0x0B, 0x43, r2 });                   // or eax, [rbx + r2]
+                emitStore(EAX, d.register0);
+                break;
+            case ORI:
+                emitLoad(EAX, d.register1);
+                emit({ 0x0D });                             // or eax, imm32
+                emit32(d.immediate);
+                emitStore(EAX, d.register0);
+                break;
+            case XOR:
+                emitLoad(EAX, d.register1);
+                emit({ 0x33, 0x43, r2 });                   // xor eax, [rbx + r2]
+                emitStore(EAX, d.register0);
+                break;
+            case XORI:
+                emitLoad(EAX, d.register1);
+                emit({ 0x35 });                             // xor eax, imm32
+                emit32(d.immediate);
+                emitStore(EAX, d.register0);
+                break;
+            case NOR:
+                emitLoad(EAX, d.register1);
+                emit({ 0x0B, 0x43, r2 });                   // or eax, [rbx + r2]
+                emit({ 0xF7, 0xD0 });                       // not eax
+                emitStore(EAX, d.register0);
+                break;
+            case SUB:
+            case SUBU:
+                emitLoad(EAX, d.register1);
+                emit({ 0x2B, 0x43, r2 });                   // sub eax, [rbx + r2]
+                emitStore(EAX, d.register0);
+                break;
+            case LUI:
+                emit({ 0xC7, 0x43, r0 });                   // mov dword [rbx + r0], imm32
+                emit32(static_cast<std::uint32_t>(d.immediate) << (INSTRUCTION_BIT / 2));
+                break;
+            case SLL:
+                emitLoad(EAX, d.register1);
+                emit({ 0xC1, 0xE0, static_cast<std::uint8_t>(d.immediate & 31) }); // shl eax, imm8
+                emitStore(EAX, d.register0);
+                break;
+            case SRL:
+                emitLoad(EAX, d.register1);
+                emit({ 0xC1, 0xE8, static_cast<std::uint8_t>(d.immediate & 31) }); // shr eax, imm8
+                emitStore(EAX, d.register0);
+                break;
+            case SRA:
+                emitLoad(EAX, d.register1);
+                emit({ 0xC1, 0xE8, static_cast<std::uint8_t>(d.immediate & 31) }); // shr eax, imm8
+                emit({ 0x0D });                             // or eax, imm32
+                emit32(~(~0U >> (d.immediate & 31)));
+                emitStore(EAX, d.register0);
+                break;
+            case SLLV:
+                emitLoad(EAX, d.register1);
+                emitLoad(ECX, d.register2);
+                emit({ 0xD3, 0xE0 });                       // shl eax, cl
+                emitStore(EAX, d.register0);
+                break;
+            case SRLV:
+                emitLoad(EAX, d.register1);
+                emitLoad(ECX, d.register2);
+                emit({ 0xD3, 0xE8 });                       // shr eax, cl
+                emitStore(EAX, d.register0);
+                break;
+            case SLT:
+            case SLTU:
+            case SNE:
+            case SEQ:
+            {
+                static const std::uint8_t setcc[] = { 0x92, 0x92, 0x95, 0x94 }; // setb, setb, setne, sete
+                std::uint8_t condition = setcc[d.opcode == SLT ? 0 : d.opcode == SLTU ? 1 : d.opcode == SNE ? 2 : 3];
+                emitLoad(EAX, d.register1);
+                emit({ 0x3B, 0x43, r2 });                   // cmp eax, [rbx + r2]
+                emit({ 0x0F, condition, 0xC0 });            // setcc al
+                emit({ 0x0F, 0xB6, 0xC0 });                 // movzx eax, al
+                emitStore(EAX, d.register0);
+            }
+                break;
+            case SLTI:
+            case SLTIU:
+                emitLoad(EAX, d.register1);
+                emit({ 0x3D });                             // cmp eax, imm32
+                emit32(d.immediate);
+                emit({ 0x0F, 0x92, 0xC0 });                 // setb al
+                emit({ 0x0F, 0xB6, 0xC0 });                 // movzx eax, al
+                emitStore(EAX, d.register0);
+                break;
+            case MULT:
+            case MULTU:
+                emitLoad(EAX, d.register0);
+                emit({ 0xF7, 0x63, r1 });                   // mul dword [rbx + r1]
+                emit({ 0x49, 0x8B, 0x74, 0x24, CONTEXT_LO }); // mov rsi, [r12 + lo]
+                emit({ 0x89, 0x06 });                       // mov [rsi], eax
+                emit({ 0x49, 0x8B, 0x74, 0x24, CONTEXT_HI }); // mov rsi, [r12 + hi]
+                emit({ 0x89, 0x16 });                       // mov [rsi], edx
+                break;
+            case MFHI:
+            case MFLO:
+                emit({ 0x49, 0x8B, 0x74, 0x24, d.opcode == MFHI ? CONTEXT_HI : CONTEXT_LO }); // mov rsi, [r12 + hi/lo]
+                emit({ 0x8B, 0x06 });                       // mov eax, [rsi]
+                emitStore(EAX, d.register0);
+                break;
+            case LW:
+                emitMemoryAccess(location, d.register1, d.address);
+                emit({ 0x41, 0x8B, 0x44, 0x35, 0x00 });     // mov eax, [r13 + rsi]
+                emitStore(EAX, d.register0);
+                break;
+            case LB:
+                emitMemoryAccess(location, d.register1, d.address);
+                emit({ 0x41, 0x0F, 0xB6, 0x44, 0x35, 0x00 }); // movzx eax, byte [r13 + rsi]
+                emitStore(EAX, d.register0);
+                break;
+            case SW:
+            case SB:
+            {
+                emitMemoryAccess(location, d.register1, d.address);
+                emitLoad(EAX, d.register0);
+                if (d.opcode == SW)
+                {
+                    emit({ 0x41, 0x89, 0x44, 0x35, 0x00 }); // mov [r13 + rsi], eax
+                }
+                else
+                {
+                    emit({ 0x41, 0x88, 0x44, 0x35, 0x00 }); // mov [r13 + rsi], al
+                }
+                // A store into the text segment invalidates compiled code, leave before running any more of it
+                emit({ 0x81, 0xFE });                       // cmp esi, imm32
+                emit32(virtualMachine.program.getTextSegmentLength());
+                std::size_t skip = emitJcc(CONDITION_AE);
+                emit({ 0x49, 0x8B, 0x7C, 0x24, CONTEXT_VIRTUAL_MACHINE }); // mov rdi, [r12 + virtualMachine]
+                emit({ 0xBA });                             // mov edx, imm32
+                emit32(d.opcode == SW ? INSTRUCTION_SIZE : 1);
+                emitCall(reinterpret_cast<const void*>(&Jit::invalidate));
+                emitExit(location + INSTRUCTION_SIZE, false, length + 1);
+                bindLabel(skip);
+            }
+                break;
+            case BEQ:
+            case BNE:
+            {
+                emitLoad(EAX, d.register0);
+                emit({ 0x3B, 0x43, r1 });                   // cmp eax, [rbx + r1]
+                std::size_t taken = emitJcc(d.opcode == BEQ ? CONDITION_E : CONDITION_NE);
+                emitExit(location + INSTRUCTION_SIZE, true, length + 1);
+                bindLabel(taken);
+                emitExit(d.address, true, length + 1);
+                ended = true;
+            }
+                break;
+            case BGEZ:
+            case BGTZ:
+            case BLEZ:
+            case BLTZ:
+            {
+                emit({ 0x83, 0x7B, r0, 0x00 });             // cmp dword [rbx + r0], 0
+                std::size_t taken = emitJcc(d.opcode == BGEZ ? CONDITION_GE : d.opcode == BGTZ ? CONDITION_G : d.opcode == BLEZ ? CONDITION_LE : CONDITION_L);
+                emitExit(location + INSTRUCTION_SIZE, true, length + 1);
+                bindLabel(taken);
+                emitExit(d.address, true, length + 1);
+                ended = true;
+            }
+                break;
+            case BGEZAL:
+            case BLTZAL:
+            {
+                // Like the interpreters, a bltzal that is not taken skips the following instruction
+                std::uint32_t next = location + (d.opcode == BLTZAL ? 2 : 1) * INSTRUCTION_SIZE;
+                emit({ 0x83, 0x7B, r0, 0x00 });             // cmp dword [rbx + r0], 0
+                std::size_t notTaken = emitJcc(d.opcode == BGEZAL ? CONDITION_L : CONDITION_GE);
+                emit({ 0xC7, 0x43, registerDisplacement(RA) }); // mov dword [rbx + ra], imm32
+                emit32(next);
+                emitExit(d.address, true, length + 1);
+                bindLabel(notTaken);
+                emitExit(next, true, length + 1);
+                ended = true;
+            }
+                break;
+            case JAL:
+                emit({ 0xC7, 0x43, registerDisplacement(RA) }); // mov dword [rbx + ra], imm32
+                emit32(location + INSTRUCTION_SIZE);
+                emitExit(d.address, true, length + 1);
+                ended = true;
+                break;
+            case J:
+                emitExit(d.address, true, length + 1);
+                ended = true;
+                break;
+            case JR:
+            case JALR:
+                if (d.opcode == JALR)
+                {
+                    emit({ 0xC7, 0x43, r1 });               // mov dword [rbx + r1], imm32
+                    emit32(location + INSTRUCTION_SIZE);
+                }
+                emitLoad(EAX, d.register0);
+                emit({ 0x41, 0x89, 0x44, 0x24, CONTEXT_PC }); // mov [r12 + pc], eax
+                emitCharge(length + 1);
+                emit({ 0xE9 });                             // jmp epilogue
+                emit32(static_cast<std::uint32_t>(epilogue - (codeSize + 4)));
+                ended = true;
+                break;
+            default:
+                // System calls, division, atomics and illegal instructions are left to the interpreter
+                if (length == 0)
+                {
+                    codeSize = start;
+                    setWritable(false);
+                    return nullptr;
+                }
+                emitExit(location, true, length);
+                ended = true;
+                break;
+            }
+
+            location += INSTRUCTION_SIZE;
+            length++;
+        }
+
+        const std::uint8_t* entry = code + start;
+        entries[pc / INSTRUCTION_SIZE] = entry;
+        link(pc, entry);
+
+        setWritable(false);
+
+        return entry;
+    }
+
+    void Jit::link(std::uint32_t pc, const std::uint8_t* entry)
+    {
+        auto it = pendingLinks.find(pc);
+        if (it == pendingLinks.end())
+        {
+            return;
+        }
+
+        for (std::size_t offset : it->second)
+        {
+            patch32(offset, static_cast<std::uint32_t>(entry - (code + offset + 4)));
+        }
+        pendingLinks.erase(it);
+    }
+
+    void Jit::setWritable(bool aWritable)
+    {
+        if (writable == aWritable)
+        {
+            return;
+        }
+
+        if (mprotect(code, CODE_BUFFER_SIZE, aWritable ? PROT_READ | PROT_WRITE : PROT_READ | PROT_EXEC))
+        {
+            throw std::runtime_error("Failed to change JIT code buffer protection");
+        }
+        writable = aWritable;
+    }
+
+    void Jit::emit(std::initializer_list<std::uint8_t> bytes)
+    {
+        for (std::uint8_t byte : bytes)
+        {
+            code[codeSize++] = byte;
+        }
+    }
+
+    void Jit::emit32(std::uint32_t value)
+    {
+        std::memcpy(code + codeSize, &value, sizeof(value));
+        codeSize += sizeof(value);
+    }
+
+    void Jit::emit64(std::uint64_t value)
+    {
+        std::memcpy(code + codeSize, &value, sizeof(value));
+        codeSize += sizeof(value);
+    }
+
+    void Jit::patch32(std::size_t offset, std::uint32_t value)
+    {
+        std::memcpy(code + offset, &value, sizeof(value));
+    }
+
+    void Jit::emitLoad(std::uint8_t hostRegister, std::uint32_t guestRegister)
+    {
+        emit({ 0x8B, static_cast<std::uint8_t>(0x43 | hostRegister << 3), registerDisplacement(guestRegister) }); // mov r32, [rbx + disp8]
+    }
+
+    void Jit::emitStore(std::uint8_t hostRegister, std::uint32_t guestRegister)
+    {
+        emit({ 0x89, static_cast<std::uint8_t>(0x43 | hostRegister << 3), registerDisplacement(guestRegister) }); // mov [rbx + disp8], r32
+    }
+
+    void Jit::emitCall(const void* function)
+    {
+        emit({ 0x48, 0xB8 });                           // mov rax, imm64
+        emit64(reinterpret_cast<std::uint64_t>(function));
+        emit({ 0xFF, 0xD0 });                           // call rax
+    }
+
+    // Chained exits only continue into the next block while there are instructions left to run
+    void Jit::emitExit(std::uint32_t target, bool chain, std::uint32_t retired)
+    {
+        emit({ 0x41, 0xC7, 0x44, 0x24, CONTEXT_PC });   // mov dword [r12 + pc], imm32
+        emit32(target);
+        emitCharge(retired);
+        emit({ 0x0F, 0x8E });                           // jle epilogue
+        emit32(static_cast<std::uint32_t>(epilogue - (codeSize + 4)));
+        emit({ 0xE9 });                                 // jmp rel32
+        std::size_t rel32 = codeSize;
+        emit32(static_cast<std::uint32_t>(epilogue - (rel32 + 4)));
+
+        if (!chain || target % INSTRUCTION_SIZE || target / INSTRUCTION_SIZE >= entries.size())
+        {
+            return;
+        }
+
+        const std::uint8_t* entry = entries[target / INSTRUCTION_SIZE];
+        if (entry != nullptr)
+        {
+            patch32(rel32, static_cast<std::uint32_t>(entry - (code + rel32 + 4)));
+        }
+        else
+        {
+            pendingLinks[target].push_back(rel32);
+        }
+    }
+
+    void Jit::emitCharge(std::uint32_t retired)
+    {
+        emit({ 0x49, 0x81, 0x6C, 0x24, CONTEXT_REMAINING_INSTRUCTIONS }); // sub qword [r12 + remainingInstructions], imm32
+        emit32(retired);
+    }
+
+    std::size_t Jit::emitJcc(std::uint8_t condition)
+    {
+        emit({ 0x0F, static_cast<std::uint8_t>(0x80 | condition) }); // jcc rel32
+        std::size_t rel32 = codeSize;
+        emit32(0);
+        return rel32;
+    }
+
+    void Jit::bindLabel(std::size_t rel32Offset)
+    {
+        patch32(rel32Offset, static_cast<std::uint32_t>(codeSize - (rel32Offset + 4)));
+    }
+
+    // Leaves rsi holding the guest address, zero extended, with pc pointing at the accessing instruction
+    void Jit::emitMemoryAccess(std::uint32_t location, std::uint32_t guestRegister, std::uint32_t displacement)
+    {
+        emit({ 0x41, 0xC7, 0x44, 0x24, CONTEXT_PC });   // mov dword [r12 + pc], imm32
+        emit32(location);
+        emitLoad(ESI, guestRegister);
+        emit({ 0x81, 0xC6 });                           // add esi, imm32
+        emit32(displacement);
+    }
+
+    void Jit::invalidate(VirtualMachine* virtualMachine, std::uint32_t address, std::uint32_t size)
+    {
+        virtualMachine->invalidateInstruction(address, size);
+    }
+#else
+    Jit::Jit(VirtualMachine& aVirtualMachine)
+        : virtualMachine(aVirtualMachine)
+    {
+        throw std::runtime_error("JIT is not supported on this platform");
+    }
+
+    Jit::~Jit()
+    {
+    }
+
+    bool Jit::execute(std::uint32_t& pc)
+    {
+        return false;
+    }
+
+    void Jit::flush()
+    {
+    }
+
+    bool Jit::recoverFault(std::uint32_t& pc)
+    {
+        return false;
+    }
+#endif
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__))
+#define KASM_JIT 1
+#else
+#define KASM_JIT 0
+#endif
+
+namespace kasm
+{
+	class VirtualMachine;
+
+	// Baseline template JIT translating hot basic blocks of the decoded text segment to x86-64.
+	// Guest registers stay in the virtual machine's register file, addressed off a pinned host register,
+	// so control can move between compiled code and the interpreter at any block boundary.
+	class Jit
+	{
+	public:
+		Jit(VirtualMachine& aVirtualMachine);
+		~Jit();
+
+		// Runs compiled code starting at pc if the block there is hot, updating pc to where the interpreter must
+		// resume. Returns false without touching pc when the block has to be interpreted.
+		bool execute(std::uint32_t& pc);
+		void flush();
+		// After a guest memory fault in compiled code, sets pc to the faulting instruction. Returns false if the fault
+		// did not happen in compiled code.
+		bool recoverFault(std::uint32_t& pc);
+
+		static bool isSupported() { return KASM_JIT; }
+
+		static const std::uint32_t HOT_THRESHOLD = 64;
+		static const std::uint32_t MAX_BLOCK_LENGTH = 256;
+		static const std::size_t CODE_BUFFER_SIZE = 16 * 1024 * 1024;
+
+		// State shared with compiled code, offsets are baked into the generated instructions
+		struct Context
+		{
+			std::uint32_t* registers;
+			std::uint32_t* hi;
+			std::uint32_t* lo;
+			VirtualMachine* virtualMachine;
+			std::uint8_t* memory;
+			std::uint32_t pc; // also kept up to date before every memory access so faults can be attributed
+			std::int64_t remainingInstructions; // charged at every block exit, which returns once it runs out
+		};
+
+	private:
+		const std::uint8_t* compile(std::uint32_t pc);
+		void link(std::uint32_t pc, const std::uint8_t* entry);
+		void setWritable(bool writable);
+
+		void emit(std::initializer_list<std::uint8_t> bytes);
+		void emit32(std::uint32_t value);
+		void emit64(std::uint64_t value);
+		void patch32(std::size_t offset, std::uint32_t value);
+		void emitLoad(std::uint8_t hostRegister, std::uint32_t guestRegister);
+		void emitStore(std::uint8_t hostRegister, std::uint32_t guestRegister);
+		void emitCall(const void* function);
+		void emitExit(std::uint32_t target, bool chain, std::uint32_t retired);
+		void emitCharge(std::uint32_t retired);
+		std::size_t emitJcc(std::uint8_t condition);
+		void bindLabel(std::size_t rel32Offset);
+
+		void emitMemoryAccess(std::uint32_t location, std::uint32_t guestRegister, std::uint32_t displacement);
+
+		static void invalidate(VirtualMachine* virtualMachine, std::uint32_t address, std::uint32_t size);
+
+		VirtualMachine& virtualMachine;
+		Context context;
+
+		std::uint8_t* code = nullptr;
+		std::size_t codeSize = 0;
+		std::size_t epilogue = 0;
+		std::size_t blocksBegin = 0;
+		bool writable = false;
+		bool running = false;
+
+		std::vector<const std::uint8_t*> entries;
+		std::vector<std::uint32_t> counters;
+		std::unordered_map<std::uint32_t, std::vector<std::size_t>> pendingLinks; // target pc -> rel32 offsets of exits to chain
+	};
+}
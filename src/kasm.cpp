@@ -1,14 +1,71 @@
+#include <algorithm>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "assembler.hpp"
+#include "bench_util.hpp"
 #include "debugger.hpp"
 #include "disassembler.hpp"
 #include "compiler.hpp"
+#include "pipeline.hpp"
+#include "runner.hpp"
+#include "scheduler.hpp"
+#include "server.hpp"
 #include "virtualMachine.hpp"
 
 #include "binaryBuilder.hpp"
 
+// Parses a byte count with an optional K, M or G suffix
+static bool parseSize(const std::string& value, std::uint64_t& size)
+{
+	std::size_t end = 0;
+	unsigned long long number;
+	try
+	{
+		number = std::stoull(value, &end);
+	}
+	catch (const std::exception&)
+	{
+		return false;
+	}
+
+	std::string suffix = value.substr(end);
+	unsigned int shift = 0;
+	if (suffix == "K" || suffix == "k") shift = 10;
+	else if (suffix == "M" || suffix == "m") shift = 20;
+	else if (suffix == "G" || suffix == "g") shift = 30;
+	else if (!suffix.empty()) return false;
+
+	// Checked before shifting, so large values are rejected instead of wrapping
+	if (number > (std::numeric_limits<std::uint64_t>::max() >> shift))
+	{
+		return false;
+	}
+
+	size = static_cast<std::uint64_t>(number) << shift;
+	return true;
+}
+
+static bool parseSize(const std::string& value, std::uint32_t& size)
+{
+	std::uint64_t wideSize;
+	if (!parseSize(value, wideSize) || wideSize > std::numeric_limits<std::uint32_t>::max())
+	{
+		return false;
+	}
+
+	size = static_cast<std::uint32_t>(wideSize);
+	return true;
+}
+
 int main(int argc, char* argv[])
 {
 	if (argc < 2)
@@ -39,16 +96,53 @@ int main(int argc, char* argv[])
 
 		if (subcommand == "asm")
 		{
-			if (argc < 4)
+			std::vector<std::string> arguments;
+			std::string symbolTable;
+
+			for (int i = 2; i < argc; i++)
+			{
+				std::string argument = argv[i];
+				std::string value;
+				std::uint32_t size;
+
+				if (kasm::parseOption(argument, "--symbols", value))
+				{
+					symbolTable = value;
+				}
+				else if (kasm::parseOption(argument, "--stack", value))
+				{
+					if (!parseSize(value, size))
+					{
+						std::cerr << "Invalid stack size\n";
+						return -1;
+					}
+					assembler.setStackSize(size);
+				}
+				else if (kasm::parseOption(argument, "--global", value))
+				{
+					if (!parseSize(value, size))
+					{
+						std::cerr << "Invalid global size\n";
+						return -1;
+					}
+					assembler.setGlobalSize(size);
+				}
+				else
+				{
+					arguments.push_back(argument);
+				}
+			}
+
+			if (arguments.size() < 2)
 			{
 				std::cerr << "Subcommand asm requires source and output paths\n";
 				return -1;
 			}
 
-			std::string source = argv[2];
-			std::string output = argv[3];
+			std::string source = arguments[0];
+			std::string output = arguments[1];
 
-			assembler.assemble(source, output);
+			assembler.assemble(source, output, symbolTable);
 		}
 		else if (subcommand == "dsm")
 		{
@@ -65,16 +159,449 @@ int main(int argc, char* argv[])
 		}
 		else if (subcommand == "vm")
 		{
-			if (argc < 3)
+			std::vector<std::string> arguments;
+			// Applied to every virtual machine, more than one runs when there are several inputs
+			std::vector<std::function<void(kasm::VirtualMachine&)>> configuration;
+			unsigned int jobs = std::max(std::thread::hardware_concurrency(), 1U);
+			kasm::VirtualMachine::Limits limits;
+			bool snapshot = false;
+			std::string snapshotLabel;
+			std::string serveAddress;
+			std::uint64_t quantum = kasm::Scheduler::DEFAULT_QUANTUM;
+			std::string symbolTable;
+			bool pipeline = false;
+			std::string profilePath;
+			std::uint32_t sampleFrequency = 0;
+			std::string pprofPath;
+			bool collectStatistics = false;
+			std::string statisticsPath;
+			std::uint32_t channelCapacity = kasm::Pipeline::DEFAULT_CHANNEL_CAPACITY;
+			std::uint32_t messageSize = kasm::Pipeline::DEFAULT_MESSAGE_SIZE;
+
+			for (int i = 2; i < argc; i++)
+			{
+				std::string argument = argv[i];
+				std::string value;
+
+				if (kasm::parseOption(argument, "--engine", value))
+				{
+					if (value == "switch")
+					{
+						configuration.push_back([](kasm::VirtualMachine& vm) { vm.setEngine(kasm::VirtualMachine::Engine::SWITCH); });
+					}
+					else if (value == "threaded")
+					{
+						configuration.push_back([](kasm::VirtualMachine& vm) { vm.setEngine(kasm::VirtualMachine::Engine::THREADED); });
+					}
+					else
+					{
+						std::cerr << "Invalid engine [switch|threaded]\n";
+						return -1;
+					}
+				}
+				else if (argument == "--jit")
+				{
+					if (!kasm::Jit::isSupported())
+					{
+						std::cerr << "JIT is not supported on this platform\n";
+						return -1;
+					}
+					configuration.push_back([](kasm::VirtualMachine& vm) { vm.setEngine(kasm::VirtualMachine::Engine::THREADED); vm.setJit(true); });
+				}
+				else if (kasm::parseOption(argument, "--stack", value))
+				{
+					std::uint32_t size;
+					if (!parseSize(value, size))
+					{
+						std::cerr << "Invalid stack size\n";
+						return -1;
+					}
+					configuration.push_back([=](kasm::VirtualMachine& vm) { vm.setStackSize(size); });
+				}
+				else if (kasm::parseOption(argument, "--global", value))
+				{
+					std::uint32_t size;
+					if (!parseSize(value, size))
+					{
+						std::cerr << "Invalid global size\n";
+						return -1;
+					}
+					configuration.push_back([=](kasm::VirtualMachine& vm) { vm.setGlobalSize(size); });
+				}
+				else if (kasm::parseOption(argument, "--io-buffer", value))
+				{
+					std::uint32_t size;
+					if (!parseSize(value, size))
+					{
+						std::cerr << "Invalid I/O buffer size\n";
+						return -1;
+					}
+					configuration.push_back([=](kasm::VirtualMachine& vm) { vm.getConsole().setBufferSize(size); });
+				}
+				else if (kasm::parseOption(argument, "--io-flush", value))
+				{
+					std::uint64_t milliseconds;
+					if (!kasm::parseCount(value, milliseconds) || milliseconds > std::numeric_limits<std::uint32_t>::max())
+					{
+						std::cerr << "Invalid I/O flush interval\n";
+						return -1;
+					}
+					configuration.push_back([=](kasm::VirtualMachine& vm) { vm.getConsole().setFlushInterval(static_cast<std::uint32_t>(milliseconds)); });
+				}
+				else if (kasm::parseOption(argument, "--jobs", value))
+				{
+					// Far more threads than the host has only adds contention, a typo like --jobs=1k is rejected
+					std::uint64_t count;
+					std::uint64_t maximum = std::uint64_t(std::max(std::thread::hardware_concurrency(), 1U)) * 64;
+					if (!kasm::parseCount(value, count) || count == 0 || count > maximum || count > std::numeric_limits<std::uint32_t>::max())
+					{
+						std::cerr << "Invalid job count\n";
+						return -1;
+					}
+					jobs = static_cast<unsigned int>(count);
+				}
+				else if (kasm::parseOption(argument, "--max-instructions", value))
+				{
+					if (!kasm::parseCount(value, limits.instructions))
+					{
+						std::cerr << "Invalid instruction limit\n";
+						return -1;
+					}
+				}
+				else if (kasm::parseOption(argument, "--max-memory", value))
+				{
+					if (!parseSize(value, limits.memory))
+					{
+						std::cerr << "Invalid memory limit\n";
+						return -1;
+					}
+				}
+				else if (kasm::parseOption(argument, "--max-files", value))
+				{
+					std::uint64_t count;
+					if (!kasm::parseCount(value, count) || count > std::numeric_limits<std::uint32_t>::max())
+					{
+						std::cerr << "Invalid open file limit\n";
+						return -1;
+					}
+					limits.files = static_cast<std::uint32_t>(count);
+				}
+				else if (kasm::parseOption(argument, "--max-output", value))
+				{
+					if (!parseSize(value, limits.output))
+					{
+						std::cerr << "Invalid output limit\n";
+						return -1;
+					}
+				}
+				else if (argument == "--snapshot")
+				{
+					snapshot = true;
+				}
+				else if (kasm::parseOption(argument, "--snapshot", value))
+				{
+					snapshot = true;
+					snapshotLabel = value;
+				}
+				else if (kasm::parseOption(argument, "--symbols", value))
+				{
+					symbolTable = value;
+				}
+				else if (kasm::parseOption(argument, "--serve", value))
+				{
+					serveAddress = value;
+				}
+				else if (kasm::parseOption(argument, "--quantum", value))
+				{
+					if (!kasm::parseCount(value, quantum) || quantum == 0)
+					{
+						std::cerr << "Invalid quantum\n";
+						return -1;
+					}
+				}
+				else if (kasm::parseOption(argument, "--profile", value))
+				{
+					profilePath = value;
+				}
+				else if (argument == "--sample")
+				{
+					sampleFrequency = kasm::Sampler::DEFAULT_FREQUENCY;
+				}
+				else if (kasm::parseOption(argument, "--sample", value))
+				{
+					std::uint64_t frequency;
+					if (!kasm::parseCount(value, frequency) || frequency == 0 || frequency > kasm::Sampler::MAX_FREQUENCY)
+					{
+						std::cerr << "Invalid sampling frequency\n";
+						return -1;
+					}
+					sampleFrequency = static_cast<std::uint32_t>(frequency);
+				}
+				else if (kasm::parseOption(argument, "--pprof", value))
+				{
+					pprofPath = value;
+				}
+				else if (kasm::parseOption(argument, "--stats", value))
+				{
+					// json writes to standard error, json:PATH to a file
+					if (value.compare(0, 4, "json") != 0 || (value.size() > 4 && (value[4] != ':' || value.size() == 5)))
+					{
+						std::cerr << "Invalid statistics format\n";
+						return -1;
+					}
+					collectStatistics = true;
+					statisticsPath = value.size() > 4 ? value.substr(5) : "";
+				}
+				else if (argument == "--pipeline")
+				{
+					pipeline = true;
+				}
+				else if (kasm::parseOption(argument, "--channel-capacity", value))
+				{
+					std::uint64_t count;
+					if (!kasm::parseCount(value, count) || count == 0 || count > std::numeric_limits<std::uint32_t>::max())
+					{
+						std::cerr << "Invalid channel capacity\n";
+						return -1;
+					}
+					channelCapacity = static_cast<std::uint32_t>(count);
+				}
+				else if (kasm::parseOption(argument, "--message-size", value))
+				{
+					if (!parseSize(value, messageSize) || messageSize == 0)
+					{
+						std::cerr << "Invalid message size\n";
+						return -1;
+					}
+				}
+				else
+				{
+					arguments.push_back(argument);
+				}
+			}
+
+			if (arguments.empty())
 			{
 				std::cerr << "Subcommand vm requires executable path\n";
 				return -1;
 			}
 
-			std::string executable = argv[2];
+			std::string executable = arguments[0];
 
-			virtualMachine.loadProgram(executable);
-			exitCode = virtualMachine.execute();
+			configuration.push_back([=](kasm::VirtualMachine& vm) { vm.setLimits(limits); });
+			for (const auto& configure : configuration)
+			{
+				configure(virtualMachine);
+			}
+
+			if (!profilePath.empty() && (arguments.size() > 1 || snapshot || pipeline || !serveAddress.empty()))
+			{
+				std::cerr << "Option --profile only profiles a single run\n";
+				return -1;
+			}
+
+			if (!pprofPath.empty() && !sampleFrequency)
+			{
+				sampleFrequency = kasm::Sampler::DEFAULT_FREQUENCY;
+			}
+			if (sampleFrequency && (arguments.size() > 1 || snapshot || pipeline || !serveAddress.empty()))
+			{
+				std::cerr << "Option --sample only samples a single run\n";
+				return -1;
+			}
+
+			if (collectStatistics && (arguments.size() > 1 || snapshot || pipeline || !serveAddress.empty() || !profilePath.empty()))
+			{
+				std::cerr << "Option --stats only counts a single run without --profile\n";
+				return -1;
+			}
+			if (collectStatistics && virtualMachine.getEngine() != kasm::VirtualMachine::Engine::SWITCH)
+			{
+				std::cerr << "Option --stats counts on the switch engine and does not take --engine=threaded or --jit\n";
+				return -1;
+			}
+
+			if (pipeline)
+			{
+				if (!serveAddress.empty() || snapshot)
+				{
+					std::cerr << "Option --pipeline does not take --serve or --snapshot\n";
+					return -1;
+				}
+
+				kasm::Pipeline stages(arguments, [&configuration](kasm::VirtualMachine& vm)
+				{
+					for (const auto& configure : configuration)
+					{
+						configure(vm);
+					}
+				});
+				stages.setChannelCapacity(channelCapacity);
+				stages.setMessageSize(messageSize);
+
+				for (int stageExitCode : stages.run())
+				{
+					if (stageExitCode && !exitCode)
+					{
+						exitCode = stageExitCode;
+					}
+				}
+			}
+			else if (!serveAddress.empty())
+			{
+				if (arguments.size() > 1 || snapshot)
+				{
+					std::cerr << "Option --serve does not take input paths or --snapshot\n";
+					return -1;
+				}
+
+				kasm::Scheduler scheduler(jobs, quantum);
+				kasm::Server server(scheduler, virtualMachine.loadImage(executable), [&configuration](kasm::VirtualMachine& vm)
+				{
+					for (const auto& configure : configuration)
+					{
+						configure(vm);
+					}
+				});
+				server.serve(serveAddress);
+			}
+			else if (arguments.size() == 1 && !snapshot)
+			{
+				std::unique_ptr<kasm::Profiler> profiler;
+				if (!profilePath.empty())
+				{
+					std::unordered_map<std::uint32_t, std::string> names;
+					if (!symbolTable.empty())
+					{
+						std::ifstream symbolTableFile(symbolTable, std::ios::binary);
+						names = kasm::nameLocations(kasm::readSymbolTable(symbolTableFile));
+					}
+					profiler = std::make_unique<kasm::Profiler>(std::move(names));
+					virtualMachine.setProfiler(profiler.get());
+				}
+
+				std::unique_ptr<kasm::Sampler> sampler;
+				if (sampleFrequency)
+				{
+					sampler = std::make_unique<kasm::Sampler>(sampleFrequency);
+					virtualMachine.setSampler(sampler.get());
+				}
+
+				std::unique_ptr<kasm::Statistics> statistics;
+				if (collectStatistics)
+				{
+					statistics = std::make_unique<kasm::Statistics>();
+					virtualMachine.setStatistics(statistics.get());
+				}
+
+				virtualMachine.loadProgram(executable);
+				if (statistics)
+				{
+					statistics->start();
+				}
+				exitCode = virtualMachine.execute();
+				if (statistics)
+				{
+					statistics->stop();
+				}
+				if (virtualMachine.getExitReason() != kasm::VirtualMachine::ExitReason::NORMAL)
+				{
+					std::cerr << kasm::VirtualMachine::getExitReasonDescription(virtualMachine.getExitReason()) << std::endl;
+				}
+
+				if (profiler)
+				{
+					std::ofstream profileFile(profilePath);
+					profiler->writeFolded(profileFile);
+					profiler->writeFlat(std::cerr);
+				}
+
+				if (sampler)
+				{
+					std::unordered_map<std::uint32_t, std::string> names;
+					if (!symbolTable.empty())
+					{
+						std::ifstream symbolTableFile(symbolTable, std::ios::binary);
+						names = kasm::nameLocations(kasm::readSymbolTable(symbolTableFile));
+					}
+					if (!pprofPath.empty())
+					{
+						std::ofstream pprofFile(pprofPath, std::ios::binary);
+						sampler->writePprof(pprofFile, names);
+					}
+					sampler->writeReport(std::cerr, names);
+				}
+
+				if (statistics)
+				{
+					if (statisticsPath.empty())
+					{
+						statistics->writeJson(std::cerr);
+					}
+					else
+					{
+						std::ofstream statisticsFile(statisticsPath);
+						statistics->writeJson(statisticsFile);
+					}
+				}
+			}
+			else
+			{
+				if (arguments.size() == 1)
+				{
+					std::cerr << "Option --snapshot requires input paths\n";
+					return -1;
+				}
+
+				std::shared_ptr<const kasm::VirtualMachine::Image> image = virtualMachine.loadImage(executable);
+				std::shared_ptr<const kasm::VirtualMachine::Snapshot> initialized;
+				if (snapshot)
+				{
+					virtualMachine.loadProgram(image);
+					if (snapshotLabel.empty())
+					{
+						initialized = virtualMachine.executeToSnapshot();
+					}
+					else
+					{
+						std::ifstream symbolTableFile(symbolTable, std::ios::binary);
+						std::unordered_map<std::string, std::uint32_t> symbols = kasm::readSymbolTable(symbolTableFile);
+						if (!symbols.count(snapshotLabel))
+						{
+							std::cerr << "Undefined snapshot label " << snapshotLabel << "\n";
+							return -1;
+						}
+						initialized = virtualMachine.executeToSnapshot(symbols[snapshotLabel]);
+					}
+
+					if (!initialized)
+					{
+						if (virtualMachine.getExitReason() != kasm::VirtualMachine::ExitReason::NORMAL)
+						{
+							std::cerr << kasm::VirtualMachine::getExitReasonDescription(virtualMachine.getExitReason()) << std::endl;
+						}
+						std::cerr << "Program exited before reaching the snapshot\n";
+						return -1;
+					}
+				}
+
+				std::vector<std::string> inputs(arguments.begin() + 1, arguments.end());
+				kasm::Runner runner(image, [&configuration](kasm::VirtualMachine& vm)
+				{
+					for (const auto& configure : configuration)
+					{
+						configure(vm);
+					}
+				}, initialized);
+
+				for (int inputExitCode : runner.run(inputs, jobs))
+				{
+					if (inputExitCode && !exitCode)
+					{
+						exitCode = inputExitCode;
+					}
+				}
+			}
 		}
 		else
 		{
@@ -86,6 +613,11 @@ int main(int argc, char* argv[])
 	{
 		std::cerr << e.what() << std::endl;
 	}
+	catch (kasm::VirtualMachine::Signal signal)
+	{
+		std::cerr << kasm::VirtualMachine::getSignalDescription(signal) << std::endl;
+		exitCode = -1;
+	}
     
 	return exitCode;
 }
@@ -0,0 +1,89 @@
+#include "pipeline.hpp"
+
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace kasm
+{
+    namespace
+    {
+        std::mutex errorMutex;
+
+        void reportError(const std::string& stage, const std::string& message)
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            std::cerr << stage << ": " << message << std::endl;
+        }
+    }
+
+    std::vector<int> Pipeline::run()
+    {
+        std::vector<int> exitCodes(programPaths.size(), -1);
+
+        // Channel i connects stage i - 1 to stage i
+        std::shared_ptr<ChannelTable> channels = std::make_shared<ChannelTable>();
+        for (std::size_t i = 1; i < programPaths.size(); i++)
+        {
+            if (channels->create(channelCapacity, messageSize) != i)
+            {
+                throw std::runtime_error("Failed to create the pipeline channels");
+            }
+        }
+
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < programPaths.size(); i++)
+        {
+            threads.emplace_back([this, i, &channels, &exitCodes]() { exitCodes[i] = runStage(i, channels); });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        return exitCodes;
+    }
+
+    int Pipeline::runStage(std::size_t index, const std::shared_ptr<ChannelTable>& channels)
+    {
+        std::uint32_t input = static_cast<std::uint32_t>(index);
+        std::uint32_t output = index + 1 < programPaths.size() ? static_cast<std::uint32_t>(index + 1) : 0;
+
+        int exitCode = -1;
+        try
+        {
+            VirtualMachine virtualMachine;
+            configure(virtualMachine);
+            virtualMachine.setChannels(channels);
+            virtualMachine.setEntryArguments(input, output);
+            virtualMachine.loadProgram(programPaths[index]);
+            exitCode = virtualMachine.execute();
+
+            if (virtualMachine.getExitReason() != VirtualMachine::ExitReason::NORMAL)
+            {
+                reportError(programPaths[index], VirtualMachine::getExitReasonDescription(virtualMachine.getExitReason()));
+            }
+        }
+        catch (VirtualMachine::Signal signal)
+        {
+            reportError(programPaths[index], VirtualMachine::getSignalDescription(signal));
+        }
+        catch (const std::exception& e)
+        {
+            reportError(programPaths[index], e.what());
+        }
+
+        // Lets the neighbours finish, whichever way this stage ended
+        for (std::uint32_t id : { input, output })
+        {
+            if (Channel* channel = channels->get(id))
+            {
+                channel->close();
+            }
+        }
+
+        return exitCode;
+    }
+}
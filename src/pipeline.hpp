@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "virtualMachine.hpp"
+
+namespace kasm
+{
+	// Runs programs as the stages of a pipeline, each on a thread of its own, connected by channels. Stage i starts
+	// with the id of the channel it receives from in $a0 and of the one it sends to in $a1, 0 at either end of the
+	// pipeline. All stages share the console. A stage that ends closes both of its channels, so the next one sees the
+	// end of its input once it drained it and sends of the previous one fail instead of waiting forever.
+	class Pipeline
+	{
+	public:
+		Pipeline(std::vector<std::string> aProgramPaths, std::function<void(VirtualMachine&)> aConfigure)
+			: programPaths(std::move(aProgramPaths)), configure(std::move(aConfigure)) {}
+
+		void setChannelCapacity(std::uint32_t capacity) { channelCapacity = capacity; }
+		void setMessageSize(std::uint32_t size) { messageSize = size; }
+
+		// Returns the exit code of every stage in order, -1 for stages that could not be run or raised a signal
+		std::vector<int> run();
+
+		static const std::uint32_t DEFAULT_CHANNEL_CAPACITY = 256;
+		static const std::uint32_t DEFAULT_MESSAGE_SIZE = 4096;
+
+	private:
+		int runStage(std::size_t index, const std::shared_ptr<ChannelTable>& channels);
+
+		std::vector<std::string> programPaths;
+		std::function<void(VirtualMachine&)> configure;
+		std::uint32_t channelCapacity = DEFAULT_CHANNEL_CAPACITY;
+		std::uint32_t messageSize = DEFAULT_MESSAGE_SIZE;
+	};
+}
@@ -0,0 +1,155 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace kasm
+{
+    Profiler::Profiler(std::unordered_map<std::uint32_t, std::string> aNames)
+        : names(std::move(aNames))
+    {
+        // The root stands for the entry point
+        nodes.push_back({ 0, 0, 0, {} });
+    }
+
+    void Profiler::call(std::uint32_t target, std::uint32_t returnAddress)
+    {
+        if (stack.size() == MAX_FRAMES)
+        {
+            stack.pop_front();
+        }
+        stack.push_back({ current, returnAddress });
+
+        if (stack.size() > MAX_DEPTH)
+        {
+            return;
+        }
+
+        auto it = nodes[current].children.find(target);
+        if (it != nodes[current].children.end())
+        {
+            current = it->second;
+            return;
+        }
+
+        std::size_t child = nodes.size();
+        nodes[current].children.insert({ target, child });
+        nodes.push_back({ target, current, 0, {} });
+        current = child;
+    }
+
+    void Profiler::jump(std::uint32_t target)
+    {
+        // Only the innermost calls are searched, a jump table should not cost a walk down a deep recursion
+        std::size_t searched = stack.size() < MAX_DEPTH ? stack.size() : MAX_DEPTH;
+        for (std::size_t i = stack.size(); i > stack.size() - searched; i--)
+        {
+            if (stack[i - 1].returnAddress == target)
+            {
+                current = stack[i - 1].caller;
+                stack.erase(stack.begin() + (i - 1), stack.end());
+                return;
+            }
+        }
+    }
+
+    std::string Profiler::getName(std::uint32_t function) const
+    {
+        auto it = names.find(function);
+        if (it != names.end())
+        {
+            return it->second;
+        }
+
+        std::ostringstream name;
+        name << "0x" << std::hex << std::setw(8) << std::setfill('0') << function;
+        return name.str();
+    }
+
+    std::vector<std::uint64_t> Profiler::getTotals() const
+    {
+        std::vector<std::uint64_t> totals(nodes.size());
+        for (std::size_t i = nodes.size(); i-- > 0;)
+        {
+            totals[i] += nodes[i].self;
+            if (i)
+            {
+                totals[nodes[i].parent] += totals[i];
+            }
+        }
+        return totals;
+    }
+
+    void Profiler::writeFolded(std::ostream& out) const
+    {
+        std::vector<std::string> paths(nodes.size());
+        std::vector<std::string> lines;
+        for (std::size_t i = 0; i < nodes.size(); i++)
+        {
+            paths[i] = i ? paths[nodes[i].parent] + ";" + getName(nodes[i].function) : getName(nodes[i].function);
+            if (nodes[i].self)
+            {
+                lines.push_back(paths[i] + " " + std::to_string(nodes[i].self));
+            }
+        }
+
+        std::sort(lines.begin(), lines.end());
+        for (const std::string& line : lines)
+        {
+            out << line << "\n";
+        }
+    }
+
+    void Profiler::writeFlat(std::ostream& out) const
+    {
+        struct Function
+        {
+            std::string name;
+            std::uint64_t self = 0;
+            std::uint64_t total = 0;
+        };
+
+        std::vector<std::uint64_t> totals = getTotals();
+        std::unordered_map<std::uint32_t, Function> functions;
+        for (std::size_t i = 0; i < nodes.size(); i++)
+        {
+            Function& function = functions[nodes[i].function];
+            function.self += nodes[i].self;
+
+            // Recursive calls are already part of the total of the outermost one
+            bool outermost = true;
+            for (std::size_t ancestor = i; ancestor && outermost;)
+            {
+                ancestor = nodes[ancestor].parent;
+                outermost = nodes[ancestor].function != nodes[i].function;
+            }
+            if (outermost)
+            {
+                function.total += totals[i];
+            }
+        }
+
+        std::vector<Function> sorted;
+        for (auto& function : functions)
+        {
+            function.second.name = getName(function.first);
+            sorted.push_back(function.second);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const Function& a, const Function& b)
+        {
+            return a.self != b.self ? a.self > b.self : a.name < b.name;
+        });
+
+        double scale = totals[0] ? 100.0 / totals[0] : 0.0;
+        out << std::setw(14) << "self" << std::setw(9) << "self%" << std::setw(14) << "total" << std::setw(9) << "total%" << "  function\n";
+        for (const Function& function : sorted)
+        {
+            out << std::setw(14) << function.self
+                << std::setw(8) << std::fixed << std::setprecision(2) << function.self * scale << "%"
+                << std::setw(14) << function.total
+                << std::setw(8) << function.total * scale << "%"
+                << "  " << function.name << "\n";
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace kasm
+{
+	// Deterministic call graph profiler. The virtual machine reports every retired instruction, call and return, and
+	// the profiler keeps a shadow call stack to charge each instruction to the path of calls that led to it. Frames
+	// are named after the label at the called address, or the address itself where there is none.
+	class Profiler
+	{
+	public:
+		// names maps locations to labels, see nameLocations
+		explicit Profiler(std::unordered_map<std::uint32_t, std::string> aNames);
+
+		void retire() { nodes[current].self++; }
+		void call(std::uint32_t target, std::uint32_t returnAddress);
+		// A jump to the return address of a pending call returns from it and every call made since, other jumps are
+		// not returns
+		void jump(std::uint32_t target);
+
+		// One line per call path, frames separated by semicolons, followed by the instructions retired in it, the
+		// format flame graph tools take
+		void writeFolded(std::ostream& out) const;
+		// Instructions retired in each function itself and including its callees, busiest first
+		void writeFlat(std::ostream& out) const;
+
+		// Calls nested deeper are charged to the deepest frame tracked
+		static const std::size_t MAX_DEPTH = 1024;
+		// Pending calls remembered, the oldest are forgotten first for programs that call without ever returning
+		static const std::size_t MAX_FRAMES = 1 << 20;
+
+	private:
+		struct Node
+		{
+			std::uint32_t function;
+			std::size_t parent;
+			std::uint64_t self = 0;
+			std::unordered_map<std::uint32_t, std::size_t> children;
+		};
+
+		struct Frame
+		{
+			std::size_t caller;
+			std::uint32_t returnAddress;
+		};
+
+		std::string getName(std::uint32_t function) const;
+		// Instructions retired in every subtree, children always come after their parent
+		std::vector<std::uint64_t> getTotals() const;
+
+		std::unordered_map<std::uint32_t, std::string> names;
+		std::vector<Node> nodes;
+		std::size_t current = 0;
+		std::deque<Frame> stack;
+	};
+}
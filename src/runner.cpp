@@ -0,0 +1,127 @@
+#include "runner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace kasm
+{
+    namespace
+    {
+        std::mutex errorMutex;
+
+        void reportError(const std::string& input, const std::string& message)
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            std::cerr << input << ": " << message << std::endl;
+        }
+
+#if defined(_WIN32)
+        int openInput(const std::string& path) { return _open(path.c_str(), _O_RDONLY | _O_BINARY); }
+        int openOutput(const std::string& path) { return _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE); }
+        void closeFd(int fd) { _close(fd); }
+#else
+        int openInput(const std::string& path) { return ::open(path.c_str(), O_RDONLY | O_CLOEXEC); }
+        int openOutput(const std::string& path) { return ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666); }
+        void closeFd(int fd) { ::close(fd); }
+#endif
+    }
+
+    std::vector<int> Runner::run(const std::vector<std::string>& inputs, unsigned int jobs)
+    {
+        std::vector<int> exitCodes(inputs.size(), -1);
+        std::atomic<std::size_t> next{ 0 };
+
+        auto worker = [&]()
+        {
+            VirtualMachine virtualMachine;
+            configure(virtualMachine);
+
+            for (std::size_t i = next++; i < inputs.size(); i = next++)
+            {
+                exitCodes[i] = runInput(virtualMachine, inputs[i]);
+            }
+        };
+
+        jobs = static_cast<unsigned int>(std::max<std::size_t>(std::min<std::size_t>(jobs, inputs.size()), 1));
+        std::vector<std::thread> threads;
+        for (unsigned int i = 1; i < jobs; i++)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        return exitCodes;
+    }
+
+    int Runner::runInput(VirtualMachine& virtualMachine, const std::string& input)
+    {
+        int inputFd = openInput(input);
+        if (inputFd == -1)
+        {
+            reportError(input, "Failed to open input");
+            return -1;
+        }
+
+        int outputFd = openOutput(input + ".out");
+        if (outputFd == -1)
+        {
+            closeFd(inputFd);
+            reportError(input, "Failed to open output");
+            return -1;
+        }
+
+        int exitCode = -1;
+        Console& console = virtualMachine.getConsole();
+        console.setDescriptors(inputFd, outputFd);
+        try
+        {
+            if (snapshot)
+            {
+                virtualMachine.restore(snapshot);
+                exitCode = virtualMachine.resume();
+            }
+            else
+            {
+                virtualMachine.loadProgram(image);
+                exitCode = virtualMachine.execute();
+            }
+
+            if (virtualMachine.getExitReason() != VirtualMachine::ExitReason::NORMAL)
+            {
+                reportError(input, VirtualMachine::getExitReasonDescription(virtualMachine.getExitReason()));
+            }
+        }
+        catch (VirtualMachine::Signal signal)
+        {
+            reportError(input, VirtualMachine::getSignalDescription(signal));
+        }
+        catch (const std::exception& e)
+        {
+            reportError(input, e.what());
+        }
+
+        // Leaves nothing behind that could still refer to the descriptors of this input
+        console.setDescriptors(0, 1);
+        closeFd(inputFd);
+        closeFd(outputFd);
+
+        return exitCode;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "virtualMachine.hpp"
+
+namespace kasm
+{
+	// Runs one program image over many inputs on a pool of threads. Every thread owns a virtual machine that is reused
+	// from one input to the next, while the image, and with it the decoded text and the segment pages, is shared by
+	// all of them. Each input file becomes the standard input of one run whose output goes to the input path with
+	// ".out" appended. Given a snapshot every run restores it and resumes from there instead of starting over.
+	class Runner
+	{
+	public:
+		Runner(std::shared_ptr<const VirtualMachine::Image> aImage, std::function<void(VirtualMachine&)> aConfigure,
+			std::shared_ptr<const VirtualMachine::Snapshot> aSnapshot = nullptr)
+			: image(std::move(aImage)), configure(std::move(aConfigure)), snapshot(std::move(aSnapshot)) {}
+
+		// Returns the exit code of every input in order, -1 for inputs that could not be run or raised a signal
+		std::vector<int> run(const std::vector<std::string>& inputs, unsigned int jobs);
+
+	private:
+		int runInput(VirtualMachine& virtualMachine, const std::string& input);
+
+		std::shared_ptr<const VirtualMachine::Image> image;
+		std::function<void(VirtualMachine&)> configure;
+		std::shared_ptr<const VirtualMachine::Snapshot> snapshot;
+	};
+}
@@ -0,0 +1,519 @@
+#include "sampler.hpp"
+
+#include "common.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+#if KASM_SAMPLING
+#include <csignal>
+#include <pthread.h>
+#include <sys/time.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+#endif
+
+namespace kasm
+{
+    namespace
+    {
+        // How often the ring is folded into the counts, it holds RING_SIZE samples, seconds of them at any rate
+        const std::chrono::milliseconds DRAIN_INTERVAL(100);
+
+#if KASM_SAMPLING
+        thread_local Sampler::Scope* currentScope = nullptr;
+
+#if !defined(__linux__)
+        // Without per thread timers a single process wide one runs while any thread is sampled
+        std::mutex timerMutex;
+        std::size_t timerUsers = 0;
+#endif
+
+        void setTimerPeriod(struct timespec& period, std::uint32_t frequency)
+        {
+            long nanoseconds = 1000000000L / frequency;
+            period.tv_sec = nanoseconds / 1000000000L;
+            period.tv_nsec = nanoseconds % 1000000000L;
+        }
+#endif
+
+        std::string formatAddress(std::uint32_t address)
+        {
+            std::ostringstream name;
+            name << "0x" << std::hex << std::setw(8) << std::setfill('0') << address;
+            return name.str();
+        }
+
+        // Names addresses after the nearest label at or before them
+        class Symbolizer
+        {
+        public:
+            explicit Symbolizer(const std::unordered_map<std::uint32_t, std::string>& names)
+                : labels(names.begin(), names.end()) {}
+
+            // The address of the label, or the address itself where there is none
+            std::uint32_t getLabel(std::uint32_t address) const
+            {
+                auto it = labels.upper_bound(address);
+                return it == labels.begin() ? address : std::prev(it)->first;
+            }
+
+            std::string getLabelName(std::uint32_t label) const
+            {
+                auto it = labels.find(label);
+                return it == labels.end() ? formatAddress(label) : it->second;
+            }
+
+            std::string getName(std::uint32_t address) const
+            {
+                std::uint32_t label = getLabel(address);
+                if (label == address)
+                {
+                    return getLabelName(label);
+                }
+
+                std::ostringstream name;
+                name << getLabelName(label) << "+0x" << std::hex << address - label;
+                return name.str();
+            }
+
+        private:
+            std::map<std::uint32_t, std::string> labels;
+        };
+
+        // The chain holds return addresses after the pc, they are attributed to the call before them
+        std::uint32_t getCallSite(const std::vector<std::uint32_t>& chain, std::size_t i)
+        {
+            return i ? chain[i] - INSTRUCTION_SIZE : chain[i];
+        }
+
+        void writeVarint(std::string& out, std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                out += static_cast<char>((value & 0x7F) | 0x80);
+                value >>= 7;
+            }
+            out += static_cast<char>(value);
+        }
+
+        void writeInteger(std::string& out, std::uint32_t field, std::uint64_t value)
+        {
+            writeVarint(out, field << 3);
+            writeVarint(out, value);
+        }
+
+        void writeBytes(std::string& out, std::uint32_t field, const std::string& bytes)
+        {
+            writeVarint(out, field << 3 | 2);
+            writeVarint(out, bytes.size());
+            out += bytes;
+        }
+
+        void writePacked(std::string& out, std::uint32_t field, const std::vector<std::uint64_t>& values)
+        {
+            std::string packed;
+            for (std::uint64_t value : values)
+            {
+                writeVarint(packed, value);
+            }
+            writeBytes(out, field, packed);
+        }
+    }
+
+    Sampler::Sampler(std::uint32_t aFrequency)
+        : frequency(aFrequency)
+    {
+#if KASM_SAMPLING
+        if (frequency == 0 || frequency > MAX_FREQUENCY)
+        {
+            throw std::runtime_error("Sampling frequency out of range");
+        }
+
+        static const bool installed = []()
+        {
+            struct sigaction action = {};
+            action.sa_handler = handleSignal;
+            // Interrupted console reads carry on rather than fail
+            action.sa_flags = SA_RESTART;
+            sigemptyset(&action.sa_mask);
+            return sigaction(SIGPROF, &action, nullptr) == 0;
+        }();
+        if (!installed)
+        {
+            throw std::runtime_error("Unable to install sampling signal handler");
+        }
+
+        slots = std::make_unique<Slot[]>(RING_SIZE);
+        for (std::size_t i = 0; i < RING_SIZE; i++)
+        {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+            slots[i].depth = 0;
+        }
+
+        drainThread = std::thread(&Sampler::drainPeriodically, this);
+#else
+        throw std::runtime_error("Sampling is not supported on this platform");
+#endif
+    }
+
+    Sampler::~Sampler()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        stopCondition.notify_all();
+        if (drainThread.joinable())
+        {
+            drainThread.join();
+        }
+    }
+
+    Sampler::Scope::Scope(Sampler& aSampler, const Target& aTarget)
+        : sampler(&aSampler), target(aTarget)
+    {
+#if KASM_SAMPLING
+        previous = currentScope;
+        currentScope = this;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+
+        struct itimerspec period = {};
+        setTimerPeriod(period.it_interval, sampler->frequency);
+        period.it_value = period.it_interval;
+
+#if defined(__linux__)
+        // Counts the CPU time of this thread alone and signals this thread alone
+        struct sigevent event = {};
+        event.sigev_notify = SIGEV_THREAD_ID;
+        event.sigev_signo = SIGPROF;
+        event.sigev_notify_thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+        if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &timer) != 0)
+        {
+            currentScope = previous;
+            throw std::runtime_error("Unable to create sampling timer");
+        }
+        timer_settime(timer, 0, &period, nullptr);
+#else
+        std::lock_guard<std::mutex> lock(timerMutex);
+        if (timerUsers++ == 0)
+        {
+            struct itimerval interval = {};
+            interval.it_interval.tv_sec = period.it_interval.tv_sec;
+            interval.it_interval.tv_usec = period.it_interval.tv_nsec / 1000;
+            interval.it_value = interval.it_interval;
+            setitimer(ITIMER_PROF, &interval, nullptr);
+        }
+#endif
+#else
+        previous = nullptr;
+#endif
+    }
+
+    Sampler::Scope::~Scope()
+    {
+#if KASM_SAMPLING
+#if defined(__linux__)
+        timer_delete(timer);
+#else
+        {
+            std::lock_guard<std::mutex> lock(timerMutex);
+            if (--timerUsers == 0)
+            {
+                struct itimerval interval = {};
+                setitimer(ITIMER_PROF, &interval, nullptr);
+            }
+        }
+#endif
+        // A signal still pending when it is delivered finds no scope, or the outer one
+        currentScope = previous;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    void Sampler::handleSignal(int signal)
+    {
+        (void)signal;
+#if KASM_SAMPLING
+        Scope* scope = currentScope;
+        if (scope != nullptr)
+        {
+            scope->sampler->record(scope->target);
+        }
+#endif
+    }
+
+    void Sampler::record(const Target& target)
+    {
+        std::uint32_t addresses[MAX_CHAIN];
+        std::uint32_t depth = 0;
+        addresses[depth++] = *target.pc;
+
+        auto inStack = [&target](std::uint32_t frame)
+        {
+            return frame % 4 == 0 && frame >= target.stackBegin && std::uint64_t(frame) + 8 <= target.stackEnd;
+        };
+        auto load = [&target](std::uint32_t address)
+        {
+            std::uint32_t value;
+            std::memcpy(&value, target.memory + address, sizeof(value));
+            return value;
+        };
+
+        std::uint32_t frame = target.registers[FP];
+        if (!inStack(frame))
+        {
+            // Code that never entered a frame, only the return address of the innermost call is known
+            addresses[depth++] = target.registers[RA];
+        }
+        // Callers' frames are further up the stack, which also ends a chain that loops
+        for (; depth < MAX_CHAIN && inStack(frame); depth++)
+        {
+            addresses[depth] = load(frame + 4);
+            std::uint32_t callerFrame = load(frame);
+            if (callerFrame <= frame)
+            {
+                depth++;
+                break;
+            }
+            frame = callerFrame;
+        }
+
+        std::uint64_t position = writePosition.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true)
+        {
+            slot = &slots[position & (RING_SIZE - 1)];
+            std::int64_t turn = static_cast<std::int64_t>(slot->sequence.load(std::memory_order_acquire) - position);
+            if (turn == 0)
+            {
+                if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (turn < 0)
+            {
+                // Still full from a lap ago, the drain thread fell behind
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else
+            {
+                position = writePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::memcpy(slot->addresses, addresses, depth * sizeof(addresses[0]));
+        slot->depth = depth;
+        slot->sequence.store(position + 1, std::memory_order_release);
+    }
+
+    void Sampler::drain()
+    {
+        while (true)
+        {
+            Slot& slot = slots[readPosition & (RING_SIZE - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != readPosition + 1)
+            {
+                break;
+            }
+
+            stacks[std::vector<std::uint32_t>(slot.addresses, slot.addresses + slot.depth)]++;
+            sampleCount++;
+            // Hands the slot to the writer one lap ahead
+            slot.sequence.store(readPosition + RING_SIZE, std::memory_order_release);
+            readPosition++;
+        }
+    }
+
+    void Sampler::drainPeriodically()
+    {
+#if KASM_SAMPLING
+        // A process wide timer must not pick this thread, it has nothing to sample
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGPROF);
+        pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+#endif
+
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping)
+        {
+            stopCondition.wait_for(lock, DRAIN_INTERVAL);
+            drain();
+        }
+    }
+
+    void Sampler::writeReport(std::ostream& out, const std::unordered_map<std::uint32_t, std::string>& names)
+    {
+        struct Row
+        {
+            std::string name;
+            std::uint64_t self = 0;
+            std::uint64_t total = 0;
+        };
+
+        std::lock_guard<std::mutex> lock(mutex);
+        drain();
+
+        Symbolizer symbolizer(names);
+        std::unordered_map<std::uint32_t, Row> labels;
+        std::unordered_map<std::uint32_t, Row> instructions;
+        for (const auto& stack : stacks)
+        {
+            const std::vector<std::uint32_t>& chain = stack.first;
+            labels[symbolizer.getLabel(chain[0])].self += stack.second;
+            instructions[chain[0]].self += stack.second;
+
+            // Recursion counts once towards the total of a label
+            std::set<std::uint32_t> seen;
+            for (std::size_t i = 0; i < chain.size(); i++)
+            {
+                std::uint32_t label = symbolizer.getLabel(getCallSite(chain, i));
+                if (seen.insert(label).second)
+                {
+                    labels[label].total += stack.second;
+                }
+            }
+        }
+
+        auto sort = [](std::unordered_map<std::uint32_t, Row>& rows, const auto& getName)
+        {
+            std::vector<Row> sorted;
+            for (auto& row : rows)
+            {
+                row.second.name = getName(row.first);
+                sorted.push_back(row.second);
+            }
+            std::sort(sorted.begin(), sorted.end(), [](const Row& a, const Row& b)
+            {
+                return a.self != b.self ? a.self > b.self : a.name < b.name;
+            });
+            return sorted;
+        };
+
+        out << sampleCount << " samples at " << frequency << " Hz, " << dropped.load(std::memory_order_relaxed) << " dropped\n";
+
+        double scale = sampleCount ? 100.0 / sampleCount : 0.0;
+        out << std::setw(14) << "self" << std::setw(9) << "self%" << std::setw(14) << "total" << std::setw(9) << "total%" << "  label\n";
+        for (const Row& row : sort(labels, [&symbolizer](std::uint32_t label) { return symbolizer.getLabelName(label); }))
+        {
+            out << std::setw(14) << row.self
+                << std::setw(8) << std::fixed << std::setprecision(2) << row.self * scale << "%"
+                << std::setw(14) << row.total
+                << std::setw(8) << row.total * scale << "%"
+                << "  " << row.name << "\n";
+        }
+
+        out << std::setw(14) << "self" << std::setw(9) << "self%" << "  address     instruction\n";
+        for (const Row& row : sort(instructions, [&symbolizer](std::uint32_t address) { return formatAddress(address) + "  " + symbolizer.getName(address); }))
+        {
+            out << std::setw(14) << row.self
+                << std::setw(8) << std::fixed << std::setprecision(2) << row.self * scale << "%"
+                << "  " << row.name << "\n";
+        }
+    }
+
+    void Sampler::writePprof(std::ostream& out, const std::unordered_map<std::uint32_t, std::string>& names)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        drain();
+
+        Symbolizer symbolizer(names);
+        std::string profile;
+
+        std::vector<std::string> strings = { "" };
+        std::unordered_map<std::string, std::uint64_t> stringIds = { { "", 0 } };
+        auto getString = [&strings, &stringIds](const std::string& string)
+        {
+            auto it = stringIds.insert({ string, strings.size() });
+            if (it.second)
+            {
+                strings.push_back(string);
+            }
+            return it.first->second;
+        };
+
+        auto writeValueType = [&profile, &getString](std::uint32_t field, const std::string& type, const std::string& unit)
+        {
+            std::string valueType;
+            writeInteger(valueType, 1, getString(type));
+            writeInteger(valueType, 2, getString(unit));
+            writeBytes(profile, field, valueType);
+        };
+        writeValueType(1, "samples", "count");
+        writeValueType(1, "cpu", "nanoseconds");
+
+        std::uint64_t period = 1000000000ULL / frequency;
+        std::map<std::uint32_t, std::uint64_t> locations; // address -> id
+        std::map<std::uint32_t, std::uint64_t> functions; // label -> id
+        for (const auto& stack : stacks)
+        {
+            std::vector<std::uint64_t> locationIds;
+            for (std::size_t i = 0; i < stack.first.size(); i++)
+            {
+                std::uint32_t address = getCallSite(stack.first, i);
+                auto it = locations.insert({ address, locations.size() + 1 });
+                locationIds.push_back(it.first->second);
+            }
+
+            std::string sample;
+            // The leaf comes first, as in the chain
+            writePacked(sample, 1, locationIds);
+            writePacked(sample, 2, { stack.second, stack.second * period });
+            writeBytes(profile, 2, sample);
+        }
+
+        for (const auto& location : locations)
+        {
+            std::uint32_t label = symbolizer.getLabel(location.first);
+            auto function = functions.insert({ label, functions.size() + 1 });
+
+            std::string line;
+            writeInteger(line, 1, function.first->second);
+            std::string entry;
+            writeInteger(entry, 1, location.second);
+            writeInteger(entry, 3, location.first);
+            writeBytes(entry, 4, line);
+            writeBytes(profile, 4, entry);
+        }
+
+        for (const auto& function : functions)
+        {
+            std::uint64_t name = getString(symbolizer.getLabelName(function.first));
+            std::string entry;
+            writeInteger(entry, 1, function.second);
+            writeInteger(entry, 2, name);
+            writeInteger(entry, 3, name);
+            writeBytes(profile, 5, entry);
+        }
+
+        // Ids of the strings used below are taken before the table is written
+        std::uint64_t cpu = getString("cpu");
+        std::uint64_t nanoseconds = getString("nanoseconds");
+        for (const std::string& string : strings)
+        {
+            writeBytes(profile, 6, string);
+        }
+
+        std::string periodType;
+        writeInteger(periodType, 1, cpu);
+        writeInteger(periodType, 2, nanoseconds);
+        writeBytes(profile, 11, periodType);
+        writeInteger(profile, 12, period);
+
+        out.write(profile.data(), profile.size());
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_WIN32)
+#define KASM_SAMPLING 0
+#else
+#define KASM_SAMPLING 1
+#include <ctime>
+#endif
+
+namespace kasm
+{
+	// Statistical profiler for runs too long to trace every call. A host timer interrupts each sampled thread after
+	// every period of CPU time it used, and the signal handler records the guest pc along with a few return addresses
+	// into a ring buffer. A background thread folds the ring into counts, so nothing in the handler allocates or locks.
+	// Addresses are only named when a report is written.
+	class Sampler
+	{
+	public:
+		// Throws if the platform has no profiling timer. frequency is in samples per second of CPU time.
+		explicit Sampler(std::uint32_t aFrequency);
+		~Sampler();
+
+		Sampler(const Sampler&) = delete;
+		Sampler& operator=(const Sampler&) = delete;
+
+		// Where the handler finds the state of the virtual machine running on the sampled thread. The return chain is
+		// walked from $ra and through the frames enter links by $fp, [$fp] holding the caller's $fp and [$fp + 4]
+		// the return address, as long as they stay within the stack.
+		struct Target
+		{
+			const std::uint32_t* pc;
+			const std::uint32_t* registers;
+			const std::uint8_t* memory;
+			std::uint32_t stackBegin;
+			std::uint32_t stackEnd;
+		};
+
+		// Samples the calling thread while it exists
+		class Scope
+		{
+		public:
+			Scope(Sampler& sampler, const Target& target);
+			~Scope();
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+
+		private:
+			friend class Sampler;
+
+			Sampler* sampler;
+			Target target;
+			Scope* previous;
+#if KASM_SAMPLING && defined(__linux__)
+			timer_t timer;
+#endif
+		};
+
+		// Samples per label, the nearest one at or before each address, and per instruction, busiest first
+		void writeReport(std::ostream& out, const std::unordered_map<std::uint32_t, std::string>& names);
+		// Uncompressed pprof profile.proto, every address a location in the function of its label
+		void writePprof(std::ostream& out, const std::unordered_map<std::uint32_t, std::string>& names);
+
+		std::uint32_t getFrequency() const { return frequency; }
+
+		static const std::uint32_t DEFAULT_FREQUENCY = 100;
+		static const std::uint32_t MAX_FREQUENCY = 10000;
+		static const std::size_t MAX_CHAIN = 8; // pc and return addresses kept per sample
+		static const std::size_t RING_SIZE = 1 << 14; // samples the handler can record between two drains
+
+	private:
+		struct Slot
+		{
+			std::atomic<std::uint64_t> sequence;
+			std::uint32_t depth;
+			std::uint32_t addresses[MAX_CHAIN];
+		};
+
+		static void handleSignal(int signal);
+		// Runs in the signal handler
+		void record(const Target& target);
+		void drain();
+		void drainPeriodically();
+
+		std::uint32_t frequency;
+		std::unique_ptr<Slot[]> slots;
+		alignas(64) std::atomic<std::uint64_t> writePosition{ 0 };
+		alignas(64) std::uint64_t readPosition = 0;
+		std::atomic<std::uint64_t> dropped{ 0 };
+
+		std::mutex mutex;
+		std::map<std::vector<std::uint32_t>, std::uint64_t> stacks; // pc first, counts
+		std::uint64_t sampleCount = 0;
+
+		std::condition_variable stopCondition;
+		bool stopping = false;
+		std::thread drainThread;
+	};
+}
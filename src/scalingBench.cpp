@@ -0,0 +1,336 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "assembler.hpp"
+#include "bench_util.hpp"
+#include "compiler.hpp"
+
+// Measures how the assembler and the compiler scale with the size of their input. Synthetic sources are generated
+// at sizes doubling from one step to the next and every step is timed, along with the exponent relating its time to
+// the previous step's: 1 for linear growth, 2 for quadratic.
+
+#ifndef KASM_DATA_DIR
+#define KASM_DATA_DIR "data"
+#endif
+
+struct Scale
+{
+	std::uint64_t labels = 2000;
+	std::uint64_t macros = 500; // invocations of the macros from std.kasm
+	std::uint64_t includeDepth = 50;
+	std::uint64_t forwardReferences = 1000;
+	std::uint64_t functions = 100; // of the klang program
+
+	Scale operator *(std::uint64_t factor) const
+	{
+		Scale scale = *this;
+		scale.labels *= factor;
+		scale.macros *= factor;
+		scale.includeDepth *= factor;
+		scale.forwardReferences *= factor;
+		scale.functions *= factor;
+		return scale;
+	}
+};
+
+struct Measurement
+{
+	std::uint64_t lines = 0;
+	double medianSeconds = 0;
+	std::uint64_t peakResidentSize = 0;
+};
+
+// Writes lines to a file and counts them
+class SourceWriter
+{
+public:
+	explicit SourceWriter(const std::filesystem::path& path) : file(path) {}
+
+	SourceWriter& operator <<(const std::string& line)
+	{
+		file << line << "\n";
+		lines++;
+		return *this;
+	}
+
+	std::uint64_t getLines() const { return lines; }
+
+private:
+	std::ofstream file;
+	std::uint64_t lines = 0;
+};
+
+static std::uint64_t countLines(const std::filesystem::path& path)
+{
+	std::ifstream file(path);
+	return std::count(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>(), '\n');
+}
+
+// Returns the number of lines assembled, the included files and std.kasm among them
+static std::uint64_t generateAssembly(const std::filesystem::path& directory, const Scale& scale)
+{
+	std::filesystem::path stdPath = std::filesystem::path(KASM_DATA_DIR) / "std.kasm";
+	std::uint64_t lines = countLines(stdPath);
+
+	for (std::uint64_t i = 0; i < scale.includeDepth; i++)
+	{
+		SourceWriter chain(directory / ("chain_" + std::to_string(i) + ".kasm"));
+		chain << "chain_" + std::to_string(i) + ":";
+		chain << "\taddi $t1, $t1, 1";
+		if (i + 1 < scale.includeDepth)
+		{
+			chain << "\t.include \"" + (directory / ("chain_" + std::to_string(i + 1) + ".kasm")).string() + "\"";
+		}
+		lines += chain.getLines();
+	}
+
+	SourceWriter main(directory / "main.kasm");
+	main << "\t.include \"" + stdPath.string() + "\"";
+	main << "\t.data";
+	main << "buffer:";
+	main << "\t.space 16";
+	main << "\t.text";
+	main << "main:";
+
+	// Every label is defined further down, so each of these waits in unresolvedAddressLocations until the end
+	for (std::uint64_t i = 0; i < scale.forwardReferences; i++)
+	{
+		main << (scale.labels ? "\tj label_" + std::to_string(i * 7919 % scale.labels) : std::string("\tj main"));
+	}
+
+	// Macro invocations spread evenly between the labels
+	std::uint64_t macros = 0;
+	auto invokeMacros = [&main, &macros](std::uint64_t until)
+	{
+		for (; macros < until; macros++)
+		{
+			main << (macros % 2 ? "\tREAD_STRING(buffer, 16)" : "\tPRINT_STRING_ADDRESS(buffer)");
+		}
+	};
+	for (std::uint64_t i = 0; i < scale.labels; i++)
+	{
+		main << "label_" + std::to_string(i) + ":";
+		main << "\taddi $t0, $t0, 1";
+		invokeMacros((i + 1) * scale.macros / scale.labels);
+	}
+	invokeMacros(scale.macros);
+
+	if (scale.includeDepth)
+	{
+		main << "\t.include \"" + (directory / "chain_0.kasm").string() + "\"";
+	}
+	main << "\tli $v0, 0";
+	main << "\tli $a0, 0";
+	main << "\tsys";
+
+	return lines + main.getLines();
+}
+
+// Returns the number of lines of the klang program
+static std::uint64_t generateProgram(const std::filesystem::path& directory, const Scale& scale)
+{
+	SourceWriter program(directory / "program.k");
+	program << "entry() : s32";
+	program << "{";
+	program << "\tx : u32 = 0;";
+	for (std::uint64_t i = 0; i < scale.functions; i++)
+	{
+		program << "\tx = f" + std::to_string(i) + "(x);";
+	}
+	program << "\treturn x;";
+	program << "}";
+
+	for (std::uint64_t i = 0; i < scale.functions; i++)
+	{
+		// Odd, as the lexer takes the literal 28 for a type
+		std::string literal = std::to_string(i * 2 + 1);
+		program << "";
+		program << "f" + std::to_string(i) + "(x : u32) : u32";
+		program << "{";
+		program << "\ty : u32 = x + " + literal + ";";
+		program << "\tif (y % 2 == 0 && y <= 65536)";
+		program << "\t{";
+		program << "\t\ty = y + y % 7;";
+		program << "\t}";
+		program << "\treturn y + " + literal + ";";
+		program << "}";
+	}
+
+	return program.getLines();
+}
+
+static Measurement measure(std::uint64_t lines, std::uint64_t repetitions, const std::function<void()>& run)
+{
+	Measurement measurement;
+	measurement.lines = lines;
+
+	kasm::resetPeakResidentSize();
+	std::vector<double> times;
+	for (std::uint64_t i = 0; i < repetitions; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		run();
+		times.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	}
+	measurement.peakResidentSize = kasm::getPeakResidentSize();
+
+	std::sort(times.begin(), times.end());
+	std::size_t middle = times.size() / 2;
+	measurement.medianSeconds = times.size() % 2 ? times[middle] : (times[middle - 1] + times[middle]) / 2;
+	return measurement;
+}
+
+int main(int argc, char* argv[])
+{
+	Scale base;
+	std::uint64_t steps = 4;
+	std::uint64_t repetitions = 3;
+	double maxGrowth = 0;
+	std::string directoryPath;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+		std::string value;
+
+		std::uint64_t* count = nullptr;
+		if (kasm::parseOption(argument, "--labels", value)) count = &base.labels;
+		else if (kasm::parseOption(argument, "--macros", value)) count = &base.macros;
+		else if (kasm::parseOption(argument, "--include-depth", value)) count = &base.includeDepth;
+		else if (kasm::parseOption(argument, "--forward-references", value)) count = &base.forwardReferences;
+		else if (kasm::parseOption(argument, "--functions", value)) count = &base.functions;
+		else if (kasm::parseOption(argument, "--steps", value)) count = &steps;
+		else if (kasm::parseOption(argument, "--repetitions", value)) count = &repetitions;
+
+		if (count)
+		{
+			if (!kasm::parseCount(value, *count))
+			{
+				std::cerr << "Invalid count " << argument << "\n";
+				return -1;
+			}
+		}
+		else if (kasm::parseOption(argument, "--max-growth", value))
+		{
+			try
+			{
+				maxGrowth = std::stod(value);
+			}
+			catch (const std::exception&)
+			{
+				std::cerr << "Invalid growth\n";
+				return -1;
+			}
+		}
+		else if (kasm::parseOption(argument, "--directory", value))
+		{
+			directoryPath = value;
+		}
+		else if (argument == "--help")
+		{
+			std::cout << "Usage: kasm_scaling_bench [--labels=N] [--macros=N] [--include-depth=N] [--forward-references=N] [--functions=N] [--steps=N] [--repetitions=N] [--max-growth=EXPONENT] [--directory=PATH]\n";
+			return 0;
+		}
+		else
+		{
+			std::cerr << "Invalid argument " << argument << "\n";
+			return -1;
+		}
+	}
+
+	if (steps == 0 || repetitions == 0)
+	{
+		std::cerr << "Steps and repetitions must not be 0\n";
+		return -1;
+	}
+
+	try
+	{
+		std::filesystem::path directory = directoryPath.empty() ? std::filesystem::temp_directory_path() / "kasm_scaling_bench" : std::filesystem::path(directoryPath);
+		std::filesystem::create_directories(directory);
+
+		std::cout << std::left << std::setw(8) << "phase" << std::right << std::setw(6) << "step" << std::setw(12) << "lines"
+			<< std::setw(12) << "median ms" << std::setw(14) << "lines/s" << std::setw(12) << "peak RSS K" << std::setw(9) << "growth" << "\n";
+
+		bool passed = true;
+		auto report = [&passed, maxGrowth](const char* phase, std::uint64_t step, const Measurement& measurement, const Measurement* previous)
+		{
+			std::cout << std::left << std::setw(8) << phase << std::right << std::setw(6) << step << std::setw(12) << measurement.lines
+				<< std::fixed << std::setprecision(2) << std::setw(12) << measurement.medianSeconds * 1e3
+				<< std::setprecision(0) << std::setw(14) << (measurement.medianSeconds > 0 ? measurement.lines / measurement.medianSeconds : 0)
+				<< std::setw(12) << measurement.peakResidentSize / 1024;
+			if (previous && previous->medianSeconds > 0 && measurement.lines > previous->lines)
+			{
+				double growth = std::log(measurement.medianSeconds / previous->medianSeconds) / std::log(static_cast<double>(measurement.lines) / previous->lines);
+				bool superlinear = maxGrowth > 0 && growth > maxGrowth;
+				passed = passed && !superlinear;
+				std::cout << std::setprecision(2) << std::setw(9) << growth << (superlinear ? "  superlinear" : "");
+			}
+			std::cout << std::endl;
+		};
+
+		std::vector<Measurement> assembly;
+		std::vector<Measurement> compilation;
+		for (std::uint64_t step = 0; step < steps; step++)
+		{
+			Scale scale = base * (std::uint64_t(1) << step);
+
+			std::uint64_t lines = generateAssembly(directory, scale);
+			std::string asmPath = (directory / "main.kasm").string();
+			std::string programPath = (directory / "main.kexe").string();
+			assembly.push_back(measure(lines, repetitions, [&asmPath, &programPath]()
+			{
+				kasm::Assembler assembler;
+				assembler.assemble(asmPath, programPath);
+			}));
+			report("asm", step + 1, assembly.back(), step ? &assembly[step - 1] : nullptr);
+
+			lines = generateProgram(directory, scale);
+			std::string sourcePath = (directory / "program.k").string();
+			std::string compiledPath = (directory / "program.kasm").string();
+			compilation.push_back(measure(lines, repetitions, [&sourcePath, &compiledPath]()
+			{
+				// The compiler echoes its syntax tree and every line it writes to the standard output
+				std::streambuf* output = std::cout.rdbuf(nullptr);
+				try
+				{
+					kasm::Compiler compiler;
+					compiler.compile(sourcePath, compiledPath);
+				}
+				catch (...)
+				{
+					std::cout.rdbuf(output);
+					throw;
+				}
+				std::cout.rdbuf(output);
+			}));
+			report("klang", step + 1, compilation.back(), step ? &compilation[step - 1] : nullptr);
+		}
+
+		if (directoryPath.empty())
+		{
+			std::filesystem::remove_all(directory);
+		}
+
+		if (!passed)
+		{
+			return 1;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return -1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,308 @@
+#include "scheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <unistd.h>
+#define KASM_EPOLL 1
+#else
+#define KASM_EPOLL 0
+#endif
+
+#if !defined(_WIN32)
+#include <poll.h>
+#endif
+
+namespace kasm
+{
+    namespace
+    {
+        // How long the poller sleeps before looking for new parked instances or shutdown
+        const int POLL_TIMEOUT = 10;
+        const std::size_t POLL_BATCH_SIZE = 256;
+    }
+
+    Scheduler::Scheduler(unsigned int workerCount, std::uint64_t aQuantum)
+        : quantum(aQuantum)
+    {
+        if (!quantum)
+        {
+            quantum = DEFAULT_QUANTUM;
+        }
+#if KASM_EPOLL
+        pollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (pollFd == -1)
+        {
+            throw std::runtime_error("Failed to create epoll instance");
+        }
+#endif
+
+        workerCount = std::max(workerCount, 1U);
+        for (unsigned int i = 0; i < workerCount; i++)
+        {
+            workers.push_back(std::make_unique<Worker>());
+        }
+        for (std::size_t i = 0; i < workers.size(); i++)
+        {
+            workers[i]->thread = std::thread(&Scheduler::work, this, i);
+        }
+        poller = std::thread(&Scheduler::poll, this);
+    }
+
+    Scheduler::~Scheduler()
+    {
+        wait();
+
+        stopping = true;
+        {
+            std::lock_guard<std::mutex> lock(readyMutex);
+            readyCondition.notify_all();
+        }
+        for (auto& worker : workers)
+        {
+            worker->thread.join();
+        }
+        poller.join();
+
+#if KASM_EPOLL
+        close(pollFd);
+#endif
+    }
+
+    void Scheduler::spawn(std::unique_ptr<VirtualMachine> virtualMachine, ExitHandler onExit)
+    {
+        // Started first, so nothing is left behind if that throws
+        virtualMachine->start();
+        Instance* instance = new Instance{ std::move(virtualMachine), std::move(onExit) };
+
+        instanceCount++;
+        push(nextWorker++ % workers.size(), instance);
+    }
+
+    void Scheduler::wait()
+    {
+        std::unique_lock<std::mutex> lock(exitMutex);
+        exitCondition.wait(lock, [this]() { return instanceCount == 0; });
+    }
+
+    void Scheduler::work(std::size_t index)
+    {
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(readyMutex);
+                readyCondition.wait(lock, [this]() { return readyCount > 0 || stopping; });
+                if (stopping)
+                {
+                    return;
+                }
+            }
+
+            Instance* instance = take(index);
+            if (instance != nullptr)
+            {
+                runInstance(index, instance);
+            }
+        }
+    }
+
+    Scheduler::Instance* Scheduler::take(std::size_t index)
+    {
+        Instance* instance = nullptr;
+
+        {
+            Worker& worker = *workers[index];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (!worker.instances.empty())
+            {
+                instance = worker.instances.front();
+                worker.instances.pop_front();
+            }
+        }
+
+        for (std::size_t i = 1; instance == nullptr && i < workers.size(); i++)
+        {
+            Worker& victim = *workers[(index + i) % workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.instances.empty())
+            {
+                instance = victim.instances.back();
+                victim.instances.pop_back();
+            }
+        }
+
+        if (instance != nullptr)
+        {
+            std::lock_guard<std::mutex> lock(readyMutex);
+            readyCount--;
+        }
+
+        return instance;
+    }
+
+    void Scheduler::push(std::size_t index, Instance* instance)
+    {
+        {
+            Worker& worker = *workers[index];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.instances.push_back(instance);
+        }
+
+        std::lock_guard<std::mutex> lock(readyMutex);
+        readyCount++;
+        readyCondition.notify_one();
+    }
+
+    void Scheduler::runInstance(std::size_t index, Instance* instance)
+    {
+        VirtualMachine& virtualMachine = *instance->virtualMachine;
+
+        VirtualMachine::Slice slice;
+        try
+        {
+            slice = virtualMachine.runSlice(quantum);
+        }
+        catch (VirtualMachine::Signal signal)
+        {
+            std::cerr << VirtualMachine::getSignalDescription(signal) << std::endl;
+            finish(instance, -1);
+            return;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+            finish(instance, -1);
+            return;
+        }
+
+        switch (slice)
+        {
+        case VirtualMachine::Slice::PREEMPTED:
+            push(index, instance);
+            break;
+        case VirtualMachine::Slice::BLOCKED:
+            park(instance);
+            break;
+        default:
+            if (virtualMachine.getExitReason() != VirtualMachine::ExitReason::NORMAL)
+            {
+                std::cerr << VirtualMachine::getExitReasonDescription(virtualMachine.getExitReason()) << std::endl;
+            }
+            finish(instance, virtualMachine.getExitCode());
+            break;
+        }
+    }
+
+    void Scheduler::finish(Instance* instance, int exitCode)
+    {
+#if KASM_EPOLL
+        if (instance->watchedFd != -1)
+        {
+            epoll_ctl(pollFd, EPOLL_CTL_DEL, instance->watchedFd, nullptr);
+        }
+#endif
+
+        if (instance->onExit)
+        {
+            instance->onExit(*instance->virtualMachine, exitCode);
+        }
+        delete instance;
+
+        std::lock_guard<std::mutex> lock(exitMutex);
+        if (--instanceCount == 0)
+        {
+            exitCondition.notify_all();
+        }
+    }
+
+    void Scheduler::park(Instance* instance)
+    {
+#if KASM_EPOLL
+        // One shot, so a ready instance is handed back exactly once until it parks again
+        epoll_event event = {};
+        event.events = (instance->virtualMachine->isBlockedOnOutput() ? EPOLLOUT : EPOLLIN | EPOLLRDHUP) | EPOLLONESHOT;
+        event.data.ptr = instance;
+        int fd = instance->virtualMachine->getBlockedFd();
+        if (epoll_ctl(pollFd, instance->watchedFd == fd ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event) == 0)
+        {
+            instance->watchedFd = fd;
+            return;
+        }
+
+        // Not pollable, regular files for one, never block anyway
+        push(nextWorker++ % workers.size(), instance);
+#else
+        std::lock_guard<std::mutex> lock(parkedMutex);
+        parked.push_back(instance);
+#endif
+    }
+
+    void Scheduler::poll()
+    {
+#if KASM_EPOLL
+        epoll_event events[POLL_BATCH_SIZE];
+        while (!stopping)
+        {
+            int count = epoll_wait(pollFd, events, POLL_BATCH_SIZE, POLL_TIMEOUT);
+            for (int i = 0; i < count; i++)
+            {
+                push(nextWorker++ % workers.size(), static_cast<Instance*>(events[i].data.ptr));
+            }
+        }
+#elif !defined(_WIN32)
+        std::vector<Instance*> waiting;
+        std::vector<pollfd> descriptors;
+        while (!stopping)
+        {
+            {
+                std::lock_guard<std::mutex> lock(parkedMutex);
+                waiting.insert(waiting.end(), parked.begin(), parked.end());
+                parked.clear();
+            }
+
+            descriptors.clear();
+            for (Instance* instance : waiting)
+            {
+                descriptors.push_back({ instance->virtualMachine->getBlockedFd(), static_cast<short>(instance->virtualMachine->isBlockedOnOutput() ? POLLOUT : POLLIN), 0 });
+            }
+            if (descriptors.empty())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(POLL_TIMEOUT));
+                continue;
+            }
+            ::poll(descriptors.data(), descriptors.size(), POLL_TIMEOUT);
+
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < waiting.size(); i++)
+            {
+                if (descriptors[i].revents)
+                {
+                    push(nextWorker++ % workers.size(), waiting[i]);
+                }
+                else
+                {
+                    waiting[kept++] = waiting[i];
+                }
+            }
+            waiting.resize(kept);
+        }
+#else
+        // Without a way to wait on descriptors parked instances are simply retried
+        while (!stopping)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(POLL_TIMEOUT));
+            std::lock_guard<std::mutex> lock(parkedMutex);
+            for (Instance* instance : parked)
+            {
+                push(nextWorker++ % workers.size(), instance);
+            }
+            parked.clear();
+        }
+#endif
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "virtualMachine.hpp"
+
+namespace kasm
+{
+	// Multiplexes any number of virtual machines over a fixed pool of worker threads. Each instance runs for a quantum
+	// of instructions at a time. A worker takes instances from the front of its own deque, puts preempted ones back at
+	// the end and, once it runs dry, steals from the back of another worker's deque. Instances blocking on I/O are
+	// parked without holding a thread until their descriptor becomes readable, or writable for output, which a poller
+	// thread watches with epoll, or poll where epoll is not available.
+	class Scheduler
+	{
+	public:
+		// Called on a worker thread once an instance exited, with its exit code or -1 if a signal stopped it
+		typedef std::function<void(VirtualMachine& virtualMachine, int exitCode)> ExitHandler;
+
+		Scheduler(unsigned int workerCount, std::uint64_t aQuantum);
+		// Waits for every spawned instance to exit
+		~Scheduler();
+
+		Scheduler(const Scheduler&) = delete;
+		Scheduler& operator=(const Scheduler&) = delete;
+
+		// Starts a virtual machine whose program is loaded and console descriptors are set. If the input descriptor
+		// is in non-blocking mode the instance is parked while it waits for input, and likewise for output in the
+		// console's non-blocking output mode. Each parked instance needs a descriptor of its own. Safe to call from any thread.
+		void spawn(std::unique_ptr<VirtualMachine> virtualMachine, ExitHandler onExit);
+		// Blocks until every instance spawned so far has exited
+		void wait();
+
+		std::size_t getInstanceCount() const { return instanceCount; }
+
+		static const std::uint64_t DEFAULT_QUANTUM = 100000;
+
+	private:
+		struct Instance
+		{
+			std::unique_ptr<VirtualMachine> virtualMachine;
+			ExitHandler onExit;
+			int watchedFd = -1; // descriptor registered with the poller
+		};
+
+		struct Worker
+		{
+			std::mutex mutex;
+			std::deque<Instance*> instances;
+			std::thread thread;
+		};
+
+		void work(std::size_t index);
+		Instance* take(std::size_t index);
+		void push(std::size_t index, Instance* instance);
+		void runInstance(std::size_t index, Instance* instance);
+		void finish(Instance* instance, int exitCode);
+
+		void park(Instance* instance);
+		void poll();
+
+		std::uint64_t quantum;
+		std::vector<std::unique_ptr<Worker>> workers;
+		std::atomic<std::size_t> nextWorker{ 0 };
+
+		// Counts instances sitting in a deque, idle workers sleep until there is one
+		std::mutex readyMutex;
+		std::condition_variable readyCondition;
+		std::size_t readyCount = 0;
+
+		std::mutex exitMutex;
+		std::condition_variable exitCondition;
+		std::atomic<std::size_t> instanceCount{ 0 };
+
+		std::atomic<bool> stopping{ false };
+		std::thread poller;
+		int pollFd = -1;
+		std::mutex parkedMutex;
+		std::vector<Instance*> parked; // waiting for the poller when epoll is not available
+	};
+}
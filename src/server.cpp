@@ -0,0 +1,155 @@
+#include "server.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace kasm
+{
+#if !defined(_WIN32)
+    namespace
+    {
+        // Milliseconds to wait before accepting again when out of descriptors
+        const int ACCEPT_BACKOFF = 10;
+    }
+
+
+    void Server::serve(const std::string& address)
+    {
+        std::string host = "127.0.0.1";
+        std::string port = address;
+        std::size_t separator = address.rfind(':');
+        if (separator != std::string::npos)
+        {
+            host = address.substr(0, separator);
+            port = address.substr(separator + 1);
+        }
+
+        sockaddr_in socketAddress = {};
+        socketAddress.sin_family = AF_INET;
+        std::size_t end = 0;
+        unsigned long portNumber = 0;
+        try
+        {
+            portNumber = std::stoul(port, &end);
+        }
+        catch (const std::exception&)
+        {
+        }
+        if (port.empty() || end != port.size() || portNumber > UINT16_MAX || inet_pton(AF_INET, host.c_str(), &socketAddress.sin_addr) != 1)
+        {
+            throw std::runtime_error("Invalid server address");
+        }
+        socketAddress.sin_port = htons(static_cast<std::uint16_t>(portNumber));
+
+        int listener = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        int reuse = 1;
+        if (listener == -1
+            || setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse))
+            || bind(listener, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress))
+            || listen(listener, SOMAXCONN))
+        {
+            if (listener != -1)
+            {
+                close(listener);
+            }
+            throw std::runtime_error("Failed to listen on " + address);
+        }
+
+        // Writing to a connection its client closed must fail the write instead of ending the server
+        signal(SIGPIPE, SIG_IGN);
+
+        // Held back for when every other descriptor is used up, to accept and close connections that would otherwise
+        // stay queued and keep accept failing
+        int reserveFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+
+        // Non-blocking, so the accept that drops a connection when out of descriptors cannot wait for the next one
+        fcntl(listener, F_SETFL, fcntl(listener, F_GETFL) | O_NONBLOCK);
+
+        while (true)
+        {
+            pollfd descriptor = { listener, POLLIN, 0 };
+            poll(&descriptor, 1, -1);
+
+            int connection = accept(listener, nullptr, nullptr);
+            if (connection == -1)
+            {
+                if (errno == EINTR || errno == ECONNABORTED || errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    continue;
+                }
+                if (errno == EMFILE || errno == ENFILE)
+                {
+                    if (reserveFd != -1)
+                    {
+                        close(reserveFd);
+                        int rejected = accept(listener, nullptr, nullptr);
+                        if (rejected != -1)
+                        {
+                            close(rejected);
+                        }
+                        reserveFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+                    }
+                    if (reserveFd == -1)
+                    {
+                        // No descriptor to spare, wait for sessions to end instead of spinning
+                        std::this_thread::sleep_for(std::chrono::milliseconds(ACCEPT_BACKOFF));
+                    }
+                    continue;
+                }
+                close(listener);
+                if (reserveFd != -1)
+                {
+                    close(reserveFd);
+                }
+                throw std::runtime_error("Failed to accept connection");
+            }
+
+            fcntl(connection, F_SETFD, FD_CLOEXEC);
+            fcntl(connection, F_SETFL, fcntl(connection, F_GETFL) | O_NONBLOCK);
+
+            // A session that cannot be set up, for lack of memory or mappings say, only costs its own connection
+            try
+            {
+                std::unique_ptr<VirtualMachine> virtualMachine = std::make_unique<VirtualMachine>();
+                configure(*virtualMachine);
+                virtualMachine->loadProgram(image);
+                virtualMachine->getConsole().setDescriptors(connection, connection);
+                virtualMachine->setNonBlockingInput(true);
+                virtualMachine->getConsole().setNonBlockingOutput(true);
+
+                scheduler.spawn(std::move(virtualMachine), [connection](VirtualMachine& virtualMachine, int)
+                {
+                    // Nothing may be left buffered for the descriptor once it is closed
+                    virtualMachine.getConsole().flush();
+                    virtualMachine.getConsole().setDescriptors(0, 1);
+                    close(connection);
+                });
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Failed to start a session: " << e.what() << std::endl;
+                close(connection);
+            }
+        }
+    }
+#else
+    void Server::serve(const std::string& address)
+    {
+        throw std::runtime_error("Serving is not supported on this platform");
+    }
+#endif
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "scheduler.hpp"
+#include "virtualMachine.hpp"
+
+namespace kasm
+{
+	// Runs a fresh instance of a program for every TCP connection, with the connection as its console. Instances are
+	// scheduled on a Scheduler and parked while they wait for input, so idle sessions only cost their memory.
+	class Server
+	{
+	public:
+		Server(Scheduler& aScheduler, std::shared_ptr<const VirtualMachine::Image> aImage, std::function<void(VirtualMachine&)> aConfigure)
+			: scheduler(aScheduler), image(std::move(aImage)), configure(std::move(aConfigure)) {}
+
+		// Listens on "PORT", bound to the loopback interface, or "HOST:PORT" and accepts connections until it fails
+		void serve(const std::string& address);
+
+	private:
+		Scheduler& scheduler;
+		std::shared_ptr<const VirtualMachine::Image> image;
+		std::function<void(VirtualMachine&)> configure;
+	};
+}
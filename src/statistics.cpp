@@ -0,0 +1,124 @@
+#include "statistics.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iterator>
+
+namespace kasm
+{
+    namespace
+    {
+        // In the order of VirtualMachine::Syscall, see the system call table of the README
+        const char* const SYSTEM_CALL_NAMES[] = { "exit", "read_int", "write_int", "read_char", "write_char", "read_string", "write_string", "allocate", "deallocate", "open_file", "close_file", "seek", "read_file", "write_file", "pread", "pwrite", "file_size", "stat", "map_file", "unmap", "snapshot", "thread_spawn", "thread_join", "thread_exit", "chan_create", "chan_send", "chan_recv", "chan_try_recv" };
+
+        const char* const SEGMENT_NAMES[] = { "text", "data", "stack", "global" };
+
+        void writeSegments(std::ostream& out, const std::uint64_t (&counts)[Statistics::SEGMENT_COUNT])
+        {
+            out << "{";
+            for (std::size_t i = 0; i < Statistics::SEGMENT_COUNT; i++)
+            {
+                out << (i ? ", " : "") << "\"" << SEGMENT_NAMES[i] << "\": " << counts[i];
+            }
+            out << "}";
+        }
+    }
+
+    void Statistics::start()
+    {
+        startTime = std::chrono::steady_clock::now();
+        startClock = std::clock();
+    }
+
+    void Statistics::stop()
+    {
+        wallTime = std::chrono::steady_clock::now() - startTime;
+        cpuTime = std::clock() - startClock;
+    }
+
+    void Statistics::merge(const Counters& counters)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t i = 0; i < OPCODE_COUNT; i++)
+        {
+            total.opcodes[i] += counters.opcodes[i];
+        }
+        total.branchesTaken += counters.branchesTaken;
+        total.branchesNotTaken += counters.branchesNotTaken;
+        for (std::size_t i = 0; i < SEGMENT_COUNT; i++)
+        {
+            total.loads[i] += counters.loads[i];
+            total.stores[i] += counters.stores[i];
+        }
+        for (std::size_t i = 0; i < SYSTEM_CALL_COUNT; i++)
+        {
+            total.systemCalls[i] += counters.systemCalls[i];
+            total.systemCallTimes[i] += counters.systemCallTimes[i];
+        }
+        total.peakHeapSize = std::max(total.peakHeapSize, counters.peakHeapSize);
+        threads++;
+    }
+
+    void Statistics::writeJson(std::ostream& out)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        std::uint64_t instructions = 0;
+        for (std::uint64_t count : total.opcodes)
+        {
+            instructions += count;
+        }
+        double wallSeconds = std::chrono::duration<double>(wallTime).count();
+        double cpuSeconds = static_cast<double>(cpuTime) / CLOCKS_PER_SEC;
+
+        out << std::fixed << std::setprecision(6);
+        out << "{\n";
+        // Counting always runs the switch engine, see VirtualMachine::runCounted
+        out << "  \"engine\": \"switch\",\n";
+        out << "  \"instructions\": " << instructions << ",\n";
+        out << "  \"threads\": " << threads << ",\n";
+        out << "  \"wall_seconds\": " << wallSeconds << ",\n";
+        out << "  \"cpu_seconds\": " << cpuSeconds << ",\n";
+        out << "  \"mips\": " << (wallSeconds > 0 ? instructions / wallSeconds / 1e6 : 0.0) << ",\n";
+        out << "  \"peak_heap_bytes\": " << total.peakHeapSize << ",\n";
+        out << "  \"branches\": {\"taken\": " << total.branchesTaken << ", \"not_taken\": " << total.branchesNotTaken << "},\n";
+        out << "  \"loads\": ";
+        writeSegments(out, total.loads);
+        out << ",\n  \"stores\": ";
+        writeSegments(out, total.stores);
+
+        out << ",\n  \"opcodes\": {";
+        const char* separator = "";
+        for (std::size_t i = 0; i < OPCODE_COUNT; i++)
+        {
+            if (total.opcodes[i])
+            {
+                out << separator << "\n    \"" << (i < std::size(OPCODE_NAMES) ? OPCODE_NAMES[i] : "unknown") << "\": " << total.opcodes[i];
+                separator = ",";
+            }
+        }
+        out << (*separator ? "\n  }" : "}");
+
+        out << ",\n  \"system_calls\": {";
+        separator = "";
+        for (std::size_t i = 0; i < SYSTEM_CALL_COUNT; i++)
+        {
+            if (total.systemCalls[i])
+            {
+                out << separator << "\n    \"";
+                if (i < std::size(SYSTEM_CALL_NAMES))
+                {
+                    out << SYSTEM_CALL_NAMES[i];
+                }
+                else
+                {
+                    out << i;
+                }
+                out << "\": {\"count\": " << total.systemCalls[i] << ", \"seconds\": " << std::chrono::duration<double>(total.systemCallTimes[i]).count() << "}";
+                separator = ",";
+            }
+        }
+        out << (*separator ? "\n  }" : "}");
+        out << "\n}\n";
+    }
+}
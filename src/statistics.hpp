@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <ostream>
+
+#include "common.hpp"
+
+namespace kasm
+{
+	// Execution statistics of a process. Every thread counts into Counters of its own while it runs and merges them
+	// here once it stops, so threads never contend on a counter.
+	class Statistics
+	{
+	public:
+		enum Segment
+		{
+			TEXT,
+			DATA, // the data segment, the heap and file mappings
+			STACK,
+			GLOBAL,
+			SEGMENT_COUNT
+		};
+
+		static const std::size_t OPCODE_COUNT = 1 << OPCODE_BIT;
+		static const std::size_t SYSTEM_CALL_COUNT = 256;
+
+		struct Counters
+		{
+			std::uint64_t opcodes[OPCODE_COUNT] = {};
+			std::uint64_t branchesTaken = 0;
+			std::uint64_t branchesNotTaken = 0;
+			std::uint64_t loads[SEGMENT_COUNT] = {};
+			std::uint64_t stores[SEGMENT_COUNT] = {};
+			std::uint64_t systemCalls[SYSTEM_CALL_COUNT] = {};
+			std::chrono::nanoseconds systemCallTimes[SYSTEM_CALL_COUNT] = {};
+			std::uint64_t peakHeapSize = 0;
+		};
+
+		// Wall and CPU time are taken from here to stop
+		void start();
+		void stop();
+
+		void merge(const Counters& counters);
+
+		// A single JSON object, opcodes and system calls that never ran are left out
+		void writeJson(std::ostream& out);
+
+	private:
+		std::mutex mutex;
+		Counters total;
+		std::uint64_t threads = 0;
+
+		std::chrono::steady_clock::time_point startTime;
+		std::chrono::steady_clock::duration wallTime{};
+		std::clock_t startClock = 0;
+		std::clock_t cpuTime = 0;
+	};
+}
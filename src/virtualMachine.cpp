@@ -1,15 +1,45 @@
 #include "virtualMachine.hpp"
 
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
 #include <exception>
 #include <stdexcept>
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <unordered_map>
 
 namespace kasm
 {
+    namespace
+    {
+        std::uint32_t decimalLength(std::uint32_t value)
+        {
+            std::uint32_t length = 1;
+            while (value >= 10)
+            {
+                value /= 10;
+                length++;
+            }
+            return length;
+        }
+    }
+
+    VirtualMachine::VirtualMachine()
+        : VirtualMachine(std::make_shared<Process>())
+    {
+    }
+
+    VirtualMachine::VirtualMachine(std::shared_ptr<Process> aProcess)
+        : process(std::move(aProcess)), program(process->program), heap(process->heap), console(process->console),
+          files(process->files), mappings(process->mappings), image(process->image), decodedText(process->decodedText),
+          outputSize(process->outputSize), executedText(process->decodedText),
+          executedTextGeneration(process->textGeneration)
+    {
+    }
+
     void VirtualMachine::advancePc()
     {
         pc += INSTRUCTION_SIZE;
@@ -24,26 +54,476 @@ namespace kasm
         return exitCode;
     }
 
-    InstructionData VirtualMachine::fetchInstruction()
+    void VirtualMachine::start()
     {
-        std::uint32_t instruction = program.getWord(pc);
-        InstructionData instructionData = { instruction };
-        return instructionData;
+        reset();
+    }
+
+    VirtualMachine::Slice VirtualMachine::runSlice(std::uint64_t quantum)
+    {
+        if (blockedOnOutput)
+        {
+            console.flush();
+            if (console.isOutputBlocked())
+            {
+                return Slice::BLOCKED;
+            }
+            blockedOnOutput = false;
+            if (draining)
+            {
+                draining = false;
+                return Slice::EXITED;
+            }
+        }
+
+        slicing = true;
+        holdBackInstructions(static_cast<std::int64_t>(std::min<std::uint64_t>(quantum, std::numeric_limits<std::int64_t>::max())));
+        preempted = false;
+        blockedFd = -1;
+        shouldExit = false;
+
+        try
+        {
+            run();
+        }
+        catch (...)
+        {
+            remainingInstructions += sliceReserve;
+            sliceReserve = 0;
+            slicing = false;
+            throw;
+        }
+        remainingInstructions += sliceReserve;
+        sliceReserve = 0;
+        slicing = false;
+
+        if (preempted || blockedFd != -1)
+        {
+            shouldExit = false;
+            return preempted ? Slice::PREEMPTED : Slice::BLOCKED;
+        }
+        if (console.isOutputBlocked())
+        {
+            waitForOutput();
+            draining = true;
+            return Slice::BLOCKED;
+        }
+        return Slice::EXITED;
+    }
+
+    VirtualMachine::DecodedInstruction VirtualMachine::decodeInstruction(const InstructionData& instructionData, std::uint32_t location)
+    {
+        DecodedInstruction instruction;
+        instruction.opcode = instructionData.opcode;
+        instruction.handler = instructionData.opcode;
+        instruction.register0 = instructionData.register0;
+        instruction.register1 = instructionData.register1;
+        instruction.register2 = instructionData.register2;
+        instruction.immediate = instructionData.immediate;
+        instruction.signedImmediate = static_cast<std::int16_t>(instructionData.immediate);
+        instruction.address = 0;
+
+        switch (instructionData.opcode)
+        {
+        case BEQ:
+        case BGEZ:
+        case BGEZAL:
+        case BGTZ:
+        case BLEZ:
+        case BLTZ:
+        case BLTZAL:
+        case BNE:
+            instruction.address = instructionData.directAddressOffset + location;
+            break;
+        case J:
+        case JAL:
+            instruction.address = instructionData.directAddressAbsolute;
+            break;
+        case LB:
+        case LW:
+        case SB:
+        case SW:
+            instruction.address = instructionData.directAddressOffset + location;
+            break;
+        default:
+            break;
+        }
+
+        return instruction;
+    }
+
+    void VirtualMachine::fuseInstructions(DecodedText& decoded, std::uint32_t first, std::uint32_t last)
+    {
+        static const struct
+        {
+            InternalOpcode handler;
+            std::uint32_t length;
+            std::uint8_t opcodes[MAX_FUSED_LENGTH];
+        } superinstructions[] =
+        {
+            // Longest sequences first so they win over the pairs they contain
+            { FUSED_RET, 6, { OR, LW, ADDI, LW, ADDI, JR } },
+            { FUSED_ENTER, 5, { ADDI, SW, ADDI, SW, OR } },
+            { FUSED_LUI_ORI, 2, { LUI, ORI } },
+            { FUSED_ADDI_SW, 2, { ADDI, SW } },
+            { FUSED_ADDI_SB, 2, { ADDI, SB } },
+            { FUSED_LW_ADDI, 2, { LW, ADDI } },
+            { FUSED_LB_ADDI, 2, { LB, ADDI } },
+            { FUSED_SW_ADDI, 2, { SW, ADDI } },
+            { FUSED_ADDI_LW, 2, { ADDI, LW } },
+        };
+
+        // The sentinel is never part of a sequence, so matching stops at the end of the text segment
+        std::uint32_t instructionCount = static_cast<std::uint32_t>(decoded.size()) - 1;
+        for (std::uint32_t i = first; i < last && i < instructionCount; i++)
+        {
+            decoded[i].handler = decoded[i].opcode;
+            for (const auto& superinstruction : superinstructions)
+            {
+                if (i + superinstruction.length > instructionCount)
+                {
+                    continue;
+                }
+
+                bool match = true;
+                for (std::uint32_t j = 0; j < superinstruction.length && match; j++)
+                {
+                    match = decoded[i + j].opcode == superinstruction.opcodes[j];
+                }
+
+                if (match)
+                {
+                    decoded[i].handler = superinstruction.handler;
+                    break;
+                }
+            }
+        }
+    }
+
+    void VirtualMachine::invalidateInstruction(std::uint32_t address, std::uint32_t size)
+    {
+        std::unique_lock<std::recursive_mutex> lock = lockProcess();
+        // Until the first write the decoded text is shared with the image and every other instance running it, besides
+        // the process and this virtual machine. Once the process is threaded, other threads may be running the current
+        // copy, a new one is published that they pick up at their next control transfer.
+        if (process->threaded || decodedText.use_count() > 2)
+        {
+            decodedText = std::make_shared<DecodedText>(*decodedText);
+        }
+
+        DecodedText& decoded = *decodedText;
+        std::uint32_t first = address / INSTRUCTION_SIZE;
+        std::uint32_t last = (address + size - 1) / INSTRUCTION_SIZE;
+        for (std::uint32_t i = first; i <= last && i + 1 < decoded.size(); i++)
+        {
+            std::uint32_t location = i * INSTRUCTION_SIZE;
+            decoded[i] = decodeInstruction({ program.getWord(location) }, location);
+        }
+
+        // Any superinstruction overlapping the rewritten words has to be matched again
+        fuseInstructions(decoded, first < MAX_FUSED_LENGTH - 1 ? 0 : first - (MAX_FUSED_LENGTH - 1), last + 1);
+
+        // Compiled code may still be running, the JIT of every thread is flushed the next time control returns to
+        // its interpreter
+        process->textGeneration++;
+        if (!process->threaded)
+        {
+            refreshText();
+        }
+    }
+
+    void VirtualMachine::refreshText()
+    {
+        std::unique_lock<std::recursive_mutex> lock = lockProcess();
+        executedText = decodedText;
+        executedTextGeneration = process->textGeneration.load(std::memory_order_relaxed);
+    }
+
+    const VirtualMachine::DecodedInstruction& VirtualMachine::fetchInstruction()
+    {
+        if (process->textGeneration.load(std::memory_order_relaxed) != executedTextGeneration)
+        {
+            refreshText();
+        }
+        if (pc % INSTRUCTION_SIZE == 0 && pc < program.getTextSegmentLength())
+        {
+            return (*executedText)[pc / INSTRUCTION_SIZE];
+        }
+
+        unalignedInstruction = decodeInstruction({ program.getWord(pc) }, pc);
+        return unalignedInstruction;
     }
 
     void VirtualMachine::step()
     {
-        InstructionData instructionData = fetchInstruction();
-        executeInstruction(instructionData);
+        executeInstruction(fetchInstruction());
     }
 
     void VirtualMachine::run()
     {
+        try
+        {
+            runGuarded(&VirtualMachine::runEngine);
+        }
+        catch (...)
+        {
+            stopProcess(std::current_exception());
+            endThreads();
+            throw;
+        }
+
+        if (!preempted && blockedFd == -1)
+        {
+            endThreads();
+        }
+    }
+
+    // Guest memory accesses are not bounds checked by the engines. Touching an uncommitted page faults in the host and
+    // the fault handler jumps back here with pc still on the faulting instruction, which the engines guarantee by
+    // materializing pc before every memory access. No frame between here and the faulting access owns anything that
+    // needs destroying. In particular nothing holding lockProcess() touches guest memory the getGuestBuffer family has
+    // not checked under that same lock, a fault there would leave the process mutex locked for good.
+    void VirtualMachine::runGuarded(void (VirtualMachine::*body)())
+    {
+        std::unique_ptr<Sampler::Scope> sampling;
+        if (sampler)
+        {
+            sampling = std::make_unique<Sampler::Scope>(*sampler, Sampler::Target{ &pc, &registers[0], program.getMemory().base(), stackGuard + STACK_GUARD_SIZE, stackEnd });
+        }
+
+#if KASM_GUEST_FAULTS
+        sigjmp_buf faultJump;
+        GuestMemory::FaultScope faultScope(program.getMemory(), faultJump);
+        if (sigsetjmp(faultJump, 1))
+        {
+            if (jit)
+            {
+                jit->recoverFault(pc);
+            }
+
+            {
+                std::unique_lock<std::recursive_mutex> lock = lockProcess();
+                console.flush();
+            }
+
+            std::uint32_t faultAddress = GuestMemory::FaultScope::getFaultAddress();
+            if (faultAddress >= stackGuard && faultAddress - stackGuard < STACK_GUARD_SIZE)
+            {
+                executeSignal(Signal::STACK_OVERFLOW);
+            }
+            else
+            {
+                executeSignal(Signal::SEGMENTATION_FAULT);
+            }
+
+            if (counters)
+            {
+                statistics->merge(*counters);
+                counters.reset();
+            }
+            return;
+        }
+#endif
+
+        (this->*body)();
+
+        if (counters)
+        {
+            statistics->merge(*counters);
+            counters.reset();
+        }
+
+        std::unique_lock<std::recursive_mutex> lock = lockProcess();
+        console.flush();
+    }
+
+    void VirtualMachine::runEngine()
+    {
+        if (profiler)
+        {
+            runProfiled();
+            return;
+        }
+        if (statistics)
+        {
+            runCounted();
+            return;
+        }
+
+        switch (engine)
+        {
+        case Engine::THREADED:
+            runThreaded();
+            break;
+        default:
+            runSwitch();
+            break;
+        }
+    }
+
+    void VirtualMachine::runSwitch()
+    {
+        // Loaded once rather than through the process aliases for every instruction, see fetchInstruction
+        const std::uint32_t textSegmentLength = program.getTextSegmentLength();
+        const std::shared_ptr<DecodedText>* const text = &executedText;
+        const std::atomic<std::uint32_t>& textGeneration = process->textGeneration;
+
+        while (pc < textSegmentLength && !shouldExit)
+        {
+            if (remainingInstructions <= 0)
+            {
+                instructionsExhausted();
+                continue;
+            }
+            remainingInstructions--;
+            if (textGeneration.load(std::memory_order_relaxed) != executedTextGeneration)
+            {
+                refreshText();
+            }
+            executeInstruction(pc % INSTRUCTION_SIZE == 0 ? (**text)[pc / INSTRUCTION_SIZE] : fetchInstruction());
+        }
+    }
+
+    void VirtualMachine::runProfiled()
+    {
+        while (pc < program.getTextSegmentLength() && !shouldExit)
+        {
+            if (remainingInstructions <= 0)
+            {
+                instructionsExhausted();
+                continue;
+            }
+            remainingInstructions--;
+
+            // A copy, a store may rewrite the decoded text underneath
+            DecodedInstruction d = fetchInstruction();
+            std::uint32_t location = pc;
+            profiler->retire();
+            bool linked = (d.opcode == BGEZAL || d.opcode == BLTZAL) && isBranchTaken(d);
+            executeInstruction(d);
+
+            switch (d.opcode)
+            {
+            case JAL:
+            case JALR:
+                profiler->call(pc, location + INSTRUCTION_SIZE);
+                break;
+            case BGEZAL:
+            case BLTZAL:
+                if (linked)
+                {
+                    profiler->call(pc, location + (d.opcode == BLTZAL ? 2 : 1) * INSTRUCTION_SIZE);
+                }
+                break;
+            case JR:
+                profiler->jump(pc);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    void VirtualMachine::runCounted()
+    {
+        if (!counters)
+        {
+            counters = std::make_unique<Statistics::Counters>();
+        }
+        Statistics::Counters& c = *counters;
+
         while (pc < program.getTextSegmentLength() && !shouldExit)
         {
-            InstructionData instructionData = fetchInstruction();
-            executeInstruction(instructionData);
+            if (remainingInstructions <= 0)
+            {
+                instructionsExhausted();
+                continue;
+            }
+            remainingInstructions--;
+
+            // A copy, a store may rewrite the decoded text underneath
+            DecodedInstruction d = fetchInstruction();
+
+            switch (d.opcode)
+            {
+            case BEQ:
+            case BGEZ:
+            case BGEZAL:
+            case BGTZ:
+            case BLEZ:
+            case BLTZ:
+            case BLTZAL:
+            case BNE:
+                // Decided from the condition rather than where pc ends up, a bltzal that is not taken skips two
+                // instructions
+                if (isBranchTaken(d))
+                {
+                    c.branchesTaken++;
+                }
+                else
+                {
+                    c.branchesNotTaken++;
+                }
+                executeInstruction(d);
+                break;
+            case LB:
+            case LW:
+                c.loads[getSegment(registers[d.register1] + d.address)]++;
+                executeInstruction(d);
+                break;
+            case SB:
+            case SW:
+                c.stores[getSegment(registers[d.register1] + d.address)]++;
+                executeInstruction(d);
+                break;
+            case CAS:
+            case AMOADD:
+            case AMOSWAP:
+                c.loads[getSegment(registers[d.register1])]++;
+                c.stores[getSegment(registers[d.register1])]++;
+                executeInstruction(d);
+                break;
+            case SYS:
+            {
+                std::uint8_t number = static_cast<std::uint8_t>(registers[V0]);
+                auto start = std::chrono::steady_clock::now();
+                executeInstruction(d);
+                c.systemCallTimes[number] += std::chrono::steady_clock::now() - start;
+                c.systemCalls[number]++;
+                if (number == ALLOCATE)
+                {
+                    std::unique_lock<std::recursive_mutex> lock = lockProcess();
+                    c.peakHeapSize = std::max(c.peakHeapSize, heap.getAllocatedSize());
+                }
+            }
+                break;
+            default:
+                executeInstruction(d);
+                break;
+            }
+
+            if (d.opcode < Statistics::OPCODE_COUNT)
+            {
+                c.opcodes[d.opcode]++;
+            }
+        }
+    }
+
+    Statistics::Segment VirtualMachine::getSegment(std::uint32_t address) const
+    {
+        if (address < program.getTextSegmentLength())
+        {
+            return Statistics::TEXT;
+        }
+        if (address >= GLOBAL_OFFSET)
+        {
+            return Statistics::GLOBAL;
+        }
+        if (address >= stackGuard && address < stackEnd)
+        {
+            return Statistics::STACK;
         }
+        return Statistics::DATA;
     }
 
     void VirtualMachine::reset()
@@ -51,13 +531,46 @@ namespace kasm
         pc = 0;
         shouldExit = false;
         exitCode = 0;
+        waitForThreads = false;
+        blockedOnOutput = false;
+        draining = false;
 
         registers.clear();
-        registers[SP] = STACK_OFFSET + STACK_SIZE;
+        registers[SP] = STACK_OFFSET + program.getStackSize();
+        stackEnd = registers[SP];
         registers[GP] = GLOBAL_OFFSET;
+        registers[A0] = entryArguments[0];
+        registers[A1] = entryArguments[1];
+
+        resetLimits();
+        unmapAll();
+        heap.reset(DATA_SEGMENT_OFFSET + program.getDataSegmentLength(), STACK_OFFSET - STACK_GUARD_SIZE);
+    }
+
+    bool VirtualMachine::isBranchTaken(const DecodedInstruction& d)
+    {
+        switch (d.opcode)
+        {
+        case BEQ:
+            return registers[d.register0] == registers[d.register1];
+        case BNE:
+            return registers[d.register0] != registers[d.register1];
+        case BGEZ:
+        case BGEZAL:
+            return static_cast<std::int32_t>(registers[d.register0]) >= 0;
+        case BGTZ:
+            return static_cast<std::int32_t>(registers[d.register0]) > 0;
+        case BLEZ:
+            return static_cast<std::int32_t>(registers[d.register0]) <= 0;
+        case BLTZ:
+        case BLTZAL:
+            return static_cast<std::int32_t>(registers[d.register0]) < 0;
+        default:
+            return false;
+        }
     }
 
-    void VirtualMachine::executeInstruction(const InstructionData& d)
+    void VirtualMachine::executeInstruction(const DecodedInstruction& d)
     {
         switch (d.opcode)
         {
@@ -66,16 +579,9 @@ namespace kasm
             advancePc();
             break;
         case ADDI:
-        {
-            std::uint32_t unsignedImmediate = 0x0000FFFF & d.immediate;
-            std::uint32_t mask = 0x00008000;
-            if (mask & unsignedImmediate) unsignedImmediate |= 0xFFFF0000;
-            std::int32_t signedImmediate = unsignedImmediate;
-            std::int32_t signedSum = reinterpret_cast<std::int32_t&>(registers[d.register1]) + signedImmediate;
-            registers[d.register0] = reinterpret_cast<std::uint32_t&>(signedSum);
+            registers[d.register0] = registers[d.register1] + static_cast<std::uint32_t>(d.signedImmediate);
             advancePc();
-        }
-        break;
+            break;
         case ADDIU:
             registers[d.register0] = registers[d.register1] + d.immediate;
             advancePc();
@@ -93,16 +599,16 @@ namespace kasm
             advancePc();
             break;
         case BEQ:
-            if (registers[d.register0] == registers[d.register1]) pc = resolveAddress(d, AddressType::DirectAddressOffset); else advancePc();
+            if (registers[d.register0] == registers[d.register1]) pc = d.address; else advancePc();
             break;
         case BGEZ:
-            if (registers[d.register0] >= 0) pc = resolveAddress(d, AddressType::DirectAddressOffset); else advancePc();
+            if (static_cast<std::int32_t>(registers[d.register0]) >= 0) pc = d.address; else advancePc();
             break;
         case BGEZAL:
-            if (registers[d.register0] >= 0)
+            if (static_cast<std::int32_t>(registers[d.register0]) >= 0)
             {
                 registers[RA] = pc + INSTRUCTION_SIZE;
-                pc = resolveAddress(d, AddressType::DirectAddressOffset);
+                pc = d.address;
             }
             else
             {
@@ -110,20 +616,20 @@ namespace kasm
             }
             break;
         case BGTZ:
-            if (registers[d.register0] > 0) pc = resolveAddress(d, AddressType::DirectAddressOffset); else advancePc();
+            if (static_cast<std::int32_t>(registers[d.register0]) > 0) pc = d.address; else advancePc();
             break;
         case BLEZ:
-            if (registers[d.register0] <= 0) pc = resolveAddress(d, AddressType::DirectAddressOffset); else advancePc();
+            if (static_cast<std::int32_t>(registers[d.register0]) <= 0) pc = d.address; else advancePc();
             break;
         case BLTZ:
-            if (registers[d.register0] < 0) pc = resolveAddress(d, AddressType::DirectAddressOffset); else advancePc();
+            if (static_cast<std::int32_t>(registers[d.register0]) < 0) pc = d.address; else advancePc();
             break;
         case BLTZAL:
             advancePc();
-            if (registers[d.register0] < 0)
+            if (static_cast<std::int32_t>(registers[d.register0]) < 0)
             {
                 registers[RA] = pc + INSTRUCTION_SIZE;
-                pc = resolveAddress(d, AddressType::DirectAddressOffset);
+                pc = d.address;
             }
             else
             {
@@ -131,7 +637,7 @@ namespace kasm
             }
             break;
         case BNE:
-            if (registers[d.register0] != registers[d.register1]) pc = resolveAddress(d, AddressType::DirectAddressOffset); else advancePc();
+            if (registers[d.register0] != registers[d.register1]) pc = d.address; else advancePc();
             break;
         case DIV:
             lo = registers[d.register0] / registers[d.register1];
@@ -144,25 +650,25 @@ namespace kasm
             advancePc();
             break;
         case J:
-            pc = resolveAddress(d, AddressType::DirectAddressAbsolute);
+            pc = d.address;
             break;
         case JAL:
             registers[RA] = pc + INSTRUCTION_SIZE;
-            pc = resolveAddress(d, AddressType::DirectAddressAbsolute);
+            pc = d.address;
             break;
         case JR:
             pc = registers[d.register0];
             break;
         case LB:
-            registers[d.register0] = program[resolveAddress(d, AddressType::IndirectAddressOffset)];
+            registers[d.register0] = program[registers[d.register1] + d.address];
             advancePc();
             break;
         case LUI:
-            registers[d.register0] = d.immediate << (INSTRUCTION_BIT / 2);
+            registers[d.register0] = static_cast<std::uint32_t>(d.immediate) << (INSTRUCTION_BIT / 2);
             advancePc();
             break;
         case LW:
-            registers[d.register0] = program.getWord(resolveAddress(d, AddressType::IndirectAddressOffset));
+            registers[d.register0] = program.getWord(registers[d.register1] + d.address);
             advancePc();
             break;
         case MFHI:
@@ -198,8 +704,12 @@ namespace kasm
             advancePc();
             break;
         case SB:
-            program[resolveAddress(d, AddressType::IndirectAddressOffset)] = registers[d.register0];
+        {
+            std::uint32_t address = registers[d.register1] + d.address;
+            program[address] = registers[d.register0];
+            if (address < program.getTextSegmentLength()) invalidateInstruction(address, 1);
             advancePc();
+        }
             break;
         case SLL:
             registers[d.register0] = registers[d.register1] << d.immediate;
@@ -254,8 +764,12 @@ namespace kasm
             advancePc();
             break;
         case SW:
-            program.getWord(resolveAddress(d, AddressType::IndirectAddressOffset)) = registers[d.register0];
+        {
+            std::uint32_t address = registers[d.register1] + d.address;
+            program.getWord(address) = registers[d.register0];
+            if (address < program.getTextSegmentLength()) invalidateInstruction(address, INSTRUCTION_SIZE);
             advancePc();
+        }
             break;
         case SYS:
             systemCall();
@@ -277,15 +791,56 @@ namespace kasm
             registers[d.register0] = ~(registers[d.register1] | registers[d.register2]);
             advancePc();
             break;
+        case CAS:
+        case AMOADD:
+        case AMOSWAP:
+            if (executeAtomic(d)) advancePc();
+            break;
+        case SYNC:
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            advancePc();
+            break;
         default:
             executeSignal(Signal::ILLEGAL_OPCODE);
             break;
         }
     }
 
+    bool VirtualMachine::executeAtomic(const DecodedInstruction& d)
+    {
+        std::uint32_t address = registers[d.register1];
+        if (address % INSTRUCTION_SIZE)
+        {
+            executeSignal(Signal::SEGMENTATION_FAULT);
+            return false;
+        }
+
+        // Sequentially consistent, so guest code needs no fences around them
+        std::atomic<std::uint32_t>& word = program.getAtomicWord(address);
+        std::uint32_t value;
+        switch (d.opcode)
+        {
+        case CAS:
+            // Left holding the old value whether or not the exchange happened
+            value = registers[d.register0];
+            word.compare_exchange_strong(value, registers[d.register2]);
+            break;
+        case AMOADD:
+            value = word.fetch_add(registers[d.register2]);
+            break;
+        default:
+            value = word.exchange(registers[d.register2]);
+            break;
+        }
+        registers[d.register0] = value;
+
+        if (address < program.getTextSegmentLength()) invalidateInstruction(address, INSTRUCTION_SIZE);
+        return true;
+    }
+
     void VirtualMachine::loadProgram(const std::string& programPath)
     {
-        program.open(programPath);
+        loadProgram(loadImage(programPath));
         /*
         std::cout << "Loaded program: " << programPath << std::endl;
         std::cout << "--- BEGIN PROGRAM MEMORY ---" << std::endl;
@@ -305,6 +860,32 @@ namespace kasm
         */
     }
 
+    std::shared_ptr<const VirtualMachine::Image> VirtualMachine::loadImage(const std::string& programPath) const
+    {
+        return std::make_shared<const Image>(programPath, stackSize, globalSize);
+    }
+
+    void VirtualMachine::loadProgram(std::shared_ptr<const Image> aImage)
+    {
+        image = std::move(aImage);
+        program.load(*image);
+        decodedText = image->getDecodedText();
+        executedText = decodedText;
+        jitFlushPending = true;
+    }
+
+    void VirtualMachine::setJit(bool enabled)
+    {
+        if (enabled)
+        {
+            jit = std::make_unique<Jit>(*this);
+        }
+        else
+        {
+            jit.reset();
+        }
+    }
+
     void VirtualMachine::setSignalHandler(Signal signal, void(*handler)(void))
     {
         signalHandlers[signal] = handler;
@@ -322,129 +903,516 @@ namespace kasm
         }
     }
 
+    char* VirtualMachine::getGuestBuffer(std::uint32_t address, std::uint32_t size)
+    {
+        if (!program.getMemory().isCommitted(address, size))
+        {
+            executeSignal(Signal::SEGMENTATION_FAULT);
+        }
+
+        return program.getCharPtr(address);
+    }
+
+    const char* VirtualMachine::getGuestString(std::uint32_t address)
+    {
+        std::uint64_t length = program.getMemory().getCommittedLength(address);
+        const char* string = program.getCharPtr(address);
+        if (std::memchr(string, '\0', length) == nullptr)
+        {
+            executeSignal(Signal::SEGMENTATION_FAULT);
+        }
+
+        return string;
+    }
+
+    char* VirtualMachine::getWritableGuestBuffer(std::uint32_t address, std::uint32_t size)
+    {
+        if (!program.getMemory().isWritable(address, size))
+        {
+            executeSignal(Signal::SEGMENTATION_FAULT);
+        }
+
+        program.getMemory().prepareWrite(address, size);
+        return program.getCharPtr(address);
+    }
+
+    void VirtualMachine::guestBufferWritten(std::uint32_t address, std::uint32_t size)
+    {
+        if (size && address < program.getTextSegmentLength())
+        {
+            invalidateInstruction(address, std::min(size, program.getTextSegmentLength() - address));
+        }
+    }
+
+    std::uint32_t VirtualMachine::mapFile(std::uint32_t handle, std::uint32_t size, std::uint32_t offset, bool copyOnWrite)
+    {
+        int fd = files.get(handle);
+        if (size == 0)
+        {
+            std::int64_t fileSize = files.size(handle);
+            if (fileSize <= offset || fileSize - offset > std::numeric_limits<std::uint32_t>::max())
+            {
+                return 0;
+            }
+            size = static_cast<std::uint32_t>(fileSize - offset);
+        }
+
+        std::uint64_t pageSize = GuestMemory::getPageSize();
+        std::uint64_t mappingSize = (std::uint64_t(size) + pageSize - 1) / pageSize * pageSize;
+
+        std::uint32_t address = findMappingAddress(mappingSize);
+        if (!address || !program.getMemory().mapFile(address, size, fd, offset, copyOnWrite))
+        {
+            return 0;
+        }
+
+        mappings[address] = static_cast<std::uint32_t>(mappingSize);
+        heap.setLimit(mappings.begin()->first);
+        return address;
+    }
+
+    std::uint32_t VirtualMachine::findMappingAddress(std::uint64_t size) const
+    {
+        // Highest gap below the stack guard, walking down the existing mappings
+        std::uint64_t gapEnd = STACK_OFFSET - STACK_GUARD_SIZE;
+        for (auto it = mappings.rbegin(); ; it++)
+        {
+            std::uint64_t gapBegin = it == mappings.rend() ? heap.getCommittedEnd() : std::uint64_t(it->first) + it->second;
+            if (gapEnd >= gapBegin && gapEnd - gapBegin >= size)
+            {
+                return static_cast<std::uint32_t>(gapEnd - size);
+            }
+            if (it == mappings.rend())
+            {
+                return 0;
+            }
+            gapEnd = it->first;
+        }
+    }
+
+    bool VirtualMachine::unmap(std::uint32_t address)
+    {
+        auto it = mappings.find(address);
+        if (it == mappings.end())
+        {
+            return false;
+        }
+
+        program.getMemory().decommit(it->first, it->second);
+        mappings.erase(it);
+        heap.setLimit(mappings.empty() ? STACK_OFFSET - STACK_GUARD_SIZE : mappings.begin()->first);
+        return true;
+    }
+
+    void VirtualMachine::unmapAll()
+    {
+        while (!mappings.empty())
+        {
+            unmap(mappings.begin()->first);
+        }
+    }
+
+    void VirtualMachine::resetLimits()
+    {
+        exitReason = ExitReason::NORMAL;
+        resetInstructionBudget();
+        outputSize = 0;
+    }
+
+    void VirtualMachine::resetInstructionBudget()
+    {
+        instructionBudget = limits.instructions && limits.instructions < std::uint64_t(std::numeric_limits<std::int64_t>::max())
+            ? static_cast<std::int64_t>(limits.instructions) : std::numeric_limits<std::int64_t>::max();
+        remainingInstructions = instructionBudget;
+        sliceReserve = 0;
+    }
+
+    void VirtualMachine::holdBackInstructions(std::int64_t count)
+    {
+        if (remainingInstructions > count)
+        {
+            sliceReserve += remainingInstructions - count;
+            remainingInstructions = count;
+        }
+    }
+
+    void VirtualMachine::instructionsExhausted()
+    {
+        if (process->stopping)
+        {
+            shouldExit = true;
+        }
+        else if (sliceReserve > 0 && slicing)
+        {
+            preempted = true;
+            shouldExit = true;
+        }
+        else if (sliceReserve > 0)
+        {
+            std::int64_t count = sliceReserve < THREAD_CHECK_INTERVAL ? sliceReserve : THREAD_CHECK_INTERVAL;
+            sliceReserve -= count;
+            remainingInstructions += count;
+        }
+        else
+        {
+            exceedLimit(ExitReason::INSTRUCTION_LIMIT);
+        }
+    }
+
+    bool VirtualMachine::waitForInput(bool skipWhitespace)
+    {
+        if (!nonBlockingInput || console.isInputReady(skipWhitespace))
+        {
+            return true;
+        }
+
+        // The engines advance pc past the system call afterwards, step back so the next slice runs it again. Output
+        // the descriptor does not take has to be written first, the other end may be waiting for it.
+        console.flush();
+        if (console.isOutputBlocked())
+        {
+            waitForOutput();
+        }
+        else
+        {
+            blockedFd = console.getInputFd();
+            shouldExit = true;
+        }
+        pc -= INSTRUCTION_SIZE;
+        return false;
+    }
+
+    void VirtualMachine::waitForOutput()
+    {
+        blockedFd = console.getOutputFd();
+        blockedOnOutput = true;
+        shouldExit = true;
+    }
+
+    void VirtualMachine::exceedLimit(ExitReason reason)
+    {
+        exitReason = reason;
+        shouldExit = true;
+        exitCode = -1;
+        {
+            std::unique_lock<std::recursive_mutex> lock = lockProcess();
+            console.flush();
+        }
+
+        // The limits are the process's, not just this thread's
+        if (threadId)
+        {
+            stopProcess();
+        }
+    }
+
+    bool VirtualMachine::chargeOutput(std::uint64_t size)
+    {
+        if (limits.output && outputSize + size > limits.output)
+        {
+            exceedLimit(ExitReason::OUTPUT_LIMIT);
+            return false;
+        }
+
+        outputSize += size;
+        return true;
+    }
+
+    std::uint64_t VirtualMachine::getMappedSize() const
+    {
+        std::uint64_t size = 0;
+        for (const auto& mapping : mappings)
+        {
+            size += mapping.second;
+        }
+        return size;
+    }
+
+    const char* VirtualMachine::getExitReasonDescription(ExitReason reason)
+    {
+        switch (reason)
+        {
+        case ExitReason::INSTRUCTION_LIMIT:
+            return "Instruction limit exceeded";
+        case ExitReason::MEMORY_LIMIT:
+            return "Memory limit exceeded";
+        case ExitReason::FILE_LIMIT:
+            return "Open file limit exceeded";
+        case ExitReason::OUTPUT_LIMIT:
+            return "Output limit exceeded";
+        default:
+            return "Exited";
+        }
+    }
+
+    const char* VirtualMachine::getSignalDescription(Signal signal)
+    {
+        switch (signal)
+        {
+        case Signal::SEGMENTATION_FAULT:
+            return "Segmentation fault";
+        case Signal::ILLEGAL_OPCODE:
+            return "Illegal opcode";
+        case Signal::STACK_OVERFLOW:
+            return "Stack overflow";
+        default:
+            return "Unhandled signal";
+        }
+    }
+
     void VirtualMachine::systemCall()
     {
+        // Calls that wait hold no lock while they do, whoever they wait for may need it to make progress
+        std::unique_lock<std::recursive_mutex> lock;
+        switch (registers[V0])
+        {
+        case THREAD_JOIN:
+        case CHAN_SEND:
+        case CHAN_RECV:
+            break;
+        default:
+            lock = lockProcess();
+            break;
+        }
+
         switch (registers[V0])
         {
         case EXIT:
             shouldExit = true;
             exitCode = registers[A0];
+            console.flush();
+            if (threadId)
+            {
+                stopProcess();
+            }
             break;
         case READ_INT:
-            std::cin >> registers[A0];
+            if (waitForInput(true))
+            {
+                console.readInt(registers[A0]);
+            }
             break;
         case WRITE_INT:
-            std::cout << registers[A0];
+            if (chargeOutput(decimalLength(registers[A0])))
+            {
+                console.writeInt(registers[A0]);
+            }
             break;
         case READ_CHAR:
-        {
-            char c;
-            std::cin >> c;
-            registers[A0] = static_cast<std::uint32_t>(c);
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            if (waitForInput(true))
+            {
+                registers[A0] = static_cast<std::uint32_t>(static_cast<char>(console.readChar()));
+            }
             break;
-        }
         case WRITE_CHAR:
-            std::cout << static_cast<char>(registers[A0]);
-            break;
-        case READ_STRING:
-            if (registers[A1] < 1)
+            if (chargeOutput(1))
             {
-                break;
+                console.writeChar(static_cast<char>(registers[A0]));
             }
-            else
+            break;
+        case READ_STRING:
+            if (registers[A1] >= 1 && waitForInput(false))
             {
-                char c;
-                unsigned int i = 0;
-                while ((c = std::cin.get()) != '\n' && i < registers[A1] - 1)
-                {
-                    *program.getCharPtr(registers[A0] + i) = c;
-                    i++;
-                }
-                *program.getCharPtr(registers[A0] + i) = '\0';
+                console.readLine(getWritableGuestBuffer(registers[A0], registers[A1]), registers[A1]);
+                guestBufferWritten(registers[A0], registers[A1]);
             }
             break;
         case WRITE_STRING:
-            std::cout << program.getCharPtr(registers[A0]);
+        {
+            const char* string = getGuestString(registers[A0]);
+            std::size_t length = std::strlen(string);
+            if (chargeOutput(length))
+            {
+                console.writeString(string, length);
+            }
             break;
+        }
         case ALLOCATE:
-            registers[V0] = (std::uint32_t)reinterpret_cast<std::uintptr_t>(new std::uint8_t[registers[A0]]);
+            registers[V0] = heap.allocate(registers[A0]);
+            if (limits.memory && heap.getAllocatedSize() + getMappedSize() > limits.memory)
+            {
+                heap.deallocate(registers[V0]);
+                registers[V0] = 0;
+                exceedLimit(ExitReason::MEMORY_LIMIT);
+            }
             break;
         case DEALLOCATE:
-            delete[] reinterpret_cast<std::uint8_t*>(registers[A0]);
+            if (registers[A0] && !heap.deallocate(registers[A0]))
+            {
+                throw std::runtime_error("Invalid deallocation");
+            }
             break;
         case OPEN_FILE:
         {
-            std::ios_base::openmode mode = std::ios_base::in;
+            bool read = false;
+            bool write = false;
 
             switch (registers[A2])
             {
             case 1:
-                mode = std::ios_base::in;
+                read = true;
                 break;
             case 2:
-                mode = std::ios_base::out;
+                write = true;
                 break;
             case 3:
-                mode = std::ios_base::in | std::ios_base::out;
+                read = true;
+                write = true;
                 break;
             default:
                 throw std::runtime_error("Invalid open mode");
                 break;
             }
 
-            files.insert({ fileID, new std::fstream(program.getCharPtr(registers[A0]), mode) });
-            registers[V0] = fileID++;
+            if (limits.files && files.getOpenCount() >= limits.files)
+            {
+                exceedLimit(ExitReason::FILE_LIMIT);
+                break;
+            }
+            registers[V0] = files.open(getGuestString(registers[A0]), read, write);
         }
             break;
         case CLOSE_FILE:
-            delete files.at(registers[A0]);
-            files.erase(registers[A0]);
+            files.close(registers[A0]);
             break;
         case SEEK:
             {
-                std::fstream* file = files.at(registers[A0]);
-
-                std::ios_base::seekdir seekdir = std::ios_base::beg;
+                FileTable::Whence whence = FileTable::Whence::BEGIN;
 
                 switch (registers[A2])
                 {
                 case 0:
-                    seekdir = std::ios_base::beg;
+                    whence = FileTable::Whence::BEGIN;
                     break;
                 case 1:
-                    seekdir = std::ios_base::end;
+                    whence = FileTable::Whence::END;
                     break;
                 case 2:
-                    seekdir = std::ios_base::cur;
+                    whence = FileTable::Whence::CURRENT;
                     break;
                 default:
                     throw std::runtime_error("Invalid seek mode");
                     break;
                 }
 
-                file->seekg(registers[A1], seekdir);
-                file->seekp(registers[A1], seekdir);
+                // The distance and the position are 64 bits wide, split into a low and a high word like file_size's
+                std::int64_t distance = static_cast<std::int64_t>(static_cast<std::uint64_t>(registers[A3]) << 32 | registers[A1]);
+                std::uint64_t position = static_cast<std::uint64_t>(files.seek(registers[A0], distance, whence));
+                registers[V0] = static_cast<std::uint32_t>(position);
+                registers[V1] = static_cast<std::uint32_t>(position >> 32);
             }
             break;
-        default:
-            throw std::runtime_error(std::string("Illegal system call: " + registers[V0]).c_str());
+        case READ_FILE:
+            registers[V0] = static_cast<std::uint32_t>(files.read(registers[A0], getWritableGuestBuffer(registers[A1], registers[A2]), registers[A2]));
+            guestBufferWritten(registers[A1], registers[A2]);
+            break;
+        case WRITE_FILE:
+            if (!chargeOutput(registers[A2]))
+            {
+                break;
+            }
+            registers[V0] = static_cast<std::uint32_t>(files.write(registers[A0], getGuestBuffer(registers[A1], registers[A2]), registers[A2]));
             break;
+        case PREAD:
+        {
+            // The offset's high word is passed in $t0, the fifth argument register
+            std::int64_t offset = static_cast<std::int64_t>(static_cast<std::uint64_t>(registers[T0]) << 32 | registers[A3]);
+            registers[V0] = static_cast<std::uint32_t>(files.pread(registers[A0], getWritableGuestBuffer(registers[A1], registers[A2]), registers[A2], offset));
+            guestBufferWritten(registers[A1], registers[A2]);
         }
-    }
-
-    std::uint32_t VirtualMachine::resolveAddress(const InstructionData& instructionData, AddressType type)
-    {
-        switch (type)
+            break;
+        case PWRITE:
+        {
+            if (!chargeOutput(registers[A2]))
+            {
+                break;
+            }
+            std::int64_t offset = static_cast<std::int64_t>(static_cast<std::uint64_t>(registers[T0]) << 32 | registers[A3]);
+            registers[V0] = static_cast<std::uint32_t>(files.pwrite(registers[A0], getGuestBuffer(registers[A1], registers[A2]), registers[A2], offset));
+        }
+            break;
+        case FILE_SIZE:
+        {
+            std::uint64_t size = static_cast<std::uint64_t>(files.size(registers[A0]));
+            registers[V0] = static_cast<std::uint32_t>(size);
+            registers[V1] = static_cast<std::uint32_t>(size >> 32);
+        }
+            break;
+        case STAT:
         {
-        case kasm::AddressType::DirectAddressAbsolute:
-            return instructionData.directAddressAbsolute;
-        case kasm::AddressType::DirectAddressOffset:
-            return instructionData.directAddressOffset + pc;
-        case kasm::AddressType::IndirectAddressOffset:
-            return registers[instructionData.register1] + instructionData.directAddressOffset + pc;
+            FileTable::Status status;
+            std::uint32_t* buffer = reinterpret_cast<std::uint32_t*>(getWritableGuestBuffer(registers[A1], 4 * sizeof(std::uint32_t)));
+            if (!FileTable::stat(getGuestString(registers[A0]), status))
+            {
+                registers[V0] = static_cast<std::uint32_t>(-1);
+                break;
+            }
+
+            buffer[0] = static_cast<std::uint32_t>(status.size);
+            buffer[1] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(status.size) >> 32);
+            buffer[2] = status.directory;
+            buffer[3] = static_cast<std::uint32_t>(status.modificationTime);
+            guestBufferWritten(registers[A1], 4 * sizeof(std::uint32_t));
+            registers[V0] = 0;
+        }
+            break;
+        case MAP_FILE:
+            registers[V0] = mapFile(registers[A0], registers[A1], registers[A2], registers[A3] != 0);
+            if (registers[V0] && limits.memory && heap.getAllocatedSize() + getMappedSize() > limits.memory)
+            {
+                unmap(registers[V0]);
+                registers[V0] = 0;
+                exceedLimit(ExitReason::MEMORY_LIMIT);
+            }
+            break;
+        case UNMAP:
+            registers[V0] = unmap(registers[A0]) ? 0 : static_cast<std::uint32_t>(-1);
+            break;
+        case SNAPSHOT:
+            // Only marks the spot for executeToSnapshot, a plain run carries on
+            if (stopAtSnapshot)
+            {
+                if (process->threaded)
+                {
+                    throw std::runtime_error("Snapshots of multithreaded programs are not supported");
+                }
+
+                shouldExit = true;
+                snapshotReached = true;
+            }
+            break;
+        case THREAD_SPAWN:
+            registers[V0] = spawnThread(registers[A0], registers[A1], registers[A2]);
+            break;
+        case THREAD_JOIN:
+            registers[V0] = joinThread(registers[A0]);
+            break;
+        case THREAD_EXIT:
+            shouldExit = true;
+            exitCode = registers[A0];
+            waitForThreads = threadId == 0;
+            break;
+        case CHAN_CREATE:
+            registers[V0] = process->channels->create(registers[A0], registers[A1]);
+            break;
+        case CHAN_SEND:
+            sendMessage(registers[A0], registers[A1], registers[A2], registers[V0]);
+            break;
+        case CHAN_RECV:
+            receiveMessage(registers[A0], registers[A1], registers[A2], true, registers[V0]);
+            break;
+        case CHAN_TRY_RECV:
+            receiveMessage(registers[A0], registers[A1], registers[A2], false, registers[V0]);
+            break;
         default:
+            throw std::runtime_error("Illegal system call: " + std::to_string(registers[V0]));
             break;
         }
+
+        // Also left for runSlice() to drain once the program ended
+        if (!shouldExit && console.isOutputBlocked())
+        {
+            waitForOutput();
+        }
     }
 }
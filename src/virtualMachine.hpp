@@ -1,160 +1,349 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <exception>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <unordered_map>
 
+#include "channel.hpp"
 #include "common.hpp"
+#include "console.hpp"
+#include "fileTable.hpp"
+#include "guestHeap.hpp"
+#include "guestMemory.hpp"
+#include "jit.hpp"
+#include "profiler.hpp"
+#include "sampler.hpp"
+#include "statistics.hpp"
 
 namespace kasm
 {
 	class VirtualMachine
 	{
 	public:
-		VirtualMachine() {};
+		VirtualMachine();
 		~VirtualMachine() {};
 
+		VirtualMachine(const VirtualMachine&) = delete;
+		VirtualMachine& operator=(const VirtualMachine&) = delete;
+
+		class Image;
+		class Snapshot;
+
 		int execute();
+
+		// Time slicing for running many instances on few threads: start() resets the loaded program to its entry
+		// point, then every runSlice() continues it for up to quantum instructions, rounded up to a basic block
+		enum class Slice
+		{
+			EXITED, // for any reason, see getExitReason()
+			PREEMPTED, // the quantum ran out
+			BLOCKED // I/O would have to wait for getBlockedFd() to become readable, or writable if isBlockedOnOutput()
+		};
+
+		void start();
+		Slice runSlice(std::uint64_t quantum);
+		int getExitCode() const { return exitCode; }
+		// With non-blocking input, input system calls that would wait stop runSlice() instead and run again on the
+		// next slice. The input descriptor has to be in non-blocking mode itself.
+		void setNonBlockingInput(bool enabled) { nonBlockingInput = enabled; }
+		int getBlockedFd() const { return blockedFd; }
+		// Set when the console's output descriptor, in non-blocking output mode, did not take everything written to
+		// it. The next slice writes the rest before the program continues, or before it exits if it already ended.
+		bool isBlockedOnOutput() const { return blockedOnOutput; }
+
 		void loadProgram(const std::string& programPath);
+		// Loads an image with this virtual machine's stack and global size overrides
+		std::shared_ptr<const Image> loadImage(const std::string& programPath) const;
+		// Runs a shared image, only per instance state such as registers, writable memory and files is private
+		void loadProgram(std::shared_ptr<const Image> aImage);
 
 		enum class Signal
 		{
 			SEGMENTATION_FAULT,
 			ILLEGAL_OPCODE,
 			WATCHED_REGISTER_CHANGED,
-			WATCHED_MEMORY_CHANGED
+			WATCHED_MEMORY_CHANGED,
+			STACK_OVERFLOW
 		};
 
+		// Everything a run depends on except the console: registers, memory, heap, open files and mappings
+		std::shared_ptr<const Snapshot> snapshot();
+		// Puts back a snapshot taken by any virtual machine running the same image, resume() continues from there.
+		// Only pages written since the last snapshot or restore of the same snapshot are copied.
+		void restore(const std::shared_ptr<const Snapshot>& aSnapshot);
+		int resume();
+		// Runs the loaded program from the start up to its SNAPSHOT system call, or until pc reaches address, and
+		// takes a snapshot there. Returns null if the program exits first.
+		std::shared_ptr<const Snapshot> executeToSnapshot();
+		std::shared_ptr<const Snapshot> executeToSnapshot(std::uint32_t address);
+
 		void setSignalHandler(Signal signal, void(*handler)(void));
 		void executeSignal(Signal signal);
+		static const char* getSignalDescription(Signal signal);
+
+		enum class Engine
+		{
+			SWITCH,
+			THREADED
+		};
+
+		void setEngine(Engine aEngine) { engine = aEngine; }
+		Engine getEngine() const { return engine; }
+
+		// Enables the JIT tier of the threaded engine
+		void setJit(bool enabled);
+
+		// Reports every instruction, call and return of the main thread to profiler, which has to outlive the runs.
+		// While profiling the switch engine runs the program whichever engine is selected. nullptr stops profiling.
+		void setProfiler(Profiler* aProfiler) { profiler = aProfiler; }
+		// Samples the main thread and every thread it spawns while they run, whichever engine runs them. The pc is
+		// exact in the switch engine, kept at basic block granularity by the threaded one and stale in compiled code.
+		// sampler has to outlive the runs, nullptr stops sampling.
+		void setSampler(Sampler* aSampler) { sampler = aSampler; }
+		// Counts what the main thread and every thread it spawns execute and merges the counts into statistics once
+		// each of them stops, statistics has to outlive the runs. Counting runs the switch engine whichever engine is
+		// selected, the engines themselves never count. nullptr stops counting.
+		void setStatistics(Statistics* aStatistics) { statistics = aStatistics; }
+
+		// Override the sizes from the program header for programs loaded afterwards, zero keeps the header's choice
+		void setStackSize(std::uint32_t size) { stackSize = size; }
+		void setGlobalSize(std::uint32_t size) { globalSize = size; }
+
+		Console& getConsole() { return console; }
+
+		// Channels the CHAN_ system calls work on, every process has a table of its own unless given a shared one, so
+		// virtual machines sharing a table can pass messages to each other
+		void setChannels(std::shared_ptr<ChannelTable> aChannels);
+		// Initial $a0 and $a1 of the following runs, zero by default
+		void setEntryArguments(std::uint32_t a0, std::uint32_t a1) { entryArguments[0] = a0; entryArguments[1] = a1; }
+
+		// Per run limits, zero means unlimited. The instruction budget is checked at control transfers, so a run may
+		// retire up to a basic block more than allowed before it is stopped.
+		struct Limits
+		{
+			std::uint64_t instructions = 0;
+			std::uint64_t memory = 0; // heap allocations and file mappings
+			std::uint32_t files = 0;
+			std::uint64_t output = 0; // console output and bytes written to files
+		};
+
+		void setLimits(const Limits& aLimits) { limits = aLimits; }
+		const Limits& getLimits() const { return limits; }
+
+		enum class ExitReason
+		{
+			NORMAL, // the program exited or ran off the end of the text segment
+			INSTRUCTION_LIMIT,
+			MEMORY_LIMIT,
+			FILE_LIMIT,
+			OUTPUT_LIMIT
+		};
+
+		// Why the last run stopped, the exit code is -1 if a limit stopped it
+		ExitReason getExitReason() const { return exitReason; }
+		static const char* getExitReasonDescription(ExitReason reason);
+		// Retired by the main thread, threads started by the program are not counted
+		std::uint64_t getRetiredInstructions() const { return instructionBudget - remainingInstructions - sliceReserve; }
+
+		// Instructions a thread of a multithreaded program runs between checks whether another thread ended it
+		static const std::int64_t THREAD_CHECK_INTERVAL = 100000;
 
 	protected:
+		class Process;
+
+		// Runs on the process of another virtual machine, as one of its threads
+		VirtualMachine(std::shared_ptr<Process> aProcess);
+
+		struct DecodedInstruction
+		{
+			std::uint8_t opcode;
+			std::uint8_t register0;
+			std::uint8_t register1;
+			std::uint8_t register2;
+			std::uint8_t handler; // opcode dispatched by the threaded engine, a superinstruction if one starts here
+			std::uint16_t immediate;
+			std::int32_t signedImmediate;
+			std::uint32_t address; // resolved branch/jump target or pc relative memory displacement
+		};
+
+		// Decoded opcodes outside of the 6 bit encodable range used internally by the execution engines
+		enum InternalOpcode : std::uint8_t
+		{
+			TEXT_END = 1 << OPCODE_BIT, // sentinel following the last instruction of the text segment
+
+			// Superinstructions covering the common pseudoinstruction and compiler expansions
+			FUSED_LUI_ORI,  // li, la
+			FUSED_ADDI_SW,  // pushw
+			FUSED_ADDI_SB,  // pushb
+			FUSED_LW_ADDI,  // popw
+			FUSED_LB_ADDI,  // popb
+			FUSED_SW_ADDI,  // klang expression spill
+			FUSED_ADDI_LW,  // klang expression reload
+			FUSED_ENTER,    // enter
+			FUSED_RET,      // ret
+		};
+
+		static const std::uint32_t MAX_FUSED_LENGTH = 6;
+
+		typedef std::vector<DecodedInstruction> DecodedText;
+
+		static DecodedInstruction decodeInstruction(const InstructionData& instructionData, std::uint32_t location);
+		static void fuseInstructions(DecodedText& decoded, std::uint32_t first, std::uint32_t last);
+		void invalidateInstruction(std::uint32_t address, std::uint32_t size = INSTRUCTION_SIZE);
+		// Switches to the decoded text published by the last write to the text segment, the engines call it when
+		// the process' text generation no longer matches executedTextGeneration
+		void refreshText();
+
 		void advancePc();
 		void systemCall();
-		std::uint32_t resolveAddress(const InstructionData& instructionData, AddressType type);
+		void resetLimits();
+		void resetInstructionBudget();
+		void exceedLimit(ExitReason reason);
+		// Moves all but count of the remaining instructions into the reserve, so the engines stop after count
+		void holdBackInstructions(std::int64_t count);
+		// Called by the engines when remainingInstructions runs out, ending the slice or the run, or refilling it from
+		// the reserve after checking that no other thread ended the process
+		void instructionsExhausted();
+		// Stops the run before an input system call that would have to wait, returning false, if input is non-blocking
+		bool waitForInput(bool skipWhitespace);
+		// Stops the run once the console has output left that its descriptor would not take without waiting
+		void waitForOutput();
+		// Counts bytes against the output limit, stopping the run and returning false if they do not fit
+		bool chargeOutput(std::uint64_t size);
+		std::uint64_t getMappedSize() const;
+		// Highest page aligned gap of size bytes below the stack guard and above the heap, 0 if there is none
+		std::uint32_t findMappingAddress(std::uint64_t size) const;
+
+		// Host views of guest memory handed to system calls, raising SEGMENTATION_FAULT instead of faulting in the host
+		char* getGuestBuffer(std::uint32_t address, std::uint32_t size);
+		const char* getGuestString(std::uint32_t address);
+		// Also refuses read only file mappings, and makes sure the host can write to it while the memory is tracked for
+		// a snapshot
+		char* getWritableGuestBuffer(std::uint32_t address, std::uint32_t size);
+		// Keeps the decoded text in sync after a system call wrote to guest memory
+		void guestBufferWritten(std::uint32_t address, std::uint32_t size);
+
+		// File mappings are placed top down below the stack guard, the heap may grow up to the lowest one
+		std::uint32_t mapFile(std::uint32_t handle, std::uint32_t size, std::uint32_t offset, bool copyOnWrite);
+		bool unmap(std::uint32_t address);
+		void unmapAll();
 
-		InstructionData fetchInstruction();
+		// Guest threads. Each runs on a host thread of its own with its own virtual machine, sharing the process. System
+		// calls of different threads are serialized by the process mutex, which lockProcess() only takes once the
+		// program started a thread.
+		std::uint32_t spawnThread(std::uint32_t entry, std::uint32_t argument, std::uint32_t size);
+		std::uint32_t joinThread(std::uint32_t id);
+		void runThread();
+		// Ends every thread of the process, the first thread to end it decides the exit code
+		void stopProcess(std::exception_ptr error = nullptr);
+		// Run by the main thread once it stopped, joins the other threads and takes over the exit code, or rethrows
+		// the error, of whichever thread ended the process
+		void endThreads();
+		std::unique_lock<std::recursive_mutex> lockProcess();
+
+		// Channel system calls, storing -1 in result if the channel does not exist, is closed or, for sends, the
+		// message is too large. Receives store the size of the message, which is truncated to the buffer, or -2 if
+		// they would have to wait and wait is false. A call that is run again in the next slice, or cut short by the
+		// end of the process, leaves result untouched.
+		void sendMessage(std::uint32_t id, std::uint32_t address, std::uint32_t size, std::uint32_t& result);
+		void receiveMessage(std::uint32_t id, std::uint32_t address, std::uint32_t size, bool wait, std::uint32_t& result);
+		// Called before a channel system call waits. Returns false if it must not, after arranging for it to run again
+		// in the next slice, or for the run to end if another thread ended the process.
+		bool waitForChannel();
+
+		const DecodedInstruction& fetchInstruction();
 		void run();
+		void runGuarded(void (VirtualMachine::*body)());
+		void runEngine();
+		void runSwitch();
+		void runProfiled();
+		void runCounted();
+		Statistics::Segment getSegment(std::uint32_t address) const;
+		void runThreaded();
 		void step();
 		void reset();
-		void executeInstruction(const InstructionData& instructionData);
+		void executeInstruction(const DecodedInstruction& instruction);
+		// Whether a conditional branch branches with the registers as they are, false for any other instruction
+		bool isBranchTaken(const DecodedInstruction& instruction);
+		// Runs CAS, AMOADD or AMOSWAP on the word register1 points to as a single host atomic operation, returns false
+		// after raising SEGMENTATION_FAULT if the address is not word aligned
+		bool executeAtomic(const DecodedInstruction& instruction);
 
+		Engine engine = Engine::SWITCH;
+		std::unique_ptr<Jit> jit;
+		Profiler* profiler = nullptr;
+		Sampler* sampler = nullptr;
+		Statistics* statistics = nullptr;
+		std::unique_ptr<Statistics::Counters> counters; // of this thread, not yet merged into statistics
+		bool jitFlushPending = false;
+		std::uint32_t stackSize = 0;
+		std::uint32_t globalSize = 0;
 		std::uint32_t pc, hi, lo;
 		bool shouldExit;
 		int exitCode;
+		bool stopAtSnapshot = false;
+		bool snapshotReached = false;
+
+		Limits limits;
+		ExitReason exitReason = ExitReason::NORMAL;
+		// Counted down by the engines, at basic block granularity except in the switch engine
+		std::int64_t instructionBudget = 0;
+		std::int64_t remainingInstructions = 0;
+		std::int64_t sliceReserve = 0; // part of remainingInstructions held back from the current slice
+
+		bool nonBlockingInput = false;
+		bool slicing = false;
+		bool preempted = false;
+		int blockedFd = -1;
+		bool blockedOnOutput = false;
+		bool draining = false; // exited, but blocked on output
 
-		class Program : public std::vector<std::uint8_t>
+		std::uint32_t threadId = 0; // 0 for the main thread
+		std::uint32_t stackGuard = STACK_OFFSET - STACK_GUARD_SIZE; // faults in the STACK_GUARD_SIZE bytes from here overflow the stack
+		std::uint32_t stackEnd = 0; // one past the top of the stack
+		bool waitForThreads = false; // the main thread ended with THREAD_EXIT, the process lives on until all others end
+		std::uint32_t jitTextGeneration = 0;
+		std::uint32_t entryArguments[2] = { 0, 0 };
+
+		class Program
 		{
 		public:
-			Program() { stack = new std::uint8_t[STACK_SIZE]; global = new std::uint8_t[GLOBAL_SIZE];}
-			Program(const std::string& programPath) { stack = new std::uint8_t[STACK_SIZE]; global = new std::uint8_t[GLOBAL_SIZE]; open(programPath); }
-			~Program() { delete[] stack; delete[] global; };
-
-			void open(const std::string& programPath)
-			{
-				std::ifstream programFile(programPath, std::ios::binary);
-
-				if (!programFile.good())
-				{
-					throw std::runtime_error("Failed to open executable");
-				}
-
-				programFile.read(reinterpret_cast<char*>(&programHeader), sizeof(programHeader));
-				resize(programHeader.textSegmentLength + programHeader.dataSegmentLength);
-				programFile.read(reinterpret_cast<char*>(data()), size());
-			}
-
-			std::uint32_t& getWord(std::uint32_t i)
-			{
-				if (i < DATA_SEGMENT_OFFSET)
-				{
-					return *reinterpret_cast<std::uint32_t*>(data() + i);
-				}
-				else if (i < STACK_OFFSET)
-				{
-					return *reinterpret_cast<std::uint32_t*>(data() + i - DATA_SEGMENT_OFFSET + programHeader.textSegmentLength);
-				}
-				else if (i < GLOBAL_OFFSET)
-				{
-					std::uint32_t tmp = i - STACK_OFFSET;
-					return *reinterpret_cast<std::uint32_t*>(stack + tmp);
-				}
-				else
-				{
-					std::uint32_t tmp = i - GLOBAL_OFFSET;
-					return *reinterpret_cast<std::uint32_t*>(global + tmp);
-				}
-			}
-
-			char* getCharPtr(std::uint32_t i)
-			{
-				if (i < DATA_SEGMENT_OFFSET)
-				{
-					return reinterpret_cast<char*>(data() + i);
-				}
-				else if (i < STACK_OFFSET)
-				{
-					return reinterpret_cast<char*>(data() + i - DATA_SEGMENT_OFFSET + programHeader.textSegmentLength);
-				}
-				else if (i < GLOBAL_OFFSET)
-				{
-					return reinterpret_cast<char*>(stack + i - STACK_OFFSET);
-				}
-				else
-				{
-					return reinterpret_cast<char*>(global + i - GLOBAL_OFFSET);
-				}
-			}
+			Program() {}
 
-			std::uint32_t getTextSegmentLength() const { return programHeader.textSegmentLength; }
+			// Text and data are mapped copy-on-write from the image where the platform allows it, so instances only
+			// pay for the pages they write. Anonymous pages only take up memory once touched, so committing the full
+			// stack and global regions up front is as lazy as committing them on demand.
+			void load(const Image& image);
 
-			std::uint8_t operator[](std::uint32_t i) const
-			{
-				if (i < DATA_SEGMENT_OFFSET)
-				{
-					return data()[i];
-				}
-				else if (i < STACK_OFFSET)
-				{
-					return data()[i - DATA_SEGMENT_OFFSET + programHeader.textSegmentLength];
-				}
-				else if (i < GLOBAL_OFFSET)
-				{
-					return stack[i - STACK_OFFSET];
-				}
-				else
-				{
-					return global[i - GLOBAL_OFFSET];
-				}
-			}
-
-			std::uint8_t& operator[](std::uint32_t i)
-			{
-				if (i < DATA_SEGMENT_OFFSET)
-				{
-					return data()[i];
-				}
-				else if (i < STACK_OFFSET)
-				{
-					return data()[i - DATA_SEGMENT_OFFSET + programHeader.textSegmentLength];
-				}
-				else if (i < GLOBAL_OFFSET)
-				{
-					return stack[i - STACK_OFFSET];
-				}
-				else
-				{
-					return global[i - GLOBAL_OFFSET];
-				}
-			}
+			// Guest addresses map one to one onto the reservation, accesses outside of the committed segments fault
+			std::uint32_t& getWord(std::uint32_t i) { return *reinterpret_cast<std::uint32_t*>(memory.base() + i); }
+			// Only valid for word aligned addresses
+			std::atomic<std::uint32_t>& getAtomicWord(std::uint32_t i) { return *reinterpret_cast<std::atomic<std::uint32_t>*>(memory.base() + i); }
+			char* getCharPtr(std::uint32_t i) { return reinterpret_cast<char*>(memory.base() + i); }
+			std::uint8_t operator[](std::uint32_t i) const { return memory.base()[i]; }
+			std::uint8_t& operator[](std::uint32_t i) { return memory.base()[i]; }
+
+			std::uint32_t getTextSegmentLength() const { return programHeader.textSegmentLength; }
+			std::uint32_t getDataSegmentLength() const { return programHeader.dataSegmentLength; }
+			std::uint32_t getStackSize() const { return stackSize; }
+			std::uint32_t getGlobalSize() const { return globalSize; }
+			GuestMemory& getMemory() { return memory; }
+			const GuestMemory& getMemory() const { return memory; }
 		private:
 			ProgramHeader programHeader;
-			std::uint8_t* stack;
-			std::uint8_t* global;
-		} program;
+			std::uint32_t stackSize = 0;
+			std::uint32_t globalSize = 0;
+			GuestMemory memory;
+		};
 
 		class Registers
 		{
@@ -179,11 +368,114 @@ namespace kasm
 			DEALLOCATE,
 			OPEN_FILE,
 			CLOSE_FILE,
-			SEEK
+			SEEK,
+			READ_FILE,
+			WRITE_FILE,
+			PREAD,
+			PWRITE,
+			FILE_SIZE,
+			STAT,
+			MAP_FILE,
+			UNMAP,
+			SNAPSHOT,
+			THREAD_SPAWN,
+			THREAD_JOIN,
+			THREAD_EXIT,
+			CHAN_CREATE,
+			CHAN_SEND,
+			CHAN_RECV,
+			CHAN_TRY_RECV
 		};
 
+		DecodedInstruction unalignedInstruction;
+
 		std::unordered_map<Signal, void(*)(void)> signalHandlers;
-		std::unordered_map<std::uint32_t, std::fstream*> files;
-		std::uint32_t fileID = 1;
+
+		// Everything the threads of a program share, referenced through the aliases below
+		std::shared_ptr<Process> process;
+		Program& program;
+		GuestHeap& heap;
+		Console& console;
+		FileTable& files;
+		std::map<std::uint32_t, std::uint32_t>& mappings; // guest address -> page aligned size
+		std::shared_ptr<const Image>& image;
+		// Shared with the image until the first write to the text segment, see invalidateInstruction
+		std::shared_ptr<DecodedText>& decodedText;
+		std::uint64_t& outputSize;
+		// The copy of the decoded text the engines run, the same as decodedText unless the process is threaded. Then
+		// other threads may still be running the current copy, so a write publishes a new one instead of rewriting it
+		// and every thread switches over at its next control transfer
+		std::shared_ptr<DecodedText> executedText;
+		std::uint32_t executedTextGeneration = 0;
+
+		friend class Jit;
+	};
+
+	// The address space and resources of a running program, shared by the virtual machines running its threads
+	class VirtualMachine::Process
+	{
+	public:
+		Program program;
+		GuestHeap heap{ program.getMemory() };
+		Console console;
+		FileTable files;
+		std::map<std::uint32_t, std::uint32_t> mappings;
+		std::shared_ptr<const Image> image;
+		std::shared_ptr<DecodedText> decodedText;
+		std::uint64_t outputSize = 0;
+		std::shared_ptr<ChannelTable> channels = std::make_shared<ChannelTable>();
+
+		std::recursive_mutex mutex;
+		bool threaded = false; // set by the main thread before starting the first thread, cleared once all are joined
+		// Bumped on every write to the text segment so each thread's JIT knows to flush
+		std::atomic<std::uint32_t> textGeneration{ 0 };
+
+		struct Thread
+		{
+			std::unique_ptr<VirtualMachine> virtualMachine;
+			std::thread thread;
+			std::uint32_t stack; // mapping holding the stack above its guard
+		};
+
+		std::map<std::uint32_t, Thread> threads; // running or not yet joined, by id
+		std::uint32_t nextThreadId = 1;
+
+		// How the process ended, recorded by the first thread to end it
+		std::atomic<bool> stopping{ false };
+		int exitCode = 0;
+		ExitReason exitReason = ExitReason::NORMAL;
+		std::exception_ptr error;
+	};
+
+	// An executable loaded once and shared, read only, by every virtual machine running it
+	class VirtualMachine::Image
+	{
+	public:
+		// Sizes of zero fall back to the ones in the program header, then to the defaults
+		Image(const std::string& programPath, std::uint32_t aStackSize = 0, std::uint32_t aGlobalSize = 0);
+		~Image();
+
+		Image(const Image&) = delete;
+		Image& operator=(const Image&) = delete;
+
+		const ProgramHeader& getHeader() const { return programHeader; }
+		std::uint32_t getStackSize() const { return stackSize; }
+		std::uint32_t getGlobalSize() const { return globalSize; }
+		const std::vector<std::uint8_t>& getText() const { return text; }
+		const std::vector<std::uint8_t>& getData() const { return data; }
+		// File holding the text at offset 0 and the data at getDataOffset(), -1 if it could not be created
+		int getSegmentsFd() const { return segmentsFd; }
+		std::uint64_t getDataOffset() const { return dataOffset; }
+		const std::shared_ptr<DecodedText>& getDecodedText() const { return decodedText; }
+
+	private:
+		ProgramHeader programHeader;
+		std::uint32_t stackSize;
+		std::uint32_t globalSize;
+		std::vector<std::uint8_t> text;
+		std::vector<std::uint8_t> data;
+		int segmentsFd = -1;
+		std::uint64_t dataOffset = 0;
+		std::shared_ptr<DecodedText> decodedText;
 	};
 }
@@ -0,0 +1,117 @@
+#include "virtualMachine.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace kasm
+{
+    namespace
+    {
+        // How long a channel system call waits at a time before checking whether another thread ended the process
+        const std::chrono::milliseconds CHANNEL_CHECK_INTERVAL(10);
+    }
+
+    void VirtualMachine::setChannels(std::shared_ptr<ChannelTable> aChannels)
+    {
+        process->channels = std::move(aChannels);
+    }
+
+    bool VirtualMachine::waitForChannel()
+    {
+        if (process->stopping)
+        {
+            shouldExit = true;
+            return false;
+        }
+
+        // A waiting instance must not hold on to its worker, give it up and retry the call in the next slice
+        if (slicing)
+        {
+            preempted = true;
+            shouldExit = true;
+            pc -= INSTRUCTION_SIZE;
+            return false;
+        }
+
+        return true;
+    }
+
+    void VirtualMachine::sendMessage(std::uint32_t id, std::uint32_t address, std::uint32_t size, std::uint32_t& result)
+    {
+        Channel* channel = process->channels->get(id);
+        if (channel == nullptr || size > channel->getMessageSize())
+        {
+            result = static_cast<std::uint32_t>(-1);
+            return;
+        }
+
+        while (true)
+        {
+            {
+                // The message is checked again on every try under the process lock, which every unmap takes. Another
+                // thread may have unmapped it while this one waited, and a fault after claiming a slot would leave the
+                // slot claimed for good.
+                std::unique_lock<std::recursive_mutex> lock = lockProcess();
+                const char* message = getGuestBuffer(address, size);
+                if (channel->isClosed())
+                {
+                    break;
+                }
+                if (channel->trySend(message, size))
+                {
+                    result = 0;
+                    return;
+                }
+            }
+            if (!waitForChannel())
+            {
+                return;
+            }
+            channel->waitForSpace(CHANNEL_CHECK_INTERVAL);
+        }
+
+        result = static_cast<std::uint32_t>(-1);
+    }
+
+    void VirtualMachine::receiveMessage(std::uint32_t id, std::uint32_t address, std::uint32_t size, bool wait, std::uint32_t& result)
+    {
+        Channel* channel = process->channels->get(id);
+        if (channel == nullptr)
+        {
+            result = static_cast<std::uint32_t>(-1);
+            return;
+        }
+
+        while (true)
+        {
+            // Checked before trying, so messages sent before the channel was closed are still delivered
+            bool closed = channel->isClosed();
+            {
+                // Like the message of a send, a fault here would lose the message taken off the channel
+                std::unique_lock<std::recursive_mutex> lock = lockProcess();
+                std::int64_t length = channel->tryReceive(getWritableGuestBuffer(address, size), size);
+                if (length != -1)
+                {
+                    guestBufferWritten(address, std::min(size, static_cast<std::uint32_t>(length)));
+                    result = static_cast<std::uint32_t>(length);
+                    return;
+                }
+            }
+            if (closed)
+            {
+                result = static_cast<std::uint32_t>(-1);
+                return;
+            }
+            if (!wait)
+            {
+                result = static_cast<std::uint32_t>(-2);
+                return;
+            }
+            if (!waitForChannel())
+            {
+                return;
+            }
+            channel->waitForMessage(CHANNEL_CHECK_INTERVAL);
+        }
+    }
+}
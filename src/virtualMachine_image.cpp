@@ -0,0 +1,110 @@
+#include "virtualMachine.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define KASM_SHARED_SEGMENTS 1
+#else
+#define KASM_SHARED_SEGMENTS 0
+#endif
+
+namespace kasm
+{
+    VirtualMachine::Image::Image(const std::string& programPath, std::uint32_t aStackSize, std::uint32_t aGlobalSize)
+    {
+        std::ifstream programFile(programPath, std::ios::binary);
+
+        if (!programFile.good())
+        {
+            throw std::runtime_error("Failed to open executable");
+        }
+
+        readProgramHeader(programFile, programHeader);
+
+        std::uint32_t pageSize = GuestMemory::getPageSize();
+        stackSize = aStackSize ? aStackSize : programHeader.stackSize ? programHeader.stackSize : DEFAULT_STACK_SIZE;
+        globalSize = aGlobalSize ? aGlobalSize : programHeader.globalSize ? programHeader.globalSize : DEFAULT_GLOBAL_SIZE;
+        if (stackSize > MAX_STACK_SIZE || globalSize > MAX_GLOBAL_SIZE)
+        {
+            throw std::runtime_error("Stack or global size too large");
+        }
+        // Keeps the initial stack pointer page aligned
+        stackSize = (stackSize + pageSize - 1) / pageSize * pageSize;
+
+        text.resize(programHeader.textSegmentLength);
+        data.resize(programHeader.dataSegmentLength);
+        programFile.read(reinterpret_cast<char*>(text.data()), text.size());
+        programFile.read(reinterpret_cast<char*>(data.data()), data.size());
+
+        std::uint32_t instructionCount = programHeader.textSegmentLength / INSTRUCTION_SIZE;
+        decodedText = std::make_shared<DecodedText>(instructionCount + 1);
+        for (std::uint32_t i = 0; i < instructionCount; i++)
+        {
+            std::uint32_t location = i * INSTRUCTION_SIZE;
+            InstructionData instructionData;
+            std::memcpy(&instructionData.instruction, text.data() + location, sizeof(instructionData.instruction));
+            (*decodedText)[i] = decodeInstruction(instructionData, location);
+        }
+
+        DecodedInstruction textEnd = {};
+        textEnd.opcode = TEXT_END;
+        textEnd.handler = TEXT_END;
+        (*decodedText)[instructionCount] = textEnd;
+
+        fuseInstructions(*decodedText, 0, instructionCount);
+
+#if KASM_SHARED_SEGMENTS
+        // Without a file to map from every instance gets a private copy of the segments instead
+        dataOffset = (std::uint64_t(text.size()) + pageSize - 1) / pageSize * pageSize;
+        segmentsFd = memfd_create("kasm-image", MFD_CLOEXEC);
+        if (segmentsFd != -1)
+        {
+            bool written = ftruncate(segmentsFd, dataOffset + data.size()) == 0
+                && pwrite(segmentsFd, text.data(), text.size(), 0) == static_cast<ssize_t>(text.size())
+                && pwrite(segmentsFd, data.data(), data.size(), dataOffset) == static_cast<ssize_t>(data.size());
+            if (!written)
+            {
+                close(segmentsFd);
+                segmentsFd = -1;
+            }
+        }
+#endif
+    }
+
+    VirtualMachine::Image::~Image()
+    {
+#if KASM_SHARED_SEGMENTS
+        if (segmentsFd != -1)
+        {
+            close(segmentsFd);
+        }
+#endif
+    }
+
+    void VirtualMachine::Program::load(const Image& image)
+    {
+        programHeader = image.getHeader();
+        stackSize = image.getStackSize();
+        globalSize = image.getGlobalSize();
+
+        memory.reset();
+
+        bool mapped = image.getSegmentsFd() != -1
+            && (image.getText().empty() || memory.mapFile(TEXT_SEGMENT_OFFSET, programHeader.textSegmentLength, image.getSegmentsFd(), 0, true))
+            && (image.getData().empty() || memory.mapFile(DATA_SEGMENT_OFFSET, programHeader.dataSegmentLength, image.getSegmentsFd(), image.getDataOffset(), true));
+        if (!mapped)
+        {
+            memory.reset();
+            memory.commit(TEXT_SEGMENT_OFFSET, programHeader.textSegmentLength);
+            memory.commit(DATA_SEGMENT_OFFSET, programHeader.dataSegmentLength);
+            std::copy(image.getText().begin(), image.getText().end(), memory.base() + TEXT_SEGMENT_OFFSET);
+            std::copy(image.getData().begin(), image.getData().end(), memory.base() + DATA_SEGMENT_OFFSET);
+        }
+
+        memory.commit(STACK_OFFSET, stackSize);
+        memory.commit(GLOBAL_OFFSET, globalSize);
+    }
+}
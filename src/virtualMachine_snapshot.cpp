@@ -0,0 +1,132 @@
+#include "virtualMachine.hpp"
+
+#include <stdexcept>
+
+namespace kasm
+{
+    class VirtualMachine::Snapshot
+    {
+    public:
+        Snapshot(VirtualMachine& virtualMachine)
+            : image(virtualMachine.image), decodedText(virtualMachine.decodedText),
+              memory(virtualMachine.program.getMemory().snapshot()), heap(virtualMachine.heap),
+              mappings(virtualMachine.mappings), registers(virtualMachine.registers),
+              pc(virtualMachine.pc), hi(virtualMachine.hi), lo(virtualMachine.lo)
+        {
+            virtualMachine.files.save(files);
+        }
+
+        std::shared_ptr<const Image> image;
+        // Shared like between instances, a write to the text segment after the snapshot copies it first
+        std::shared_ptr<DecodedText> decodedText;
+        std::shared_ptr<const GuestMemory::Snapshot> memory;
+        GuestHeap heap;
+        FileTable files;
+        std::map<std::uint32_t, std::uint32_t> mappings;
+        Registers registers;
+        std::uint32_t pc, hi, lo;
+    };
+
+    std::shared_ptr<const VirtualMachine::Snapshot> VirtualMachine::snapshot()
+    {
+        console.flush();
+        return std::make_shared<const Snapshot>(*this);
+    }
+
+    void VirtualMachine::restore(const std::shared_ptr<const Snapshot>& aSnapshot)
+    {
+        if (image != aSnapshot->image)
+        {
+            loadProgram(aSnapshot->image);
+        }
+
+        program.getMemory().restore(aSnapshot->memory);
+        heap = aSnapshot->heap;
+        files.restore(aSnapshot->files);
+        mappings = aSnapshot->mappings;
+        registers = aSnapshot->registers;
+        pc = aSnapshot->pc;
+        hi = aSnapshot->hi;
+        lo = aSnapshot->lo;
+        shouldExit = false;
+        exitCode = 0;
+        waitForThreads = false;
+        resetLimits();
+
+        if (decodedText != aSnapshot->decodedText)
+        {
+            decodedText = aSnapshot->decodedText;
+            executedText = decodedText;
+            jitFlushPending = true;
+        }
+    }
+
+    int VirtualMachine::resume()
+    {
+        run();
+
+        return exitCode;
+    }
+
+    std::shared_ptr<const VirtualMachine::Snapshot> VirtualMachine::executeToSnapshot()
+    {
+        reset();
+
+        stopAtSnapshot = true;
+        snapshotReached = false;
+        try
+        {
+            run();
+        }
+        catch (...)
+        {
+            stopAtSnapshot = false;
+            throw;
+        }
+        stopAtSnapshot = false;
+
+        if (!snapshotReached)
+        {
+            return nullptr;
+        }
+
+        shouldExit = false;
+        return snapshot();
+    }
+
+    std::shared_ptr<const VirtualMachine::Snapshot> VirtualMachine::executeToSnapshot(std::uint32_t address)
+    {
+        if (address % INSTRUCTION_SIZE || address >= program.getTextSegmentLength())
+        {
+            throw std::runtime_error("Snapshot address outside of the text segment");
+        }
+
+        reset();
+
+        // Traps on an illegal instruction at address the way the debugger's breakpoints do
+        std::uint32_t instruction = program.getWord(address);
+        program.getWord(address) = 0xFFFFFFFF;
+        invalidateInstruction(address);
+
+        bool reached = false;
+        try
+        {
+            run();
+        }
+        catch (Signal signal)
+        {
+            reached = signal == Signal::ILLEGAL_OPCODE && pc == address;
+            if (!reached)
+            {
+                program.getWord(address) = instruction;
+                invalidateInstruction(address);
+                throw;
+            }
+        }
+
+        program.getWord(address) = instruction;
+        invalidateInstruction(address);
+
+        return reached ? snapshot() : nullptr;
+    }
+}
@@ -0,0 +1,379 @@
+#include "virtualMachine.hpp"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define KASM_THREADED_DISPATCH 1
+#else
+#define KASM_THREADED_DISPATCH 0
+#endif
+
+namespace kasm
+{
+#if KASM_THREADED_DISPATCH
+    // Direct threaded engine. Every opcode has its own handler that ends by jumping straight to the handler of the next
+    // instruction, so each handler gets its own indirect branch for the predictor to learn. The pc is tracked implicitly
+    // by the instruction pointer into the decoded text; it is only materialized, and the exit and text bounds checks only
+    // performed, at control transfers and system calls, where the instruction budget is also charged for the whole block
+    // that led there. Falling off the end of the text segment lands on the TEXT_END
+    // sentinel. Memory accesses are the exception, pc is stored before each one so a fault reports the right instruction.
+    //
+    // Superinstructions dispatch on the handler of the first instruction of a sequence and execute every instruction
+    // of the sequence from its own decoded operands, so the architectural state afterwards is exactly that of running
+    // them one by one. Branch targets and breakpoints inside a sequence still see the unfused instructions since only
+    // the first one carries the fused handler.
+    //
+    // With the JIT tier enabled every control transfer also counts as a basic block entry. Blocks that get hot are
+    // compiled and run natively until they branch somewhere not compiled yet.
+    void VirtualMachine::runThreaded()
+    {
+        static void* const dispatchTable[] =
+        {
+            &&op_ADD, &&op_ADDI, &&op_ADDIU, &&op_ADDU, &&op_AND, &&op_ANDI, &&op_BEQ, &&op_BGEZ,
+            &&op_BGEZAL, &&op_BGTZ, &&op_BLEZ, &&op_BLTZ, &&op_BLTZAL, &&op_BNE, &&op_DIV, &&op_DIVU,
+            &&op_J, &&op_JAL, &&op_JR, &&op_LB, &&op_LUI, &&op_LW, &&op_MFHI, &&op_MFLO,
+            &&op_MULT, &&op_MULTU, &&op_OR, &&op_ORI, &&op_SB, &&op_SLL, &&op_SLLV, &&op_SLT,
+            &&op_SLTI, &&op_SLTIU, &&op_SLTU, &&op_SNE, &&op_SEQ, &&op_SRA, &&op_SRL, &&op_SRLV,
+            &&op_SUB, &&op_SUBU, &&op_SW, &&op_SYS, &&op_XOR, &&op_XORI, &&op_JALR, &&op_NOR,
+            &&op_ATOMIC, &&op_ATOMIC, &&op_ATOMIC, &&op_SYNC, &&op_ILLEGAL, &&op_ILLEGAL, &&op_ILLEGAL, &&op_ILLEGAL,
+            &&op_ILLEGAL, &&op_ILLEGAL, &&op_ILLEGAL, &&op_ILLEGAL, &&op_ILLEGAL, &&op_ILLEGAL, &&op_ILLEGAL, &&op_ILLEGAL,
+            &&op_TEXT_END,
+            &&op_FUSED_LUI_ORI, &&op_FUSED_ADDI_SW, &&op_FUSED_ADDI_SB, &&op_FUSED_LW_ADDI, &&op_FUSED_LB_ADDI,
+            &&op_FUSED_SW_ADDI, &&op_FUSED_ADDI_LW, &&op_FUSED_ENTER, &&op_FUSED_RET,
+        };
+
+        const std::uint32_t textSegmentLength = program.getTextSegmentLength();
+        // Keep the pointer to the decoded text in a register rather than reloading the member
+        const std::shared_ptr<DecodedText>* const text = &executedText;
+        const DecodedInstruction* base = (*text)->data();
+        const DecodedInstruction* ip = base;
+        const DecodedInstruction* blockStart = nullptr; // first instruction dispatched since the last transfer
+        std::uint8_t* const memory = program.getMemory().base();
+
+#define PC() (static_cast<std::uint32_t>(ip - base) * INSTRUCTION_SIZE)
+#define DISPATCH() goto *dispatchTable[ip->handler]
+#define NEXT() do { ip++; DISPATCH(); } while (0)
+#define SKIP(count) do { ip += (count); DISPATCH(); } while (0)
+#define JUMP(target) do { pc = (target); goto transfer; } while (0)
+#define R0 registers[ip->register0]
+#define R1 registers[ip->register1]
+#define R2 registers[ip->register2]
+#define WORD(address) (*reinterpret_cast<std::uint32_t*>(memory + (address)))
+#define BYTE(address) (memory[address])
+#define SYNC_PC(i) (pc = PC() + (i) * INSTRUCTION_SIZE)
+
+// Operations of the instruction i slots after ip, used to build the superinstructions
+#define EXEC_ADDI(i) registers[ip[i].register0] = registers[ip[i].register1] + static_cast<std::uint32_t>(ip[i].signedImmediate)
+#define EXEC_OR(i) registers[ip[i].register0] = registers[ip[i].register1] | registers[ip[i].register2]
+#define EXEC_LW(i) do { SYNC_PC(i); registers[ip[i].register0] = WORD(registers[ip[i].register1] + ip[i].address); } while (0)
+#define EXEC_LB(i) do { SYNC_PC(i); registers[ip[i].register0] = BYTE(registers[ip[i].register1] + ip[i].address); } while (0)
+// A store into the text segment may rewrite the rest of the sequence, so resume dispatching right after it
+#define EXEC_SW(i) do {                                                                \
+        std::uint32_t address = registers[ip[i].register1] + ip[i].address;             \
+        SYNC_PC(i);                                                                     \
+        WORD(address) = registers[ip[i].register0];                                     \
+        if (address < textSegmentLength)                                                \
+        {                                                                               \
+            invalidateInstruction(address, INSTRUCTION_SIZE);                           \
+            ip += (i);                                                                  \
+            JUMP(PC() + INSTRUCTION_SIZE);                                              \
+        } } while (0)
+#define EXEC_SB(i) do {                                                                \
+        std::uint32_t address = registers[ip[i].register1] + ip[i].address;             \
+        SYNC_PC(i);                                                                     \
+        BYTE(address) = registers[ip[i].register0];                                     \
+        if (address < textSegmentLength)                                                \
+        {                                                                               \
+            invalidateInstruction(address, 1);                                          \
+            ip += (i);                                                                  \
+            JUMP(PC() + INSTRUCTION_SIZE);                                              \
+        } } while (0)
+
+    transfer:
+        // Every transfer leaves ip on the instruction that made it, which retired the whole block up to it
+        if (blockStart != nullptr)
+        {
+            remainingInstructions -= ip - blockStart + 1;
+            blockStart = nullptr;
+        }
+        if (shouldExit || pc >= textSegmentLength)
+        {
+            return;
+        }
+        if (remainingInstructions <= 0)
+        {
+            instructionsExhausted();
+            goto transfer;
+        }
+        if (pc % INSTRUCTION_SIZE)
+        {
+            remainingInstructions--;
+            step();
+            goto transfer;
+        }
+        std::uint32_t textGeneration = process->textGeneration.load(std::memory_order_relaxed);
+        if (textGeneration != executedTextGeneration)
+        {
+            refreshText();
+        }
+        if (jit)
+        {
+            if (jitFlushPending || textGeneration != jitTextGeneration)
+            {
+                jit->flush();
+                jitFlushPending = false;
+                jitTextGeneration = textGeneration;
+            }
+            if (jit->execute(pc))
+            {
+                goto transfer;
+            }
+        }
+        // A write to the text segment may have replaced the decoded text
+        base = (*text)->data();
+        ip = base + pc / INSTRUCTION_SIZE;
+        blockStart = ip;
+        DISPATCH();
+
+    op_ADD:
+        R0 = R1 + R2;
+        NEXT();
+    op_ADDI:
+        R0 = R1 + static_cast<std::uint32_t>(ip->signedImmediate);
+        NEXT();
+    op_ADDIU:
+        R0 = R1 + ip->immediate;
+        NEXT();
+    op_ADDU:
+        R0 = R1 + R2;
+        NEXT();
+    op_AND:
+        R0 = R1 & R2;
+        NEXT();
+    op_ANDI:
+        R0 = R1 & ip->immediate;
+        NEXT();
+    op_BEQ:
+        if (R0 == R1) JUMP(ip->address);
+        NEXT();
+    op_BGEZ:
+        if (static_cast<std::int32_t>(R0) >= 0) JUMP(ip->address);
+        NEXT();
+    op_BGEZAL:
+        if (static_cast<std::int32_t>(R0) >= 0)
+        {
+            registers[RA] = PC() + INSTRUCTION_SIZE;
+            JUMP(ip->address);
+        }
+        NEXT();
+    op_BGTZ:
+        if (static_cast<std::int32_t>(R0) > 0) JUMP(ip->address);
+        NEXT();
+    op_BLEZ:
+        if (static_cast<std::int32_t>(R0) <= 0) JUMP(ip->address);
+        NEXT();
+    op_BLTZ:
+        if (static_cast<std::int32_t>(R0) < 0) JUMP(ip->address);
+        NEXT();
+    op_BLTZAL:
+        if (static_cast<std::int32_t>(R0) < 0)
+        {
+            registers[RA] = PC() + 2 * INSTRUCTION_SIZE;
+            JUMP(ip->address);
+        }
+        JUMP(PC() + 2 * INSTRUCTION_SIZE);
+    op_BNE:
+        if (R0 != R1) JUMP(ip->address);
+        NEXT();
+    op_DIV:
+    op_DIVU:
+        lo = R0 / R1;
+        hi = R0 % R1;
+        NEXT();
+    op_J:
+        JUMP(ip->address);
+    op_JAL:
+        registers[RA] = PC() + INSTRUCTION_SIZE;
+        JUMP(ip->address);
+    op_JR:
+        JUMP(R0);
+    op_LB:
+        EXEC_LB(0);
+        NEXT();
+    op_LUI:
+        R0 = static_cast<std::uint32_t>(ip->immediate) << (INSTRUCTION_BIT / 2);
+        NEXT();
+    op_LW:
+        EXEC_LW(0);
+        NEXT();
+    op_MFHI:
+        R0 = hi;
+        NEXT();
+    op_MFLO:
+        R0 = lo;
+        NEXT();
+    op_MULT:
+    op_MULTU:
+    {
+        std::uint64_t product = static_cast<std::uint64_t>(R0) * static_cast<std::uint64_t>(R1);
+        lo = static_cast<std::uint32_t>(product);
+        hi = static_cast<std::uint32_t>(product >> 32);
+    }
+        NEXT();
+    op_OR:
+        R0 = R1 | R2;
+        NEXT();
+    op_ORI:
+        R0 = R1 | ip->immediate;
+        NEXT();
+    op_SB:
+        EXEC_SB(0);
+        NEXT();
+    op_SLL:
+        R0 = R1 << ip->immediate;
+        NEXT();
+    op_SLLV:
+        R0 = R1 << R2;
+        NEXT();
+    op_SLT:
+        R0 = R1 < R2;
+        NEXT();
+    op_SLTI:
+    op_SLTIU:
+        R0 = R1 < ip->immediate;
+        NEXT();
+    op_SLTU:
+        R0 = R1 < R2;
+        NEXT();
+    op_SNE:
+        R0 = R1 != R2;
+        NEXT();
+    op_SEQ:
+        R0 = R1 == R2;
+        NEXT();
+    op_SRA:
+        R0 = (R1 >> ip->immediate) | ~(~0U >> ip->immediate);
+        NEXT();
+    op_SRL:
+        R0 = R1 >> ip->immediate;
+        NEXT();
+    op_SRLV:
+        R0 = R1 >> R2;
+        NEXT();
+    op_SUB:
+    op_SUBU:
+        R0 = R1 - R2;
+        NEXT();
+    op_SW:
+        EXEC_SW(0);
+        NEXT();
+    op_SYS:
+        pc = PC();
+        systemCall();
+        JUMP(pc + INSTRUCTION_SIZE);
+    op_XOR:
+        R0 = R1 ^ R2;
+        NEXT();
+    op_XORI:
+        R0 = R1 ^ ip->immediate;
+        NEXT();
+    op_JALR:
+        R1 = PC() + INSTRUCTION_SIZE;
+        JUMP(R0);
+    op_NOR:
+        R0 = ~(R1 | R2);
+        NEXT();
+    op_ATOMIC:
+    {
+        std::uint32_t address = R1;
+        SYNC_PC(0);
+        if (!executeAtomic(*ip))
+        {
+            goto transfer;
+        }
+        // Like a store into the text segment it may have rewritten the rest of the block
+        if (address < textSegmentLength)
+        {
+            JUMP(PC() + INSTRUCTION_SIZE);
+        }
+        NEXT();
+    }
+    op_SYNC:
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        NEXT();
+    op_ILLEGAL:
+        pc = PC();
+        executeSignal(Signal::ILLEGAL_OPCODE);
+        goto transfer;
+    op_TEXT_END:
+        pc = PC();
+        remainingInstructions -= ip - blockStart;
+        return;
+
+    op_FUSED_LUI_ORI:
+        R0 = static_cast<std::uint32_t>(ip->immediate) << (INSTRUCTION_BIT / 2);
+        registers[ip[1].register0] = registers[ip[1].register1] | ip[1].immediate;
+        SKIP(2);
+    op_FUSED_ADDI_SW:
+        EXEC_ADDI(0);
+        EXEC_SW(1);
+        SKIP(2);
+    op_FUSED_ADDI_SB:
+        EXEC_ADDI(0);
+        EXEC_SB(1);
+        SKIP(2);
+    op_FUSED_LW_ADDI:
+        EXEC_LW(0);
+        EXEC_ADDI(1);
+        SKIP(2);
+    op_FUSED_LB_ADDI:
+        EXEC_LB(0);
+        EXEC_ADDI(1);
+        SKIP(2);
+    op_FUSED_SW_ADDI:
+        EXEC_SW(0);
+        EXEC_ADDI(1);
+        SKIP(2);
+    op_FUSED_ADDI_LW:
+        EXEC_ADDI(0);
+        EXEC_LW(1);
+        SKIP(2);
+    op_FUSED_ENTER:
+        EXEC_ADDI(0);
+        EXEC_SW(1);
+        EXEC_ADDI(2);
+        EXEC_SW(3);
+        EXEC_OR(4);
+        SKIP(5);
+    op_FUSED_RET:
+        EXEC_OR(0);
+        EXEC_LW(1);
+        EXEC_ADDI(2);
+        EXEC_LW(3);
+        EXEC_ADDI(4);
+        ip += 5;
+        JUMP(R0);
+
+#undef PC
+#undef DISPATCH
+#undef NEXT
+#undef SKIP
+#undef JUMP
+#undef R0
+#undef R1
+#undef R2
+#undef WORD
+#undef BYTE
+#undef SYNC_PC
+#undef EXEC_ADDI
+#undef EXEC_OR
+#undef EXEC_LW
+#undef EXEC_LB
+#undef EXEC_SW
+#undef EXEC_SB
+    }
+#else
+    void VirtualMachine::runThreaded()
+    {
+        runSwitch();
+    }
+#endif
+}
@@ -0,0 +1,191 @@
+#include "virtualMachine.hpp"
+
+#include <system_error>
+
+namespace kasm
+{
+    std::unique_lock<std::recursive_mutex> VirtualMachine::lockProcess()
+    {
+        std::unique_lock<std::recursive_mutex> lock(process->mutex, std::defer_lock);
+        if (process->threaded)
+        {
+            lock.lock();
+        }
+        return lock;
+    }
+
+    std::uint32_t VirtualMachine::spawnThread(std::uint32_t entry, std::uint32_t argument, std::uint32_t size)
+    {
+        std::lock_guard<std::recursive_mutex> lock(process->mutex);
+
+        // The stack sits above a guard like the main one, in the same area as the file mappings
+        std::uint64_t pageSize = GuestMemory::getPageSize();
+        std::uint64_t stackSize = (std::uint64_t(size ? size : DEFAULT_STACK_SIZE) + pageSize - 1) / pageSize * pageSize;
+        std::uint32_t stack = findMappingAddress(STACK_GUARD_SIZE + stackSize);
+        if (!stack)
+        {
+            return 0;
+        }
+
+        program.getMemory().commit(stack + STACK_GUARD_SIZE, static_cast<std::uint32_t>(stackSize));
+        mappings[stack] = static_cast<std::uint32_t>(STACK_GUARD_SIZE + stackSize);
+        heap.setLimit(mappings.begin()->first);
+        if (limits.memory && heap.getAllocatedSize() + getMappedSize() > limits.memory)
+        {
+            unmap(stack);
+            exceedLimit(ExitReason::MEMORY_LIMIT);
+            return 0;
+        }
+
+        if (!process->threaded)
+        {
+            // From here on writes to the text segment publish a new copy of the decoded text, see invalidateInstruction
+            program.getMemory().stopTracking();
+            process->threaded = true;
+        }
+
+        // Every thread, this one included, has to notice when another one ends the process
+        holdBackInstructions(THREAD_CHECK_INTERVAL);
+
+        std::unique_ptr<VirtualMachine> thread(new VirtualMachine(process));
+        thread->engine = engine;
+        thread->setJit(jit != nullptr);
+        thread->sampler = sampler;
+        thread->statistics = statistics;
+        thread->limits = limits;
+        thread->signalHandlers = signalHandlers;
+        thread->threadId = process->nextThreadId++;
+        thread->stackGuard = stack;
+        thread->pc = entry;
+        thread->hi = 0;
+        thread->lo = 0;
+        thread->shouldExit = false;
+        thread->exitCode = 0;
+        thread->registers.clear();
+        thread->registers[SP] = static_cast<std::uint32_t>(stack + STACK_GUARD_SIZE + stackSize);
+        thread->stackEnd = thread->registers[SP];
+        thread->registers[GP] = GLOBAL_OFFSET;
+        thread->registers[A0] = argument;
+        // Returning from the entry point runs off the end of the text segment, which ends the thread
+        thread->registers[RA] = program.getTextSegmentLength();
+        thread->resetInstructionBudget();
+        thread->holdBackInstructions(THREAD_CHECK_INTERVAL);
+
+        std::uint32_t id = thread->threadId;
+        Process::Thread& entryThread = process->threads[id];
+        entryThread.virtualMachine = std::move(thread);
+        entryThread.stack = stack;
+        try
+        {
+            entryThread.thread = std::thread(&VirtualMachine::runThread, entryThread.virtualMachine.get());
+        }
+        catch (const std::system_error&)
+        {
+            process->threads.erase(id);
+            unmap(stack);
+            return 0;
+        }
+
+        return id;
+    }
+
+    std::uint32_t VirtualMachine::joinThread(std::uint32_t id)
+    {
+        // Taken out of the table, so a second join of the same thread fails instead of waiting as well
+        Process::Thread thread;
+        {
+            std::lock_guard<std::recursive_mutex> lock(process->mutex);
+            auto it = process->threads.find(id);
+            if (it == process->threads.end() || id == threadId)
+            {
+                return static_cast<std::uint32_t>(-1);
+            }
+            thread = std::move(it->second);
+            process->threads.erase(it);
+        }
+
+        thread.thread.join();
+
+        std::lock_guard<std::recursive_mutex> lock(process->mutex);
+        unmap(thread.stack);
+        if (process->stopping)
+        {
+            shouldExit = true;
+        }
+        return static_cast<std::uint32_t>(thread.virtualMachine->exitCode);
+    }
+
+    void VirtualMachine::runThread()
+    {
+        try
+        {
+            runGuarded(&VirtualMachine::runEngine);
+        }
+        catch (...)
+        {
+            stopProcess(std::current_exception());
+        }
+    }
+
+    void VirtualMachine::stopProcess(std::exception_ptr error)
+    {
+        std::lock_guard<std::recursive_mutex> lock(process->mutex);
+        if (!process->stopping)
+        {
+            process->exitCode = exitCode;
+            process->exitReason = exitReason;
+            process->error = error;
+            process->stopping = true;
+        }
+    }
+
+    void VirtualMachine::endThreads()
+    {
+        if (!process->threaded)
+        {
+            return;
+        }
+
+        if (!waitForThreads)
+        {
+            stopProcess();
+        }
+
+        // Threads may still start others while the main thread waits for them to end on their own
+        while (true)
+        {
+            Process::Thread thread;
+            {
+                std::lock_guard<std::recursive_mutex> lock(process->mutex);
+                if (process->threads.empty())
+                {
+                    break;
+                }
+                thread = std::move(process->threads.begin()->second);
+                process->threads.erase(process->threads.begin());
+            }
+
+            thread.thread.join();
+
+            std::lock_guard<std::recursive_mutex> lock(process->mutex);
+            unmap(thread.stack);
+        }
+
+        std::exception_ptr error = process->error;
+        if (process->stopping)
+        {
+            exitCode = process->exitCode;
+            exitReason = process->exitReason;
+        }
+        process->stopping = false;
+        process->error = nullptr;
+        process->threaded = false;
+        // Another thread may have written the text segment since this one last transferred control
+        refreshText();
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}